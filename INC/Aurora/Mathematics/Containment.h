@@ -0,0 +1,33 @@
+/**
+ * @file Containment.h
+ * @brief Defines the Containment enum, representing how a shape lies relative to a volume that contains it, excludes it, or cuts through it.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing how a shape lies relative to a volume.
+		 */
+		enum class Containment
+		{
+			/**
+			 * @brief The shape lies entirely outside the volume.
+			 */
+			Outside,
+
+			/**
+			 * @brief The shape lies partly inside and partly outside the volume.
+			 */
+			Intersecting,
+
+			/**
+			 * @brief The shape lies entirely inside the volume.
+			 */
+			Inside
+		};
+	}
+}
\ No newline at end of file
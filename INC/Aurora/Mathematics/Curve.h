@@ -0,0 +1,28 @@
+/**
+ * @file Curve.h
+ * @brief Defines the Curve enum, representing the space filling curve used to order points so that points close together in space end up close together in memory.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing a space filling curve.
+		 */
+		enum class Curve
+		{
+			/**
+			 * @brief The Z-order curve, which interleaves the bits of the coordinates and is the cheapest to compute, but jumps across space at the boundaries of every power of two.
+			 */
+			Morton,
+
+			/**
+			 * @brief The Hilbert curve, which only ever steps between neighbouring cells and so keeps points closer together, at a few times the cost of a Morton code.
+			 */
+			Hilbert
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * @file Dither.h
+ * @brief Defines the Dither enum, representing the dithering methods used when quantizing colors, as well as functions for quantizing col images to col32.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+#include "Rounding.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct col32;
+
+		/**
+		 * @brief Enumeration representing the available dithering methods.
+		 */
+		enum class Dither
+		{
+			/**
+			 * @brief No dithering, each component is rounded using the requested rounding.
+			 */
+			None,
+
+			/**
+			 * @brief Ordered dithering using an 8x8 Bayer matrix, fast but with a visible cross hatch pattern.
+			 */
+			Bayer,
+
+			/**
+			 * @brief Ordered dithering using a 64x64 blue noise threshold map, producing an even grain without a visible pattern.
+			 */
+			BlueNoise,
+
+			/**
+			 * @brief Floyd-Steinberg error diffusion, which preserves the local average of each component best.
+			 */
+			FloydSteinberg
+		};
+
+		/**
+		 * @brief Quantizes a color to 8 bits per component.
+		 * @param value The color to quantize, each component is clamped to [0, 1] with NaN treated as 0.
+		 * @param rounding The rounding applied to each component.
+		 * @return The quantized color.
+		 * @note Unlike the col32 conversion operator of col, HDR colors are clamped rather than scaled by their brightest component.
+		 */
+		col32 quantize(col value, Rounding rounding = Rounding::Nearest);
+
+		/**
+		 * @brief Quantizes a span of colors to 8 bits per component without dithering.
+		 * @param source The colors to quantize, each component is clamped to [0, 1] with NaN treated as 0.
+		 * @param destination The quantized colors.
+		 * @param rounding The rounding applied to each component.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 * @note Large spans are split across threadCount() threads.
+		 */
+		void quantize(std::span<const col> source, std::span<col32> destination, Rounding rounding = Rounding::Nearest);
+
+		/**
+		 * @brief Quantizes an image to 8 bits per component with the requested dithering.
+		 * @param source The pixels of the image, row by row, each component is clamped to [0, 1] with NaN treated as 0.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The quantized pixels of the image.
+		 * @param dither The dithering method to apply to the color components.
+		 * @param rounding The rounding applied to each component when no dithering is used, and to the alpha component in every case.
+		 * @throws std::invalid_argument if the dimensions are negative, the source or destination is too small, or the dithering method is not defined.
+		 * @note Ordered dithering splits the rows across threadCount() threads, Floyd-Steinberg pipelines the rows across threadCount() threads with each row trailing the row above it.
+		 * The dither pattern is anchored to the image, so the same image always quantizes to the same result regardless of the number of threads.
+		 */
+		void quantize(std::span<const col> source, int width, int height, std::span<col32> destination, Dither dither, Rounding rounding = Rounding::Nearest);
+	}
+}
\ No newline at end of file
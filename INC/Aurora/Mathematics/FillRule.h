@@ -0,0 +1,28 @@
+/**
+ * @file FillRule.h
+ * @brief Defines the FillRule enum, representing which parts of the plane a filled path covers where its contours overlap or cross themselves.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing the rule deciding whether a point is inside a path, from the contours crossing a ray from the point.
+		 */
+		enum class FillRule
+		{
+			/**
+			 * @brief A point is inside if the contours crossing the ray going one way do not match those going the other way, so a contour inside another going the same way adds nothing and one going the other way cuts a hole.
+			 */
+			NonZero,
+
+			/**
+			 * @brief A point is inside if the ray crosses an odd number of contours, so every contour inside another cuts a hole whatever its direction.
+			 */
+			EvenOdd
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * @file Filter.h
+ * @brief Defines the Filter enum, representing the reconstruction filters used when resampling images, as well as functions for separable convolution and resampling of col and col32 images.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct col32;
+
+		/**
+		 * @brief Enumeration representing the available resampling filters.
+		 */
+		enum class Filter
+		{
+			/**
+			 * @brief Bilinear filtering, weighting the 2x2 nearest pixels as lerp does.
+			 */
+			Bilinear,
+
+			/**
+			 * @brief Bicubic filtering, weighting the 4x4 nearest pixels as catmullRom does, sharper than bilinear but may overshoot at hard edges.
+			 */
+			CatmullRom
+		};
+
+		/**
+		 * @brief Convolves an image with a separable kernel, applied once horizontally and once vertically.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The filtered pixels of the image, must not be the same memory as the source.
+		 * @param kernel The weights of the kernel, centered on the middle weight, pixels beyond the edges of the image repeat the edge pixels.
+		 * @throws std::invalid_argument if the dimensions are negative, the source or destination is too small, or the kernel does not have an odd number of weights.
+		 * @note The image is processed in tiles of rows that are split across threadCount() threads.
+		 */
+		void convolve(std::span<const col> source, int width, int height, std::span<col> destination, std::span<const float> kernel);
+
+		/**
+		 * @brief Convolves an image with a separable kernel, applied once horizontally and once vertically.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The filtered pixels of the image, must not be the same memory as the source.
+		 * @param kernel The weights of the kernel, centered on the middle weight, pixels beyond the edges of the image repeat the edge pixels.
+		 * @throws std::invalid_argument if the dimensions are negative, the source or destination is too small, or the kernel does not have an odd number of weights.
+		 * @note Components are filtered as stored, without sRGB decoding, and the result is rounded to the nearest value and clamped to [0, 255].
+		 * The image is processed in tiles of rows that are split across threadCount() threads.
+		 */
+		void convolve(std::span<const col32> source, int width, int height, std::span<col32> destination, std::span<const float> kernel);
+
+		/**
+		 * @brief Blurs an image by averaging the pixels in a square around each pixel.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The blurred pixels of the image, must not be the same memory as the source.
+		 * @param radius The number of pixels on each side of a pixel included in its average.
+		 * @throws std::invalid_argument if the dimensions or radius are negative, the radius is too large for the number of weights to fit in an int, or the source or destination is too small.
+		 */
+		void boxBlur(std::span<const col> source, int width, int height, std::span<col> destination, int radius);
+
+		/**
+		 * @brief Blurs an image by averaging the pixels in a square around each pixel.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The blurred pixels of the image, must not be the same memory as the source.
+		 * @param radius The number of pixels on each side of a pixel included in its average.
+		 * @throws std::invalid_argument if the dimensions or radius are negative, the radius is too large for the number of weights to fit in an int, or the source or destination is too small.
+		 */
+		void boxBlur(std::span<const col32> source, int width, int height, std::span<col32> destination, int radius);
+
+		/**
+		 * @brief Blurs an image with a gaussian kernel.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The blurred pixels of the image, must not be the same memory as the source.
+		 * @param sigma The standard deviation of the gaussian in pixels, the kernel extends 3 standard deviations to each side.
+		 * @throws std::invalid_argument if the dimensions are negative, the sigma is too large for the number of weights to fit in an int, or the source or destination is too small.
+		 * @note A sigma of 0 or less copies the image.
+		 */
+		void gaussianBlur(std::span<const col> source, int width, int height, std::span<col> destination, float sigma);
+
+		/**
+		 * @brief Blurs an image with a gaussian kernel.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The blurred pixels of the image, must not be the same memory as the source.
+		 * @param sigma The standard deviation of the gaussian in pixels, the kernel extends 3 standard deviations to each side.
+		 * @throws std::invalid_argument if the dimensions are negative, the sigma is too large for the number of weights to fit in an int, or the source or destination is too small.
+		 * @note A sigma of 0 or less copies the image.
+		 */
+		void gaussianBlur(std::span<const col32> source, int width, int height, std::span<col32> destination, float sigma);
+
+		/**
+		 * @brief Resamples an image to a new size.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The pixels of the resampled image, row by row, must not be the same memory as the source.
+		 * @param destinationWidth The width of the resampled image in pixels.
+		 * @param destinationHeight The height of the resampled image in pixels.
+		 * @param filter The filter used to reconstruct the image between its pixels.
+		 * @throws std::invalid_argument if any dimension is negative, the source is empty while the destination is not, the source or destination is too small, or the filter is not defined.
+		 * @note The edges of both images are aligned, so a pixel center maps to the same relative position in the source. Reductions of more than 2x skip over source pixels, blur the image first or reduce it in steps to avoid aliasing.
+		 * The image is processed in tiles of rows that are split across threadCount() threads.
+		 */
+		void resample(std::span<const col> source, int width, int height, std::span<col> destination, int destinationWidth, int destinationHeight, Filter filter);
+
+		/**
+		 * @brief Resamples an image to a new size.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The pixels of the resampled image, row by row, must not be the same memory as the source.
+		 * @param destinationWidth The width of the resampled image in pixels.
+		 * @param destinationHeight The height of the resampled image in pixels.
+		 * @param filter The filter used to reconstruct the image between its pixels.
+		 * @throws std::invalid_argument if any dimension is negative, the source is empty while the destination is not, the source or destination is too small, or the filter is not defined.
+		 * @note Components are filtered as stored, without sRGB decoding, and the result is rounded to the nearest value and clamped to [0, 255].
+		 * The edges of both images are aligned, so a pixel center maps to the same relative position in the source. Reductions of more than 2x skip over source pixels, blur the image first or reduce it in steps to avoid aliasing.
+		 */
+		void resample(std::span<const col32> source, int width, int height, std::span<col32> destination, int destinationWidth, int destinationHeight, Filter filter);
+	}
+}
\ No newline at end of file
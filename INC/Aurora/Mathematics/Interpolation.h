@@ -0,0 +1,38 @@
+/**
+ * @file Interpolation.h
+ * @brief Defines the Interpolation enum, representing how the values of a track change between its keys.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing how the values of a track change between its keys.
+		 */
+		enum class Interpolation
+		{
+			/**
+			 * @brief Holds the value of a key until the next key.
+			 */
+			Step,
+
+			/**
+			 * @brief Interpolates linearly between the values of two keys.
+			 */
+			Linear,
+
+			/**
+			 * @brief Follows a cubic curve through the keys whose tangent at each key is the slope between the keys on either side, as catmullRom does when the keys are evenly spaced.
+			 */
+			CatmullRom,
+
+			/**
+			 * @brief Follows a cubic curve through the keys with the tangent given for each key, as hermite does.
+			 */
+			Hermite
+		};
+	}
+}
\ No newline at end of file
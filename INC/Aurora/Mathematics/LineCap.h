@@ -0,0 +1,33 @@
+/**
+ * @file LineCap.h
+ * @brief Defines the LineCap enum, representing how a stroke ends at the start and end of an open contour of a path.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing the shape of the ends of a stroke.
+		 */
+		enum class LineCap
+		{
+			/**
+			 * @brief Ends the stroke square at the end of the contour, so a contour of a single point draws nothing.
+			 */
+			Butt,
+
+			/**
+			 * @brief Ends the stroke with a half circle centred on the end of the contour, so a contour of a single point draws a dot.
+			 */
+			Round,
+
+			/**
+			 * @brief Ends the stroke square, half the width of the stroke past the end of the contour, so a contour of a single point draws a square.
+			 */
+			Square
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file LineJoin.h
+ * @brief Defines the LineJoin enum, representing how a stroke fills the outer corner where two segments of a path meet.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing the shape of the corners of a stroke.
+		 */
+		enum class LineJoin
+		{
+			/**
+			 * @brief Extends the outer edges of both segments until they meet in a point, falling back to a bevel when the point is farther from the corner than the miter limit allows.
+			 */
+			Miter,
+
+			/**
+			 * @brief Fills the corner with an arc centred on the corner, of the radius of half the width of the stroke.
+			 */
+			Round,
+
+			/**
+			 * @brief Cuts the corner with a straight line between the outer edges of both segments.
+			 */
+			Bevel
+		};
+	}
+}
\ No newline at end of file
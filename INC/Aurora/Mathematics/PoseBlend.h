@@ -0,0 +1,28 @@
+/**
+ * @file PoseBlend.h
+ * @brief Defines the PoseBlend enum, representing how a layer of animation is combined with the pose beneath it.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing how a layer of animation is combined with the pose beneath it.
+		 */
+		enum class PoseBlend
+		{
+			/**
+			 * @brief The layer replaces the pose beneath it by its weight, interpolating the translations and scales linearly and the rotations along the shortest arc.
+			 */
+			Override,
+
+			/**
+			 * @brief The layer holds differences from a reference pose, as computed by pose::difference, which are added to the pose beneath it by its weight, rotating each bone in its local space before its own rotation.
+			 */
+			Additive
+		};
+	}
+}
\ No newline at end of file
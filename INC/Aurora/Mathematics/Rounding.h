@@ -0,0 +1,28 @@
+/**
+ * @file Rounding.h
+ * @brief Defines the Rounding enum representing the ways a continuous value can be rounded to an integer.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumerates the ways a continuous value can be rounded to an integer.
+		 */
+		enum class Rounding
+		{
+			/**
+			 * @brief Rounds towards zero, matching a static_cast to an integer type.
+			 */
+			Truncate,
+
+			/**
+			 * @brief Rounds to the nearest integer, with halves rounded up.
+			 */
+			Nearest
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+/**
+ * @file Spline.h
+ * @brief Defines the Spline enum, representing how the control points of a spline shape the curve between them.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Enumeration representing the kind of a spline.
+		 */
+		enum class Spline
+		{
+			/**
+			 * @brief Passes through every point, with the tangent at each point half the difference between the points on either side, as catmullRom does, and the first and last points repeated to give the ends a neighbour.
+			 */
+			CatmullRom,
+
+			/**
+			 * @brief Passes through every point with the tangent given for each point, as hermite does.
+			 */
+			Hermite,
+
+			/**
+			 * @brief Cubic Bézier segments sharing their end points, where every segment is a point on the curve, two control points, and the point the next segment starts from.
+			 */
+			Bezier,
+
+			/**
+			 * @brief A uniform cubic B-spline, which passes near the points rather than through them and whose curvature is continuous across segments, each segment being shaped by four consecutive points.
+			 */
+			BSpline
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file Tonemap.h
+ * @brief Defines the Tonemap enum, representing the tone mapping operators used to map high dynamic range colors into the displayable range, as well as functions for applying them to colors.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct col32;
+
+		/**
+		 * @brief Enumeration representing the available tone mapping operators.
+		 */
+		enum class Tonemap
+		{
+			/**
+			 * @brief The Reinhard operator (x / (1 + x)), never reaches full white.
+			 */
+			Reinhard,
+
+			/**
+			 * @brief The extended Reinhard operator, maps the white point to full white.
+			 */
+			ReinhardExtended,
+
+			/**
+			 * @brief The fitted ACES filmic curve (Narkowicz).
+			 */
+			Aces,
+
+			/**
+			 * @brief The Hable (Uncharted 2) filmic curve, normalized so that the white point maps to full white.
+			 */
+			Filmic
+		};
+
+		/**
+		 * @brief Applies a tone mapping operator to a high dynamic range color.
+		 * @param op The tone mapping operator to apply.
+		 * @param value The linear high dynamic range color.
+		 * @param exposure The multiplier applied to the color before tone mapping.
+		 * @param whitePoint The exposed intensity that maps to full white, used by the ReinhardExtended and Filmic operators.
+		 * @return The tone mapped linear color, with each component in the range [0, 1] and the alpha component clamped to [0, 1].
+		 * @throws std::invalid_argument if the operator uses the white point and it is not positive.
+		 * @note Negative and NaN components are treated as 0.
+		 */
+		col tonemap(Tonemap op, col value, float exposure = 1.0f, float whitePoint = 4.0f);
+
+		/**
+		 * @brief Applies a tone mapping operator to a span of high dynamic range colors.
+		 * @param op The tone mapping operator to apply.
+		 * @param source The linear high dynamic range colors.
+		 * @param destination The tone mapped linear colors, may be the same memory as the source.
+		 * @param exposure The multiplier applied to each color before tone mapping.
+		 * @param whitePoint The exposed intensity that maps to full white, used by the ReinhardExtended and Filmic operators.
+		 * @throws std::invalid_argument if the destination is smaller than the source, or if the operator uses the white point and it is not positive.
+		 * @note Large spans are split across threadCount() threads.
+		 */
+		void tonemap(Tonemap op, std::span<const col> source, std::span<col> destination, float exposure = 1.0f, float whitePoint = 4.0f);
+
+		/**
+		 * @brief Applies a tone mapping operator to a span of high dynamic range colors and encodes the result as 8-bit sRGB.
+		 * @param op The tone mapping operator to apply.
+		 * @param source The linear high dynamic range colors.
+		 * @param destination The sRGB encoded colors, the alpha component is stored linearly.
+		 * @param exposure The multiplier applied to each color before tone mapping.
+		 * @param whitePoint The exposed intensity that maps to full white, used by the ReinhardExtended and Filmic operators.
+		 * @throws std::invalid_argument if the destination is smaller than the source, or if the operator uses the white point and it is not positive.
+		 * @note Large spans are split across threadCount() threads.
+		 */
+		void tonemap(Tonemap op, std::span<const col> source, std::span<col32> destination, float exposure = 1.0f, float whitePoint = 4.0f);
+	}
+}
\ No newline at end of file
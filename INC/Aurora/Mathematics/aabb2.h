@@ -0,0 +1,251 @@
+/**
+ * @file aabb2.h
+ * @brief Defines the aabb2 structure, representing an axis aligned 2D rectangle stored as its minimum and maximum corners.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct rect;
+		struct vec2;
+
+		/**
+		 * @brief Represents an axis aligned 2D rectangle by its minimum and maximum corners.
+		 * @note Unlike rect, which stores a position and size, the corners are stored directly in 16 bytes, so overlap, containment and merge tests are a handful of vectorizable minimum, maximum and comparison operations.
+		 * A default constructed aabb2 is empty, containing nothing, and becomes valid once a point or rectangle is merged into it.
+		 * Since the type is over-aligned, it is passed by reference, which 32-bit x86 requires of over-aligned parameters.
+		 */
+		struct alignas(16) aabb2
+		{
+			/**
+			 * @brief Default constructor, initializes an empty rectangle.
+			 */
+			aabb2();
+
+			/**
+			 * @brief Constructs a rectangle from its corners.
+			 * @param min The minimum corner.
+			 * @param max The maximum corner.
+			 * @note The corners are stored as given, if any component of min is greater than max the rectangle is empty.
+			 */
+			aabb2(vec2 min, vec2 max);
+
+			/**
+			 * @brief Constructs a rectangle covering the same area as a rect.
+			 * @param value The rect to convert, a negative size extends it from its position in the negative direction.
+			 * @note The maximum corner is the position plus the size, which is exact unless that sum is rounded.
+			 */
+			aabb2(rect value);
+
+			/**
+			 * @brief Gets the minimum corner of the rectangle.
+			 * @return The minimum corner.
+			 */
+			vec2 min() const;
+
+			/**
+			 * @brief Sets the minimum corner of the rectangle.
+			 * @param value The new minimum corner.
+			 */
+			void min(vec2 value);
+
+			/**
+			 * @brief Gets the maximum corner of the rectangle.
+			 * @return The maximum corner.
+			 */
+			vec2 max() const;
+
+			/**
+			 * @brief Sets the maximum corner of the rectangle.
+			 * @param value The new maximum corner.
+			 */
+			void max(vec2 value);
+
+			/**
+			 * @brief Gets the components of the minimum corner where they are stored, for the functions of this library that read many rectangles at once without converting each to a vec2.
+			 * @return The x and y of the minimum corner.
+			 */
+			inline const float* minLanes() const { return min_; }
+
+			/**
+			 * @brief Gets the components of the maximum corner where they are stored, for the functions of this library that read many rectangles at once without converting each to a vec2.
+			 * @return The x and y of the maximum corner.
+			 */
+			inline const float* maxLanes() const { return max_; }
+
+			/**
+			 * @brief Gets the center of the rectangle.
+			 * @return The center.
+			 */
+			vec2 center() const;
+
+			/**
+			 * @brief Gets the size of the rectangle.
+			 * @return The size, the difference between the maximum and minimum corners, or a size of zero if the rectangle is empty.
+			 */
+			vec2 size() const;
+
+			/**
+			 * @brief Checks if the rectangle is empty.
+			 * @return True if any component of the minimum corner is greater than the maximum corner, false otherwise.
+			 * @note A rectangle with a size of zero along an axis is not empty, it still contains the points on its boundary.
+			 */
+			bool empty() const;
+
+			/**
+			 * @brief Calculates the area of the rectangle.
+			 * @return The area, or 0 if the rectangle is empty.
+			 */
+			float area() const;
+
+			/**
+			 * @brief Calculates the perimeter of the rectangle.
+			 * @return The perimeter, or 0 if the rectangle is empty.
+			 */
+			float perimeter() const;
+
+			/**
+			 * @brief Checks if two rectangles are approximately equal.
+			 * @param value1 The first rectangle to compare.
+			 * @param value2 The second rectangle to compare.
+			 * @return True if the corners are approximately equal, false otherwise.
+			 */
+			static bool approximately(const aabb2& value1, const aabb2& value2);
+
+			/**
+			 * @brief Checks if a point is inside a rectangle.
+			 * @param value The rectangle to check against.
+			 * @param point The point to check.
+			 * @return True if the point is inside the rectangle or on its boundary, false otherwise.
+			 */
+			static bool inside(const aabb2& value, vec2 point);
+
+			/**
+			 * @brief Checks if a point is inside this rectangle.
+			 * @param point The point to check.
+			 * @return True if the point is inside the rectangle or on its boundary, false otherwise.
+			 */
+			bool inside(vec2 point) const;
+
+			/**
+			 * @brief Checks if one rectangle is completely inside another.
+			 * @param value1 The containing rectangle.
+			 * @param value2 The rectangle to check.
+			 * @return True if value2 is inside value1, false otherwise.
+			 */
+			static bool inside(const aabb2& value1, const aabb2& value2);
+
+			/**
+			 * @brief Checks if another rectangle is completely inside this rectangle.
+			 * @param value The rectangle to check.
+			 * @return True if the specified rectangle is inside this rectangle, false otherwise.
+			 */
+			bool inside(const aabb2& value) const;
+
+			/**
+			 * @brief Checks if two rectangles intersect.
+			 * @param value1 The first rectangle to check.
+			 * @param value2 The second rectangle to check against.
+			 * @return True if the rectangles overlap, false if they are disjoint or only touch.
+			 */
+			static bool intersects(const aabb2& value1, const aabb2& value2);
+
+			/**
+			 * @brief Checks if this rectangle intersects with another.
+			 * @param other The rectangle to check against.
+			 * @return True if the rectangles overlap, false if they are disjoint or only touch.
+			 */
+			bool intersects(const aabb2& other) const;
+
+			/**
+			 * @brief Calculates the overlapping region of two rectangles.
+			 * @param value1 The first rectangle.
+			 * @param value2 The second rectangle.
+			 * @return The overlapping region, which is empty if the rectangles are disjoint.
+			 */
+			static aabb2 intersection(const aabb2& value1, const aabb2& value2);
+
+			/**
+			 * @brief Merges two rectangles into a new rectangle that encompasses both.
+			 * @param value1 The first rectangle to merge.
+			 * @param value2 The second rectangle to merge.
+			 * @return A new rectangle that encompasses both input rectangles.
+			 */
+			static aabb2 merge(const aabb2& value1, const aabb2& value2);
+
+			/**
+			 * @brief Merges another rectangle into this rectangle, expanding to encompass both.
+			 * @param value The rectangle to merge with.
+			 */
+			void merge(const aabb2& value);
+
+			/**
+			 * @brief Merges a rectangle with a point, expanding to encompass both.
+			 * @param value The rectangle to merge.
+			 * @param point The point to merge with.
+			 * @return A new rectangle that encompasses both the input rectangle and point.
+			 */
+			static aabb2 merge(const aabb2& value, vec2 point);
+
+			/**
+			 * @brief Merges a point into this rectangle, expanding to encompass both.
+			 * @param point The point to merge with.
+			 */
+			void merge(vec2 point);
+
+			/**
+			 * @brief Expands a rectangle by the same amount in every direction.
+			 * @param value The rectangle to expand.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the rectangle.
+			 * @return The expanded rectangle.
+			 */
+			static aabb2 expand(const aabb2& value, float amount);
+
+			/**
+			 * @brief Expands this rectangle by the same amount in every direction.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the rectangle.
+			 */
+			void expand(float amount);
+
+			/**
+			 * @brief Expands a rectangle by a separate amount along each axis.
+			 * @param value The rectangle to expand.
+			 * @param amount The distance the sides along each axis are moved outwards.
+			 * @return The expanded rectangle.
+			 */
+			static aabb2 expand(const aabb2& value, vec2 amount);
+
+			/**
+			 * @brief Expands this rectangle by a separate amount along each axis.
+			 * @param amount The distance the sides along each axis are moved outwards.
+			 */
+			void expand(vec2 amount);
+
+			/**
+			 * @brief Compares two rectangles for equality.
+			 * @param other The rectangle to compare against.
+			 * @return True if the rectangles are equal, false otherwise.
+			 */
+			bool operator ==(const aabb2& other) const;
+
+			/**
+			 * @brief Compares two rectangles for inequality.
+			 * @param other The rectangle to compare against.
+			 * @return True if the rectangles are not equal, false otherwise.
+			 */
+			bool operator !=(const aabb2& other) const;
+
+			/**
+			 * @brief Converts the rectangle to a rect.
+			 * @return The rect with its position at the minimum corner, or a rect of size zero at the origin if this rectangle is empty.
+			 */
+			operator rect() const;
+		private:
+			float min_[2];
+			float max_[2];
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+/**
+ * @file aabb3.h
+ * @brief Defines the aabb3 structure, representing an axis aligned 3D box stored as its minimum and maximum corners.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct bounds;
+		struct vec3;
+
+		/**
+		 * @brief Represents an axis aligned 3D box by its minimum and maximum corners.
+		 * @note Unlike bounds, which stores a position and size, the corners are stored directly and padded to 32 bytes, so overlap, containment and merge tests are a handful of vectorizable minimum, maximum and comparison operations.
+		 * A default constructed aabb3 is empty, containing nothing, and becomes valid once a point or box is merged into it.
+		 * Since the type is over-aligned, it is passed by reference, which 32-bit x86 requires of over-aligned parameters.
+		 */
+		struct alignas(32) aabb3
+		{
+			/**
+			 * @brief Default constructor, initializes an empty box.
+			 */
+			aabb3();
+
+			/**
+			 * @brief Constructs a box from its corners.
+			 * @param min The minimum corner.
+			 * @param max The maximum corner.
+			 * @note The corners are stored as given, if any component of min is greater than max the box is empty.
+			 */
+			aabb3(vec3 min, vec3 max);
+
+			/**
+			 * @brief Constructs a box covering the same volume as a bounds.
+			 * @param value The bounds to convert, a negative size extends it from its position in the negative direction.
+			 * @note The maximum corner is the position plus the size, which is exact unless that sum is rounded.
+			 */
+			aabb3(bounds value);
+
+			/**
+			 * @brief Gets the minimum corner of the box.
+			 * @return The minimum corner.
+			 */
+			vec3 min() const;
+
+			/**
+			 * @brief Sets the minimum corner of the box.
+			 * @param value The new minimum corner.
+			 */
+			void min(vec3 value);
+
+			/**
+			 * @brief Gets the maximum corner of the box.
+			 * @return The maximum corner.
+			 */
+			vec3 max() const;
+
+			/**
+			 * @brief Sets the maximum corner of the box.
+			 * @param value The new maximum corner.
+			 */
+			void max(vec3 value);
+
+			/**
+			 * @brief Gets the components of the minimum corner where they are stored, for the functions of this library that read many boxes at once without converting each to a vec3.
+			 * @return The x, y and z of the minimum corner followed by an unused lane holding the lowest float, four floats aligned to 16 bytes.
+			 */
+			inline const float* minLanes() const { return min_; }
+
+			/**
+			 * @brief Gets the components of the maximum corner where they are stored, for the functions of this library that read many boxes at once without converting each to a vec3.
+			 * @return The x, y and z of the maximum corner followed by an unused lane holding the highest float, four floats aligned to 16 bytes.
+			 */
+			inline const float* maxLanes() const { return max_; }
+
+			/**
+			 * @brief Gets the center of the box.
+			 * @return The center.
+			 */
+			vec3 center() const;
+
+			/**
+			 * @brief Gets the size of the box.
+			 * @return The size, the difference between the maximum and minimum corners, or a size of zero if the box is empty.
+			 */
+			vec3 size() const;
+
+			/**
+			 * @brief Checks if the box is empty.
+			 * @return True if any component of the minimum corner is greater than the maximum corner, false otherwise.
+			 * @note A box with a size of zero along an axis is not empty, it still contains the points on its boundary.
+			 */
+			bool empty() const;
+
+			/**
+			 * @brief Calculates the surface area of the box.
+			 * @return The surface area, or 0 if the box is empty.
+			 */
+			float surfaceArea() const;
+
+			/**
+			 * @brief Calculates the volume of the box.
+			 * @return The volume, or 0 if the box is empty.
+			 */
+			float volume() const;
+
+			/**
+			 * @brief Checks if two boxes are approximately equal.
+			 * @param value1 The first box to compare.
+			 * @param value2 The second box to compare.
+			 * @return True if the corners are approximately equal, false otherwise.
+			 */
+			static bool approximately(const aabb3& value1, const aabb3& value2);
+
+			/**
+			 * @brief Checks if a point is inside a box.
+			 * @param value The box to check against.
+			 * @param point The point to check.
+			 * @return True if the point is inside the box or on its boundary, false otherwise.
+			 */
+			static bool inside(const aabb3& value, vec3 point);
+
+			/**
+			 * @brief Checks if a point is inside this box.
+			 * @param point The point to check.
+			 * @return True if the point is inside the box or on its boundary, false otherwise.
+			 */
+			bool inside(vec3 point) const;
+
+			/**
+			 * @brief Checks if one box is completely inside another.
+			 * @param value1 The containing box.
+			 * @param value2 The box to check.
+			 * @return True if value2 is inside value1, false otherwise.
+			 */
+			static bool inside(const aabb3& value1, const aabb3& value2);
+
+			/**
+			 * @brief Checks if another box is completely inside this box.
+			 * @param value The box to check.
+			 * @return True if the specified box is inside this box, false otherwise.
+			 */
+			bool inside(const aabb3& value) const;
+
+			/**
+			 * @brief Checks if two boxes intersect.
+			 * @param value1 The first box to check.
+			 * @param value2 The second box to check against.
+			 * @return True if the boxes overlap, false if they are disjoint or only touch.
+			 */
+			static bool intersects(const aabb3& value1, const aabb3& value2);
+
+			/**
+			 * @brief Checks if this box intersects with another.
+			 * @param other The box to check against.
+			 * @return True if the boxes overlap, false if they are disjoint or only touch.
+			 */
+			bool intersects(const aabb3& other) const;
+
+			/**
+			 * @brief Calculates the overlapping region of two boxes.
+			 * @param value1 The first box.
+			 * @param value2 The second box.
+			 * @return The overlapping region, which is empty if the boxes are disjoint.
+			 */
+			static aabb3 intersection(const aabb3& value1, const aabb3& value2);
+
+			/**
+			 * @brief Merges two boxes into a new box that encompasses both.
+			 * @param value1 The first box to merge.
+			 * @param value2 The second box to merge.
+			 * @return A new box that encompasses both input boxes.
+			 */
+			static aabb3 merge(const aabb3& value1, const aabb3& value2);
+
+			/**
+			 * @brief Merges another box into this box, expanding to encompass both.
+			 * @param value The box to merge with.
+			 */
+			void merge(const aabb3& value);
+
+			/**
+			 * @brief Merges a box with a point, expanding to encompass both.
+			 * @param value The box to merge.
+			 * @param point The point to merge with.
+			 * @return A new box that encompasses both the input box and point.
+			 */
+			static aabb3 merge(const aabb3& value, vec3 point);
+
+			/**
+			 * @brief Merges a point into this box, expanding to encompass both.
+			 * @param point The point to merge with.
+			 */
+			void merge(vec3 point);
+
+			/**
+			 * @brief Expands a box by the same amount in every direction.
+			 * @param value The box to expand.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the box.
+			 * @return The expanded box.
+			 */
+			static aabb3 expand(const aabb3& value, float amount);
+
+			/**
+			 * @brief Expands this box by the same amount in every direction.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the box.
+			 */
+			void expand(float amount);
+
+			/**
+			 * @brief Expands a box by a separate amount along each axis.
+			 * @param value The box to expand.
+			 * @param amount The distance the sides along each axis are moved outwards.
+			 * @return The expanded box.
+			 */
+			static aabb3 expand(const aabb3& value, vec3 amount);
+
+			/**
+			 * @brief Expands this box by a separate amount along each axis.
+			 * @param amount The distance the sides along each axis are moved outwards.
+			 */
+			void expand(vec3 amount);
+
+			/**
+			 * @brief Compares two boxes for equality.
+			 * @param other The box to compare against.
+			 * @return True if the boxes are equal, false otherwise.
+			 */
+			bool operator ==(const aabb3& other) const;
+
+			/**
+			 * @brief Compares two boxes for inequality.
+			 * @param other The box to compare against.
+			 * @return True if the boxes are not equal, false otherwise.
+			 */
+			bool operator !=(const aabb3& other) const;
+
+			/**
+			 * @brief Converts the box to a bounds.
+			 * @return The bounds with its position at the minimum corner, or a bounds of size zero at the origin if this box is empty.
+			 */
+			operator bounds() const;
+		private:
+			// the unused fourth lane is unbounded (the lowest value in min_ and the highest in max_) so it never affects a test
+			float min_[4];
+			float max_[4];
+		};
+	}
+}
\ No newline at end of file
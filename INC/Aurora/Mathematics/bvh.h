@@ -0,0 +1,183 @@
+/**
+ * @file bvh.h
+ * @brief Defines the bvh structure, a bounding volume hierarchy for finding boxes that overlap a box, contain a point, or are hit by a ray.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+		struct ray;
+		struct vec3;
+
+		/**
+		 * @brief Represents a bounding volume hierarchy over an array of axis aligned boxes, each identified by its index in the array.
+		 * @note The hierarchy is built top down with the surface area heuristic evaluated over binned centroids, large inputs are built on up to threadCount() threads, and the result does not depend on the number of threads.
+		 * Nodes are stored depth first in a flat array with both children of a node next to each other, and the boxes of each leaf are copied next to each other, so a query walks contiguous memory.
+		 * Queries use a fixed size stack instead of recursion and append to a vector supplied by the caller, which can be reused between queries to avoid allocating.
+		 */
+		struct bvh
+		{
+			/**
+			 * @brief Default constructor, initializes an empty hierarchy.
+			 */
+			bvh();
+
+			/**
+			 * @brief Constructs a hierarchy over an array of bounds.
+			 * @param primitives The bounds to build the hierarchy over.
+			 * @throws std::invalid_argument if there are more than 4294967295 primitives.
+			 */
+			bvh(std::span<const bounds> primitives);
+
+			/**
+			 * @brief Constructs a hierarchy over an array of boxes.
+			 * @param primitives The boxes to build the hierarchy over.
+			 * @throws std::invalid_argument if there are more than 4294967295 primitives.
+			 */
+			bvh(std::span<const aabb3> primitives);
+
+			/**
+			 * @brief Rebuilds the hierarchy over an array of bounds, replacing its previous contents.
+			 * @param primitives The bounds to build the hierarchy over.
+			 * @throws std::invalid_argument if there are more than 4294967295 primitives.
+			 */
+			void build(std::span<const bounds> primitives);
+
+			/**
+			 * @brief Rebuilds the hierarchy over an array of boxes, replacing its previous contents.
+			 * @param primitives The boxes to build the hierarchy over, empty boxes are kept but never found by a query.
+			 * @throws std::invalid_argument if there are more than 4294967295 primitives.
+			 */
+			void build(std::span<const aabb3> primitives);
+
+			/**
+			 * @brief Updates the hierarchy for primitives that have moved, keeping its structure.
+			 * @param primitives The new bounds of the primitives, in the same order the hierarchy was built with.
+			 * @throws std::invalid_argument if the number of primitives differs from the number the hierarchy was built with.
+			 * @note Refitting is much cheaper than building, but the quality of the hierarchy degrades as the primitives move away from where they were when it was built, so it should be rebuilt every so often.
+			 */
+			void refit(std::span<const bounds> primitives);
+
+			/**
+			 * @brief Updates the hierarchy for primitives that have moved, keeping its structure.
+			 * @param primitives The new boxes of the primitives, in the same order the hierarchy was built with.
+			 * @throws std::invalid_argument if the number of primitives differs from the number the hierarchy was built with.
+			 * @note Refitting is much cheaper than building, but the quality of the hierarchy degrades as the primitives move away from where they were when it was built, so it should be rebuilt every so often.
+			 */
+			void refit(std::span<const aabb3> primitives);
+
+			/**
+			 * @brief Gets the number of primitives in the hierarchy.
+			 * @return The number of primitives.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of nodes in the hierarchy.
+			 * @return The number of nodes, 0 if the hierarchy is empty.
+			 */
+			size_t nodeCount() const;
+
+			/**
+			 * @brief Gets the box enclosing every primitive in the hierarchy.
+			 * @return The enclosing box, which is empty if the hierarchy is empty.
+			 */
+			aabb3 box() const;
+
+			/**
+			 * @brief Finds the primitives overlapping a box.
+			 * @param value The box to check against.
+			 * @param results The vector the indices of the overlapping primitives are appended to, in no particular order.
+			 * @note As with aabb3::intersects, primitives only touching the box are not included.
+			 */
+			void overlapping(const aabb3& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the primitives containing a point.
+			 * @param point The point to check.
+			 * @param results The vector the indices of the containing primitives are appended to, in no particular order.
+			 * @note As with aabb3::inside, points on the boundary of a primitive are contained by it.
+			 */
+			void containing(vec3 point, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the primitives hit by a ray.
+			 * @param origin The origin of the ray.
+			 * @param direction The direction of the ray, which does not need to be normalized.
+			 * @param maxDistance The distance along the ray past which primitives are ignored, in multiples of the direction.
+			 * @param results The vector the indices of the primitives hit are appended to, in no particular order.
+			 * @note A primitive containing the origin is hit.
+			 */
+			void intersecting(vec3 origin, vec3 direction, float maxDistance, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the primitives hit by a ray.
+			 * @param value The ray.
+			 * @param maxDistance The distance along the ray past which primitives are ignored, in multiples of its direction.
+			 * @param results The vector the indices of the primitives hit are appended to, in no particular order.
+			 * @note A primitive containing the origin is hit.
+			 */
+			void intersecting(const ray& value, float maxDistance, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the closest primitive hit by a ray, testing the contents of the primitives with a function.
+			 * @param origin The origin of the ray.
+			 * @param direction The direction of the ray, which does not need to be normalized.
+			 * @param maxDistance The distance along the ray past which primitives are ignored, in multiples of the direction.
+			 * @param intersect The function testing the contents of a primitive whose box is hit, receiving its index and the distance of the closest hit so far, and returning the distance along the ray it is hit at, or a negative value if it is missed.
+			 * @param index The index of the closest primitive hit, unchanged if none is hit.
+			 * @param distance The distance along the ray the closest primitive is hit at, unchanged if none is hit.
+			 * @return True if a primitive is hit within the maximum distance, false otherwise.
+			 * @note Nodes are visited closest first and skipped once they are farther than the closest hit, so the function is only invoked for primitives that could be closer.
+			 */
+			bool raycast(vec3 origin, vec3 direction, float maxDistance, const std::function<float(size_t index, float distance)>& intersect, size_t& index, float& distance) const;
+
+			/**
+			 * @brief Finds the closest primitive hit by a ray, testing the contents of the primitives with a function.
+			 * @param value The ray.
+			 * @param maxDistance The distance along the ray past which primitives are ignored, in multiples of its direction.
+			 * @param intersect The function testing the contents of a primitive whose box is hit, receiving its index and the distance of the closest hit so far, and returning the distance along the ray it is hit at, or a negative value if it is missed.
+			 * @param index The index of the closest primitive hit, unchanged if none is hit.
+			 * @param distance The distance along the ray the closest primitive is hit at, unchanged if none is hit.
+			 * @return True if a primitive is hit within the maximum distance, false otherwise.
+			 * @note Nodes are visited closest first and skipped once they are farther than the closest hit, so the function is only invoked for primitives that could be closer.
+			 */
+			bool raycast(const ray& value, float maxDistance, const std::function<float(size_t index, float distance)>& intersect, size_t& index, float& distance) const;
+		private:
+			// a leaf has a count of primitives starting at index in the primitive arrays, an interior node has a count of 0 and its children at index and index + 1
+			struct node
+			{
+				float min[3];
+				uint32_t index;
+				float max[3];
+				uint32_t count;
+			};
+
+			// a primitive box in leaf order
+			struct primitive
+			{
+				float min[3];
+				float max[3];
+			};
+
+			struct builder;
+
+			void refit();
+
+			std::vector<node> nodes_;
+			std::vector<primitive> primitives_;
+			std::vector<uint32_t> indices_;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+ * @file callback.h
+ * @brief Defines the callback structure, a non-owning reference to a function used by queries to report results without allocating.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		template<typename Signature>
+		struct callback;
+
+		/**
+		 * @brief Represents a reference to a function, lambda or other callable object with a given signature.
+		 * @tparam Result The type the function returns.
+		 * @tparam Arguments The types of the arguments of the function.
+		 * @note Unlike std::function, a callback never copies the callable or allocates, it only stores its address, so it must not outlive the callable it refers to. It is meant to be taken as a parameter and invoked before the function taking it returns.
+		 */
+		template<typename Result, typename... Arguments>
+		struct callback<Result(Arguments...)>
+		{
+			/**
+			 * @brief Constructs a callback referring to a callable object.
+			 * @param function The callable object, which must outlive the callback.
+			 */
+			template<typename Function> requires (!std::is_same_v<std::remove_cvref_t<Function>, callback> && std::is_invocable_r_v<Result, Function&, Arguments...>)
+			callback(Function&& function) :
+				context_(const_cast<void*>(static_cast<const void*>(std::addressof(function)))),
+				invoke_([](void* context, Arguments... arguments) -> Result
+					{
+						return std::invoke(*static_cast<std::remove_reference_t<Function>*>(context), std::forward<Arguments>(arguments)...);
+					})
+			{
+			}
+
+			/**
+			 * @brief Invokes the function the callback refers to.
+			 * @param arguments The arguments to pass to the function.
+			 * @return The result of the function.
+			 */
+			Result operator ()(Arguments... arguments) const
+			{
+				return invoke_(context_, std::forward<Arguments>(arguments)...);
+			}
+		private:
+			void* context_;
+			Result(*invoke_)(void*, Arguments...);
+		};
+	}
+}
\ No newline at end of file
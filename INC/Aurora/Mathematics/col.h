@@ -13,6 +13,9 @@ namespace Aurora
 		struct vec4;
 		struct col32;
 		struct hsv;
+		struct xyz;
+		struct oklab;
+		struct oklch;
 
 		/**
 		 * @brief Represents a color with red, green, blue, and alpha components.
@@ -296,6 +299,7 @@ namespace Aurora
 			/**
 			 * @brief Implicit conversion operator to col32.
 			 * @return The color represented as a col32.
+			 * @note Components are truncated, use quantize from Dither.h for rounded or dithered conversions of images.
 			 */
 			operator col32() const;
 
@@ -304,6 +308,24 @@ namespace Aurora
 			 * @return The color represented as a hsv.
 			 */
 			operator hsv() const;
+
+			/**
+			 * @brief Implicit conversion operator to xyz.
+			 * @return The color represented as a xyz, treating this color as linear sRGB.
+			 */
+			operator xyz() const;
+
+			/**
+			 * @brief Implicit conversion operator to oklab.
+			 * @return The color represented as a oklab, treating this color as linear sRGB.
+			 */
+			operator oklab() const;
+
+			/**
+			 * @brief Implicit conversion operator to oklch.
+			 * @return The color represented as a oklch, treating this color as linear sRGB.
+			 */
+			operator oklch() const;
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file compressedtrack.h
+ * @brief Defines the compressedtrack structure, a track of a vec3 or a rotation whose keys are reduced to those needed to stay within a tolerance and stored quantized to 16 bits per component.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Interpolation.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct quat;
+		struct vec3;
+
+		/**
+		 * @brief Represents a track of animation compressed for storage and sampling, such as the translation or rotation of a bone in a clip of thousands of characters.
+		 * @note Compressing quantizes every key first, then starts from the first and last key and repeatedly adds the key the interpolated track misses by the most, until every key that was dropped is within the tolerance, so the error of both steps together is bounded by the tolerance or by the quantization of the keys that are kept, whichever is larger, and error() gives the largest error of the result.
+		 * A vec3 is stored as three 16 bit fractions of the range of each component over the track, and a rotation as its three smallest components in 15 bits each and the index of the largest, which is recovered as the square root of what the others leave, so a key and its time take 12 bytes, against the 56 or 72 of a segment of track.
+		 * Sampling decodes the keys around the time and interpolates them like track, so each sample costs more arithmetic than a track but reads a fraction of the memory, which keeps the clips of many characters in cache.
+		 * Sampling many tracks at once decodes and interpolates eight tracks together, one per lane of the vector registers, and compressing measures the error through the same code, so the tolerance holds for what is played.
+		 */
+		struct compressedtrack
+		{
+			/**
+			 * @brief Default constructor, initializes a track of a vec3 without keys, which samples as 0.
+			 */
+			compressedtrack();
+
+			/**
+			 * @brief Compresses a track of a vec3.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The value of each key.
+			 * @param tolerance The largest distance allowed between the compressed track and the value of any key.
+			 * @param interpolation How the value changes between the keys that are kept, Interpolation::Step, Interpolation::Linear or Interpolation::CatmullRom.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite.
+			 * @note The quantization alone moves a component by up to half of a 65535th of its range over the track, so a smaller tolerance keeps every key.
+			 */
+			compressedtrack(std::span<const float> times, std::span<const vec3> values, float tolerance, Interpolation interpolation = Interpolation::CatmullRom);
+
+			/**
+			 * @brief Compresses a track of a rotation.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The rotation of each key.
+			 * @param tolerance The largest angle allowed between the compressed track and the rotation of any key, in radians.
+			 * @param interpolation How the rotation changes between the keys that are kept, Interpolation::Step, Interpolation::Linear or Interpolation::CatmullRom, with the components interpolated and the result normalized.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite.
+			 * @note The quantization alone moves a rotation by around a ten thousandth of a radian, so a smaller tolerance keeps every key.
+			 */
+			compressedtrack(std::span<const float> times, std::span<const quat> values, float tolerance, Interpolation interpolation = Interpolation::CatmullRom);
+
+			/**
+			 * @brief Gets the number of keys kept by the compression.
+			 * @return The number of keys.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the memory taken by the keys.
+			 * @return The number of bytes of the times and quantized values of the keys.
+			 */
+			size_t bytes() const;
+
+			/**
+			 * @brief Gets the largest error of the compressed track, measured when compressing it.
+			 * @return The largest distance, or angle in radians for a rotation, between the compressed track and the value of any key of the original track.
+			 */
+			float error() const;
+
+			/**
+			 * @brief Gets the number of components of the value of the track.
+			 * @return 3 for a vec3 and 4 for a rotation.
+			 */
+			size_t components() const;
+
+			/**
+			 * @brief Gets the time of the first key.
+			 * @return The time of the first key, or 0 if the track has no keys.
+			 */
+			float start() const;
+
+			/**
+			 * @brief Gets the time of the last key.
+			 * @return The time of the last key, or 0 if the track has no keys.
+			 */
+			float end() const;
+
+			/**
+			 * @brief Samples a track of a vec3.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample of the same playing instance, or 0 at the start, updated to the segment of this sample.
+			 * @return The value at the time.
+			 * @throws std::invalid_argument if the track does not hold a vec3.
+			 */
+			vec3 sampleVec3(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples a track of a rotation.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample, updated to the segment of this sample.
+			 * @return The rotation at the time, normalized.
+			 * @throws std::invalid_argument if the track does not hold a rotation.
+			 */
+			quat sampleQuat(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples many tracks at the same time, on multiple threads.
+			 * @param tracks The tracks to sample.
+			 * @param time The time to sample at.
+			 * @param cursors The cursor of each track, updated to the segment of each sample.
+			 * @param results The destination for the values, the components of each track one after the other.
+			 * @throws std::invalid_argument if the cursors are fewer than the tracks, or if the results are fewer than the components of every track.
+			 */
+			static void sample(std::span<const compressedtrack> tracks, float time, std::span<size_t> cursors, std::span<float> results);
+
+		private:
+			void compress(std::span<const float> times, const float* values, float tolerance);
+			size_t find(float time, size_t& cursor) const;
+			void evaluate(float time, size_t& cursor, float* result) const;
+
+			template <typename Tile>
+			void gather(float time, size_t& cursor, Tile& destination, size_t lane) const;
+
+			struct key
+			{
+				float time;
+				uint16_t value[3];
+			};
+
+			std::vector<key> keys_;
+			float minimum_[3];
+			float step_[3];
+			size_t components_;
+			Interpolation interpolation_;
+			float error_;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file dualquat.h
+ * @brief Defines the dualquat structure, a unit dual quaternion representing a rotation followed by a translation, for blending rigid transforms such as the bones of a skinned mesh.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+#include "quat.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct mat4;
+		struct vec3;
+
+		/**
+		 * @brief Represents a rigid transform as a dual quaternion, a real part holding the rotation and a dual part holding the translation multiplied by half the rotation.
+		 * @note Unlike quat, the operations of this structure do not normalize their inputs, since the dual part of a unit dual quaternion does not have length 1, and blending several dual quaternions only stays rigid when the sum is normalized once at the end.
+		 * Points are rotated by the real part and then translated, as by mat4::createRotation followed by mat4::createTranslation.
+		 */
+		struct dualquat
+		{
+			/**
+			 * @brief The real part, the rotation.
+			 */
+			quat real;
+
+			/**
+			 * @brief The dual part, half the translation as a quaternion with a w of 0, multiplied by the real part.
+			 */
+			quat dual;
+
+			/**
+			 * @brief Creates a dual quaternion at identity.
+			 */
+			dualquat();
+
+			/**
+			 * @brief Creates a dual quaternion from its parts without normalizing them.
+			 * @param real The real part.
+			 * @param dual The dual part.
+			 */
+			dualquat(quat real, quat dual);
+
+			/**
+			 * @brief Creates a dual quaternion that rotates and then translates.
+			 * @param rotation The rotation, which is normalized.
+			 * @param translation The translation.
+			 */
+			dualquat(quat rotation, vec3 translation);
+
+			/**
+			 * @brief Creates a dual quaternion from the rotation and translation of a matrix.
+			 * @param value The matrix, decomposed with mat4::decompose, whose scale is dropped.
+			 */
+			explicit dualquat(const mat4& value);
+
+			/**
+			 * @brief Gets the identity dual quaternion.
+			 * @return The identity dual quaternion.
+			 */
+			static dualquat identity();
+
+			/**
+			 * @brief Gets the rotation of the dual quaternion.
+			 * @return The real part, normalized.
+			 */
+			quat rotation() const;
+
+			/**
+			 * @brief Gets the translation of the dual quaternion.
+			 * @return The translation, twice the dual part multiplied by the conjugate of the real part, divided by the squared length of the real part.
+			 */
+			vec3 translation() const;
+
+			/**
+			 * @brief Gets the matrix of the dual quaternion.
+			 * @return The matrix that rotates and then translates points transformed as row vectors.
+			 */
+			mat4 matrix() const;
+
+			/**
+			 * @brief Normalizes a dual quaternion.
+			 * @param value The dual quaternion to normalize.
+			 * @return The dual quaternion with a real part of length 1 and a dual part perpendicular to it, or the identity if the real part has length 0.
+			 */
+			static dualquat normalize(dualquat value);
+
+			/**
+			 * @brief Normalizes the dual quaternion.
+			 */
+			void normalize();
+
+			/**
+			 * @brief Inverts a unit dual quaternion.
+			 * @param value The dual quaternion to invert.
+			 * @return The dual quaternion undoing the transform, the conjugate of both parts.
+			 */
+			static dualquat invert(dualquat value);
+
+			/**
+			 * @brief Blends dual quaternions by their weights, flipping those on the other side of the first so every rotation takes the short way, and normalizing the sum.
+			 * @param values The dual quaternions to blend.
+			 * @param weights The weight of each dual quaternion, which do not need to add up to 1.
+			 * @return The blended dual quaternion, or the identity if the weights add up to 0.
+			 * @throws std::invalid_argument if the weights are fewer than the dual quaternions.
+			 */
+			static dualquat blend(std::span<const dualquat> values, std::span<const float> weights);
+
+			/**
+			 * @brief Transforms a point, rotating and then translating it.
+			 * @param value The point.
+			 * @return The transformed point.
+			 * @note The dual quaternion is expected to be normalized.
+			 */
+			vec3 transformPoint(vec3 value) const;
+
+			/**
+			 * @brief Transforms a direction, rotating it without the translation.
+			 * @param value The direction.
+			 * @return The rotated direction.
+			 * @note The dual quaternion is expected to be normalized.
+			 */
+			vec3 transformVector(vec3 value) const;
+
+			/**
+			 * @brief Composes two dual quaternions.
+			 * @param other The dual quaternion applied first.
+			 * @return The dual quaternion applying the other and then the current one, as with the product of two quaternions.
+			 */
+			dualquat operator*(const dualquat& other) const;
+
+			/**
+			 * @brief Composes the current dual quaternion with another in-place.
+			 * @param other The dual quaternion applied first.
+			 * @return Reference to the modified dual quaternion.
+			 */
+			dualquat& operator*=(const dualquat& other);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+/**
+ * @file frustum.h
+ * @brief Defines the frustum structure, representing the volume visible through a projection, as well as functions for culling boxes and spheres against it in batches.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "Containment.h"
+#include "plane.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+		struct mat4;
+
+		/**
+		 * @brief Represents a frustum by the six planes bounding it, with their normals pointing inwards.
+		 * @note The planes are stored in the order left, right, bottom, top, near and far, and are normalized, so signed distances to them are in world units.
+		 * Classifying a shape tests it against each plane on its own, so a shape outside the frustum near one of its edges or corners may be reported as intersecting it.
+		 */
+		struct frustum
+		{
+			/**
+			 * @brief The index of the left plane.
+			 */
+			static constexpr int leftPlane = 0;
+
+			/**
+			 * @brief The index of the right plane.
+			 */
+			static constexpr int rightPlane = 1;
+
+			/**
+			 * @brief The index of the bottom plane.
+			 */
+			static constexpr int bottomPlane = 2;
+
+			/**
+			 * @brief The index of the top plane.
+			 */
+			static constexpr int topPlane = 3;
+
+			/**
+			 * @brief The index of the near plane.
+			 */
+			static constexpr int nearPlane = 4;
+
+			/**
+			 * @brief The index of the far plane.
+			 */
+			static constexpr int farPlane = 5;
+
+			/**
+			 * @brief The planes bounding the frustum, with their normals pointing inwards.
+			 */
+			plane planes[6];
+
+			/**
+			 * @brief Default constructor, initializes the frustum of the identity matrix, the cube from -1 to 1 on every axis.
+			 */
+			frustum();
+
+			/**
+			 * @brief Constructs the frustum of a view projection matrix.
+			 * @param viewProjection The matrix transforming points from world space to clip space.
+			 * @note Points are transformed as row vectors, so the matrix is the view matrix multiplied by the projection matrix, as created by mat4::createPerspective and mat4::createOrthographic, with a clip space depth from -1 to 1.
+			 */
+			frustum(const mat4& viewProjection);
+
+			/**
+			 * @brief Constructs a frustum from its six planes.
+			 * @param planes The planes in the order left, right, bottom, top, near and far, with their normals pointing inwards.
+			 * @note The planes are normalized.
+			 */
+			frustum(std::span<const plane, 6> planes);
+
+			/**
+			 * @brief Checks if two frustums are approximately equal within a small tolerance.
+			 * @param value1 The first frustum for comparison.
+			 * @param value2 The second frustum for comparison.
+			 * @return True if all planes are approximately equal, false otherwise.
+			 */
+			static bool approximately(const frustum& value1, const frustum& value2);
+
+			/**
+			 * @brief Checks if the frustum contains a point.
+			 * @param point The point to check.
+			 * @return True if the point is inside the frustum or on its boundary, false otherwise.
+			 */
+			bool contains(vec3 point) const;
+
+			/**
+			 * @brief Classifies a box against the frustum.
+			 * @param value The box to classify.
+			 * @return The containment of the box, outside for an empty box.
+			 */
+			Containment classify(const aabb3& value) const;
+
+			/**
+			 * @brief Classifies a bounds against the frustum.
+			 * @param value The bounds to classify.
+			 * @return The containment of the bounds.
+			 */
+			Containment classify(bounds value) const;
+
+			/**
+			 * @brief Classifies a sphere against the frustum.
+			 * @param center The center of the sphere.
+			 * @param radius The radius of the sphere.
+			 * @return The containment of the sphere.
+			 */
+			Containment classify(vec3 center, float radius) const;
+
+			/**
+			 * @brief Equality comparison operator for frustums.
+			 * @param other The frustum to compare.
+			 * @return True if all planes are equal, false otherwise.
+			 */
+			bool operator ==(const frustum& other) const;
+
+			/**
+			 * @brief Inequality comparison operator for frustums.
+			 * @param other The frustum to compare.
+			 * @return True if any plane is not equal, false otherwise.
+			 */
+			bool operator !=(const frustum& other) const;
+		};
+
+		/**
+		 * @brief Classifies a span of boxes against a frustum.
+		 * @param value The frustum.
+		 * @param boxes The boxes to classify.
+		 * @param results The containment of each box.
+		 * @throws std::invalid_argument if the results are fewer than the boxes.
+		 * @note The boxes are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions, and a packet stops being tested once all of its boxes are outside a plane.
+		 */
+		void classify(const frustum& value, std::span<const aabb3> boxes, std::span<Containment> results);
+
+		/**
+		 * @brief Classifies a span of boxes against a frustum, starting with the plane the boxes were last found outside of.
+		 * @param value The frustum.
+		 * @param boxes The boxes to classify.
+		 * @param results The containment of each box.
+		 * @param hints The plane each box was last found outside of, updated whenever a box is found outside another plane. Start with zeros and keep the hints from frame to frame, values above 5 are treated as 0.
+		 * @throws std::invalid_argument if the results or the hints are fewer than the boxes.
+		 * @note Objects rarely move far between frames, so a box culled by a plane is usually culled by the same plane in the next frame. Each packet of 8 boxes starts with the plane its first box was last found outside of, so a packet of neighbouring boxes that stays culled takes a single plane test.
+		 */
+		void classify(const frustum& value, std::span<const aabb3> boxes, std::span<Containment> results, std::span<uint8_t> hints);
+
+		/**
+		 * @brief Classifies a span of bounds against a frustum.
+		 * @param value The frustum.
+		 * @param boxes The bounds to classify.
+		 * @param results The containment of each bounds.
+		 * @throws std::invalid_argument if the results are fewer than the bounds.
+		 * @note The bounds are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions, and a packet stops being tested once all of its bounds are outside a plane.
+		 */
+		void classify(const frustum& value, std::span<const bounds> boxes, std::span<Containment> results);
+
+		/**
+		 * @brief Classifies a span of bounds against a frustum, starting with the plane the bounds were last found outside of.
+		 * @param value The frustum.
+		 * @param boxes The bounds to classify.
+		 * @param results The containment of each bounds.
+		 * @param hints The plane each bounds was last found outside of, updated whenever a bounds is found outside another plane. Start with zeros and keep the hints from frame to frame, values above 5 are treated as 0.
+		 * @throws std::invalid_argument if the results or the hints are fewer than the bounds.
+		 */
+		void classify(const frustum& value, std::span<const bounds> boxes, std::span<Containment> results, std::span<uint8_t> hints);
+
+		/**
+		 * @brief Classifies a span of spheres against a frustum.
+		 * @param value The frustum.
+		 * @param centers The centers of the spheres.
+		 * @param radii The radii of the spheres.
+		 * @param results The containment of each sphere.
+		 * @throws std::invalid_argument if the radii or the results are fewer than the centers.
+		 * @note The spheres are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions, and a packet stops being tested once all of its spheres are outside a plane.
+		 */
+		void classify(const frustum& value, std::span<const vec3> centers, std::span<const float> radii, std::span<Containment> results);
+
+		/**
+		 * @brief Classifies a span of spheres against a frustum, starting with the plane the spheres were last found outside of.
+		 * @param value The frustum.
+		 * @param centers The centers of the spheres.
+		 * @param radii The radii of the spheres.
+		 * @param results The containment of each sphere.
+		 * @param hints The plane each sphere was last found outside of, updated whenever a sphere is found outside another plane. Start with zeros and keep the hints from frame to frame, values above 5 are treated as 0.
+		 * @throws std::invalid_argument if the radii, the results or the hints are fewer than the centers.
+		 */
+		void classify(const frustum& value, std::span<const vec3> centers, std::span<const float> radii, std::span<Containment> results, std::span<uint8_t> hints);
+	}
+}
\ No newline at end of file
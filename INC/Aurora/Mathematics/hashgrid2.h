@@ -0,0 +1,193 @@
+/**
+ * @file hashgrid2.h
+ * @brief Defines the hashgrid2 structure, a uniform grid of square cells stored in a hash table, for finding the 2D points or rectangles near a point or a rectangle.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "callback.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb2;
+		struct rect;
+		struct ivec2;
+		struct vec2;
+
+		/**
+		 * @brief Represents an unbounded uniform grid over the plane, in which only the cells holding points or rectangles take up memory, each point or rectangle identified by its index in the array the grid was built from.
+		 * @note The grid is rebuilt from a whole array at once, typically every frame, by counting the points and rectangles falling in each cell and sorting them by cell on multiple threads, so the contents of each cell end up next to each other in memory.
+		 * The occupied cells are found through an open addressing hash table keyed by their integer coordinates, whose slots hold the range of each cell directly, so a lookup touches one or two cache lines.
+		 * A rectangle is stored in every cell it overlaps and reported once per query. Rectangles should be about the size of a cell or smaller, a rectangle spanning many cells costs as much as that many points.
+		 * The grid suits particles, sprites and other content of similar sizes, for content with very different sizes an rtree or a quadtree is a better fit.
+		 */
+		struct hashgrid2
+		{
+			/**
+			 * @brief Default constructor, initializes an empty grid with cells of size 1.
+			 */
+			hashgrid2();
+
+			/**
+			 * @brief Constructs an empty grid.
+			 * @param cellSize The size of the cells along both axes, which works best at about the query radius or the size of the largest rectangle.
+			 * @throws std::invalid_argument if the cell size is not positive and finite.
+			 */
+			hashgrid2(float cellSize);
+
+			/**
+			 * @brief Rebuilds the grid over an array of points, replacing its previous contents.
+			 * @param points The points to store.
+			 * @throws std::invalid_argument if there are more than 4294967295 points.
+			 */
+			void build(std::span<const vec2> points);
+
+			/**
+			 * @brief Rebuilds the grid over an array of rectangles, replacing its previous contents.
+			 * @param rectangles The rectangles to store.
+			 * @throws std::invalid_argument if the rectangles cover more than 4294967295 cells in total.
+			 */
+			void build(std::span<const rect> rectangles);
+
+			/**
+			 * @brief Rebuilds the grid over an array of rectangles, replacing its previous contents.
+			 * @param rectangles The rectangles to store, empty rectangles are kept but never found by a query.
+			 * @throws std::invalid_argument if the rectangles cover more than 4294967295 cells in total.
+			 */
+			void build(std::span<const aabb2> rectangles);
+
+			/**
+			 * @brief Removes every point or rectangle, keeping the cell size and the allocated memory.
+			 */
+			void clear();
+
+			/**
+			 * @brief Gets the size of the cells.
+			 * @return The size of the cells along both axes.
+			 */
+			float cellSize() const;
+
+			/**
+			 * @brief Gets the number of points or rectangles in the grid.
+			 * @return The number of points or rectangles the grid was built from.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of cells holding at least one point or rectangle.
+			 * @return The number of occupied cells.
+			 */
+			size_t cellCount() const;
+
+			/**
+			 * @brief Gets the cell containing a point.
+			 * @param point The point.
+			 * @return The integer coordinates of the cell, which is the point divided by the cell size and rounded down.
+			 */
+			ivec2 cell(vec2 point) const;
+
+			/**
+			 * @brief Finds the points or rectangles in a cell and the 8 cells around it.
+			 * @param cell The coordinates of the center cell.
+			 * @param results The vector the indices of the points or rectangles are appended to, grouped by cell.
+			 */
+			void neighbors(ivec2 cell, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or rectangles in a cell and the 8 cells around it, reporting each to a callback.
+			 * @param cell The coordinates of the center cell.
+			 * @param visit The function receiving the index of each point or rectangle, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 */
+			bool neighbors(ivec2 cell, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the points or rectangles within a distance of a point.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param results The vector the indices of the points or rectangles are appended to, grouped by cell.
+			 * @note Points and rectangles exactly at the distance are included. With a radius of at most half the cell size, this searches at most 4 cells.
+			 */
+			void within(vec2 point, float radius, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or rectangles within a distance of a point, reporting each to a callback.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param visit The function receiving the index of each point or rectangle, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note Points and rectangles exactly at the distance are included. With a radius of at most half the cell size, this searches at most 4 cells.
+			 */
+			bool within(vec2 point, float radius, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the points or rectangles overlapping a rectangle.
+			 * @param value The rectangle to check against.
+			 * @param results The vector the indices of the points or rectangles are appended to, grouped by cell.
+			 * @note As with aabb2::intersects, rectangles only touching the rectangle are not included, and neither are points on its edges.
+			 */
+			void overlapping(const aabb2& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or rectangles overlapping a rectangle, reporting each to a callback.
+			 * @param value The rectangle to check against.
+			 * @param visit The function receiving the index of each point or rectangle, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with aabb2::intersects, rectangles only touching the rectangle are not included, and neither are points on its edges.
+			 */
+			bool overlapping(const aabb2& value, callback<bool(size_t index)> visit) const;
+		private:
+			// a point or a rectangle as stored in one of the cells it overlaps
+			struct item
+			{
+				float min[2];
+				float max[2];
+				uint32_t index;
+			};
+
+			// a slot of the table, holding the coordinates of an occupied cell and the range of its items, or an empty range if the slot is free
+			struct slot
+			{
+				int cell[2];
+				uint32_t begin;
+				uint32_t end;
+			};
+
+			// a cell overlapped by a point or a rectangle while building, sorted by the high bits of the hash of the cell
+			struct record
+			{
+				uint32_t key;
+				uint32_t index;
+				int cell[2];
+			};
+
+			float cellSize_;
+			float inverse_;
+			size_t size_;
+			size_t cellCount_;
+			// whether any rectangle overlaps more than one cell, which is when queries have to skip repeated rectangles
+			bool spanning_;
+			std::vector<item> items_;
+			std::vector<slot> slots_;
+			// the memory used while building, kept so that rebuilding every frame does not allocate once the grid has grown
+			std::vector<uint64_t> offsets_;
+			std::vector<record> records_;
+			std::vector<record> sorted_;
+			std::vector<uint32_t> histograms_;
+
+			const slot* find(int x, int y) const;
+
+			template<typename Corners>
+			void build(size_t count, Corners& corners);
+
+			template<typename Accept>
+			bool search(const int* low, const int* high, Accept& accept, callback<bool(size_t index)> visit) const;
+		};
+	}
+}
\ No newline at end of file
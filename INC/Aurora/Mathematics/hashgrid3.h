@@ -0,0 +1,193 @@
+/**
+ * @file hashgrid3.h
+ * @brief Defines the hashgrid3 structure, a uniform grid of cubic cells stored in a hash table, for finding the points or boxes near a point or a box.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "callback.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+		struct ivec3;
+		struct vec3;
+
+		/**
+		 * @brief Represents an unbounded uniform grid over 3D space, in which only the cells holding points or boxes take up memory, each point or box identified by its index in the array the grid was built from.
+		 * @note The grid is rebuilt from a whole array at once, typically every frame, by counting the points and boxes falling in each cell and sorting them by cell on multiple threads, so the contents of each cell end up next to each other in memory.
+		 * The occupied cells are found through an open addressing hash table keyed by their integer coordinates, whose slots hold the range of each cell directly, so a lookup touches one or two cache lines.
+		 * A box is stored in every cell it overlaps and reported once per query. Boxes should be about the size of a cell or smaller, a box spanning many cells costs as much as that many points.
+		 * The grid suits particles and other content of similar sizes, for content with very different sizes a bvh or an octree is a better fit.
+		 */
+		struct hashgrid3
+		{
+			/**
+			 * @brief Default constructor, initializes an empty grid with cells of size 1.
+			 */
+			hashgrid3();
+
+			/**
+			 * @brief Constructs an empty grid.
+			 * @param cellSize The size of the cells along every axis, which works best at about the query radius or the size of the largest box.
+			 * @throws std::invalid_argument if the cell size is not positive and finite.
+			 */
+			hashgrid3(float cellSize);
+
+			/**
+			 * @brief Rebuilds the grid over an array of points, replacing its previous contents.
+			 * @param points The points to store.
+			 * @throws std::invalid_argument if there are more than 4294967295 points.
+			 */
+			void build(std::span<const vec3> points);
+
+			/**
+			 * @brief Rebuilds the grid over an array of boxes, replacing its previous contents.
+			 * @param boxes The bounds of the boxes to store.
+			 * @throws std::invalid_argument if the boxes cover more than 4294967295 cells in total.
+			 */
+			void build(std::span<const bounds> boxes);
+
+			/**
+			 * @brief Rebuilds the grid over an array of boxes, replacing its previous contents.
+			 * @param boxes The boxes to store, empty boxes are kept but never found by a query.
+			 * @throws std::invalid_argument if the boxes cover more than 4294967295 cells in total.
+			 */
+			void build(std::span<const aabb3> boxes);
+
+			/**
+			 * @brief Removes every point or box, keeping the cell size and the allocated memory.
+			 */
+			void clear();
+
+			/**
+			 * @brief Gets the size of the cells.
+			 * @return The size of the cells along every axis.
+			 */
+			float cellSize() const;
+
+			/**
+			 * @brief Gets the number of points or boxes in the grid.
+			 * @return The number of points or boxes the grid was built from.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of cells holding at least one point or box.
+			 * @return The number of occupied cells.
+			 */
+			size_t cellCount() const;
+
+			/**
+			 * @brief Gets the cell containing a point.
+			 * @param point The point.
+			 * @return The integer coordinates of the cell, which is the point divided by the cell size and rounded down.
+			 */
+			ivec3 cell(vec3 point) const;
+
+			/**
+			 * @brief Finds the points or boxes in a cell and the 26 cells around it.
+			 * @param cell The coordinates of the center cell.
+			 * @param results The vector the indices of the points or boxes are appended to, grouped by cell.
+			 */
+			void neighbors(ivec3 cell, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or boxes in a cell and the 26 cells around it, reporting each to a callback.
+			 * @param cell The coordinates of the center cell.
+			 * @param visit The function receiving the index of each point or box, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 */
+			bool neighbors(ivec3 cell, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the points or boxes within a distance of a point.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param results The vector the indices of the points or boxes are appended to, grouped by cell.
+			 * @note Points and boxes exactly at the distance are included. With a radius of at most half the cell size, this searches at most 8 cells.
+			 */
+			void within(vec3 point, float radius, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or boxes within a distance of a point, reporting each to a callback.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param visit The function receiving the index of each point or box, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note Points and boxes exactly at the distance are included. With a radius of at most half the cell size, this searches at most 8 cells.
+			 */
+			bool within(vec3 point, float radius, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the points or boxes overlapping a box.
+			 * @param value The box to check against.
+			 * @param results The vector the indices of the points or boxes are appended to, grouped by cell.
+			 * @note As with aabb3::intersects, boxes only touching the box are not included, and neither are points on its faces.
+			 */
+			void overlapping(const aabb3& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points or boxes overlapping a box, reporting each to a callback.
+			 * @param value The box to check against.
+			 * @param visit The function receiving the index of each point or box, grouped by cell, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with aabb3::intersects, boxes only touching the box are not included, and neither are points on its faces.
+			 */
+			bool overlapping(const aabb3& value, callback<bool(size_t index)> visit) const;
+		private:
+			// a point or a box as stored in one of the cells it overlaps
+			struct item
+			{
+				float min[3];
+				float max[3];
+				uint32_t index;
+			};
+
+			// a slot of the table, holding the coordinates of an occupied cell and the range of its items, or an empty range if the slot is free
+			struct slot
+			{
+				int cell[3];
+				uint32_t begin;
+				uint32_t end;
+			};
+
+			// a cell overlapped by a point or a box while building, sorted by the high bits of the hash of the cell
+			struct record
+			{
+				uint32_t key;
+				uint32_t index;
+				int cell[3];
+			};
+
+			float cellSize_;
+			float inverse_;
+			size_t size_;
+			size_t cellCount_;
+			// whether any box overlaps more than one cell, which is when queries have to skip repeated boxes
+			bool spanning_;
+			std::vector<item> items_;
+			std::vector<slot> slots_;
+			// the memory used while building, kept so that rebuilding every frame does not allocate once the grid has grown
+			std::vector<uint64_t> offsets_;
+			std::vector<record> records_;
+			std::vector<record> sorted_;
+			std::vector<uint32_t> histograms_;
+
+			const slot* find(int x, int y, int z) const;
+
+			template<typename Corners>
+			void build(size_t count, Corners& corners);
+
+			template<typename Accept>
+			bool search(const int* low, const int* high, Accept& accept, callback<bool(size_t index)> visit) const;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * @file hierarchy.h
+ * @brief Defines the hierarchy structure, a tree of transforms whose world matrices are recomputed from their local translation, rotation and scale only where they changed.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "quat.h"
+#include "vec3.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct mat4;
+
+		/**
+		 * @brief Represents a tree of transforms, such as the nodes of a scene or the bones of a skeleton, each identified by the id returned when inserting it and placed relative to its parent by a translation, a rotation and a scale.
+		 * @note The world matrix of a node is its local matrix, which scales, then rotates, then translates, followed by the world matrix of its parent, with points transformed as row vectors so the translation is in the last row as with mat4::createTranslation.
+		 * The translations, rotations and scales are kept in one array each, and the nodes are ordered breadth first so the parent of every node comes before it and the nodes of a depth are next to each other, which is restored by the update following a change to the structure of the tree.
+		 * Changing a node marks it as dirty, and an update walks the nodes in order, recomputing the world matrix of every node that is dirty or whose parent was recomputed, so a frame where few nodes move costs little more than one pass over the flags.
+		 * World matrices are stored as four rows of four floats, so each row of a product is a few packed multiplies and adds, and the nodes of a depth are split across multiple threads once there are enough of them, since every parent was finished at the depth before.
+		 */
+		struct hierarchy
+		{
+			/**
+			 * @brief Default constructor, initializes an empty hierarchy.
+			 */
+			hierarchy();
+
+			/**
+			 * @brief Inserts a root node at the origin, without rotation and with a scale of 1.
+			 * @return The id of the node, which stays valid until the node is removed.
+			 * @throws std::invalid_argument if there are already 4294967295 nodes.
+			 */
+			size_t insert();
+
+			/**
+			 * @brief Inserts a root node.
+			 * @param translation The translation of the node.
+			 * @param rotation The rotation of the node.
+			 * @param scale The scale of the node.
+			 * @return The id of the node, which stays valid until the node is removed.
+			 * @throws std::invalid_argument if there are already 4294967295 nodes.
+			 */
+			size_t insert(vec3 translation, quat rotation, vec3 scale);
+
+			/**
+			 * @brief Inserts a node at the origin of its parent, without rotation and with a scale of 1.
+			 * @param parent The id of the parent.
+			 * @return The id of the node, which stays valid until the node is removed.
+			 * @throws std::invalid_argument if no node has the id of the parent, or if there are already 4294967295 nodes.
+			 */
+			size_t insert(size_t parent);
+
+			/**
+			 * @brief Inserts a node.
+			 * @param parent The id of the parent.
+			 * @param translation The translation of the node relative to its parent.
+			 * @param rotation The rotation of the node relative to its parent.
+			 * @param scale The scale of the node relative to its parent.
+			 * @return The id of the node, which stays valid until the node is removed.
+			 * @throws std::invalid_argument if no node has the id of the parent, or if there are already 4294967295 nodes.
+			 */
+			size_t insert(size_t parent, vec3 translation, quat rotation, vec3 scale);
+
+			/**
+			 * @brief Removes a node along with all of its descendants.
+			 * @param id The id of the node.
+			 * @throws std::invalid_argument if no node has the id.
+			 * @note Takes time in proportion to the number of nodes removed, the gaps they leave are compacted by the next update.
+			 */
+			void remove(size_t id);
+
+			/**
+			 * @brief Moves a node and its descendants under another parent, keeping its local transform.
+			 * @param id The id of the node.
+			 * @param parent The id of the new parent.
+			 * @throws std::invalid_argument if no node has either id, or if the new parent is the node itself or one of its descendants.
+			 */
+			void attach(size_t id, size_t parent);
+
+			/**
+			 * @brief Makes a node a root node, keeping its local transform.
+			 * @param id The id of the node.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			void detach(size_t id);
+
+			/**
+			 * @brief Removes every node, keeping the allocated memory.
+			 */
+			void clear();
+
+			/**
+			 * @brief Checks if a node has an id.
+			 * @param id The id to check.
+			 * @return True if the id belongs to a node in the hierarchy, false otherwise.
+			 */
+			bool contains(size_t id) const;
+
+			/**
+			 * @brief Gets the parent of a node.
+			 * @param id The id of the node.
+			 * @return The id of the parent, or the id of the node itself if it is a root node.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			size_t parent(size_t id) const;
+
+			/**
+			 * @brief Gets the number of nodes in the hierarchy.
+			 * @return The number of nodes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the translation of a node.
+			 * @param id The id of the node.
+			 * @return The translation of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			vec3 translation(size_t id) const;
+
+			/**
+			 * @brief Sets the translation of a node, which takes effect on the next update.
+			 * @param id The id of the node.
+			 * @param value The translation of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			void translation(size_t id, vec3 value);
+
+			/**
+			 * @brief Gets the rotation of a node.
+			 * @param id The id of the node.
+			 * @return The rotation of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			quat rotation(size_t id) const;
+
+			/**
+			 * @brief Sets the rotation of a node, which takes effect on the next update.
+			 * @param id The id of the node.
+			 * @param value The rotation of the node relative to its parent, which does not need to be normalized.
+			 * @throws std::invalid_argument if no node has the id.
+			 * @note A rotation of length 0 is treated as no rotation.
+			 */
+			void rotation(size_t id, quat value);
+
+			/**
+			 * @brief Gets the scale of a node.
+			 * @param id The id of the node.
+			 * @return The scale of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			vec3 scale(size_t id) const;
+
+			/**
+			 * @brief Sets the scale of a node, which takes effect on the next update.
+			 * @param id The id of the node.
+			 * @param value The scale of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			void scale(size_t id, vec3 value);
+
+			/**
+			 * @brief Sets the translation, rotation and scale of a node at once, which takes effect on the next update.
+			 * @param id The id of the node.
+			 * @param translation The translation of the node relative to its parent.
+			 * @param rotation The rotation of the node relative to its parent, which does not need to be normalized.
+			 * @param scale The scale of the node relative to its parent.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			void local(size_t id, vec3 translation, quat rotation, vec3 scale);
+
+			/**
+			 * @brief Recomputes the world matrices of the nodes that changed since the last update and of their descendants.
+			 * @return The number of world matrices recomputed.
+			 */
+			size_t update();
+
+			/**
+			 * @brief Gets the world matrix of a node.
+			 * @param id The id of the node.
+			 * @return The world matrix of the node as of the last update, or the identity matrix if the node was inserted since.
+			 * @throws std::invalid_argument if no node has the id.
+			 */
+			mat4 world(size_t id) const;
+
+			/**
+			 * @brief Copies the world matrices of a span of nodes, without creating a mat4 for each.
+			 * @param ids The ids of the nodes.
+			 * @param matrices The destination for the world matrices as of the last update, 16 floats for each node in row major order.
+			 * @throws std::invalid_argument if no node has one of the ids, or if the matrices are fewer than 16 times the number of ids.
+			 */
+			void world(std::span<const size_t> ids, std::span<float> matrices) const;
+		private:
+			// a world matrix, as four rows of four floats aligned so each row loads as one packed value
+			struct alignas(16) frame
+			{
+				float rows[4][4];
+			};
+
+			// the position of each node in the arrays below by id, or none for a free id
+			std::vector<uint32_t> slots_;
+			std::vector<uint32_t> freeIds_;
+			// the arrays below are indexed by position, which is breadth first order once the structure is up to date, and may have gaps left by removed nodes until then
+			std::vector<uint32_t> ids_;
+			std::vector<uint32_t> parents_;
+			// the children of each position as a list through their siblings, to find the descendants of a node without a pass over every node
+			std::vector<uint32_t> firstChildren_;
+			std::vector<uint32_t> nextSiblings_;
+			std::vector<uint32_t> previousSiblings_;
+			std::vector<vec3> translations_;
+			std::vector<quat> rotations_;
+			std::vector<vec3> scales_;
+			std::vector<frame> worlds_;
+			std::vector<uint8_t> dirty_;
+			// the position of the first node at each depth followed by the number of positions, valid once the structure is up to date
+			std::vector<size_t> depths_;
+			size_t size_;
+			bool ordered_;
+			// the memory used to find the breadth first order and the descendants of a removed node, kept between calls
+			std::vector<uint32_t> order_;
+			std::vector<uint32_t> offsets_;
+			std::vector<uint32_t> children_;
+
+			uint32_t find(size_t id) const;
+			size_t add(uint32_t parent, vec3 translation, quat rotation, vec3 scale);
+			void link(uint32_t position);
+			void unlink(uint32_t position);
+			void reorder();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * @file iaabb2.h
+ * @brief Defines the iaabb2 structure, representing an axis aligned 2D integer rectangle stored as its minimum and maximum corners.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb2;
+		struct irect;
+		struct ivec2;
+		struct vec2;
+
+		/**
+		 * @brief Represents an axis aligned 2D integer rectangle by its minimum and maximum corners.
+		 * @note Unlike irect, which stores a position and size, the corners are stored directly in 16 bytes, so overlap, containment and merge tests are a handful of vectorizable minimum, maximum and comparison operations.
+		 * A default constructed iaabb2 is empty, containing nothing, and becomes valid once a point or rectangle is merged into it.
+		 * Since the type is over-aligned, it is passed by reference, which 32-bit x86 requires of over-aligned parameters.
+		 */
+		struct alignas(16) iaabb2
+		{
+			/**
+			 * @brief Default constructor, initializes an empty rectangle.
+			 */
+			iaabb2();
+
+			/**
+			 * @brief Constructs a rectangle from its corners.
+			 * @param min The minimum corner.
+			 * @param max The maximum corner.
+			 * @note The corners are stored as given, if any component of min is greater than max the rectangle is empty.
+			 */
+			iaabb2(ivec2 min, ivec2 max);
+
+			/**
+			 * @brief Constructs a rectangle covering the same area as a irect.
+			 * @param value The irect to convert, a negative size extends it from its position in the negative direction.
+			 */
+			iaabb2(irect value);
+
+			/**
+			 * @brief Gets the minimum corner of the rectangle.
+			 * @return The minimum corner.
+			 */
+			ivec2 min() const;
+
+			/**
+			 * @brief Sets the minimum corner of the rectangle.
+			 * @param value The new minimum corner.
+			 */
+			void min(ivec2 value);
+
+			/**
+			 * @brief Gets the maximum corner of the rectangle.
+			 * @return The maximum corner.
+			 */
+			ivec2 max() const;
+
+			/**
+			 * @brief Sets the maximum corner of the rectangle.
+			 * @param value The new maximum corner.
+			 */
+			void max(ivec2 value);
+
+			/**
+			 * @brief Gets the center of the rectangle.
+			 * @return The center.
+			 */
+			vec2 center() const;
+
+			/**
+			 * @brief Gets the size of the rectangle.
+			 * @return The size, the difference between the maximum and minimum corners, or a size of zero if the rectangle is empty.
+			 */
+			ivec2 size() const;
+
+			/**
+			 * @brief Checks if the rectangle is empty.
+			 * @return True if any component of the minimum corner is greater than the maximum corner, false otherwise.
+			 * @note A rectangle with a size of zero along an axis is not empty, it still contains the points on its boundary.
+			 */
+			bool empty() const;
+
+			/**
+			 * @brief Calculates the area of the rectangle.
+			 * @return The area, or 0 if the rectangle is empty.
+			 */
+			int area() const;
+
+			/**
+			 * @brief Calculates the perimeter of the rectangle.
+			 * @return The perimeter, or 0 if the rectangle is empty.
+			 */
+			int perimeter() const;
+
+			/**
+			 * @brief Checks if a point is inside a rectangle.
+			 * @param value The rectangle to check against.
+			 * @param point The point to check.
+			 * @return True if the point is inside the rectangle or on its boundary, false otherwise.
+			 */
+			static bool inside(const iaabb2& value, ivec2 point);
+
+			/**
+			 * @brief Checks if a point is inside this rectangle.
+			 * @param point The point to check.
+			 * @return True if the point is inside the rectangle or on its boundary, false otherwise.
+			 */
+			bool inside(ivec2 point) const;
+
+			/**
+			 * @brief Checks if one rectangle is completely inside another.
+			 * @param value1 The containing rectangle.
+			 * @param value2 The rectangle to check.
+			 * @return True if value2 is inside value1, false otherwise.
+			 */
+			static bool inside(const iaabb2& value1, const iaabb2& value2);
+
+			/**
+			 * @brief Checks if another rectangle is completely inside this rectangle.
+			 * @param value The rectangle to check.
+			 * @return True if the specified rectangle is inside this rectangle, false otherwise.
+			 */
+			bool inside(const iaabb2& value) const;
+
+			/**
+			 * @brief Checks if two rectangles intersect.
+			 * @param value1 The first rectangle to check.
+			 * @param value2 The second rectangle to check against.
+			 * @return True if the rectangles overlap, false if they are disjoint or only touch.
+			 */
+			static bool intersects(const iaabb2& value1, const iaabb2& value2);
+
+			/**
+			 * @brief Checks if this rectangle intersects with another.
+			 * @param other The rectangle to check against.
+			 * @return True if the rectangles overlap, false if they are disjoint or only touch.
+			 */
+			bool intersects(const iaabb2& other) const;
+
+			/**
+			 * @brief Calculates the overlapping region of two rectangles.
+			 * @param value1 The first rectangle.
+			 * @param value2 The second rectangle.
+			 * @return The overlapping region, which is empty if the rectangles are disjoint.
+			 */
+			static iaabb2 intersection(const iaabb2& value1, const iaabb2& value2);
+
+			/**
+			 * @brief Merges two rectangles into a new rectangle that encompasses both.
+			 * @param value1 The first rectangle to merge.
+			 * @param value2 The second rectangle to merge.
+			 * @return A new rectangle that encompasses both input rectangles.
+			 */
+			static iaabb2 merge(const iaabb2& value1, const iaabb2& value2);
+
+			/**
+			 * @brief Merges another rectangle into this rectangle, expanding to encompass both.
+			 * @param value The rectangle to merge with.
+			 */
+			void merge(const iaabb2& value);
+
+			/**
+			 * @brief Merges a rectangle with a point, expanding to encompass both.
+			 * @param value The rectangle to merge.
+			 * @param point The point to merge with.
+			 * @return A new rectangle that encompasses both the input rectangle and point.
+			 */
+			static iaabb2 merge(const iaabb2& value, ivec2 point);
+
+			/**
+			 * @brief Merges a point into this rectangle, expanding to encompass both.
+			 * @param point The point to merge with.
+			 */
+			void merge(ivec2 point);
+
+			/**
+			 * @brief Expands a rectangle by the same amount in every direction.
+			 * @param value The rectangle to expand.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the rectangle, an empty rectangle is left unchanged.
+			 * @return The expanded rectangle.
+			 */
+			static iaabb2 expand(const iaabb2& value, int amount);
+
+			/**
+			 * @brief Expands this rectangle by the same amount in every direction.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the rectangle, an empty rectangle is left unchanged.
+			 */
+			void expand(int amount);
+
+			/**
+			 * @brief Expands a rectangle by a separate amount along each axis.
+			 * @param value The rectangle to expand.
+			 * @param amount The distance the sides along each axis are moved outwards, an empty rectangle is left unchanged.
+			 * @return The expanded rectangle.
+			 */
+			static iaabb2 expand(const iaabb2& value, ivec2 amount);
+
+			/**
+			 * @brief Expands this rectangle by a separate amount along each axis.
+			 * @param amount The distance the sides along each axis are moved outwards, an empty rectangle is left unchanged.
+			 */
+			void expand(ivec2 amount);
+
+			/**
+			 * @brief Compares two rectangles for equality.
+			 * @param other The rectangle to compare against.
+			 * @return True if the rectangles are equal, false otherwise.
+			 */
+			bool operator ==(const iaabb2& other) const;
+
+			/**
+			 * @brief Compares two rectangles for inequality.
+			 * @param other The rectangle to compare against.
+			 * @return True if the rectangles are not equal, false otherwise.
+			 */
+			bool operator !=(const iaabb2& other) const;
+
+			/**
+			 * @brief Converts the rectangle to a irect.
+			 * @return The irect with its position at the minimum corner, or a irect of size zero at the origin if this rectangle is empty.
+			 */
+			operator irect() const;
+
+			/**
+			 * @brief Converts the rectangle to a floating point rectangle.
+			 * @return The floating point rectangle.
+			 */
+			operator aabb2() const;
+		private:
+			int min_[2];
+			int max_[2];
+		};
+	}
+}
\ No newline at end of file
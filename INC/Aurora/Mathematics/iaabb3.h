@@ -0,0 +1,239 @@
+/**
+ * @file iaabb3.h
+ * @brief Defines the iaabb3 structure, representing an axis aligned 3D integer box stored as its minimum and maximum corners.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct ibounds;
+		struct ivec3;
+		struct vec3;
+
+		/**
+		 * @brief Represents an axis aligned 3D integer box by its minimum and maximum corners.
+		 * @note Unlike ibounds, which stores a position and size, the corners are stored directly and padded to 32 bytes, so overlap, containment and merge tests are a handful of vectorizable minimum, maximum and comparison operations.
+		 * A default constructed iaabb3 is empty, containing nothing, and becomes valid once a point or box is merged into it.
+		 * Since the type is over-aligned, it is passed by reference, which 32-bit x86 requires of over-aligned parameters.
+		 */
+		struct alignas(32) iaabb3
+		{
+			/**
+			 * @brief Default constructor, initializes an empty box.
+			 */
+			iaabb3();
+
+			/**
+			 * @brief Constructs a box from its corners.
+			 * @param min The minimum corner.
+			 * @param max The maximum corner.
+			 * @note The corners are stored as given, if any component of min is greater than max the box is empty.
+			 */
+			iaabb3(ivec3 min, ivec3 max);
+
+			/**
+			 * @brief Constructs a box covering the same volume as a ibounds.
+			 * @param value The ibounds to convert, a negative size extends it from its position in the negative direction.
+			 */
+			iaabb3(ibounds value);
+
+			/**
+			 * @brief Gets the minimum corner of the box.
+			 * @return The minimum corner.
+			 */
+			ivec3 min() const;
+
+			/**
+			 * @brief Sets the minimum corner of the box.
+			 * @param value The new minimum corner.
+			 */
+			void min(ivec3 value);
+
+			/**
+			 * @brief Gets the maximum corner of the box.
+			 * @return The maximum corner.
+			 */
+			ivec3 max() const;
+
+			/**
+			 * @brief Sets the maximum corner of the box.
+			 * @param value The new maximum corner.
+			 */
+			void max(ivec3 value);
+
+			/**
+			 * @brief Gets the center of the box.
+			 * @return The center.
+			 */
+			vec3 center() const;
+
+			/**
+			 * @brief Gets the size of the box.
+			 * @return The size, the difference between the maximum and minimum corners, or a size of zero if the box is empty.
+			 */
+			ivec3 size() const;
+
+			/**
+			 * @brief Checks if the box is empty.
+			 * @return True if any component of the minimum corner is greater than the maximum corner, false otherwise.
+			 * @note A box with a size of zero along an axis is not empty, it still contains the points on its boundary.
+			 */
+			bool empty() const;
+
+			/**
+			 * @brief Calculates the surface area of the box.
+			 * @return The surface area, or 0 if the box is empty.
+			 */
+			int surfaceArea() const;
+
+			/**
+			 * @brief Calculates the volume of the box.
+			 * @return The volume, or 0 if the box is empty.
+			 */
+			int volume() const;
+
+			/**
+			 * @brief Checks if a point is inside a box.
+			 * @param value The box to check against.
+			 * @param point The point to check.
+			 * @return True if the point is inside the box or on its boundary, false otherwise.
+			 */
+			static bool inside(const iaabb3& value, ivec3 point);
+
+			/**
+			 * @brief Checks if a point is inside this box.
+			 * @param point The point to check.
+			 * @return True if the point is inside the box or on its boundary, false otherwise.
+			 */
+			bool inside(ivec3 point) const;
+
+			/**
+			 * @brief Checks if one box is completely inside another.
+			 * @param value1 The containing box.
+			 * @param value2 The box to check.
+			 * @return True if value2 is inside value1, false otherwise.
+			 */
+			static bool inside(const iaabb3& value1, const iaabb3& value2);
+
+			/**
+			 * @brief Checks if another box is completely inside this box.
+			 * @param value The box to check.
+			 * @return True if the specified box is inside this box, false otherwise.
+			 */
+			bool inside(const iaabb3& value) const;
+
+			/**
+			 * @brief Checks if two boxes intersect.
+			 * @param value1 The first box to check.
+			 * @param value2 The second box to check against.
+			 * @return True if the boxes overlap, false if they are disjoint or only touch.
+			 */
+			static bool intersects(const iaabb3& value1, const iaabb3& value2);
+
+			/**
+			 * @brief Checks if this box intersects with another.
+			 * @param other The box to check against.
+			 * @return True if the boxes overlap, false if they are disjoint or only touch.
+			 */
+			bool intersects(const iaabb3& other) const;
+
+			/**
+			 * @brief Calculates the overlapping region of two boxes.
+			 * @param value1 The first box.
+			 * @param value2 The second box.
+			 * @return The overlapping region, which is empty if the boxes are disjoint.
+			 */
+			static iaabb3 intersection(const iaabb3& value1, const iaabb3& value2);
+
+			/**
+			 * @brief Merges two boxes into a new box that encompasses both.
+			 * @param value1 The first box to merge.
+			 * @param value2 The second box to merge.
+			 * @return A new box that encompasses both input boxes.
+			 */
+			static iaabb3 merge(const iaabb3& value1, const iaabb3& value2);
+
+			/**
+			 * @brief Merges another box into this box, expanding to encompass both.
+			 * @param value The box to merge with.
+			 */
+			void merge(const iaabb3& value);
+
+			/**
+			 * @brief Merges a box with a point, expanding to encompass both.
+			 * @param value The box to merge.
+			 * @param point The point to merge with.
+			 * @return A new box that encompasses both the input box and point.
+			 */
+			static iaabb3 merge(const iaabb3& value, ivec3 point);
+
+			/**
+			 * @brief Merges a point into this box, expanding to encompass both.
+			 * @param point The point to merge with.
+			 */
+			void merge(ivec3 point);
+
+			/**
+			 * @brief Expands a box by the same amount in every direction.
+			 * @param value The box to expand.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the box, an empty box is left unchanged.
+			 * @return The expanded box.
+			 */
+			static iaabb3 expand(const iaabb3& value, int amount);
+
+			/**
+			 * @brief Expands this box by the same amount in every direction.
+			 * @param amount The distance each side is moved outwards, a negative amount shrinks the box, an empty box is left unchanged.
+			 */
+			void expand(int amount);
+
+			/**
+			 * @brief Expands a box by a separate amount along each axis.
+			 * @param value The box to expand.
+			 * @param amount The distance the sides along each axis are moved outwards, an empty box is left unchanged.
+			 * @return The expanded box.
+			 */
+			static iaabb3 expand(const iaabb3& value, ivec3 amount);
+
+			/**
+			 * @brief Expands this box by a separate amount along each axis.
+			 * @param amount The distance the sides along each axis are moved outwards, an empty box is left unchanged.
+			 */
+			void expand(ivec3 amount);
+
+			/**
+			 * @brief Compares two boxes for equality.
+			 * @param other The box to compare against.
+			 * @return True if the boxes are equal, false otherwise.
+			 */
+			bool operator ==(const iaabb3& other) const;
+
+			/**
+			 * @brief Compares two boxes for inequality.
+			 * @param other The box to compare against.
+			 * @return True if the boxes are not equal, false otherwise.
+			 */
+			bool operator !=(const iaabb3& other) const;
+
+			/**
+			 * @brief Converts the box to a ibounds.
+			 * @return The ibounds with its position at the minimum corner, or a ibounds of size zero at the origin if this box is empty.
+			 */
+			operator ibounds() const;
+
+			/**
+			 * @brief Converts the box to a floating point box.
+			 * @return The floating point box.
+			 */
+			operator aabb3() const;
+		private:
+			// the unused fourth lane is unbounded (the lowest value in min_ and the highest in max_) so it never affects a test
+			int min_[4];
+			int max_[4];
+		};
+	}
+}
\ No newline at end of file
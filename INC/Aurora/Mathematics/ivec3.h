@@ -5,6 +5,10 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
 namespace Aurora
 {
     namespace Mathematics
@@ -1027,6 +1031,43 @@ namespace Aurora
              */
             static ivec3 floorToInt(vec3 value);
 
+            /**
+             * @brief Decodes a 32-bit Morton code, the inverse of morton32.
+             * @param code The Morton code.
+             * @return The vector whose components are the interleaved bits of the code, each between 0 and 1023.
+             */
+            static ivec3 fromMorton32(uint32_t code);
+
+            /**
+             * @brief Decodes a 64-bit Morton code, the inverse of morton64.
+             * @param code The Morton code.
+             * @return The vector whose components are the interleaved bits of the code, each between 0 and 2097151.
+             */
+            static ivec3 fromMorton64(uint64_t code);
+
+            /**
+             * @brief Hashes a vector, mixing every bit of each component into every bit of the result.
+             * @param value The vector to hash.
+             * @return The hash of the vector.
+             * @note Neighbouring vectors have unrelated hashes, so both the low and the high bits of the result can index a table with a power of two size.
+             */
+            static size_t hash(ivec3 value);
+
+            /**
+             * @brief Calculates the distance along a Hilbert curve through a grid of 1024 by 1024 by 1024 cells.
+             * @param value The cell, whose components are taken as unsigned integers and cut to their lowest 10 bits.
+             * @return The index of the cell along the curve.
+             * @note Unlike a Morton curve, consecutive cells along a Hilbert curve are always neighbours, which keeps cells that are close together on the curve closer together in space.
+             */
+            static uint32_t hilbert32(ivec3 value);
+
+            /**
+             * @brief Calculates the distance along a Hilbert curve through a grid of 2097152 by 2097152 by 2097152 cells.
+             * @param value The cell, whose components are taken as unsigned integers and cut to their lowest 21 bits.
+             * @return The index of the cell along the curve.
+             */
+            static uint64_t hilbert64(ivec3 value);
+
             /**
              * @brief Returns the maximum components of two vectors.
              * @param value1 The first vector.
@@ -1043,6 +1084,21 @@ namespace Aurora
              */
             static ivec3 min(ivec3 value1, ivec3 value2);
 
+            /**
+             * @brief Calculates the 32-bit Morton code of a vector, which interleaves the bits of its components.
+             * @param value The vector, whose components are taken as unsigned integers and cut to their lowest 10 bits.
+             * @return The Morton code, with the lowest bit of x in its lowest bit.
+             * @note Sorting by Morton code orders cells along a Z-order curve, so cells close together in space are mostly close together in the order. Negative components should be offset first, for instance by the minimum of an ibounds around the cells.
+             */
+            static uint32_t morton32(ivec3 value);
+
+            /**
+             * @brief Calculates the 64-bit Morton code of a vector, which interleaves the bits of its components.
+             * @param value The vector, whose components are taken as unsigned integers and cut to their lowest 21 bits.
+             * @return The Morton code, with the lowest bit of x in its lowest bit.
+             */
+            static uint64_t morton64(ivec3 value);
+
             /**
              * @brief Rounds each component of the vector to the nearest integer.
              * @param value The input vector.
@@ -1295,4 +1351,16 @@ namespace Aurora
             operator vec4() const;
         };
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Hashes ivec3 values with ivec3::hash, so they can be used as keys in the standard unordered containers.
+ */
+template<>
+struct std::hash<Aurora::Mathematics::ivec3>
+{
+    size_t operator ()(Aurora::Mathematics::ivec3 value) const noexcept
+    {
+        return Aurora::Mathematics::ivec3::hash(value);
+    }
+};
\ No newline at end of file
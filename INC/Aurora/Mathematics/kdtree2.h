@@ -0,0 +1,148 @@
+/**
+ * @file kdtree2.h
+ * @brief Defines the kdtree2 structure, a k-d tree over static 2D points for finding the points closest to a point or within a distance of it.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "callback.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct vec2;
+
+		/**
+		 * @brief Represents a k-d tree over an array of 2D points, each identified by its index in the array.
+		 * @note The tree is built by splitting the points at the median along the widest axis of their cell until at most 8 points are left, and the subtrees below the first few levels are built on multiple threads.
+		 * The nodes are stored in one flat array and the points in the order of the leaves in another, so the points of a leaf are next to each other in memory along with their indices.
+		 * The tree cannot change once built, points that move belong in a hashgrid2 rebuilt every frame instead.
+		 * Queries use a fixed size stack instead of recursion, search the closer child of a node first, and skip the cells farther away than the points already found. The batch queries split the points to search around across multiple threads.
+		 */
+		struct kdtree2
+		{
+			/**
+			 * @brief Default constructor, initializes an empty tree.
+			 */
+			kdtree2();
+
+			/**
+			 * @brief Constructs a tree over an array of points.
+			 * @param points The points to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 points.
+			 */
+			kdtree2(std::span<const vec2> points);
+
+			/**
+			 * @brief Rebuilds the tree over an array of points, replacing its previous contents.
+			 * @param points The points to build the tree over, points with NaN components are kept but never found by a query.
+			 * @throws std::invalid_argument if there are more than 4294967295 points.
+			 */
+			void build(std::span<const vec2> points);
+
+			/**
+			 * @brief Gets the number of points in the tree.
+			 * @return The number of points.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of nodes in the tree, including the leaves.
+			 * @return The number of nodes, 0 if the tree is empty.
+			 */
+			size_t nodeCount() const;
+
+			/**
+			 * @brief Finds the point closest to a point.
+			 * @param point The point to search from.
+			 * @param index The index of the closest point, unchanged if none is found.
+			 * @param distance The distance to the closest point, unchanged if none is found.
+			 * @param maxDistance The distance past which points are ignored.
+			 * @param epsilon How much farther than the closest point the point found may be, as a fraction of the distance to the closest point, where 0 finds the closest point and larger values skip more of the tree.
+			 * @return True if a point is found within the maximum distance, false otherwise.
+			 */
+			bool nearest(vec2 point, size_t& index, float& distance, float maxDistance = std::numeric_limits<float>::infinity(), float epsilon = 0.0f) const;
+
+			/**
+			 * @brief Finds the points closest to a point.
+			 * @param point The point to search from.
+			 * @param indices The indices of the closest points, closest first, where the number of indices is the number of points to find.
+			 * @param distances The distances to the closest points, in the same order.
+			 * @param maxDistance The distance past which points are ignored.
+			 * @param epsilon How much farther than the actual closest points the points found may be, as a fraction of their distance, where 0 finds the closest points.
+			 * @return The number of points found, which is less than the number of indices if there are fewer points within the maximum distance. The indices and distances past the points found are unchanged.
+			 * @throws std::invalid_argument if the distances are fewer than the indices.
+			 */
+			size_t nearest(vec2 point, std::span<size_t> indices, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity(), float epsilon = 0.0f) const;
+
+			/**
+			 * @brief Finds the points closest to each of a span of points, on multiple threads.
+			 * @param points The points to search from.
+			 * @param count The number of closest points to find for each point.
+			 * @param indices The indices of the closest points, count for each point to search from, closest first, or the maximum value of size_t past the points found.
+			 * @param distances The distances to the closest points, in the same order, or -1 past the points found.
+			 * @param maxDistance The distance past which points are ignored.
+			 * @param epsilon How much farther than the actual closest points the points found may be, as a fraction of their distance, where 0 finds the closest points.
+			 * @throws std::invalid_argument if the indices or the distances are fewer than count times the number of points.
+			 */
+			void nearest(std::span<const vec2> points, size_t count, std::span<size_t> indices, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity(), float epsilon = 0.0f) const;
+
+			/**
+			 * @brief Finds the points within a distance of a point.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param results The vector the indices of the points are appended to, in no particular order.
+			 * @note Points exactly at the distance are included.
+			 */
+			void within(vec2 point, float radius, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the points within a distance of a point, reporting each to a callback.
+			 * @param point The point to search around.
+			 * @param radius The distance to search within.
+			 * @param visit The function receiving the index of each point, in no particular order, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note Points exactly at the distance are included.
+			 */
+			bool within(vec2 point, float radius, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the points within a distance of each of a span of points, on multiple threads.
+			 * @param points The points to search around.
+			 * @param radius The distance to search within.
+			 * @param offsets The position in the results of the indices found for each point, followed by the size of the results, so the indices found for point i are those from offsets[i] up to offsets[i + 1].
+			 * @param results The vector the indices of the points found are appended to, grouped by the point they were found around.
+			 * @throws std::invalid_argument if the offsets are fewer than the number of points plus 1.
+			 * @note Points exactly at the distance are included.
+			 */
+			void within(std::span<const vec2> points, float radius, std::span<size_t> offsets, std::vector<size_t>& results) const;
+		private:
+			// a point in the order of the leaves, with its index in the array the tree was built from
+			struct point
+			{
+				float position[2];
+				uint32_t index;
+			};
+
+			// a node splitting its cell at a position along an axis into the two children given by first and second, or a leaf holding the points from first up to second
+			struct node
+			{
+				float split;
+				uint32_t axis;
+				uint32_t first;
+				uint32_t second;
+			};
+
+			std::vector<point> points_;
+			std::vector<node> nodes_;
+
+			uint32_t subdivide(std::vector<node>& nodes, size_t begin, size_t end, const float* lower, const float* upper, size_t limit, std::vector<uint32_t>& deferred);
+		};
+	}
+}
\ No newline at end of file
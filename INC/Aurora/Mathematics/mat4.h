@@ -6,7 +6,9 @@
 #pragma once
 
 #include "matrix.h"
+#include <cstddef>
 #include <map>
+#include <span>
 
 namespace Aurora
 {
@@ -171,10 +173,31 @@ namespace Aurora
              * @param translation The translation vector.
              * @param rotation The rotation vector in degrees.
              * @param scaling The scaling vector.
-             * @return The transformation matrix.
+             * @return The transformation matrix, which scales, then rotates, then translates points transformed as row vectors.
              */
             static mat4 createTransform(const vec3& translation, const vec3& rotation, const vec3& scaling);
 
+            /**
+             * @brief Decomposes a transformation matrix into the translation, rotation, and scale it scales, rotates, and translates by, the reverse of createTransform.
+             * @param value The matrix to decompose.
+             * @param translation The translation, the last row of the matrix.
+             * @param rotation The rotation, found from the normalized rows of the upper 3x3 part of the matrix.
+             * @param scale The scale, the lengths of the rows of the upper 3x3 part of the matrix, with the x component negated if the matrix mirrors.
+             * @return True if the matrix is a scale, a rotation, and a translation, false if it shears, projects, or scales an axis to 0, in which case the rotation is that of the rows made perpendicular, or the identity if an axis is scaled to 0.
+             */
+            static bool decompose(const mat4& value, vec3& translation, quat& rotation, vec3& scale);
+
+            /**
+             * @brief Decomposes a span of transformation matrices into translations, rotations, and scales on multiple threads, as decompose does for one matrix.
+             * @param matrices The matrices to decompose, 16 floats each in row major order, as written by hierarchy::world, where any floats past the last whole matrix are ignored.
+             * @param translations The destination for the translations.
+             * @param rotations The destination for the rotations.
+             * @param scales The destination for the scales.
+             * @return The number of matrices that shear, project, or scale an axis to 0.
+             * @throws std::invalid_argument if the translations, rotations, or scales are fewer than the matrices.
+             */
+            static size_t decompose(std::span<const float> matrices, std::span<vec3> translations, std::span<quat> rotations, std::span<vec3> scales);
+
             /**
              * Creates a perspective projection matrix.
              *
@@ -183,6 +206,7 @@ namespace Aurora
              * @param nearClip Distance to the near clipping plane.
              * @param farClip Distance to the far clipping plane.
              * @return A perspective projection matrix.
+             * @note Like the other transformation matrices, the matrix transforms points as row vectors, and maps depth to -1 at the near plane and 1 at the far plane.
              */
             static mat4 createPerspective(float fov, const ivec2& viewport, float nearClip, float farClip);
 
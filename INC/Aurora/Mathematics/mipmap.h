@@ -0,0 +1,49 @@
+/**
+ * @file mipmap.h
+ * @brief Contains functions for generating chains of mipmaps from col32 images.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col32;
+
+		/**
+		 * @brief Calculates the number of levels in the mipmap chain of an image, including the image itself.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @return The number of levels, each level is half the size of the level above it (rounded down, but never less than 1) until a level of 1x1 is reached.
+		 * @throws std::invalid_argument if the dimensions are not positive.
+		 */
+		int mipmapLevels(int width, int height);
+
+		/**
+		 * @brief Calculates the number of pixels in every level of the mipmap chain of an image, excluding the image itself.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @return The number of pixels required to hold the generated levels.
+		 * @throws std::invalid_argument if the dimensions are not positive.
+		 */
+		size_t mipmapChainSize(int width, int height);
+
+		/**
+		 * @brief Generates every level of the mipmap chain of an image below the image itself.
+		 * @param source The pixels of the image, row by row.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The pixels of the generated levels, row by row, starting with the largest level and with each level directly following the one above it.
+		 * @param srgb True if the color components are sRGB encoded, in which case they are averaged in linear space and encoded again, false if they are already linear.
+		 * @throws std::invalid_argument if the dimensions are not positive, or the source or destination is too small.
+		 * @note Each pixel is averaged from the 2x2 block of pixels above it, or from a 3 pixel span with polyphase weights along any odd dimension so that no source pixel is skipped.
+		 * Color components are weighted by alpha, so fully transparent pixels do not bleed into their neighbours, while the alpha component is averaged linearly.
+		 * Each level is reduced from the full precision of the level above it rather than its 8-bit encoding, and the chain is generated in one pass split across threadCount() threads, where each row of a smaller level is reduced as soon as the rows it reads are, without waiting for the rest of the level above it.
+		 */
+		void generateMipmaps(std::span<const col32> source, int width, int height, std::span<col32> destination, bool srgb = true);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+/**
+ * @file octree.h
+ * @brief Defines the octree structure, a loose octree for indexing boxes that are inserted, moved and removed one at a time.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+		struct frustum;
+		struct vec3;
+
+		/**
+		 * @brief Represents a loose octree over a cubic region of space, storing boxes that are each identified by the id returned when inserting them.
+		 * @note Every node reaches half its size past each of its faces, so a box fits in the node containing its center at the depth where the nodes are at least as large as the box, which is found from the size of the box without descending the tree.
+		 * Moving a box that still fits its node only updates the box, and otherwise moves it to another node without touching the rest of the tree.
+		 * Nodes are allocated from a pool and returned to it once they and their children hold no boxes, so moving boxes around settles into reusing the same nodes.
+		 * Boxes whose center lies outside the region are kept in the root, which is always searched, so they are still found by queries at the cost of being tested by every query.
+		 */
+		struct octree
+		{
+			/**
+			 * @brief Default constructor, initializes an empty octree over the cube from -1 to 1 on every axis.
+			 */
+			octree();
+
+			/**
+			 * @brief Constructs an empty octree over a region of space.
+			 * @param region The region to index, which is extended to the smallest cube around its center containing it.
+			 * @param maxDepth The depth of the smallest nodes, where the root is at a depth of 0.
+			 * @throws std::invalid_argument if the maximum depth is negative or greater than 20.
+			 */
+			octree(bounds region, int maxDepth = 8);
+
+			/**
+			 * @brief Constructs an empty octree over a region of space.
+			 * @param region The region to index, which is extended to the smallest cube around its center containing it.
+			 * @param maxDepth The depth of the smallest nodes, where the root is at a depth of 0.
+			 * @throws std::invalid_argument if the region is empty, or the maximum depth is negative or greater than 20.
+			 */
+			octree(const aabb3& region, int maxDepth = 8);
+
+			/**
+			 * @brief Inserts a box.
+			 * @param value The bounds of the box.
+			 * @return The id of the box, which stays valid until the box is removed and may then be reused.
+			 */
+			size_t insert(bounds value);
+
+			/**
+			 * @brief Inserts a box.
+			 * @param value The box, an empty box is kept but never found by a query.
+			 * @return The id of the box, which stays valid until the box is removed and may then be reused.
+			 */
+			size_t insert(const aabb3& value);
+
+			/**
+			 * @brief Moves a box.
+			 * @param id The id of the box.
+			 * @param value The new bounds of the box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void move(size_t id, bounds value);
+
+			/**
+			 * @brief Moves a box.
+			 * @param id The id of the box.
+			 * @param value The new box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void move(size_t id, const aabb3& value);
+
+			/**
+			 * @brief Removes a box.
+			 * @param id The id of the box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void remove(size_t id);
+
+			/**
+			 * @brief Removes every box, keeping the region and the allocated memory.
+			 */
+			void clear();
+
+			/**
+			 * @brief Checks if a box has an id.
+			 * @param id The id to check.
+			 * @return True if the id belongs to a box in the octree, false otherwise.
+			 */
+			bool contains(size_t id) const;
+
+			/**
+			 * @brief Gets a box.
+			 * @param id The id of the box.
+			 * @return The box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			aabb3 box(size_t id) const;
+
+			/**
+			 * @brief Gets the region indexed by the octree.
+			 * @return The cube covered by the root, not including how far it reaches past its faces.
+			 */
+			aabb3 region() const;
+
+			/**
+			 * @brief Gets the number of boxes in the octree.
+			 * @return The number of boxes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of nodes in use.
+			 * @return The number of nodes, including the root.
+			 */
+			size_t nodeCount() const;
+
+			/**
+			 * @brief Finds the boxes overlapping a box.
+			 * @param value The box to check against.
+			 * @param results The vector the ids of the overlapping boxes are appended to, in no particular order.
+			 * @note As with aabb3::intersects, boxes only touching the box are not included.
+			 */
+			void overlapping(const aabb3& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the boxes inside or intersecting a frustum.
+			 * @param value The frustum to check against.
+			 * @param results The vector the ids of the visible boxes are appended to, in no particular order.
+			 * @note Nodes entirely inside the frustum add their boxes without testing them, and the planes a node is entirely inside of are not tested for its children. As with frustum::classify, a box outside the frustum near one of its edges may be included.
+			 */
+			void overlapping(const frustum& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the box closest to a point.
+			 * @param point The point to search from.
+			 * @param id The id of the closest box, unchanged if no box is found.
+			 * @param distance The distance from the point to the closest box, 0 if the box contains the point, unchanged if no box is found.
+			 * @param maxDistance The distance past which boxes are ignored.
+			 * @return True if a box is found within the maximum distance, false otherwise.
+			 */
+			bool nearest(vec3 point, size_t& id, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+		private:
+			struct item
+			{
+				float min[3];
+				float max[3];
+				uint32_t id;
+			};
+
+			struct node
+			{
+				float center[3];
+				float half;
+				int depth;
+				uint32_t parent;
+				uint32_t children[8];
+				uint32_t childCount;
+				std::vector<item> items;
+			};
+
+			struct entry
+			{
+				uint32_t node;
+				uint32_t slot;
+			};
+
+			float center_[3];
+			float half_;
+			int maxDepth_;
+			size_t size_;
+			std::vector<node> nodes_;
+			std::vector<uint32_t> freeNodes_;
+			std::vector<entry> entries_;
+			std::vector<uint32_t> freeEntries_;
+
+			bool fits(uint32_t index, const float* min, const float* max) const;
+			uint32_t place(const float* min, const float* max);
+			uint32_t allocate(uint32_t parent, int octant);
+			void release(uint32_t index);
+			void attach(uint32_t id, uint32_t index, const float* min, const float* max);
+			void detach(entry current);
+			const entry& find(size_t id) const;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file oklab.h
+ * @brief Defines the oklab structure, representing a color in the Oklab perceptual color space.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct oklch;
+
+		/**
+		 * @brief Represents a color in the Oklab perceptual color space, in which euclidean distances approximate perceived color differences.
+		 * @note Conversions to and from col treat the col as linear sRGB (Rec. 709 primaries).
+		 * Since the 'a' component is the green-red axis of the color space, the alpha component is named 'alpha' on this type.
+		 */
+		struct oklab
+		{
+			/**
+			 * @brief Perceived lightness of the color, where 0 is black and 1 is the white of linear sRGB.
+			 */
+			float l;
+
+			/**
+			 * @brief Green (negative) to red (positive) component of the color.
+			 */
+			float a;
+
+			/**
+			 * @brief Blue (negative) to yellow (positive) component of the color.
+			 */
+			float b;
+
+			/**
+			 * @brief Alpha component of the color.
+			 */
+			float alpha;
+
+			/**
+			 * @brief Default constructor, initializes all color components to zero, and the alpha component to 1.
+			 */
+			oklab();
+
+			/**
+			 * @brief Constructor with specified color components.
+			 * @param l Lightness component.
+			 * @param a Green-red component.
+			 * @param b Blue-yellow component.
+			 * @param alpha Alpha component (default is 1.0).
+			 */
+			oklab(float l, float a, float b, float alpha = 1.0f);
+
+			/**
+			 * @brief Checks if two colors are approximately equal within a small tolerance.
+			 * @param value1 The first color for comparison.
+			 * @param value2 The second color for comparison.
+			 * @return True if colors are approximately equal, false otherwise.
+			 */
+			static bool approximately(oklab value1, oklab value2);
+
+			/**
+			 * @brief Calculates the perceptual difference between two colors (the euclidean distance between them, ignoring alpha).
+			 * @param value1 The first color.
+			 * @param value2 The second color.
+			 * @return The perceptual difference, where a difference of roughly 0.02 is just noticeable.
+			 */
+			static float difference(oklab value1, oklab value2);
+
+			/**
+			 * @brief Linearly interpolates between two colors, producing a perceptually uniform gradient.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @return The interpolated color.
+			 */
+			static oklab lerp(oklab value1, oklab value2, float amount);
+
+			/**
+			 * @brief Linearly interpolates between two colors without clamping the interpolation parameter.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @return The unclamped interpolated color.
+			 */
+			static oklab lerpUnclamped(oklab value1, oklab value2, float amount);
+
+			/**
+			 * @brief Equality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are equal, false otherwise.
+			 */
+			bool operator ==(oklab other) const;
+
+			/**
+			 * @brief Inequality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are not equal, false otherwise.
+			 */
+			bool operator !=(oklab other) const;
+
+			/**
+			 * @brief Implicit conversion operator to col.
+			 * @return The color represented as a linear sRGB col, components outside the sRGB gamut are left unclamped.
+			 */
+			operator col() const;
+
+			/**
+			 * @brief Implicit conversion operator to oklch.
+			 * @return The color represented in polar form.
+			 */
+			operator oklch() const;
+		};
+
+		/**
+		 * @brief Converts a span of linear sRGB colors to Oklab.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const col> source, std::span<oklab> destination);
+
+		/**
+		 * @brief Converts a span of Oklab colors to linear sRGB.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const oklab> source, std::span<col> destination);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @file oklch.h
+ * @brief Defines the oklch structure, representing a color in the polar form of the Oklab perceptual color space.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+#include "LerpDirection.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct oklab;
+
+		/**
+		 * @brief Represents a color in the Oklch color space, the polar form of Oklab with lightness, chroma, and hue.
+		 * @note Conversions to and from col treat the col as linear sRGB (Rec. 709 primaries).
+		 * For consistency with oklab, the alpha component is named 'alpha' on this type.
+		 */
+		struct oklch
+		{
+			/**
+			 * @brief Perceived lightness of the color, where 0 is black and 1 is the white of linear sRGB.
+			 */
+			float l;
+
+			/**
+			 * @brief Chroma component of the color, the distance from the neutral axis.
+			 */
+			float c;
+
+			/**
+			 * @brief Hue component of the color in degrees.
+			 */
+			float h;
+
+			/**
+			 * @brief Alpha component of the color.
+			 */
+			float alpha;
+
+			/**
+			 * @brief Default constructor, initializes all color components to zero, and the alpha component to 1.
+			 */
+			oklch();
+
+			/**
+			 * @brief Constructor with specified color components.
+			 * @param l Lightness component.
+			 * @param c Chroma component.
+			 * @param h Hue component in degrees.
+			 * @param alpha Alpha component (default is 1.0).
+			 */
+			oklch(float l, float c, float h, float alpha = 1.0f);
+
+			/**
+			 * @brief Checks if two colors are approximately equal within a small tolerance.
+			 * @param value1 The first color for comparison.
+			 * @param value2 The second color for comparison.
+			 * @return True if colors are approximately equal, false otherwise.
+			 */
+			static bool approximately(oklch value1, oklch value2);
+
+			/**
+			 * @brief Linearly interpolates between two colors.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @param direction The direction of hue interpolation.
+			 * @return The interpolated color.
+			 */
+			static oklch lerp(oklch value1, oklch value2, float amount, LerpDirection direction = LerpDirection::Direct);
+
+			/**
+			 * @brief Linearly interpolates between two colors without clamping the interpolation parameter.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @param direction The direction of hue interpolation.
+			 * @return The unclamped interpolated color.
+			 */
+			static oklch lerpUnclamped(oklch value1, oklch value2, float amount, LerpDirection direction = LerpDirection::Direct);
+
+			/**
+			 * @brief Equality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are equal, false otherwise.
+			 */
+			bool operator ==(oklch other) const;
+
+			/**
+			 * @brief Inequality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are not equal, false otherwise.
+			 */
+			bool operator !=(oklch other) const;
+
+			/**
+			 * @brief Implicit conversion operator to col.
+			 * @return The color represented as a linear sRGB col, components outside the sRGB gamut are left unclamped.
+			 */
+			operator col() const;
+
+			/**
+			 * @brief Implicit conversion operator to oklab.
+			 * @return The color represented in rectangular form.
+			 */
+			operator oklab() const;
+		};
+
+		/**
+		 * @brief Converts a span of linear sRGB colors to Oklch.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const col> source, std::span<oklch> destination);
+
+		/**
+		 * @brief Converts a span of Oklch colors to linear sRGB.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const oklch> source, std::span<col> destination);
+	}
+}
\ No newline at end of file
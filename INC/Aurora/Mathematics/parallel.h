@@ -0,0 +1,39 @@
+/**
+ * @file parallel.h
+ * @brief Contains the worker thread configuration and the parallel loop used by the batch functions of this library.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Gets the maximum number of threads used by the batch functions of this library.
+		 * @return The maximum number of threads, always at least 1.
+		 * @note Defaults to the number of hardware threads reported by the platform.
+		 */
+		unsigned int threadCount();
+
+		/**
+		 * @brief Sets the maximum number of threads used by the batch functions of this library.
+		 * @param value The maximum number of threads.
+		 * @note If the value is 0, the number of hardware threads reported by the platform is used, a value of 1 runs every batch function on the calling thread.
+		 */
+		void threadCount(unsigned int value);
+
+		/**
+		 * @brief Invokes a function over the range [0, count) split into blocks, distributing the blocks across up to threadCount() threads.
+		 * @param count The number of items in the range.
+		 * @param grain The number of items in each block, every invocation receives at most this many items.
+		 * @param body The function to invoke, receiving the first item of the block and one past the last item of the block.
+		 * @note The calling thread participates in the work, and the function does not return until every block has been processed.
+		 * If an invocation throws, the remaining blocks are abandoned and the first exception is rethrown on the calling thread.
+		 */
+		void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+	}
+}
\ No newline at end of file
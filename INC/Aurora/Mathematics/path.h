@@ -0,0 +1,142 @@
+/**
+ * @file path.h
+ * @brief Defines the path structure, contours of lines and quadratic and cubic Bézier curves in 2D, flattened to polylines and tessellated into triangles to stroke or fill them.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "FillRule.h"
+#include "LineCap.h"
+#include "LineJoin.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct vec2;
+
+		/**
+		 * @brief Represents a path of vector graphics, such as an SVG path or the outline of a glyph, made of contours of lines and curves.
+		 * @note Flattening turns each quadratic curve into as few lines as keep it within the tolerance by mapping it onto a parabola, where the number of lines and the position of each has a closed form from the integral of the curvature, so the lines are spread evenly by how much the curve turns rather than by its parameter.
+		 * A cubic curve is first split into quadratic curves, as many as keep each within a tenth of the tolerance, which the parabola then flattens.
+		 * Stroking covers each line with a quad, each corner with its join and each end of an open contour with its cap, as overlapping triangles, and filling cuts the contours into horizontal bands at every vertex and every crossing of two lines and covers the spans of each band inside the path with a trapezoid.
+		 * The triangles are written three vertices at a time into a buffer the caller provides, and every function returns how many vertices the whole result holds and writes only those that fit, so a buffer kept from earlier calls is reused and a result that did not fit can be written again into a buffer of the size returned.
+		 */
+		struct path
+		{
+			/**
+			 * @brief Default constructor, initializes an empty path.
+			 */
+			path();
+
+			/**
+			 * @brief Starts a new contour at a point.
+			 * @param point The first point of the contour.
+			 */
+			void moveTo(vec2 point);
+
+			/**
+			 * @brief Adds a line from the current point to a point, starting a contour at the current point if there is none.
+			 * @param point The end of the line.
+			 */
+			void lineTo(vec2 point);
+
+			/**
+			 * @brief Adds a quadratic Bézier curve from the current point to a point, starting a contour at the current point if there is none.
+			 * @param control The control point of the curve.
+			 * @param point The end of the curve.
+			 */
+			void quadraticTo(vec2 control, vec2 point);
+
+			/**
+			 * @brief Adds a cubic Bézier curve from the current point to a point, starting a contour at the current point if there is none.
+			 * @param control1 The control point near the start of the curve.
+			 * @param control2 The control point near the end of the curve.
+			 * @param point The end of the curve.
+			 */
+			void cubicTo(vec2 control1, vec2 control2, vec2 point);
+
+			/**
+			 * @brief Closes the current contour with a line back to its first point, and makes that point the current point.
+			 */
+			void close();
+
+			/**
+			 * @brief Removes every contour.
+			 */
+			void clear();
+
+			/**
+			 * @brief Checks if the path has no contours.
+			 * @return True if the path is empty, false otherwise.
+			 */
+			bool empty() const;
+
+			/**
+			 * @brief Gets the number of contours of the path.
+			 * @return The number of contours.
+			 */
+			size_t contours() const;
+
+			/**
+			 * @brief Flattens the contours into polylines.
+			 * @param tolerance The largest distance allowed between a curve and the lines replacing it.
+			 * @param points The destination for the points of every contour one after the other, where a closed contour ends with its first point again.
+			 * @param ends The destination for the index past the last point of each contour.
+			 * @return The number of points of every contour, of which only those that fit in the points are written.
+			 * @throws std::invalid_argument if the tolerance is not positive, or if the ends are fewer than the contours.
+			 */
+			size_t flatten(float tolerance, std::span<vec2> points, std::span<size_t> ends) const;
+
+			/**
+			 * @brief Tessellates the outline of the path into triangles.
+			 * @param width The width of the stroke, which draws nothing if not positive.
+			 * @param tolerance The largest distance allowed between a curve, or the arc of a round join or cap, and the triangles covering it.
+			 * @param vertices The destination for the vertices of the triangles, three for each.
+			 * @param join The shape of the corners.
+			 * @param cap The shape of the ends of the open contours.
+			 * @param miterLimit The longest a miter join may reach from its corner, as a multiple of half the width, past which it becomes a bevel.
+			 * @return The number of vertices of the triangles, of which only those that fit in the vertices are written.
+			 * @throws std::invalid_argument if the tolerance is not positive.
+			 * @note The triangles of the segments, joins and caps overlap at the inner side of every corner, so a stroke drawn with transparency is blended where they do unless the overlaps are masked, as with a stencil.
+			 */
+			size_t stroke(float width, float tolerance, std::span<vec2> vertices, LineJoin join = LineJoin::Miter, LineCap cap = LineCap::Butt, float miterLimit = 4.0f) const;
+
+			/**
+			 * @brief Tessellates the inside of the path into triangles that do not overlap, with every contour closed.
+			 * @param tolerance The largest distance allowed between a curve and the lines replacing it.
+			 * @param vertices The destination for the vertices of the triangles, three for each.
+			 * @param rule How the contours decide what is inside the path where they overlap.
+			 * @return The number of vertices of the triangles, of which only those that fit in the vertices are written.
+			 * @throws std::invalid_argument if the tolerance is not positive.
+			 */
+			size_t fill(float tolerance, std::span<vec2> vertices, FillRule rule = FillRule::NonZero) const;
+
+		private:
+			enum class verb : uint8_t
+			{
+				Move,
+				Line,
+				Quadratic,
+				Cubic,
+				Close
+			};
+
+			void begin();
+			void polylines(float tolerance, std::vector<float>& points, std::vector<size_t>& ends, std::vector<uint8_t>& closed) const;
+
+			std::vector<verb> verbs_;
+			// the points of every verb one after the other, x then y, none for Close
+			std::vector<float> points_;
+			// the point the next verb starts from and the first point of the current contour, x then y
+			float current_[2];
+			float start_[2];
+			size_t contours_;
+			bool open_;
+		};
+	}
+}
\ No newline at end of file
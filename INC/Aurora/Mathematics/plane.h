@@ -0,0 +1,116 @@
+/**
+ * @file plane.h
+ * @brief Defines the plane structure, representing an infinite plane in 3D space.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include "vec3.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Represents an infinite plane as the points p where dot(normal, p) + distance = 0.
+		 * @note The side the normal points towards is the front of the plane, where the signed distance of a point is positive.
+		 * The normal is not required to be of unit length, but signed distances are only in world units once the plane is normalized.
+		 */
+		struct plane
+		{
+			/**
+			 * @brief The normal of the plane, pointing towards its front.
+			 */
+			vec3 normal;
+
+			/**
+			 * @brief The signed distance from the plane to the origin, in multiples of the length of the normal.
+			 */
+			float distance;
+
+			/**
+			 * @brief Default constructor, initializes a plane through the origin facing up.
+			 */
+			plane();
+
+			/**
+			 * @brief Constructs a plane from its normal and distance.
+			 * @param normal The normal of the plane.
+			 * @param distance The signed distance from the plane to the origin.
+			 */
+			plane(vec3 normal, float distance);
+
+			/**
+			 * @brief Constructs a plane from its normal and a point on it.
+			 * @param normal The normal of the plane.
+			 * @param point A point on the plane.
+			 */
+			plane(vec3 normal, vec3 point);
+
+			/**
+			 * @brief Constructs a plane through three points.
+			 * @param point1 The first point.
+			 * @param point2 The second point.
+			 * @param point3 The third point.
+			 * @note The normal is normalized and follows the right hand rule, pointing along cross(point2 - point1, point3 - point1).
+			 */
+			plane(vec3 point1, vec3 point2, vec3 point3);
+
+			/**
+			 * @brief Checks if two planes are approximately equal within a small tolerance.
+			 * @param value1 The first plane for comparison.
+			 * @param value2 The second plane for comparison.
+			 * @return True if the normals and distances are approximately equal, false otherwise.
+			 */
+			static bool approximately(plane value1, plane value2);
+
+			/**
+			 * @brief Scales a plane so that its normal is of unit length.
+			 * @param value The plane to normalize.
+			 * @return The normalized plane, which describes the same points.
+			 */
+			static plane normalize(plane value);
+
+			/**
+			 * @brief Returns a version of the plane with a normal of unit length.
+			 * @return The normalized plane, which describes the same points.
+			 */
+			plane normalized() const;
+
+			/**
+			 * @brief Returns the plane facing the opposite direction.
+			 * @return The flipped plane, which describes the same points.
+			 */
+			plane flipped() const;
+
+			/**
+			 * @brief Calculates the signed distance from the plane to a point.
+			 * @param point The point to measure.
+			 * @return The signed distance, positive in front of the plane and negative behind it, in multiples of the length of the normal.
+			 */
+			float signedDistance(vec3 point) const;
+
+			/**
+			 * @brief Finds the point on the plane closest to another point.
+			 * @param point The point to project onto the plane.
+			 * @return The closest point on the plane.
+			 */
+			vec3 closestPoint(vec3 point) const;
+
+			/**
+			 * @brief Equality comparison operator for planes.
+			 * @param other The plane to compare.
+			 * @return True if the planes are equal, false otherwise.
+			 * @note Planes describing the same points with differently scaled normals are not equal.
+			 */
+			bool operator ==(plane other) const;
+
+			/**
+			 * @brief Inequality comparison operator for planes.
+			 * @param other The plane to compare.
+			 * @return True if the planes are not equal, false otherwise.
+			 */
+			bool operator !=(plane other) const;
+		};
+	}
+}
\ No newline at end of file
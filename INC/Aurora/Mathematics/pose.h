@@ -0,0 +1,139 @@
+/**
+ * @file pose.h
+ * @brief Defines the pose structure, the local translation, rotation and scale of every bone of a skeleton, and the blending of poses in layers.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "poselayer.h"
+#include "quat.h"
+#include "vec3.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Represents the pose of a skeleton, a translation, a rotation and a scale for each bone relative to its parent, as sampled from a clip or set on a hierarchy.
+		 * @note Each component is stored in its own array, the x of the translation of every bone followed by the y of every bone and so on, so blending a layer is a pass over contiguous floats that processes several bones with each packed instruction.
+		 * Rotations are blended with a normalized linear interpolation instead of quat::slerp, which takes the short way by negating the rotation on the other side, and can be corrected to follow the constant speed of a spherical interpolation closely.
+		 */
+		struct pose
+		{
+			/**
+			 * @brief Default constructor, initializes a pose without bones.
+			 */
+			pose();
+
+			/**
+			 * @brief Creates a pose with every bone at the origin, without rotation and with a scale of 1.
+			 * @param bones The number of bones.
+			 */
+			explicit pose(size_t bones);
+
+			/**
+			 * @brief Gets the number of bones of the pose.
+			 * @return The number of bones.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Changes the number of bones of the pose, keeping the bones that remain and resetting those added.
+			 * @param bones The number of bones.
+			 */
+			void resize(size_t bones);
+
+			/**
+			 * @brief Places every bone at the origin, without rotation and with a scale of 1.
+			 */
+			void reset();
+
+			/**
+			 * @brief Gets the translation of a bone.
+			 * @param bone The index of the bone.
+			 * @return The translation of the bone.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			vec3 translation(size_t bone) const;
+
+			/**
+			 * @brief Sets the translation of a bone.
+			 * @param bone The index of the bone.
+			 * @param value The translation of the bone.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			void translation(size_t bone, vec3 value);
+
+			/**
+			 * @brief Gets the rotation of a bone.
+			 * @param bone The index of the bone.
+			 * @return The rotation of the bone.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			quat rotation(size_t bone) const;
+
+			/**
+			 * @brief Sets the rotation of a bone.
+			 * @param bone The index of the bone.
+			 * @param value The rotation of the bone, expected to be normalized.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			void rotation(size_t bone, quat value);
+
+			/**
+			 * @brief Gets the scale of a bone.
+			 * @param bone The index of the bone.
+			 * @return The scale of the bone.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			vec3 scale(size_t bone) const;
+
+			/**
+			 * @brief Sets the scale of a bone.
+			 * @param bone The index of the bone.
+			 * @param value The scale of the bone.
+			 * @throws std::invalid_argument if the bone does not belong to the pose.
+			 */
+			void scale(size_t bone, vec3 value);
+
+			/**
+			 * @brief Blends layers onto the pose in order, each combined with the result of the layers before it.
+			 * @param layers The layers to blend, a first layer overriding with a weight of 1 replacing the current pose entirely.
+			 * @param correct Whether to correct the weights of the rotations so they follow a spherical interpolation to within a fraction of a degree, at the cost of a few multiplies per bone.
+			 * @throws std::invalid_argument if the pose of a layer or its mask has fewer bones than the pose.
+			 */
+			void blend(std::span<const poselayer> layers, bool correct = false);
+
+			/**
+			 * @brief Blends layers onto many poses, such as those of the characters of a crowd, on multiple threads.
+			 * @param layers The layers of every pose, layerCount for each pose one after the other.
+			 * @param layerCount The number of layers of each pose.
+			 * @param poses The poses to blend onto, each blended as by the member overload with its own layers.
+			 * @param correct Whether to correct the weights of the rotations to follow a spherical interpolation.
+			 * @throws std::invalid_argument if the layers are fewer than the layers of every pose, or if the pose of a layer or its mask has fewer bones than the pose it is blended onto.
+			 * @note Every layer is checked before any pose is blended.
+			 */
+			static void blend(std::span<const poselayer> layers, size_t layerCount, std::span<pose> poses, bool correct = false);
+
+			/**
+			 * @brief Computes the difference of a pose from a reference pose, to blend it as an additive layer.
+			 * @param reference The reference pose, usually the first frame of the clip the pose was sampled from.
+			 * @param value The pose.
+			 * @return The pose adding which to the reference pose with a weight of 1 gives the pose, the difference of the translations, the ratio of the scales, or 1 where the reference scale is 0, and the conjugate of the reference rotation followed by the rotation.
+			 * @throws std::invalid_argument if the pose has fewer bones than the reference pose.
+			 */
+			static pose difference(const pose& reference, const pose& value);
+
+		private:
+			void validate(size_t bone) const;
+			float* channel(size_t index);
+			const float* channel(size_t index) const;
+
+			std::vector<float> channels_;
+			size_t size_;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * @file poselayer.h
+ * @brief Defines the poselayer structure, a pose blended onto another with a weight, a per-bone mask and a blend mode.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+#include "PoseBlend.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct pose;
+
+		/**
+		 * @brief Represents one layer of a pose blend, such as a clip being faded in or an additive breathing animation limited to the upper body.
+		 * @note The layer refers to its pose and mask without copying them, so both must outlive every blend using the layer.
+		 */
+		struct poselayer
+		{
+			/**
+			 * @brief The pose of the layer.
+			 */
+			const pose* source;
+
+			/**
+			 * @brief The weight of the layer, 0 leaving the pose beneath it unchanged and 1 applying the layer fully.
+			 */
+			float weight;
+
+			/**
+			 * @brief How the layer is combined with the pose beneath it.
+			 */
+			PoseBlend mode;
+
+			/**
+			 * @brief The weight of each bone, multiplied by the weight of the layer, or empty to apply the layer to every bone.
+			 */
+			std::span<const float> mask;
+
+			/**
+			 * @brief Creates a layer.
+			 * @param source The pose of the layer.
+			 * @param weight The weight of the layer.
+			 * @param mode How the layer is combined with the pose beneath it.
+			 * @param mask The weight of each bone, or empty to apply the layer to every bone.
+			 */
+			poselayer(const pose& source, float weight = 1.0f, PoseBlend mode = PoseBlend::Override, std::span<const float> mask = {});
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+/**
+ * @file quadtree.h
+ * @brief Defines the quadtree structure, a loose quadtree for indexing the 2D rectangles of dynamic content that are inserted, moved and removed one at a time.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "callback.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb2;
+		struct irect;
+		struct rect;
+		struct vec2;
+
+		/**
+		 * @brief Represents a loose quadtree over a square region of the plane, storing rectangles that are each identified by the id returned when inserting them.
+		 * @note Every node reaches half its size past each of its edges, so a rectangle fits in the node containing its center at the depth where the nodes are at least as large as the rectangle, which is found from the size of the rectangle without descending the tree.
+		 * Moving a rectangle that still fits its node only updates the rectangle, and otherwise moves it to another node without touching the rest of the tree.
+		 * Nodes are allocated from a pool and returned to it once they and their children hold no rectangles, so moving rectangles around settles into reusing the same nodes.
+		 * Rectangles whose center lies outside the region are kept in the root, which is always searched, so they are still found by queries at the cost of being tested by every query.
+		 * Static content is better served by an rtree, which is smaller and faster to query.
+		 */
+		struct quadtree
+		{
+			/**
+			 * @brief Default constructor, initializes an empty quadtree over the square from -1 to 1 on both axes.
+			 */
+			quadtree();
+
+			/**
+			 * @brief Constructs an empty quadtree over a region of the plane.
+			 * @param region The region to index, which is extended to the smallest square around its center containing it.
+			 * @param maxDepth The depth of the smallest nodes, where the root is at a depth of 0.
+			 * @throws std::invalid_argument if the region is empty, or the maximum depth is negative or greater than 20.
+			 */
+			quadtree(rect region, int maxDepth = 8);
+
+			/**
+			 * @brief Constructs an empty quadtree over a region of the plane.
+			 * @param region The region to index, which is extended to the smallest square around its center containing it.
+			 * @param maxDepth The depth of the smallest nodes, where the root is at a depth of 0.
+			 * @throws std::invalid_argument if the region is empty, or the maximum depth is negative or greater than 20.
+			 */
+			quadtree(const aabb2& region, int maxDepth = 8);
+
+			/**
+			 * @brief Inserts a rectangle.
+			 * @param value The rectangle.
+			 * @return The id of the rectangle, which stays valid until the rectangle is removed and may then be reused.
+			 */
+			size_t insert(rect value);
+
+			/**
+			 * @brief Inserts an integer rectangle.
+			 * @param value The rectangle.
+			 * @return The id of the rectangle, which stays valid until the rectangle is removed and may then be reused.
+			 */
+			size_t insert(irect value);
+
+			/**
+			 * @brief Inserts a rectangle.
+			 * @param value The rectangle, an empty rectangle is kept but never found by a query.
+			 * @return The id of the rectangle, which stays valid until the rectangle is removed and may then be reused.
+			 */
+			size_t insert(const aabb2& value);
+
+			/**
+			 * @brief Moves a rectangle.
+			 * @param id The id of the rectangle.
+			 * @param value The new rectangle.
+			 * @throws std::invalid_argument if no rectangle has the id.
+			 */
+			void move(size_t id, rect value);
+
+			/**
+			 * @brief Moves a rectangle.
+			 * @param id The id of the rectangle.
+			 * @param value The new integer rectangle.
+			 * @throws std::invalid_argument if no rectangle has the id.
+			 */
+			void move(size_t id, irect value);
+
+			/**
+			 * @brief Moves a rectangle.
+			 * @param id The id of the rectangle.
+			 * @param value The new rectangle.
+			 * @throws std::invalid_argument if no rectangle has the id.
+			 */
+			void move(size_t id, const aabb2& value);
+
+			/**
+			 * @brief Removes a rectangle.
+			 * @param id The id of the rectangle.
+			 * @throws std::invalid_argument if no rectangle has the id.
+			 */
+			void remove(size_t id);
+
+			/**
+			 * @brief Removes every rectangle, keeping the region and the allocated memory.
+			 */
+			void clear();
+
+			/**
+			 * @brief Checks if a rectangle has an id.
+			 * @param id The id to check.
+			 * @return True if the id belongs to a rectangle in the quadtree, false otherwise.
+			 */
+			bool contains(size_t id) const;
+
+			/**
+			 * @brief Gets a rectangle.
+			 * @param id The id of the rectangle.
+			 * @return The rectangle.
+			 * @throws std::invalid_argument if no rectangle has the id.
+			 */
+			aabb2 box(size_t id) const;
+
+			/**
+			 * @brief Gets the region indexed by the quadtree.
+			 * @return The square covered by the root, not including how far it reaches past its edges.
+			 */
+			aabb2 region() const;
+
+			/**
+			 * @brief Gets the number of rectangles in the quadtree.
+			 * @return The number of rectangles.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of nodes in use.
+			 * @return The number of nodes, including the root.
+			 */
+			size_t nodeCount() const;
+
+			/**
+			 * @brief Finds the rectangles overlapping a rectangle.
+			 * @param value The rectangle to check against.
+			 * @param results The vector the ids of the overlapping rectangles are appended to, in no particular order.
+			 * @note As with rect::intersects, rectangles only touching the rectangle are not included.
+			 */
+			void overlapping(const aabb2& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the rectangles overlapping a rectangle, reporting each to a callback.
+			 * @param value The rectangle to check against.
+			 * @param visit The function receiving the id of each overlapping rectangle, in no particular order, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with rect::intersects, rectangles only touching the rectangle are not included. The quadtree must not be changed by the callback.
+			 */
+			bool overlapping(const aabb2& value, callback<bool(size_t id)> visit) const;
+
+			/**
+			 * @brief Finds the rectangles containing a point.
+			 * @param point The point to check.
+			 * @param results The vector the ids of the containing rectangles are appended to, in no particular order.
+			 * @note As with rect::inside, points on the boundary of a rectangle are contained by it.
+			 */
+			void containing(vec2 point, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the rectangles containing a point, reporting each to a callback.
+			 * @param point The point to check.
+			 * @param visit The function receiving the id of each containing rectangle, in no particular order, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with rect::inside, points on the boundary of a rectangle are contained by it. The quadtree must not be changed by the callback.
+			 */
+			bool containing(vec2 point, callback<bool(size_t id)> visit) const;
+
+			/**
+			 * @brief Finds the rectangle closest to a point.
+			 * @param point The point to search from.
+			 * @param id The id of the closest rectangle, unchanged if none is found.
+			 * @param distance The distance from the point to the closest rectangle, 0 if the rectangle contains the point, unchanged if none is found.
+			 * @param maxDistance The distance past which rectangles are ignored.
+			 * @return True if a rectangle is found within the maximum distance, false otherwise.
+			 */
+			bool nearest(vec2 point, size_t& id, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+		private:
+			struct item
+			{
+				float min[2];
+				float max[2];
+				uint32_t id;
+			};
+
+			struct node
+			{
+				float center[2];
+				float half;
+				int depth;
+				uint32_t parent;
+				uint32_t children[4];
+				uint32_t childCount;
+				std::vector<item> items;
+			};
+
+			struct entry
+			{
+				uint32_t node;
+				uint32_t slot;
+			};
+
+			float center_[2];
+			float half_;
+			int maxDepth_;
+			size_t size_;
+			std::vector<node> nodes_;
+			std::vector<uint32_t> freeNodes_;
+			std::vector<entry> entries_;
+			std::vector<uint32_t> freeEntries_;
+
+			bool fits(uint32_t index, const float* min, const float* max) const;
+			uint32_t place(const float* min, const float* max);
+			uint32_t allocate(uint32_t parent, int quadrant);
+			void release(uint32_t index);
+			void attach(uint32_t id, uint32_t index, const float* min, const float* max);
+			void detach(entry current);
+			const entry& find(size_t id) const;
+		};
+	}
+}
\ No newline at end of file
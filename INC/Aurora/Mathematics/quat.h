@@ -10,6 +10,7 @@ namespace Aurora
 	namespace Mathematics
 	{
 		enum class Quality;
+		struct mat4;
 		struct vec3;
 
 		/**
@@ -101,6 +102,13 @@ namespace Aurora
 			 */
 			quat(vec3 eulerAngles);
 
+			/**
+			 * @brief Creates a quaternion from the rotation in the upper 3x3 part of a matrix, using Shepperd's method so the result stays accurate for any angle.
+			 *
+			 * @param rotation The matrix, whose upper 3x3 part is expected to be a rotation for row vectors, as made by mat4::createRotation. Use mat4::decompose for a matrix that also scales.
+			 */
+			explicit quat(const mat4& rotation);
+
 			/**
 			 * @brief Gets the absolute value of the quaternion.
 			 *
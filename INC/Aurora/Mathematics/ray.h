@@ -0,0 +1,230 @@
+/**
+ * @file ray.h
+ * @brief Defines the ray structure, representing a half line in 3D space, as well as functions for intersecting rays with boxes, spheres, planes and triangles in batches.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <limits>
+#include <span>
+#include "vec3.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+		struct plane;
+		struct vec2;
+
+		/**
+		 * @brief Represents a ray by its origin and direction, along with the inverse of its direction used by box tests.
+		 * @note The direction is not normalized, distances along the ray are measured in multiples of the direction, so a ray from one point to another reaches it at a distance of 1.
+		 * Every intersection test reports the closest distance at or after the origin, so a ray starting inside a box or sphere hits it at a distance of 0.
+		 */
+		struct ray
+		{
+			/**
+			 * @brief Default constructor, initializes a ray at the origin pointing forward.
+			 */
+			ray();
+
+			/**
+			 * @brief Constructs a ray from its origin and direction.
+			 * @param origin The origin of the ray.
+			 * @param direction The direction of the ray.
+			 */
+			ray(vec3 origin, vec3 direction);
+
+			/**
+			 * @brief Constructs a ray from one point towards another.
+			 * @param from The origin of the ray.
+			 * @param to The point the ray reaches at a distance of 1.
+			 * @return The ray.
+			 */
+			static ray between(vec3 from, vec3 to);
+
+			/**
+			 * @brief Gets the origin of the ray.
+			 * @return The origin.
+			 */
+			vec3 origin() const;
+
+			/**
+			 * @brief Sets the origin of the ray.
+			 * @param value The new origin.
+			 */
+			void origin(vec3 value);
+
+			/**
+			 * @brief Gets the direction of the ray.
+			 * @return The direction.
+			 */
+			vec3 direction() const;
+
+			/**
+			 * @brief Sets the direction of the ray, updating its inverse.
+			 * @param value The new direction.
+			 */
+			void direction(vec3 value);
+
+			/**
+			 * @brief Gets the component wise inverse of the direction of the ray.
+			 * @return The inverse direction, where a zero component of the direction has an inverse of the largest finite float of the same sign.
+			 * @note A finite inverse keeps box tests from multiplying zero by infinity when the origin lies on the boundary of a box.
+			 */
+			vec3 inverseDirection() const;
+
+			/**
+			 * @brief Gets the point at a distance along the ray.
+			 * @param distance The distance along the ray, in multiples of the direction.
+			 * @return The point.
+			 */
+			vec3 at(float distance) const;
+
+			/**
+			 * @brief Checks if two rays are approximately equal within a small tolerance.
+			 * @param value1 The first ray for comparison.
+			 * @param value2 The second ray for comparison.
+			 * @return True if the origins and directions are approximately equal, false otherwise.
+			 */
+			static bool approximately(const ray& value1, const ray& value2);
+
+			/**
+			 * @brief Checks if the ray hits a box.
+			 * @param value The box to check against.
+			 * @param distance The distance the ray enters the box at, unchanged if the box is missed.
+			 * @param maxDistance The distance past which the box is ignored.
+			 * @return True if the box is hit within the maximum distance, false otherwise.
+			 * @note Points on the boundary of the box are part of it, so a ray grazing an edge hits the box, except for a ray running within the plane of a face it is parallel to, which only hits if it starts inside the box.
+			 */
+			bool intersects(const aabb3& value, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Checks if the ray hits a bounds.
+			 * @param value The bounds to check against.
+			 * @param distance The distance the ray enters the bounds at, unchanged if the bounds is missed.
+			 * @param maxDistance The distance past which the bounds is ignored.
+			 * @return True if the bounds is hit within the maximum distance, false otherwise.
+			 */
+			bool intersects(bounds value, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Checks if the ray hits a sphere.
+			 * @param center The center of the sphere.
+			 * @param radius The radius of the sphere.
+			 * @param distance The distance the ray enters the sphere at, unchanged if the sphere is missed.
+			 * @param maxDistance The distance past which the sphere is ignored.
+			 * @return True if the sphere is hit within the maximum distance, false otherwise.
+			 */
+			bool intersects(vec3 center, float radius, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Checks if the ray hits a plane, from either side.
+			 * @param value The plane to check against.
+			 * @param distance The distance the ray crosses the plane at, unchanged if the plane is missed.
+			 * @param maxDistance The distance past which the plane is ignored.
+			 * @return True if the plane is hit within the maximum distance, false otherwise, including when the ray is parallel to the plane.
+			 */
+			bool intersects(plane value, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Checks if the ray hits a triangle, from either side, using the Möller–Trumbore algorithm.
+			 * @param vertex1 The first vertex of the triangle.
+			 * @param vertex2 The second vertex of the triangle.
+			 * @param vertex3 The third vertex of the triangle.
+			 * @param distance The distance the ray hits the triangle at, unchanged if the triangle is missed.
+			 * @param maxDistance The distance past which the triangle is ignored.
+			 * @return True if the triangle is hit within the maximum distance, false otherwise, including when the triangle is degenerate or parallel to the ray.
+			 */
+			bool intersects(vec3 vertex1, vec3 vertex2, vec3 vertex3, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Checks if the ray hits a triangle, from either side, using the Möller–Trumbore algorithm.
+			 * @param vertex1 The first vertex of the triangle.
+			 * @param vertex2 The second vertex of the triangle.
+			 * @param vertex3 The third vertex of the triangle.
+			 * @param distance The distance the ray hits the triangle at, unchanged if the triangle is missed.
+			 * @param barycentric The weights of the second and third vertices at the hit, the weight of the first is 1 - x - y, unchanged if the triangle is missed.
+			 * @param maxDistance The distance past which the triangle is ignored.
+			 * @return True if the triangle is hit within the maximum distance, false otherwise, including when the triangle is degenerate or parallel to the ray.
+			 */
+			bool intersects(vec3 vertex1, vec3 vertex2, vec3 vertex3, float& distance, vec2& barycentric, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+			/**
+			 * @brief Equality comparison operator for rays.
+			 * @param other The ray to compare.
+			 * @return True if the origins and directions are equal, false otherwise.
+			 */
+			bool operator ==(const ray& other) const;
+
+			/**
+			 * @brief Inequality comparison operator for rays.
+			 * @param other The ray to compare.
+			 * @return True if the origins or directions are not equal, false otherwise.
+			 */
+			bool operator !=(const ray& other) const;
+		private:
+			vec3 origin_;
+			vec3 direction_;
+			vec3 inverse_;
+		};
+
+		/**
+		 * @brief Intersects a ray with a span of boxes.
+		 * @param value The ray.
+		 * @param boxes The boxes to check against.
+		 * @param distances The distances the ray enters each box at, or -1 for the boxes that are missed.
+		 * @param maxDistance The distance past which boxes are ignored.
+		 * @throws std::invalid_argument if the distances are fewer than the boxes.
+		 * @note The boxes are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions.
+		 */
+		void intersect(const ray& value, std::span<const aabb3> boxes, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity());
+
+		/**
+		 * @brief Intersects a span of rays with a box.
+		 * @param rays The rays.
+		 * @param box The box to check against.
+		 * @param distances The distances each ray enters the box at, or -1 for the rays that miss it.
+		 * @param maxDistance The distance past which the box is ignored.
+		 * @throws std::invalid_argument if the distances are fewer than the rays.
+		 * @note The rays are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions.
+		 */
+		void intersect(std::span<const ray> rays, const aabb3& box, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity());
+
+		/**
+		 * @brief Intersects a ray with a span of spheres.
+		 * @param value The ray.
+		 * @param centers The centers of the spheres.
+		 * @param radii The radii of the spheres.
+		 * @param distances The distances the ray enters each sphere at, or -1 for the spheres that are missed.
+		 * @param maxDistance The distance past which spheres are ignored.
+		 * @throws std::invalid_argument if the radii or the distances are fewer than the centers.
+		 * @note The spheres are tested in packets of 8 laid out so that the tests compile to vector instructions where the compiler vectorizes square roots.
+		 */
+		void intersect(const ray& value, std::span<const vec3> centers, std::span<const float> radii, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity());
+
+		/**
+		 * @brief Intersects a ray with a span of planes, from either side.
+		 * @param value The ray.
+		 * @param planes The planes to check against.
+		 * @param distances The distances the ray crosses each plane at, or -1 for the planes that are missed.
+		 * @param maxDistance The distance past which planes are ignored.
+		 * @throws std::invalid_argument if the distances are fewer than the planes.
+		 * @note The planes are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions.
+		 */
+		void intersect(const ray& value, std::span<const plane> planes, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity());
+
+		/**
+		 * @brief Intersects a ray with a list of triangles, from either side, using the Möller–Trumbore algorithm.
+		 * @param value The ray.
+		 * @param vertices The vertices of the triangles, three consecutive vertices for each triangle.
+		 * @param distances The distances the ray hits each triangle at, or -1 for the triangles that are missed.
+		 * @param maxDistance The distance past which triangles are ignored.
+		 * @throws std::invalid_argument if the number of vertices is not a multiple of 3, or the distances are fewer than the triangles.
+		 * @note The triangles are tested in packets of 8 laid out so that the tests compile to 4 or 8 wide vector instructions.
+		 */
+		void intersect(const ray& value, std::span<const vec3> vertices, std::span<float> distances, float maxDistance = std::numeric_limits<float>::infinity());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @file rtree.h
+ * @brief Defines the rtree structure, a packed Hilbert R-tree for finding the 2D rectangles of static content that overlap a rectangle, contain a point, or lie closest to a point.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "callback.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb2;
+		struct irect;
+		struct rect;
+		struct vec2;
+
+		/**
+		 * @brief Represents a packed R-tree over an array of 2D rectangles, each identified by its index in the array.
+		 * @note The tree is bulk loaded by sorting the rectangles along a Hilbert curve through their centers and grouping every 16 consecutive rectangles, and then every 16 consecutive nodes, under a parent, so every node but the last of each level is full and the whole tree is stored level by level in one flat array.
+		 * The tree cannot change once built, content that moves or changes belongs in a quadtree instead.
+		 * Queries use a fixed size stack instead of recursion, and either append to a vector supplied by the caller or report each result to a callback, neither of which allocates once the vector has grown.
+		 */
+		struct rtree
+		{
+			/**
+			 * @brief Default constructor, initializes an empty tree.
+			 */
+			rtree();
+
+			/**
+			 * @brief Constructs a tree over an array of rectangles.
+			 * @param rectangles The rectangles to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			rtree(std::span<const rect> rectangles);
+
+			/**
+			 * @brief Constructs a tree over an array of integer rectangles.
+			 * @param rectangles The rectangles to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			rtree(std::span<const irect> rectangles);
+
+			/**
+			 * @brief Constructs a tree over an array of rectangles.
+			 * @param rectangles The rectangles to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			rtree(std::span<const aabb2> rectangles);
+
+			/**
+			 * @brief Rebuilds the tree over an array of rectangles, replacing its previous contents.
+			 * @param rectangles The rectangles to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			void build(std::span<const rect> rectangles);
+
+			/**
+			 * @brief Rebuilds the tree over an array of integer rectangles, replacing its previous contents.
+			 * @param rectangles The rectangles to build the tree over.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			void build(std::span<const irect> rectangles);
+
+			/**
+			 * @brief Rebuilds the tree over an array of rectangles, replacing its previous contents.
+			 * @param rectangles The rectangles to build the tree over, empty rectangles are kept but never found by a query.
+			 * @throws std::invalid_argument if there are more than 4294967295 rectangles.
+			 */
+			void build(std::span<const aabb2> rectangles);
+
+			/**
+			 * @brief Gets the number of rectangles in the tree.
+			 * @return The number of rectangles.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of nodes in the tree, not counting the rectangles themselves.
+			 * @return The number of nodes, 0 if the tree is empty.
+			 */
+			size_t nodeCount() const;
+
+			/**
+			 * @brief Gets the rectangle enclosing every rectangle in the tree.
+			 * @return The enclosing rectangle, which is empty if the tree is empty.
+			 */
+			aabb2 box() const;
+
+			/**
+			 * @brief Finds the rectangles overlapping a rectangle.
+			 * @param value The rectangle to check against.
+			 * @param results The vector the indices of the overlapping rectangles are appended to, in no particular order.
+			 * @note As with rect::intersects, rectangles only touching the rectangle are not included.
+			 */
+			void overlapping(const aabb2& value, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the rectangles overlapping a rectangle, reporting each to a callback.
+			 * @param value The rectangle to check against.
+			 * @param visit The function receiving the index of each overlapping rectangle, in no particular order, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with rect::intersects, rectangles only touching the rectangle are not included.
+			 */
+			bool overlapping(const aabb2& value, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the rectangles containing a point.
+			 * @param point The point to check.
+			 * @param results The vector the indices of the containing rectangles are appended to, in no particular order.
+			 * @note As with rect::inside, points on the boundary of a rectangle are contained by it.
+			 */
+			void containing(vec2 point, std::vector<size_t>& results) const;
+
+			/**
+			 * @brief Finds the rectangles containing a point, reporting each to a callback.
+			 * @param point The point to check.
+			 * @param visit The function receiving the index of each containing rectangle, in no particular order, and returning false to stop the query.
+			 * @return False if the query was stopped by the callback, true otherwise.
+			 * @note As with rect::inside, points on the boundary of a rectangle are contained by it.
+			 */
+			bool containing(vec2 point, callback<bool(size_t index)> visit) const;
+
+			/**
+			 * @brief Finds the rectangle closest to a point.
+			 * @param point The point to search from.
+			 * @param index The index of the closest rectangle, unchanged if none is found.
+			 * @param distance The distance from the point to the closest rectangle, 0 if the rectangle contains the point, unchanged if none is found.
+			 * @param maxDistance The distance past which rectangles are ignored.
+			 * @return True if a rectangle is found within the maximum distance, false otherwise.
+			 */
+			bool nearest(vec2 point, size_t& index, float& distance, float maxDistance = std::numeric_limits<float>::infinity()) const;
+		private:
+			// the rectangles in Hilbert order followed by the nodes of each level, the last of which is the root
+			struct entry
+			{
+				float min[2];
+				float max[2];
+			};
+
+			std::vector<entry> boxes_;
+			// the original index of each rectangle, and the position of the first child of each node
+			std::vector<uint32_t> indices_;
+			// the position past the last box of each level, starting with the rectangles
+			std::vector<size_t> levels_;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * @file skinning.h
+ * @brief Defines functions for skinning the vertices of a mesh by a palette of bone transforms in batches, with dual quaternion or linear blend skinning, on multiple threads.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct dualquat;
+		struct mat4;
+
+		/**
+		 * @brief Skins vertices by blending the dual quaternions of the bones influencing each of them, which keeps the volume of twisting joints that blending matrices collapses into a candy wrapper.
+		 * @param bones The palette of bone transforms, each taking a vertex from the bind pose to the current pose, expected to be normalized.
+		 * @param joints The index in the palette of the bone of each influence, influences for each vertex one after the other.
+		 * @param weights The weight of each influence, in the same order, which do not need to add up to 1.
+		 * @param influences The number of influences of each vertex, from 1 to 8.
+		 * @param positions The positions to skin stored as planes, the x components of every vertex followed by the y components and then the z components, so the number of vertices is a third of their size, and every other stream holds planes of that many floats each from its start.
+		 * @param skinnedPositions The destination for the skinned positions, stored as planes.
+		 * @param normals The normals to skin, stored as planes, or empty to only skin the positions.
+		 * @param skinnedNormals The destination for the skinned normals, stored as planes, unused if the normals are empty.
+		 * @param tangents The tangents to skin, stored as planes, or empty to skip them.
+		 * @param skinnedTangents The destination for the skinned tangents, stored as planes, unused if the tangents are empty.
+		 * @throws std::invalid_argument if the influences are fewer than 1 or more than 8, if the joints or the weights are fewer than the influences of every vertex, if a joint does not belong to a bone in the palette, if the normals or tangents are not empty and fewer than the positions, or if a destination is smaller than its source.
+		 * @note The vertices are skinned in groups of eight, one per lane, so the blended dual quaternions are normalized and applied with packed instructions. The influences of a bone on the other side of the first bone of a vertex are negated so the blend takes the short way around, and a vertex whose weights add up to 0 is copied unchanged.
+		 */
+		void skin(std::span<const dualquat> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals = {}, std::span<float> skinnedNormals = {}, std::span<const float> tangents = {}, std::span<float> skinnedTangents = {});
+
+		/**
+		 * @brief Skins vertices by blending the matrices of the bones influencing each of them, linear blend skinning.
+		 * @param bones The palette of bone matrices, each taking a vertex from the bind pose to the current pose as a row vector, of which only the first three columns are read.
+		 * @param joints The index in the palette of the bone of each influence, influences for each vertex one after the other.
+		 * @param weights The weight of each influence, in the same order, which are divided by their sum.
+		 * @param influences The number of influences of each vertex, from 1 to 8.
+		 * @param positions The positions to skin stored as planes, the x components of every vertex followed by the y components and then the z components, so the number of vertices is a third of their size, and every other stream holds planes of that many floats each from its start.
+		 * @param skinnedPositions The destination for the skinned positions, stored as planes.
+		 * @param normals The normals to skin, stored as planes, or empty to only skin the positions.
+		 * @param skinnedNormals The destination for the skinned normals, stored as planes and normalized, unused if the normals are empty.
+		 * @param tangents The tangents to skin, stored as planes, or empty to skip them.
+		 * @param skinnedTangents The destination for the skinned tangents, stored as planes and normalized, unused if the tangents are empty.
+		 * @throws std::invalid_argument if the influences are fewer than 1 or more than 8, if the joints or the weights are fewer than the influences of every vertex, if a joint does not belong to a bone in the palette, if the normals or tangents are not empty and fewer than the positions, or if a destination is smaller than its source.
+		 * @note The palette is copied into rows of floats before skinning, so the matrices are read without bounds checks. Normals are transformed by the blended matrix itself rather than its inverse transpose, which is exact for bones that scale evenly along every axis.
+		 */
+		void skin(std::span<const mat4> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals = {}, std::span<float> skinnedNormals = {}, std::span<const float> tangents = {}, std::span<float> skinnedTangents = {});
+
+		/**
+		 * @brief Skins vertices by blending the affine matrices of the bones influencing each of them, linear blend skinning without converting the palette.
+		 * @param bones The palette of bone matrices, 12 floats for each, the first three columns of each of the four rows of a matrix transforming row vectors, so the last three floats are the translation.
+		 * @param joints The index in the palette of the bone of each influence, influences for each vertex one after the other.
+		 * @param weights The weight of each influence, in the same order, which are divided by their sum.
+		 * @param influences The number of influences of each vertex, from 1 to 8.
+		 * @param positions The positions to skin, stored as planes.
+		 * @param skinnedPositions The destination for the skinned positions, stored as planes.
+		 * @param normals The normals to skin, stored as planes, or empty to only skin the positions.
+		 * @param skinnedNormals The destination for the skinned normals, stored as planes and normalized, unused if the normals are empty.
+		 * @param tangents The tangents to skin, stored as planes, or empty to skip them.
+		 * @param skinnedTangents The destination for the skinned tangents, stored as planes and normalized, unused if the tangents are empty.
+		 * @throws std::invalid_argument if the influences are fewer than 1 or more than 8, if the joints or the weights are fewer than the influences of every vertex, if a joint does not belong to a bone in the palette, if the normals or tangents are not empty and fewer than the positions, or if a destination is smaller than its source.
+		 * @note The vertices are skinned in groups of eight, one per lane, and a vertex whose weights add up to 0 is copied unchanged.
+		 */
+		void skin(std::span<const float> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals = {}, std::span<float> skinnedNormals = {}, std::span<const float> tangents = {}, std::span<float> skinnedTangents = {});
+	}
+}
\ No newline at end of file
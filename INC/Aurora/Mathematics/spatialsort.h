@@ -0,0 +1,98 @@
+/**
+ * @file spatialsort.h
+ * @brief Contains the functions that sort points along a space filling curve, so that points close together in space end up close together in memory and searches over them touch fewer cache lines.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "Curve.h"
+#include "parallel.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct ivec2;
+		struct ivec3;
+		struct vec2;
+		struct vec3;
+
+		/**
+		 * @brief Sorts 2D points along a space filling curve through their bounds.
+		 * @param points The points to sort in place.
+		 * @param indices The original index of each point once sorted, which reorder uses to sort data stored alongside the points.
+		 * @param curve The curve to sort along.
+		 * @throws std::invalid_argument if the indices are fewer than the points, or there are more than 4294967295 points.
+		 * @note The bounds of the points are divided into 65536 cells along each axis and the points are sorted by the position of their cell along the curve, with a parallel radix sort that keeps the points sharing a cell in their original order.
+		 */
+		void spatialSort(std::span<vec2> points, std::span<uint32_t> indices, Curve curve = Curve::Hilbert);
+
+		/**
+		 * @brief Sorts 3D points along a space filling curve through their bounds.
+		 * @param points The points to sort in place.
+		 * @param indices The original index of each point once sorted, which reorder uses to sort data stored alongside the points.
+		 * @param curve The curve to sort along.
+		 * @throws std::invalid_argument if the indices are fewer than the points, or there are more than 4294967295 points.
+		 * @note The bounds of the points are divided into 1024 cells along each axis and the points are sorted by the position of their cell along the curve, with a parallel radix sort that keeps the points sharing a cell in their original order.
+		 */
+		void spatialSort(std::span<vec3> points, std::span<uint32_t> indices, Curve curve = Curve::Hilbert);
+
+		/**
+		 * @brief Sorts 2D integer points, such as tiles or cells, along a space filling curve through their bounds.
+		 * @param points The points to sort in place.
+		 * @param indices The original index of each point once sorted, which reorder uses to sort data stored alongside the points.
+		 * @param curve The curve to sort along.
+		 * @throws std::invalid_argument if the indices are fewer than the points, or there are more than 4294967295 points.
+		 * @note Points more than 65536 apart along an axis are grouped into cells of the smallest power of two size that fits their bounds in 65536 cells, and keep their original order within a cell.
+		 */
+		void spatialSort(std::span<ivec2> points, std::span<uint32_t> indices, Curve curve = Curve::Hilbert);
+
+		/**
+		 * @brief Sorts 3D integer points, such as voxels or chunks, along a space filling curve through their bounds.
+		 * @param points The points to sort in place.
+		 * @param indices The original index of each point once sorted, which reorder uses to sort data stored alongside the points.
+		 * @param curve The curve to sort along.
+		 * @throws std::invalid_argument if the indices are fewer than the points, or there are more than 4294967295 points.
+		 * @note Points more than 1024 apart along an axis are grouped into cells of the smallest power of two size that fits their bounds in 1024 cells, and keep their original order within a cell.
+		 */
+		void spatialSort(std::span<ivec3> points, std::span<uint32_t> indices, Curve curve = Curve::Hilbert);
+
+		/**
+		 * @brief Reorders an array to match points sorted by spatialSort.
+		 * @tparam T The type of the elements, which has to be given explicitly when the arrays are not spans of T.
+		 * @param indices The original index of each element once sorted, as returned by spatialSort.
+		 * @param source The elements in their original order.
+		 * @param destination The elements in sorted order, which must not overlap the source.
+		 * @throws std::invalid_argument if the destination is smaller than the indices, or an index is outside the source.
+		 */
+		template<typename T>
+		void reorder(std::span<const uint32_t> indices, std::span<const T> source, std::span<T> destination)
+		{
+			if (destination.size() < indices.size())
+			{
+				throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than required (" + std::to_string(indices.size()) + ").");
+			}
+
+			for (uint32_t index : indices)
+			{
+				if (index >= source.size())
+				{
+					throw std::invalid_argument("The index (" + std::to_string(index) + ") is outside the source (" + std::to_string(source.size()) + ").");
+				}
+			}
+
+			parallelFor(indices.size(), 16384, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						destination[i] = source[indices[i]];
+					}
+				});
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * @file spline3.h
+ * @brief Defines the spline3 structure, a cubic spline through 3D points stored as the coefficients of each segment, with a table of arc length for moving along it at constant speed.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Spline.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct vec3;
+
+		/**
+		 * @brief Represents a cubic spline in 3D, such as a path followed by agents or a rail for a camera.
+		 * @note Each segment is stored as the four coefficients of its cubic for each component when the spline is built, so evaluating it is a few multiplies whatever the kind of spline, without the control points.
+		 * The parameter runs from 0 at the start of the first segment to the number of segments at the end of the last, each segment covering one unit.
+		 * The arc length is integrated over every subdivision of every segment when the spline is built, along with the speed at each end of the subdivisions, so the parameter at a distance is found by a binary search of the table and a cubic through the ends of the subdivision found, whose error is far below that of a linear lookup of the same table.
+		 */
+		struct spline3
+		{
+			/**
+			 * @brief Default constructor, initializes a spline without segments, which evaluates as 0 and has a length of 0.
+			 */
+			spline3();
+
+			/**
+			 * @brief Builds a spline from its points.
+			 * @param points The control points of the spline.
+			 * @param type How the points shape the spline.
+			 * @param tangents The tangent at each point, read only by Spline::Hermite.
+			 * @param subdivisions The number of entries of the arc length table for each segment, where more entries give a more even speed at the cost of memory.
+			 * @throws std::invalid_argument if the points are fewer than 2, or fewer than 4 for Spline::Bezier and Spline::BSpline, if the points of Spline::Bezier are not 1 more than a multiple of 3, if the type is Spline::Hermite and the tangents are fewer than the points, or if the subdivisions are 0.
+			 */
+			spline3(std::span<const vec3> points, Spline type = Spline::CatmullRom, std::span<const vec3> tangents = {}, size_t subdivisions = 16);
+
+			/**
+			 * @brief Gets the number of segments of the spline.
+			 * @return The number of segments, which is the largest parameter.
+			 */
+			size_t segments() const;
+
+			/**
+			 * @brief Gets the length of the spline.
+			 * @return The arc length from the start of the spline to its end.
+			 */
+			float length() const;
+
+			/**
+			 * @brief Evaluates the spline at a parameter.
+			 * @param parameter The parameter to evaluate at, clamped to the segments of the spline.
+			 * @return The position at the parameter.
+			 */
+			vec3 position(float parameter) const;
+
+			/**
+			 * @brief Evaluates the derivative of the spline at a parameter.
+			 * @param parameter The parameter to evaluate at, clamped to the segments of the spline.
+			 * @return The change of the position per unit of the parameter.
+			 */
+			vec3 derivative(float parameter) const;
+
+			/**
+			 * @brief Finds the parameter at a distance along the spline.
+			 * @param distance The arc length from the start of the spline, clamped to its length.
+			 * @return The parameter at the distance.
+			 */
+			float parameter(float distance) const;
+
+			/**
+			 * @brief Finds the distance along the spline at a parameter.
+			 * @param parameter The parameter, clamped to the segments of the spline.
+			 * @return The arc length from the start of the spline to the parameter.
+			 */
+			float distance(float parameter) const;
+
+			/**
+			 * @brief Evaluates the spline at a distance along it, so positions at evenly spaced distances are evenly spaced along the curve.
+			 * @param distance The arc length from the start of the spline, clamped to its length.
+			 * @return The position at the distance.
+			 */
+			vec3 positionAt(float distance) const;
+
+			/**
+			 * @brief Evaluates the spline at the distances of many agents, on multiple threads.
+			 * @param distances The arc length of each agent from the start of the spline.
+			 * @param positions The destination for the position of each agent.
+			 * @param directions The destination for the unit direction of the spline at each agent, or empty to skip them, which is 0 where the spline does not move.
+			 * @throws std::invalid_argument if the positions are fewer than the distances, or if the directions are not empty and fewer than the distances.
+			 */
+			void positionAt(std::span<const float> distances, std::span<vec3> positions, std::span<vec3> directions = {}) const;
+
+		private:
+			void evaluate(float parameter, float* position, float* derivative) const;
+
+			// the coefficients of each segment, constant first, for x, y then z
+			std::vector<float> coefficients_;
+			// the arc length at the start of every subdivision and at the end of the spline
+			std::vector<float> distances_;
+			// the speed at the start and the end of every subdivision, the change of the position per unit of the parameter
+			std::vector<float> speeds_;
+			size_t segments_;
+			size_t subdivisions_;
+		};
+	}
+}
\ No newline at end of file
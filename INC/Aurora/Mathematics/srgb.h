@@ -0,0 +1,60 @@
+/**
+ * @file srgb.h
+ * @brief Contains functions for converting color components between linear and sRGB encoding.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		/**
+		 * @brief Converts an sRGB encoded component to linear using the exact piecewise sRGB curve.
+		 * @param value The sRGB encoded component, in the range [0, 1].
+		 * @return The linear component.
+		 */
+		float srgbToLinear(float value);
+
+		/**
+		 * @brief Converts an 8-bit sRGB encoded component to linear using a lookup table.
+		 * @param value The sRGB encoded component.
+		 * @return The linear component, in the range [0, 1].
+		 */
+		float srgbToLinear(uint8_t value);
+
+		/**
+		 * @brief Converts a linear component to sRGB encoding using the exact piecewise sRGB curve.
+		 * @param value The linear component, clamped to the range [0, 1].
+		 * @return The sRGB encoded component.
+		 */
+		float linearToSrgb(float value);
+
+		/**
+		 * @brief Converts a linear component to an 8-bit sRGB encoded component using a lookup table.
+		 * @param value The linear component, clamped to the range [0, 1].
+		 * @return The rounded sRGB encoded component.
+		 * @note The lookup table has 16384 entries, which resolves every 8-bit code including the steep segment near black.
+		 */
+		uint8_t linearToSrgb8(float value);
+
+		/**
+		 * @brief Gets the lookup table used by srgbToLinear(uint8_t).
+		 * @return A pointer to 256 linear values, indexed by the 8-bit sRGB encoded component.
+		 */
+		const float* srgbToLinearTable();
+
+		/**
+		 * @brief The number of entries in the lookup table returned by linearToSrgbTable().
+		 */
+		constexpr int linearToSrgbTableSize = 16384;
+
+		/**
+		 * @brief Gets the lookup table used by linearToSrgb8.
+		 * @return A pointer to linearToSrgbTableSize 8-bit sRGB encoded components, indexed by the linear component multiplied by (linearToSrgbTableSize - 1) and rounded.
+		 */
+		const uint8_t* linearToSrgbTable();
+	}
+}
\ No newline at end of file
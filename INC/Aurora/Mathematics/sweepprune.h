@@ -0,0 +1,180 @@
+/**
+ * @file sweepprune.h
+ * @brief Defines the sweepprune structure, a sweep and prune broadphase that tracks which pairs of moving boxes overlap from one update to the next.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct aabb3;
+		struct bounds;
+
+		/**
+		 * @brief Represents a sweep and prune broadphase over boxes that are each identified by the id returned when inserting them, keeping the set of overlapping pairs between updates and reporting the pairs that start and stop overlapping.
+		 * @note The boxes are kept sorted by their minimum along one axis, the axis along which their centers are spread the most, so each box only has to be tested against the boxes after it that start before it ends.
+		 * Since boxes move little between updates, the order of the previous update is restored with an insertion sort that does about one step per box, falling back to a full sort when too many boxes have moved past each other, such as after inserting many boxes or switching axis.
+		 * The boxes are also cut into slabs along the axis they are spread the most along after that one, a few boxes thick, so the sweep of each slab only meets the boxes near it on two axes, and a pair reaching over several slabs is only reported by the slab its overlap starts in.
+		 * The slabs are split into blocks of boxes swept on multiple threads, and the pairs found are sorted by id with a counting sort and compared with the pairs of the previous update in a single pass.
+		 * Every update costs time proportional to the number of boxes plus the number of overlapping pairs, and works best when the boxes are spread along at least one axis, a scene that is flat along its widest axis still works but tests more boxes.
+		 */
+		struct sweepprune
+		{
+			/**
+			 * @brief Default constructor, initializes an empty broadphase.
+			 */
+			sweepprune();
+
+			/**
+			 * @brief Inserts a box.
+			 * @param value The bounds of the box.
+			 * @return The id of the box, which stays valid until the box is removed and may be reused after the update following its removal.
+			 * @throws std::invalid_argument if there are already 4294967295 boxes.
+			 */
+			size_t insert(bounds value);
+
+			/**
+			 * @brief Inserts a box.
+			 * @param value The box, an empty box is kept but never overlaps another.
+			 * @return The id of the box, which stays valid until the box is removed and may be reused after the update following its removal.
+			 * @throws std::invalid_argument if there are already 4294967295 boxes.
+			 */
+			size_t insert(const aabb3& value);
+
+			/**
+			 * @brief Moves a box, which takes effect on the next update.
+			 * @param id The id of the box.
+			 * @param value The new bounds of the box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void move(size_t id, bounds value);
+
+			/**
+			 * @brief Moves a box, which takes effect on the next update.
+			 * @param id The id of the box.
+			 * @param value The new box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void move(size_t id, const aabb3& value);
+
+			/**
+			 * @brief Removes a box, the pairs it was part of are reported as removed by the next update.
+			 * @param id The id of the box.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			void remove(size_t id);
+
+			/**
+			 * @brief Removes every box, keeping the allocated memory, the pairs between them are reported as removed by the next update.
+			 */
+			void clear();
+
+			/**
+			 * @brief Checks if a box has an id.
+			 * @param id The id to check.
+			 * @return True if the id belongs to a box in the broadphase, false otherwise.
+			 */
+			bool contains(size_t id) const;
+
+			/**
+			 * @brief Gets a box.
+			 * @param id The id of the box.
+			 * @return The box, as last inserted or moved.
+			 * @throws std::invalid_argument if no box has the id.
+			 */
+			aabb3 box(size_t id) const;
+
+			/**
+			 * @brief Gets the number of boxes in the broadphase.
+			 * @return The number of boxes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of overlapping pairs found by the last update.
+			 * @return The number of pairs.
+			 */
+			size_t pairCount() const;
+
+			/**
+			 * @brief Gets the axis the boxes are sorted along.
+			 * @return 0 for the x axis, 1 for the y axis, or 2 for the z axis.
+			 */
+			int axis() const;
+
+			/**
+			 * @brief Finds the pairs of boxes that overlap, comparing them with the pairs found by the previous update.
+			 * @param added The vector the pairs that started overlapping since the previous update are appended to.
+			 * @param removed The vector the pairs that stopped overlapping since the previous update are appended to, including the pairs of removed boxes.
+			 * @note Each pair is given once, with the lower id first, and the pairs are appended in increasing order of their ids. As with aabb3::intersects, boxes only touching are not a pair.
+			 */
+			void update(std::vector<std::pair<size_t, size_t>>& added, std::vector<std::pair<size_t, size_t>>& removed);
+
+			/**
+			 * @brief Gets the pairs of boxes that overlap.
+			 * @param results The vector the pairs found by the last update are appended to, with the lower id first and in increasing order of their ids.
+			 */
+			void pairs(std::vector<std::pair<size_t, size_t>>& results) const;
+
+			/**
+			 * @brief Checks if two boxes overlapped at the last update.
+			 * @param id1 The id of the first box.
+			 * @param id2 The id of the second box.
+			 * @return True if the boxes were found to overlap by the last update, false otherwise.
+			 */
+			bool overlapping(size_t id1, size_t id2) const;
+		private:
+			// a box, stored by id, and in the order of the sweep while updating
+			struct item
+			{
+				float min[3];
+				float max[3];
+				uint32_t id;
+			};
+
+			// a box in the sorted order, with its minimum along the axis kept next to its id so the insertion sort runs over one small array
+			struct endpoint
+			{
+				float key;
+				uint32_t id;
+			};
+
+			// a run of the boxes of a slab swept by one thread, which tests them against the boxes after them up to the end of the slab
+			struct task
+			{
+				size_t begin;
+				size_t end;
+				size_t last;
+				size_t slab;
+			};
+
+			size_t size_;
+			int axis_;
+			std::vector<item> boxes_;
+			std::vector<uint32_t> freeIds_;
+			// the ids removed since the last update, which are only reused after the update has reported their pairs as removed
+			std::vector<uint32_t> releasedIds_;
+			std::vector<endpoint> order_;
+			// the pairs found by the last update, each the lower id times 2 to the power of 32 plus the higher id, in increasing order
+			std::vector<uint64_t> pairs_;
+			// the memory used while updating, kept so that updating every frame does not allocate once the broadphase has grown
+			std::vector<item> sweep_;
+			std::vector<item> slabs_;
+			std::vector<size_t> slabOffsets_;
+			std::vector<task> tasks_;
+			std::vector<std::vector<uint64_t>> blockPairs_;
+			std::vector<size_t> counts_;
+			std::vector<uint64_t> found_;
+
+			const item& find(size_t id) const;
+			void sort();
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+/**
+ * @file track.h
+ * @brief Defines the track structure, a sequence of keys of a float, vec3, quat or col value over time, stored as the coefficients of the cubic of each segment so sampling is a lookup and a few multiplies.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Interpolation.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct quat;
+		struct vec3;
+
+		/**
+		 * @brief Represents a track of animation, the keys of one value over time, such as the rotation of a bone or the color of a light.
+		 * @note The track is built once from its keys, and each segment between two keys is stored as the four coefficients of a cubic in the fraction of the segment elapsed for every component, so a sample finds its segment and evaluates the cubic without the neighbouring keys or tangents.
+		 * The time of each segment, the reciprocal of its duration and its coefficients are stored next to each other, so a sample reads one or two cache lines of the track.
+		 * Finding the segment starts from a cursor kept by the caller for each playing instance, which is the segment found by the previous sample, so playback moving forward or staying in the same segment finds it in constant time, and only a jump falls back to a binary search.
+		 * Before the first key and after the last the values of the first and last key are held.
+		 */
+		struct track
+		{
+			/**
+			 * @brief Default constructor, initializes a track of a float without keys, which samples as 0.
+			 */
+			track();
+
+			/**
+			 * @brief Creates a track of a float.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The value of each key.
+			 * @param interpolation How the value changes between keys.
+			 * @param tangents The tangent of each key, the change of the value per unit of time, read only by Interpolation::Hermite.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite and the tangents are fewer than the times.
+			 */
+			track(std::span<const float> times, std::span<const float> values, Interpolation interpolation = Interpolation::Linear, std::span<const float> tangents = {});
+
+			/**
+			 * @brief Creates a track of a vec3.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The value of each key.
+			 * @param interpolation How the value changes between keys.
+			 * @param tangents The tangent of each key, read only by Interpolation::Hermite.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite and the tangents are fewer than the times.
+			 */
+			track(std::span<const float> times, std::span<const vec3> values, Interpolation interpolation = Interpolation::Linear, std::span<const vec3> tangents = {});
+
+			/**
+			 * @brief Creates a track of a rotation.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The rotation of each key, each negated if needed so it is on the same side as the key before it and the track takes the short way between them.
+			 * @param interpolation How the rotation changes between keys, with the components interpolated and the result normalized.
+			 * @param tangents The tangent of each key, read only by Interpolation::Hermite.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite and the tangents are fewer than the times.
+			 */
+			track(std::span<const float> times, std::span<const quat> values, Interpolation interpolation = Interpolation::Linear, std::span<const quat> tangents = {});
+
+			/**
+			 * @brief Creates a track of a color.
+			 * @param times The time of each key, in increasing order.
+			 * @param values The color of each key.
+			 * @param interpolation How the color changes between keys.
+			 * @param tangents The tangent of each key, read only by Interpolation::Hermite.
+			 * @throws std::invalid_argument if the times are not in increasing order, if the values are fewer than the times, or if the interpolation is Interpolation::Hermite and the tangents are fewer than the times.
+			 */
+			track(std::span<const float> times, std::span<const col> values, Interpolation interpolation = Interpolation::Linear, std::span<const col> tangents = {});
+
+			/**
+			 * @brief Gets the number of keys of the track.
+			 * @return The number of keys.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Gets the number of components of the value of the track.
+			 * @return 1 for a float, 3 for a vec3, and 4 for a rotation or a color.
+			 */
+			size_t components() const;
+
+			/**
+			 * @brief Gets the time of the first key.
+			 * @return The time of the first key, or 0 if the track has no keys.
+			 */
+			float start() const;
+
+			/**
+			 * @brief Gets the time of the last key.
+			 * @return The time of the last key, or 0 if the track has no keys.
+			 */
+			float end() const;
+
+			/**
+			 * @brief Samples the track.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample of the same playing instance, or 0 at the start, updated to the segment of this sample.
+			 * @param result The destination for the components of the value.
+			 * @throws std::invalid_argument if the result has fewer floats than the components of the track.
+			 */
+			void sample(float time, size_t& cursor, std::span<float> result) const;
+
+			/**
+			 * @brief Samples a track of a float.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample, updated to the segment of this sample.
+			 * @return The value at the time.
+			 * @throws std::invalid_argument if the track does not hold a float.
+			 */
+			float sampleFloat(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples a track of a vec3.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample, updated to the segment of this sample.
+			 * @return The value at the time.
+			 * @throws std::invalid_argument if the track does not hold a vec3.
+			 */
+			vec3 sampleVec3(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples a track of a rotation.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample, updated to the segment of this sample.
+			 * @return The rotation at the time, normalized.
+			 * @throws std::invalid_argument if the track does not hold a rotation.
+			 */
+			quat sampleQuat(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples a track of a color.
+			 * @param time The time to sample at.
+			 * @param cursor The segment found by the previous sample, updated to the segment of this sample.
+			 * @return The color at the time.
+			 * @throws std::invalid_argument if the track does not hold a color.
+			 */
+			col sampleCol(float time, size_t& cursor) const;
+
+			/**
+			 * @brief Samples many tracks at the same time, such as every track of a clip, on multiple threads.
+			 * @param tracks The tracks to sample.
+			 * @param time The time to sample at.
+			 * @param cursors The cursor of each track, updated to the segment of each sample.
+			 * @param results The destination for the values, the components of each track one after the other.
+			 * @throws std::invalid_argument if the cursors are fewer than the tracks, or if the results are fewer than the components of every track.
+			 */
+			static void sample(std::span<const track> tracks, float time, std::span<size_t> cursors, std::span<float> results);
+
+		private:
+			void build(std::span<const float> times, const float* values, const float* tangents, size_t components, Interpolation interpolation);
+			size_t find(float time, size_t& cursor) const;
+			void evaluate(float time, size_t& cursor, float* result) const;
+
+			std::vector<float> segments_;
+			size_t size_;
+			size_t stride_;
+			size_t components_;
+			bool rotation_;
+		};
+	}
+}
\ No newline at end of file
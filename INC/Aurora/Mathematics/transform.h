@@ -0,0 +1,161 @@
+/**
+ * @file transform.h
+ * @brief Defines the transform structure, a translation, rotation and scale that caches its matrix, inverse and normal matrix until it changes.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstdint>
+#include "quat.h"
+#include "vec3.h"
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct mat3;
+		struct mat4;
+
+		/**
+		 * @brief Represents a transform that scales, then rotates, then translates, and keeps the matrices derived from it until one of its parts changes.
+		 * @note Points are transformed as row vectors, so the translation is in the last row of the matrix as with mat4::createTranslation, and the rotation turns points by the quaternion itself.
+		 * Each change increments the version of the transform, and the matrix, the inverse and the normal matrix each remember the version they were computed at, so they are only computed again when they are asked for after a change.
+		 * The inverse is never found by inverting a 4x4 matrix, it is the transposed rotation divided by the scale, which is exact for any scale and reduces to the transposed rotation for a rigid transform.
+		 * The getters fill the caches, so a transform read from several threads at once should have its caches filled beforehand by reading the matrices it is used for.
+		 */
+		struct transform
+		{
+			/**
+			 * @brief Default constructor, initializes a transform at the origin, without rotation and with a scale of 1.
+			 */
+			transform();
+
+			/**
+			 * @brief Constructs a transform from its parts.
+			 * @param translation The translation of the transform.
+			 * @param rotation The rotation of the transform, which does not need to be normalized.
+			 * @param scale The scale of the transform.
+			 */
+			transform(vec3 translation, quat rotation, vec3 scale);
+
+			/**
+			 * @brief Gets the translation of the transform.
+			 * @return The translation.
+			 */
+			vec3 translation() const;
+
+			/**
+			 * @brief Sets the translation of the transform.
+			 * @param value The translation.
+			 */
+			void translation(vec3 value);
+
+			/**
+			 * @brief Gets the rotation of the transform.
+			 * @return The rotation, as it was set.
+			 */
+			quat rotation() const;
+
+			/**
+			 * @brief Sets the rotation of the transform.
+			 * @param value The rotation, which does not need to be normalized.
+			 * @note A rotation of length 0 is treated as no rotation.
+			 */
+			void rotation(quat value);
+
+			/**
+			 * @brief Gets the scale of the transform.
+			 * @return The scale.
+			 */
+			vec3 scale() const;
+
+			/**
+			 * @brief Sets the scale of the transform.
+			 * @param value The scale.
+			 */
+			void scale(vec3 value);
+
+			/**
+			 * @brief Gets the version of the transform, which increments each time one of its parts is set.
+			 * @return The version, which can be compared with a version kept alongside data derived from the transform to know if it is out of date.
+			 */
+			uint64_t version() const;
+
+			/**
+			 * @brief Checks if the transform only rotates and translates.
+			 * @return True if every component of the scale is 1, false otherwise.
+			 */
+			bool rigid() const;
+
+			/**
+			 * @brief Checks if the transform scales by the same amount along every axis, in which case its matrix already transforms normals correctly up to their length.
+			 * @return True if the components of the scale are equal, false otherwise.
+			 */
+			bool uniform() const;
+
+			/**
+			 * @brief Gets the matrix of the transform.
+			 * @return The matrix, computed again only if the transform changed since it was last asked for.
+			 */
+			mat4 matrix() const;
+
+			/**
+			 * @brief Gets the inverse of the matrix of the transform.
+			 * @return The inverse, computed again only if the transform changed since it was last asked for.
+			 * @note A component of the scale of 0 gives 0 along that axis of the inverse instead of failing.
+			 */
+			mat4 inverse() const;
+
+			/**
+			 * @brief Gets the normal matrix of the transform, the inverse transpose of the upper 3x3 part of its matrix.
+			 * @return The normal matrix, for transforming normals as row vectors, computed again only if the transform changed since it was last asked for.
+			 * @note The normals transformed are not normalized unless the transform is rigid.
+			 */
+			mat3 normal() const;
+
+			/**
+			 * @brief Transforms a point, without creating a matrix.
+			 * @param value The point.
+			 * @return The point scaled, rotated and translated.
+			 */
+			vec3 transformPoint(vec3 value) const;
+
+			/**
+			 * @brief Transforms a direction, without creating a matrix.
+			 * @param value The direction.
+			 * @return The direction scaled and rotated, without the translation.
+			 */
+			vec3 transformVector(vec3 value) const;
+
+			/**
+			 * @brief Transforms a normal, without creating a matrix.
+			 * @param value The normal.
+			 * @return The normal transformed by the normal matrix and normalized, or the zero vector if it has length 0.
+			 */
+			vec3 transformNormal(vec3 value) const;
+
+			/**
+			 * @brief Transforms a point by the inverse of the transform, without creating a matrix.
+			 * @param value The point.
+			 * @return The point translated, rotated and scaled back.
+			 */
+			vec3 inverseTransformPoint(vec3 value) const;
+		private:
+			vec3 translation_;
+			quat rotation_;
+			vec3 scale_;
+			uint64_t version_;
+			// the caches, each the affine part of a matrix as rows, with the version of the transform it was computed at
+			mutable float matrix_[4][3];
+			mutable float inverse_[4][3];
+			mutable float normal_[3][3];
+			mutable uint64_t matrixVersion_;
+			mutable uint64_t inverseVersion_;
+			mutable uint64_t normalVersion_;
+
+			void updateMatrix() const;
+			void updateInverse() const;
+			void updateNormal() const;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file xyz.h
+ * @brief Defines the xyz structure, representing a color in the CIE 1931 XYZ color space.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+
+		/**
+		 * @brief Represents a color in the CIE 1931 XYZ color space, relative to the D65 white point.
+		 * @note Conversions to and from col treat the col as linear sRGB (Rec. 709 primaries), a col of (1, 1, 1) maps to a luminance (y) of 1.
+		 */
+		struct xyz
+		{
+			/**
+			 * @brief X tristimulus component of the color.
+			 */
+			float x;
+
+			/**
+			 * @brief Y tristimulus component of the color, the relative luminance.
+			 */
+			float y;
+
+			/**
+			 * @brief Z tristimulus component of the color.
+			 */
+			float z;
+
+			/**
+			 * @brief Alpha component of the color.
+			 */
+			float a;
+
+			/**
+			 * @brief Default constructor, initializes all color components to zero, and the alpha component to 1.
+			 */
+			xyz();
+
+			/**
+			 * @brief Constructor with specified color components.
+			 * @param x X tristimulus component.
+			 * @param y Y tristimulus component.
+			 * @param z Z tristimulus component.
+			 * @param a Alpha component (default is 1.0).
+			 */
+			xyz(float x, float y, float z, float a = 1.0f);
+
+			/**
+			 * @brief Checks if two colors are approximately equal within a small tolerance.
+			 * @param value1 The first color for comparison.
+			 * @param value2 The second color for comparison.
+			 * @return True if colors are approximately equal, false otherwise.
+			 */
+			static bool approximately(xyz value1, xyz value2);
+
+			/**
+			 * @brief Linearly interpolates between two colors.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @return The interpolated color.
+			 */
+			static xyz lerp(xyz value1, xyz value2, float amount);
+
+			/**
+			 * @brief Linearly interpolates between two colors without clamping the interpolation parameter.
+			 * @param value1 The starting color.
+			 * @param value2 The ending color.
+			 * @param amount The interpolation parameter.
+			 * @return The unclamped interpolated color.
+			 */
+			static xyz lerpUnclamped(xyz value1, xyz value2, float amount);
+
+			/**
+			 * @brief Equality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are equal, false otherwise.
+			 */
+			bool operator ==(xyz other) const;
+
+			/**
+			 * @brief Inequality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are not equal, false otherwise.
+			 */
+			bool operator !=(xyz other) const;
+
+			/**
+			 * @brief Implicit conversion operator to col.
+			 * @return The color represented as a linear sRGB col, components outside the sRGB gamut are left unclamped.
+			 */
+			operator col() const;
+		};
+
+		/**
+		 * @brief Converts a span of linear sRGB colors to XYZ.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const col> source, std::span<xyz> destination);
+
+		/**
+		 * @brief Converts a span of XYZ colors to linear sRGB.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const xyz> source, std::span<col> destination);
+	}
+}
\ No newline at end of file
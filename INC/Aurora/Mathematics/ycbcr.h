@@ -0,0 +1,199 @@
+/**
+ * @file ycbcr.h
+ * @brief Defines the ycbcr structure, representing a color in the Y'CbCr color space used for video, as well as functions for converting between interleaved colors and planar 8-bit Y'CbCr images.
+ * @author Raistlin Wolfe
+ */
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace Aurora
+{
+	namespace Mathematics
+	{
+		struct col;
+		struct col32;
+
+		/**
+		 * @brief Enumeration representing the standards defining the luma coefficients of a Y'CbCr color.
+		 */
+		enum class YCbCrStandard
+		{
+			/**
+			 * @brief ITU-R BT.601, standard definition video.
+			 */
+			Bt601,
+
+			/**
+			 * @brief ITU-R BT.709, high definition video.
+			 */
+			Bt709
+		};
+
+		/**
+		 * @brief Enumeration representing the ranges used to store 8-bit Y'CbCr components.
+		 */
+		enum class YCbCrRange
+		{
+			/**
+			 * @brief Every component uses the range [0, 255].
+			 */
+			Full,
+
+			/**
+			 * @brief Luma uses the range [16, 235] and chroma uses the range [16, 240], as is common for broadcast video.
+			 */
+			Limited
+		};
+
+		/**
+		 * @brief Represents a color in the Y'CbCr color space.
+		 * @note Y'CbCr is defined over gamma encoded components, so the col this type is converted to and from is treated as gamma encoded and not linear.
+		 */
+		struct ycbcr
+		{
+			/**
+			 * @brief Luma component of the color, in the range [0, 1] for colors within gamut.
+			 */
+			float y;
+
+			/**
+			 * @brief Blue difference component of the color, in the range [-0.5, 0.5] for colors within gamut.
+			 */
+			float cb;
+
+			/**
+			 * @brief Red difference component of the color, in the range [-0.5, 0.5] for colors within gamut.
+			 */
+			float cr;
+
+			/**
+			 * @brief Alpha component of the color.
+			 */
+			float a;
+
+			/**
+			 * @brief Default constructor, initializes all color components to zero, and the alpha component to 1.
+			 */
+			ycbcr();
+
+			/**
+			 * @brief Constructor with specified color components.
+			 * @param y Luma component.
+			 * @param cb Blue difference component.
+			 * @param cr Red difference component.
+			 * @param a Alpha component (default is 1.0).
+			 */
+			ycbcr(float y, float cb, float cr, float a = 1.0f);
+
+			/**
+			 * @brief Constructs a Y'CbCr color from a gamma encoded RGB color.
+			 * @param value The color to convert.
+			 * @param standard The standard defining the luma coefficients.
+			 */
+			ycbcr(col value, YCbCrStandard standard = YCbCrStandard::Bt709);
+
+			/**
+			 * @brief Checks if two colors are approximately equal within a small tolerance.
+			 * @param value1 The first color for comparison.
+			 * @param value2 The second color for comparison.
+			 * @return True if colors are approximately equal, false otherwise.
+			 */
+			static bool approximately(ycbcr value1, ycbcr value2);
+
+			/**
+			 * @brief Converts the color to a gamma encoded RGB color.
+			 * @param standard The standard defining the luma coefficients.
+			 * @return The converted color, components outside the RGB gamut are left unclamped.
+			 */
+			col rgb(YCbCrStandard standard = YCbCrStandard::Bt709) const;
+
+			/**
+			 * @brief Equality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are equal, false otherwise.
+			 */
+			bool operator ==(ycbcr other) const;
+
+			/**
+			 * @brief Inequality comparison operator for colors.
+			 * @param other The color to compare.
+			 * @return True if colors are not equal, false otherwise.
+			 */
+			bool operator !=(ycbcr other) const;
+		};
+
+		/**
+		 * @brief Converts a span of gamma encoded RGB colors to Y'CbCr.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @param standard The standard defining the luma coefficients.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const col> source, std::span<ycbcr> destination, YCbCrStandard standard = YCbCrStandard::Bt709);
+
+		/**
+		 * @brief Converts a span of Y'CbCr colors to gamma encoded RGB.
+		 * @param source The colors to convert.
+		 * @param destination The converted colors.
+		 * @param standard The standard defining the luma coefficients.
+		 * @throws std::invalid_argument if the destination is smaller than the source.
+		 */
+		void convert(std::span<const ycbcr> source, std::span<col> destination, YCbCrStandard standard = YCbCrStandard::Bt709);
+
+		/**
+		 * @brief Converts an interleaved image to 8-bit planar Y'CbCr with full resolution chroma (4:4:4).
+		 * @param source The pixels of the image, the alpha component is discarded.
+		 * @param y The luma plane, one value per pixel.
+		 * @param cb The blue difference plane, one value per pixel.
+		 * @param cr The red difference plane, one value per pixel.
+		 * @param standard The standard defining the luma coefficients.
+		 * @param range The range the planes are stored in.
+		 * @throws std::invalid_argument if any plane is smaller than the source.
+		 * @note Uses 14-bit fixed point arithmetic, the result is within 1 of the rounded exact conversion.
+		 */
+		void convert(std::span<const col32> source, std::span<uint8_t> y, std::span<uint8_t> cb, std::span<uint8_t> cr, YCbCrStandard standard = YCbCrStandard::Bt709, YCbCrRange range = YCbCrRange::Limited);
+
+		/**
+		 * @brief Converts an 8-bit planar Y'CbCr image with full resolution chroma (4:4:4) to interleaved pixels.
+		 * @param y The luma plane, one value per pixel.
+		 * @param cb The blue difference plane, one value per pixel.
+		 * @param cr The red difference plane, one value per pixel.
+		 * @param destination The pixels of the image, the alpha component is set to 255.
+		 * @param standard The standard defining the luma coefficients.
+		 * @param range The range the planes are stored in.
+		 * @throws std::invalid_argument if any plane or the destination is smaller than the luma plane.
+		 */
+		void convert(std::span<const uint8_t> y, std::span<const uint8_t> cb, std::span<const uint8_t> cr, std::span<col32> destination, YCbCrStandard standard = YCbCrStandard::Bt709, YCbCrRange range = YCbCrRange::Limited);
+
+		/**
+		 * @brief Converts an interleaved image to 8-bit planar Y'CbCr with chroma subsampled by 2 in both directions (4:2:0).
+		 * @param source The pixels of the image, row by row, the alpha component is discarded.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param y The luma plane, width * height values.
+		 * @param cb The blue difference plane, ((width + 1) / 2) * ((height + 1) / 2) values, each the average of a 2x2 block of pixels.
+		 * @param cr The red difference plane, sized as the blue difference plane.
+		 * @param standard The standard defining the luma coefficients.
+		 * @param range The range the planes are stored in.
+		 * @throws std::invalid_argument if the dimensions are negative, or the source or any plane is too small.
+		 */
+		void convert420(std::span<const col32> source, int width, int height, std::span<uint8_t> y, std::span<uint8_t> cb, std::span<uint8_t> cr, YCbCrStandard standard = YCbCrStandard::Bt709, YCbCrRange range = YCbCrRange::Limited);
+
+		/**
+		 * @brief Converts an 8-bit planar Y'CbCr image with chroma subsampled by 2 in both directions (4:2:0) to interleaved pixels.
+		 * @param y The luma plane, width * height values.
+		 * @param cb The blue difference plane, ((width + 1) / 2) * ((height + 1) / 2) values.
+		 * @param cr The red difference plane, sized as the blue difference plane.
+		 * @param width The width of the image in pixels.
+		 * @param height The height of the image in pixels.
+		 * @param destination The pixels of the image, row by row, the alpha component is set to 255.
+		 * @param standard The standard defining the luma coefficients.
+		 * @param range The range the planes are stored in.
+		 * @throws std::invalid_argument if the dimensions are negative, or the destination or any plane is too small.
+		 * @note Chroma is replicated across each 2x2 block of pixels.
+		 */
+		void convert420(std::span<const uint8_t> y, std::span<const uint8_t> cb, std::span<const uint8_t> cr, int width, int height, std::span<col32> destination, YCbCrStandard standard = YCbCrStandard::Bt709, YCbCrRange range = YCbCrRange::Limited);
+	}
+}
\ No newline at end of file
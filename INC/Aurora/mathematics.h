@@ -1,25 +1,73 @@
 #pragma once
 
+#include <Aurora/Mathematics/aabb2.h>
+#include <Aurora/Mathematics/aabb3.h>
 #include <Aurora/Mathematics/angle.h>
 #include <Aurora/Mathematics/bounds.h>
+#include <Aurora/Mathematics/bvh.h>
+#include <Aurora/Mathematics/callback.h>
 #include <Aurora/Mathematics/col.h>
 #include <Aurora/Mathematics/col32.h>
+#include <Aurora/Mathematics/compressedtrack.h>
+#include <Aurora/Mathematics/Containment.h>
+#include <Aurora/Mathematics/Curve.h>
+#include <Aurora/Mathematics/Dither.h>
+#include <Aurora/Mathematics/dualquat.h>
+#include <Aurora/Mathematics/FillRule.h>
+#include <Aurora/Mathematics/Filter.h>
+#include <Aurora/Mathematics/frustum.h>
+#include <Aurora/Mathematics/hashgrid2.h>
+#include <Aurora/Mathematics/hashgrid3.h>
+#include <Aurora/Mathematics/hierarchy.h>
 #include <Aurora/Mathematics/hsv.h>
+#include <Aurora/Mathematics/iaabb2.h>
+#include <Aurora/Mathematics/iaabb3.h>
 #include <Aurora/Mathematics/ibounds.h>
+#include <Aurora/Mathematics/Interpolation.h>
 #include <Aurora/Mathematics/irect.h>
 #include <Aurora/Mathematics/ivec2.h>
 #include <Aurora/Mathematics/ivec3.h>
 #include <Aurora/Mathematics/ivec4.h>
+#include <Aurora/Mathematics/kdtree2.h>
+#include <Aurora/Mathematics/kdtree3.h>
 #include <Aurora/Mathematics/LerpDirection.h>
+#include <Aurora/Mathematics/LineCap.h>
+#include <Aurora/Mathematics/LineJoin.h>
 #include <Aurora/Mathematics/mat2.h>
 #include <Aurora/Mathematics/mat3.h>
 #include <Aurora/Mathematics/mat4.h>
 #include <Aurora/Mathematics/math.h>
 #include <Aurora/Mathematics/matrix.h>
+#include <Aurora/Mathematics/mipmap.h>
+#include <Aurora/Mathematics/octree.h>
+#include <Aurora/Mathematics/oklab.h>
+#include <Aurora/Mathematics/oklch.h>
+#include <Aurora/Mathematics/parallel.h>
+#include <Aurora/Mathematics/path.h>
+#include <Aurora/Mathematics/plane.h>
+#include <Aurora/Mathematics/pose.h>
+#include <Aurora/Mathematics/PoseBlend.h>
+#include <Aurora/Mathematics/poselayer.h>
+#include <Aurora/Mathematics/quadtree.h>
 #include <Aurora/Mathematics/Quality.h>
 #include <Aurora/Mathematics/quat.h>
+#include <Aurora/Mathematics/ray.h>
 #include <Aurora/Mathematics/rect.h>
+#include <Aurora/Mathematics/Rounding.h>
+#include <Aurora/Mathematics/rtree.h>
+#include <Aurora/Mathematics/skinning.h>
+#include <Aurora/Mathematics/spatialsort.h>
+#include <Aurora/Mathematics/Spline.h>
+#include <Aurora/Mathematics/spline2.h>
+#include <Aurora/Mathematics/spline3.h>
+#include <Aurora/Mathematics/srgb.h>
+#include <Aurora/Mathematics/sweepprune.h>
 #include <Aurora/Mathematics/temperature.h>
+#include <Aurora/Mathematics/Tonemap.h>
+#include <Aurora/Mathematics/track.h>
+#include <Aurora/Mathematics/transform.h>
 #include <Aurora/Mathematics/vec2.h>
 #include <Aurora/Mathematics/vec3.h>
 #include <Aurora/Mathematics/vec4.h>
+#include <Aurora/Mathematics/xyz.h>
+#include <Aurora/Mathematics/ycbcr.h>
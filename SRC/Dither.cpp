@@ -0,0 +1,440 @@
+#include "../INC/Aurora/Mathematics/Dither.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/col32.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of pixels processed per inner block, also the width of the threshold maps so a block never wraps around the map
+		constexpr size_t ditherLanes = 64;
+
+		// number of pixels handed to a thread at a time
+		constexpr size_t ditherGrain = 32768;
+
+		// clamps a component to [0, 1], mapping NaN to 0 so that it never reaches an integer conversion or the diffused error
+		inline float ditherSaturate(float value)
+		{
+			return !(value > 0.0f) ? 0.0f : std::min(value, 1.0f);
+		}
+
+		// the threshold maps are ditherLanes x ditherLanes, each threshold in (0, 1)
+		using ditherMap = std::array<float, ditherLanes * ditherLanes>;
+
+		ditherMap createBayerMap()
+		{
+			// builds the 8x8 matrix by repeatedly subdividing each cell into the 2x2 pattern (0 2 / 3 1)
+			constexpr int size = 8;
+			static const int pattern[2][2] = { { 0, 2 }, { 3, 1 } };
+			int matrix[size][size] = { { 0 } };
+
+			for (int n = 1; n < size; n *= 2)
+			{
+				// walking backwards leaves the top left n x n quadrant, which every cell reads from, to be overwritten last
+				for (int y = 2 * n - 1; y >= 0; y--)
+				{
+					for (int x = 2 * n - 1; x >= 0; x--)
+					{
+						matrix[y][x] = 4 * matrix[y % n][x % n] + pattern[y / n][x / n];
+					}
+				}
+			}
+
+			ditherMap map;
+
+			for (size_t y = 0; y < ditherLanes; y++)
+			{
+				for (size_t x = 0; x < ditherLanes; x++)
+				{
+					map[y * ditherLanes + x] = (matrix[y % size][x % size] + 0.5f) / (size * size);
+				}
+			}
+
+			return map;
+		}
+
+		ditherMap createBlueNoiseMap()
+		{
+			// void and cluster (Ulichney), ranks every cell of a toroidal grid by placing each point in the largest void left by the points before it
+			constexpr size_t size = ditherLanes;
+			constexpr size_t cells = size * size;
+			constexpr float sigma = 1.5f;
+
+			std::vector<float> kernel(cells);
+
+			for (size_t y = 0; y < size; y++)
+			{
+				for (size_t x = 0; x < size; x++)
+				{
+					float dx = static_cast<float>(std::min(x, size - x));
+					float dy = static_cast<float>(std::min(y, size - y));
+					kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0f * sigma * sigma));
+				}
+			}
+
+			std::vector<float> energy(cells, 0.0f);
+			std::vector<uint8_t> points(cells, 0);
+
+			auto splat = [&](size_t cell, float sign)
+				{
+					size_t px = cell % size;
+					size_t py = cell / size;
+
+					for (size_t y = 0; y < size; y++)
+					{
+						const float* k = kernel.data() + ((y - py) & (size - 1)) * size;
+						float* e = energy.data() + y * size;
+
+						for (size_t x = 0; x < size; x++)
+						{
+							e[x] += sign * k[(x - px) & (size - 1)];
+						}
+					}
+				};
+
+			auto tightestCluster = [&]()
+				{
+					size_t best = 0;
+					float value = -1.0f;
+
+					for (size_t i = 0; i < cells; i++)
+					{
+						if (points[i] && energy[i] > value)
+						{
+							value = energy[i];
+							best = i;
+						}
+					}
+
+					return best;
+				};
+
+			auto largestVoid = [&]()
+				{
+					size_t best = 0;
+					float value = std::numeric_limits<float>::max();
+
+					for (size_t i = 0; i < cells; i++)
+					{
+						if (!points[i] && energy[i] < value)
+						{
+							value = energy[i];
+							best = i;
+						}
+					}
+
+					return best;
+				};
+
+			// a fixed seed keeps the map, and therefore every dithered image, identical between runs
+			uint32_t state = 0x9E3779B9u;
+			size_t initial = 0;
+
+			while (initial < cells / 10)
+			{
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+
+				size_t cell = state % cells;
+
+				if (!points[cell])
+				{
+					points[cell] = 1;
+					splat(cell, 1.0f);
+					initial++;
+				}
+			}
+
+			// relax the random pattern by moving the tightest cluster into the largest void until that no longer changes anything
+			for (size_t i = 0; i < cells; i++)
+			{
+				size_t cluster = tightestCluster();
+				points[cluster] = 0;
+				splat(cluster, -1.0f);
+
+				size_t hole = largestVoid();
+				points[hole] = 1;
+				splat(hole, 1.0f);
+
+				if (hole == cluster)
+				{
+					break;
+				}
+			}
+
+			std::vector<uint8_t> relaxedPoints = points;
+			std::vector<float> relaxedEnergy = energy;
+			std::vector<size_t> rank(cells, 0);
+
+			// rank the initial points by removing the tightest clusters first
+			for (size_t r = initial; r-- > 0;)
+			{
+				size_t cluster = tightestCluster();
+				points[cluster] = 0;
+				splat(cluster, -1.0f);
+				rank[cluster] = r;
+			}
+
+			// rank the remaining cells by filling the largest voids first
+			points = relaxedPoints;
+			energy = relaxedEnergy;
+
+			for (size_t r = initial; r < cells; r++)
+			{
+				size_t hole = largestVoid();
+				points[hole] = 1;
+				splat(hole, 1.0f);
+				rank[hole] = r;
+			}
+
+			ditherMap map;
+
+			for (size_t i = 0; i < cells; i++)
+			{
+				map[i] = (rank[i] + 0.5f) / cells;
+			}
+
+			return map;
+		}
+
+		const ditherMap& bayerMap()
+		{
+			static const ditherMap map = createBayerMap();
+			return map;
+		}
+
+		const ditherMap& blueNoiseMap()
+		{
+			static const ditherMap map = createBlueNoiseMap();
+			return map;
+		}
+
+		float ditherBias(Rounding rounding)
+		{
+			switch (rounding)
+			{
+			case Aurora::Mathematics::Rounding::Truncate:
+				return 0.0f;
+			case Aurora::Mathematics::Rounding::Nearest:
+				return 0.5f;
+			default:
+				throw std::invalid_argument("'" + std::to_string(static_cast<int>(rounding)) + "' is not a defined Rounding.");
+			}
+		}
+
+		void ditherCheck(size_t required, size_t available, const char* name)
+		{
+			if (available < required)
+			{
+				throw std::invalid_argument("The " + std::string(name) + " (" + std::to_string(available) + ") is smaller than required (" + std::to_string(required) + ").");
+			}
+		}
+
+		// quantizes count pixels, adding thresholds[i] (one per pixel of the block, or a single value if stride is 0) to each color component before truncating
+		void ditherRange(const col* source, col32* destination, size_t count, const float* thresholds, size_t stride, float alphaBias)
+		{
+			float values[ditherLanes * 3];
+			float offsets[ditherLanes * 3];
+			int levels[ditherLanes * 3];
+
+			for (size_t i = 0; i < ditherLanes; i++)
+			{
+				float t = thresholds[i * stride];
+				offsets[i * 3 + 0] = t;
+				offsets[i * 3 + 1] = t;
+				offsets[i * 3 + 2] = t;
+			}
+
+			for (size_t start = 0; start < count; start += ditherLanes)
+			{
+				size_t n = std::min(ditherLanes, count - start);
+				const col* s = source + start;
+				col32* d = destination + start;
+
+				for (size_t i = 0; i < n; i++)
+				{
+					values[i * 3 + 0] = s[i].r;
+					values[i * 3 + 1] = s[i].g;
+					values[i * 3 + 2] = s[i].b;
+				}
+
+				for (size_t i = 0; i < n * 3; i++)
+				{
+					float v = ditherSaturate(values[i]) * 255.0f + offsets[i];
+					levels[i] = std::min(static_cast<int>(v), 255);
+				}
+
+				for (size_t i = 0; i < n; i++)
+				{
+					float a = ditherSaturate(s[i].a) * 255.0f + alphaBias;
+					d[i].r = static_cast<uint8_t>(levels[i * 3 + 0]);
+					d[i].g = static_cast<uint8_t>(levels[i * 3 + 1]);
+					d[i].b = static_cast<uint8_t>(levels[i * 3 + 2]);
+					d[i].a = static_cast<uint8_t>(std::min(static_cast<int>(a), 255));
+				}
+			}
+		}
+
+		void ditherOrdered(const col* source, size_t width, size_t height, col32* destination, const ditherMap& map, float alphaBias)
+		{
+			parallelFor(height, ditherGrain / (width + 1) + 1, [&](size_t begin, size_t end)
+				{
+					for (size_t y = begin; y < end; y++)
+					{
+						ditherRange(source + y * width, destination + y * width, width, map.data() + (y % ditherLanes) * ditherLanes, 1, alphaBias);
+					}
+				});
+		}
+
+		void ditherFloydSteinberg(const col* source, size_t width, size_t height, col32* destination, float alphaBias)
+		{
+			// each row receives the error of the row above it through one of a ring of buffers, with a pixel of padding on either side
+			// a row may only run over a pixel once the row above it has finished the pixel to its right, so the rows proceed as a staggered wavefront
+			const size_t stride = (width + 2) * 3;
+			const size_t buffers = static_cast<size_t>(threadCount()) + 1;
+
+			std::vector<float> errors(buffers * stride, 0.0f);
+			std::unique_ptr<std::atomic<size_t>[]> progress(new std::atomic<size_t>[height]());
+
+			auto wait = [&](size_t row, size_t required)
+				{
+					while (progress[row].load(std::memory_order_acquire) < required)
+					{
+						std::this_thread::yield();
+					}
+				};
+
+			// rows are handed out one at a time and in order, so every row waited on is already owned by a running thread
+			parallelFor(height, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t y = begin; y < end; y++)
+					{
+						const col* s = source + y * width;
+						col32* d = destination + y * width;
+						const float* current = errors.data() + (y % buffers) * stride + 3;
+						float* next = errors.data() + ((y + 1) % buffers) * stride + 3;
+
+						// the buffer for the next row was last read by the row a full ring earlier
+						if (y + 1 >= buffers)
+						{
+							wait(y + 1 - buffers, width);
+						}
+
+						std::fill(next - 3, next - 3 + stride, 0.0f);
+
+						float carry[3] = { 0.0f, 0.0f, 0.0f };
+
+						for (size_t start = 0; start < width; start += ditherLanes)
+						{
+							size_t n = std::min(ditherLanes, width - start);
+
+							if (y > 0)
+							{
+								wait(y - 1, std::min(start + n + 1, width));
+							}
+
+							for (size_t x = start; x < start + n; x++)
+							{
+								float values[3] = { s[x].r, s[x].g, s[x].b };
+								uint8_t levels[3];
+
+								for (size_t c = 0; c < 3; c++)
+								{
+									float v = ditherSaturate(values[c]) * 255.0f + current[x * 3 + c] + carry[c];
+									int level = std::clamp(static_cast<int>(v + 0.5f), 0, 255);
+									float error = v - level;
+
+									carry[c] = error * (7.0f / 16.0f);
+									next[(x - 1) * 3 + c] += error * (3.0f / 16.0f);
+									next[x * 3 + c] += error * (5.0f / 16.0f);
+									next[(x + 1) * 3 + c] += error * (1.0f / 16.0f);
+									levels[c] = static_cast<uint8_t>(level);
+								}
+
+								float a = ditherSaturate(s[x].a) * 255.0f + alphaBias;
+								d[x].r = levels[0];
+								d[x].g = levels[1];
+								d[x].b = levels[2];
+								d[x].a = static_cast<uint8_t>(std::min(static_cast<int>(a), 255));
+							}
+
+							progress[y].store(start + n, std::memory_order_release);
+						}
+					}
+				});
+		}
+	}
+
+	col32 quantize(col value, Rounding rounding)
+	{
+		col32 result;
+		quantize(std::span<const col>(&value, 1), std::span<col32>(&result, 1), rounding);
+		return result;
+	}
+
+	void quantize(std::span<const col> source, std::span<col32> destination, Rounding rounding)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		float bias = ditherBias(rounding);
+
+		parallelFor(source.size(), ditherGrain, [&](size_t begin, size_t end)
+			{
+				ditherRange(source.data() + begin, destination.data() + begin, end - begin, &bias, 0, bias);
+			});
+	}
+
+	void quantize(std::span<const col> source, int width, int height, std::span<col32> destination, Dither dither, Rounding rounding)
+	{
+		if (width < 0 || height < 0)
+		{
+			throw std::invalid_argument("The image dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ") must not be negative.");
+		}
+
+		size_t w = static_cast<size_t>(width);
+		size_t h = static_cast<size_t>(height);
+		float bias = ditherBias(rounding);
+
+		ditherCheck(w * h, source.size(), "source");
+		ditherCheck(w * h, destination.size(), "destination");
+
+		switch (dither)
+		{
+		case Aurora::Mathematics::Dither::None:
+			quantize(source.first(w * h), destination, rounding);
+			break;
+		case Aurora::Mathematics::Dither::Bayer:
+			ditherOrdered(source.data(), w, h, destination.data(), bayerMap(), bias);
+			break;
+		case Aurora::Mathematics::Dither::BlueNoise:
+			ditherOrdered(source.data(), w, h, destination.data(), blueNoiseMap(), bias);
+			break;
+		case Aurora::Mathematics::Dither::FloydSteinberg:
+			if (w > 0 && h > 0)
+			{
+				ditherFloydSteinberg(source.data(), w, h, destination.data(), bias);
+			}
+			break;
+		default:
+			throw std::invalid_argument("'" + std::to_string(static_cast<int>(dither)) + "' is not a defined Dither method.");
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include "../INC/Aurora/Mathematics/Filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/col32.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of floats accumulated at a time when summing whole rows, small enough for the sums to stay in registers
+		constexpr size_t filterLanes = 32;
+
+		// number of floats a tile of filtered rows aims to occupy, small enough for the rows of a tile to stay in cache between both passes
+		constexpr size_t filterTileFloats = 65536;
+
+		// the largest radius of a box or gaussian kernel, for which the number of its weights still fits in an int
+		constexpr int filterMaxRadius = (std::numeric_limits<int>::max() - 1) / 2;
+
+		// the source pixels and weights contributing to every pixel along one axis, with the indices already clamped to the edges of the image
+		// a kernel along the rows keeps only its weights, shared by every pixel over the consecutive pixels of the padded row
+		struct filterTaps
+		{
+			size_t count;
+			size_t radius;
+			bool kernel;
+			std::vector<int> indices;
+			std::vector<float> weights;
+		};
+
+		filterTaps filterKernelColumns(std::span<const float> kernel)
+		{
+			filterTaps taps;
+			taps.count = kernel.size();
+			taps.radius = kernel.size() / 2;
+			taps.kernel = true;
+			taps.weights.assign(kernel.begin(), kernel.end());
+			return taps;
+		}
+
+		filterTaps filterKernelRows(size_t size, std::span<const float> kernel)
+		{
+			filterTaps taps;
+			taps.count = kernel.size();
+			taps.radius = 0;
+			taps.kernel = false;
+			taps.indices.resize(size * taps.count);
+			taps.weights.resize(size * taps.count);
+
+			int radius = static_cast<int>(kernel.size() / 2);
+			int last = static_cast<int>(size) - 1;
+
+			for (size_t i = 0; i < size; i++)
+			{
+				for (size_t t = 0; t < taps.count; t++)
+				{
+					taps.indices[i * taps.count + t] = std::clamp(static_cast<int>(i + t) - radius, 0, last);
+					taps.weights[i * taps.count + t] = kernel[t];
+				}
+			}
+
+			return taps;
+		}
+
+		filterTaps filterResampleTaps(size_t sourceSize, size_t size, Filter filter)
+		{
+			filterTaps taps;
+			taps.radius = 0;
+			taps.kernel = false;
+
+			switch (filter)
+			{
+			case Aurora::Mathematics::Filter::Bilinear:
+				taps.count = 2;
+				break;
+			case Aurora::Mathematics::Filter::CatmullRom:
+				taps.count = 4;
+				break;
+			default:
+				throw std::invalid_argument("'" + std::to_string(static_cast<int>(filter)) + "' is not a defined Filter.");
+			}
+
+			taps.indices.resize(size * taps.count);
+			taps.weights.resize(size * taps.count);
+
+			float scale = static_cast<float>(sourceSize) / static_cast<float>(size);
+			int last = static_cast<int>(sourceSize) - 1;
+
+			for (size_t i = 0; i < size; i++)
+			{
+				float position = (i + 0.5f) * scale - 0.5f;
+				float base = std::floor(position);
+				float amount = position - base;
+				int first = static_cast<int>(base) - (taps.count == 4 ? 1 : 0);
+				int* indices = taps.indices.data() + i * taps.count;
+				float* weights = taps.weights.data() + i * taps.count;
+
+				// the weights are the scalar interpolation functions evaluated for a unit value at each tap, so the result matches them exactly
+				if (taps.count == 2)
+				{
+					weights[0] = lerpUnclamped(1.0f, 0.0f, amount);
+					weights[1] = lerpUnclamped(0.0f, 1.0f, amount);
+				}
+				else
+				{
+					weights[0] = catmullRom(1.0f, 0.0f, 0.0f, 0.0f, amount);
+					weights[1] = catmullRom(0.0f, 1.0f, 0.0f, 0.0f, amount);
+					weights[2] = catmullRom(0.0f, 0.0f, 1.0f, 0.0f, amount);
+					weights[3] = catmullRom(0.0f, 0.0f, 0.0f, 1.0f, amount);
+				}
+
+				for (size_t t = 0; t < taps.count; t++)
+				{
+					indices[t] = std::clamp(first + static_cast<int>(t), 0, last);
+				}
+			}
+
+			return taps;
+		}
+
+		void filterLoad(const col* source, float* destination, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				destination[i * 4 + 0] = source[i].r;
+				destination[i * 4 + 1] = source[i].g;
+				destination[i * 4 + 2] = source[i].b;
+				destination[i * 4 + 3] = source[i].a;
+			}
+		}
+
+		void filterLoad(const col32* source, float* destination, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				destination[i * 4 + 0] = source[i].r;
+				destination[i * 4 + 1] = source[i].g;
+				destination[i * 4 + 2] = source[i].b;
+				destination[i * 4 + 3] = source[i].a;
+			}
+		}
+
+		void filterStore(const float* source, col* destination, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				destination[i].r = source[i * 4 + 0];
+				destination[i].g = source[i * 4 + 1];
+				destination[i].b = source[i * 4 + 2];
+				destination[i].a = source[i * 4 + 3];
+			}
+		}
+
+		void filterStore(const float* source, col32* destination, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				destination[i].r = static_cast<uint8_t>(std::clamp(source[i * 4 + 0], 0.0f, 255.0f) + 0.5f);
+				destination[i].g = static_cast<uint8_t>(std::clamp(source[i * 4 + 1], 0.0f, 255.0f) + 0.5f);
+				destination[i].b = static_cast<uint8_t>(std::clamp(source[i * 4 + 2], 0.0f, 255.0f) + 0.5f);
+				destination[i].a = static_cast<uint8_t>(std::clamp(source[i * 4 + 3], 0.0f, 255.0f) + 0.5f);
+			}
+		}
+
+		// number of rows summed per call to filterSum
+		constexpr size_t filterMaxRows = 16;
+
+		// sums the weighted rows into the destination, accumulating onto it if requested, a block of lanes at a time so the sums never leave registers
+		void filterSum(const float* const* rows, const float* weights, size_t count, float* destination, size_t size, bool accumulate)
+		{
+			for (size_t start = 0; start < size; start += filterLanes)
+			{
+				size_t n = std::min(filterLanes, size - start);
+				float sum[filterLanes];
+
+				for (size_t i = 0; i < filterLanes; i++)
+				{
+					sum[i] = accumulate && i < n ? destination[start + i] : 0.0f;
+				}
+
+				for (size_t t = 0; t < count; t++)
+				{
+					const float* row = rows[t] + start;
+					float weight = weights[t];
+
+					if (n == filterLanes)
+					{
+						for (size_t i = 0; i < filterLanes; i++)
+						{
+							sum[i] += weight * row[i];
+						}
+					}
+					else
+					{
+						for (size_t i = 0; i < n; i++)
+						{
+							sum[i] += weight * row[i];
+						}
+					}
+				}
+
+				for (size_t i = 0; i < n; i++)
+				{
+					destination[start + i] = sum[i];
+				}
+			}
+		}
+
+		// the source row is padded by columns.radius pixels on either side when the taps are a kernel
+		void filterHorizontal(const float* source, float* destination, size_t width, const filterTaps& columns)
+		{
+			if (columns.kernel)
+			{
+				// every pixel uses the same weights over consecutive pixels, so the row is summed as shifted copies of itself
+				const float* rows[filterMaxRows];
+				const float* weights = columns.weights.data();
+
+				for (size_t start = 0; start < columns.count; start += filterMaxRows)
+				{
+					size_t n = std::min(filterMaxRows, columns.count - start);
+
+					for (size_t t = 0; t < n; t++)
+					{
+						rows[t] = source + (start + t) * 4;
+					}
+
+					filterSum(rows, weights + start, n, destination, width * 4, start > 0);
+				}
+
+				return;
+			}
+
+			for (size_t x = 0; x < width; x++)
+			{
+				const int* indices = columns.indices.data() + x * columns.count;
+				const float* weights = columns.weights.data() + x * columns.count;
+				float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+				for (size_t t = 0; t < columns.count; t++)
+				{
+					const float* pixel = source + indices[t] * 4;
+					float weight = weights[t];
+
+					for (size_t c = 0; c < 4; c++)
+					{
+						sum[c] += weight * pixel[c];
+					}
+				}
+
+				for (size_t c = 0; c < 4; c++)
+				{
+					destination[x * 4 + c] = sum[c];
+				}
+			}
+		}
+
+		// filters the rows of the source once horizontally into a tile buffer and then vertically out of it, a tile of destination rows at a time
+		template<typename Pixel>
+		void filterImage(const Pixel* source, size_t width, Pixel* destination, size_t destinationWidth, size_t destinationHeight, const filterTaps& columns, const filterTaps& rows)
+		{
+			// neighbouring tiles both filter the rows they share horizontally, so a tile spans at least twice the taps to keep that overlap small
+			size_t tileRows = std::max(filterTileFloats / (std::max(width, destinationWidth) * 4), 2 * rows.count);
+
+			parallelFor(destinationHeight, tileRows, [&](size_t begin, size_t end)
+				{
+					int first = std::numeric_limits<int>::max();
+					int last = 0;
+
+					for (size_t i = begin * rows.count; i < end * rows.count; i++)
+					{
+						first = std::min(first, rows.indices[i]);
+						last = std::max(last, rows.indices[i]);
+					}
+
+					size_t stride = destinationWidth * 4;
+					size_t padding = columns.radius * 4;
+					std::vector<float> input(width * 4 + 2 * padding);
+					std::vector<float> tile((last - first + 1) * stride);
+					std::vector<float> output(stride);
+
+					for (int row = first; row <= last; row++)
+					{
+						filterLoad(source + row * width, input.data() + padding, width);
+
+						for (size_t i = 0; i < padding; i += 4)
+						{
+							std::copy_n(input.data() + padding, 4, input.data() + i);
+							std::copy_n(input.data() + padding + width * 4 - 4, 4, input.data() + padding + width * 4 + i);
+						}
+
+						filterHorizontal(input.data(), tile.data() + (row - first) * stride, destinationWidth, columns);
+					}
+
+					for (size_t y = begin; y < end; y++)
+					{
+						const int* indices = rows.indices.data() + y * rows.count;
+						const float* weights = rows.weights.data() + y * rows.count;
+
+						for (size_t start = 0; start < rows.count; start += filterMaxRows)
+						{
+							const float* sources[filterMaxRows];
+							size_t n = std::min(filterMaxRows, rows.count - start);
+
+							for (size_t t = 0; t < n; t++)
+							{
+								sources[t] = tile.data() + (indices[start + t] - first) * stride;
+							}
+
+							filterSum(sources, weights + start, n, output.data(), stride, start > 0);
+						}
+
+						filterStore(output.data(), destination + y * destinationWidth, destinationWidth);
+					}
+				});
+		}
+
+		void filterCheck(size_t required, size_t available, const char* name)
+		{
+			if (available < required)
+			{
+				throw std::invalid_argument("The " + std::string(name) + " (" + std::to_string(available) + ") is smaller than required (" + std::to_string(required) + ").");
+			}
+		}
+
+		void filterCheckDimensions(int width, int height)
+		{
+			if (width < 0 || height < 0)
+			{
+				throw std::invalid_argument("The image dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ") must not be negative.");
+			}
+		}
+
+		template<typename Pixel>
+		void filterConvolve(std::span<const Pixel> source, int width, int height, std::span<Pixel> destination, std::span<const float> kernel)
+		{
+			filterCheckDimensions(width, height);
+
+			if (kernel.size() % 2 == 0)
+			{
+				throw std::invalid_argument("The kernel (" + std::to_string(kernel.size()) + ") must have an odd number of weights.");
+			}
+
+			size_t w = static_cast<size_t>(width);
+			size_t h = static_cast<size_t>(height);
+
+			filterCheck(w * h, source.size(), "source");
+			filterCheck(w * h, destination.size(), "destination");
+
+			if (w == 0 || h == 0)
+			{
+				return;
+			}
+
+			filterImage(source.data(), w, destination.data(), w, h, filterKernelColumns(kernel), filterKernelRows(h, kernel));
+		}
+
+		std::vector<float> filterBoxKernel(int radius)
+		{
+			if (radius < 0)
+			{
+				throw std::invalid_argument("The radius (" + std::to_string(radius) + ") must not be negative.");
+			}
+
+			if (radius > filterMaxRadius)
+			{
+				throw std::invalid_argument("The radius (" + std::to_string(radius) + ") is larger than supported (" + std::to_string(filterMaxRadius) + ").");
+			}
+
+			return std::vector<float>(2 * radius + 1, 1.0f / (2 * radius + 1));
+		}
+
+		std::vector<float> filterGaussianKernel(float sigma)
+		{
+			if (!(sigma > 0.0f))
+			{
+				return std::vector<float>(1, 1.0f);
+			}
+
+			float extent = std::ceil(3.0f * sigma);
+
+			if (!(extent < static_cast<float>(filterMaxRadius)))
+			{
+				throw std::invalid_argument("The sigma (" + std::to_string(sigma) + ") is larger than supported (" + std::to_string(filterMaxRadius / 3) + ").");
+			}
+
+			int radius = static_cast<int>(extent);
+			std::vector<float> kernel(2 * radius + 1);
+			float sum = 0.0f;
+
+			for (int i = -radius; i <= radius; i++)
+			{
+				float weight = std::exp(-(i * i) / (2.0f * sigma * sigma));
+				kernel[i + radius] = weight;
+				sum += weight;
+			}
+
+			for (float& weight : kernel)
+			{
+				weight /= sum;
+			}
+
+			return kernel;
+		}
+
+		template<typename Pixel>
+		void filterResample(std::span<const Pixel> source, int width, int height, std::span<Pixel> destination, int destinationWidth, int destinationHeight, Filter filter)
+		{
+			filterCheckDimensions(width, height);
+			filterCheckDimensions(destinationWidth, destinationHeight);
+
+			size_t w = static_cast<size_t>(width);
+			size_t h = static_cast<size_t>(height);
+			size_t dw = static_cast<size_t>(destinationWidth);
+			size_t dh = static_cast<size_t>(destinationHeight);
+
+			filterCheck(w * h, source.size(), "source");
+			filterCheck(dw * dh, destination.size(), "destination");
+
+			if (dw == 0 || dh == 0)
+			{
+				return;
+			}
+
+			if (w == 0 || h == 0)
+			{
+				throw std::invalid_argument("An empty image (" + std::to_string(width) + ", " + std::to_string(height) + ") cannot be resampled.");
+			}
+
+			filterImage(source.data(), w, destination.data(), dw, dh, filterResampleTaps(w, dw, filter), filterResampleTaps(h, dh, filter));
+		}
+	}
+
+	void convolve(std::span<const col> source, int width, int height, std::span<col> destination, std::span<const float> kernel)
+	{
+		filterConvolve(source, width, height, destination, kernel);
+	}
+
+	void convolve(std::span<const col32> source, int width, int height, std::span<col32> destination, std::span<const float> kernel)
+	{
+		filterConvolve(source, width, height, destination, kernel);
+	}
+
+	void boxBlur(std::span<const col> source, int width, int height, std::span<col> destination, int radius)
+	{
+		filterConvolve(source, width, height, destination, std::span<const float>(filterBoxKernel(radius)));
+	}
+
+	void boxBlur(std::span<const col32> source, int width, int height, std::span<col32> destination, int radius)
+	{
+		filterConvolve(source, width, height, destination, std::span<const float>(filterBoxKernel(radius)));
+	}
+
+	void gaussianBlur(std::span<const col> source, int width, int height, std::span<col> destination, float sigma)
+	{
+		filterConvolve(source, width, height, destination, std::span<const float>(filterGaussianKernel(sigma)));
+	}
+
+	void gaussianBlur(std::span<const col32> source, int width, int height, std::span<col32> destination, float sigma)
+	{
+		filterConvolve(source, width, height, destination, std::span<const float>(filterGaussianKernel(sigma)));
+	}
+
+	void resample(std::span<const col> source, int width, int height, std::span<col> destination, int destinationWidth, int destinationHeight, Filter filter)
+	{
+		filterResample(source, width, height, destination, destinationWidth, destinationHeight, filter);
+	}
+
+	void resample(std::span<const col32> source, int width, int height, std::span<col32> destination, int destinationWidth, int destinationHeight, Filter filter)
+	{
+		filterResample(source, width, height, destination, destinationWidth, destinationHeight, filter);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "../INC/Aurora/Mathematics/Tonemap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/col32.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/srgb.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of pixels processed per inner block, the channels of a block are tone mapped as one flat array so the operator loop vectorizes
+		constexpr size_t tonemapLanes = 64;
+
+		// number of pixels handed to a thread at a time
+		constexpr size_t tonemapGrain = 16384;
+
+		// the largest exposed intensity passed to an operator, past which every curve is flat to float precision and below which the squares in the curves stay finite
+		constexpr float tonemapMaximum = 1e8f;
+
+		// clamps a value to [0, upper], mapping NaN to 0 so that it never reaches an index or an integer conversion
+		inline float tonemapSaturate(float value, float upper)
+		{
+			return !(value > 0.0f) ? 0.0f : std::min(value, upper);
+		}
+
+		struct ReinhardOperator
+		{
+			ReinhardOperator(float) { }
+
+			float operator()(float x) const
+			{
+				return x / (1.0f + x);
+			}
+		};
+
+		struct ReinhardExtendedOperator
+		{
+			float invWhiteSquared;
+
+			ReinhardExtendedOperator(float whitePoint) : invWhiteSquared(1.0f / (whitePoint * whitePoint)) { }
+
+			float operator()(float x) const
+			{
+				return std::min(x * (1.0f + x * invWhiteSquared) / (1.0f + x), 1.0f);
+			}
+		};
+
+		struct AcesOperator
+		{
+			AcesOperator(float) { }
+
+			float operator()(float x) const
+			{
+				return std::min((x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f), 1.0f);
+			}
+		};
+
+		struct FilmicOperator
+		{
+			float invWhite;
+
+			static float curve(float x)
+			{
+				const float a = 0.15f; // shoulder strength
+				const float b = 0.50f; // linear strength
+				const float c = 0.10f; // linear angle
+				const float d = 0.20f; // toe strength
+				const float e = 0.02f; // toe numerator
+				const float f = 0.30f; // toe denominator
+
+				return ((x * (a * x + c * b) + d * e) / (x * (a * x + b) + d * f)) - e / f;
+			}
+
+			FilmicOperator(float whitePoint) : invWhite(1.0f / curve(std::min(whitePoint, tonemapMaximum))) { }
+
+			float operator()(float x) const
+			{
+				return std::min(curve(x) * invWhite, 1.0f);
+			}
+		};
+
+		template<typename Operator>
+		void tonemapRange(const col* source, col* destination, size_t count, float exposure, Operator op)
+		{
+			float values[tonemapLanes * 3];
+
+			for (size_t start = 0; start < count; start += tonemapLanes)
+			{
+				size_t n = std::min(tonemapLanes, count - start);
+				const col* s = source + start;
+				col* d = destination + start;
+
+				for (size_t i = 0; i < n; i++)
+				{
+					values[i * 3 + 0] = s[i].r;
+					values[i * 3 + 1] = s[i].g;
+					values[i * 3 + 2] = s[i].b;
+				}
+
+				for (size_t i = 0; i < n * 3; i++)
+				{
+					values[i] = op(tonemapSaturate(values[i] * exposure, tonemapMaximum));
+				}
+
+				for (size_t i = 0; i < n; i++)
+				{
+					float a = tonemapSaturate(s[i].a, 1.0f);
+					d[i].r = values[i * 3 + 0];
+					d[i].g = values[i * 3 + 1];
+					d[i].b = values[i * 3 + 2];
+					d[i].a = a;
+				}
+			}
+		}
+
+		template<typename Operator>
+		void tonemapRange(const col* source, col32* destination, size_t count, float exposure, Operator op)
+		{
+			const uint8_t* table = linearToSrgbTable();
+			const float scale = static_cast<float>(linearToSrgbTableSize - 1);
+			float values[tonemapLanes * 3];
+			int indices[tonemapLanes * 3];
+
+			for (size_t start = 0; start < count; start += tonemapLanes)
+			{
+				size_t n = std::min(tonemapLanes, count - start);
+				const col* s = source + start;
+				col32* d = destination + start;
+
+				for (size_t i = 0; i < n; i++)
+				{
+					values[i * 3 + 0] = s[i].r;
+					values[i * 3 + 1] = s[i].g;
+					values[i * 3 + 2] = s[i].b;
+				}
+
+				for (size_t i = 0; i < n * 3; i++)
+				{
+					float v = op(tonemapSaturate(values[i] * exposure, tonemapMaximum));
+					indices[i] = static_cast<int>(tonemapSaturate(v, 1.0f) * scale + 0.5f);
+				}
+
+				for (size_t i = 0; i < n; i++)
+				{
+					float a = tonemapSaturate(s[i].a, 1.0f);
+					d[i].r = table[indices[i * 3 + 0]];
+					d[i].g = table[indices[i * 3 + 1]];
+					d[i].b = table[indices[i * 3 + 2]];
+					d[i].a = static_cast<uint8_t>(a * 255.0f + 0.5f);
+				}
+			}
+		}
+
+		template<typename Destination>
+		void tonemapSpan(Tonemap op, std::span<const col> source, std::span<Destination> destination, float exposure, float whitePoint)
+		{
+			if (destination.size() < source.size())
+			{
+				throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+			}
+
+			if ((op == Tonemap::ReinhardExtended || op == Tonemap::Filmic) && !(whitePoint > 0.0f))
+			{
+				throw std::invalid_argument("The white point (" + std::to_string(whitePoint) + ") must be positive.");
+			}
+
+			parallelFor(source.size(), tonemapGrain, [&](size_t begin, size_t end)
+				{
+					const col* s = source.data() + begin;
+					Destination* d = destination.data() + begin;
+					size_t n = end - begin;
+
+					switch (op)
+					{
+					case Aurora::Mathematics::Tonemap::Reinhard:
+						tonemapRange(s, d, n, exposure, ReinhardOperator(whitePoint));
+						break;
+					case Aurora::Mathematics::Tonemap::ReinhardExtended:
+						tonemapRange(s, d, n, exposure, ReinhardExtendedOperator(whitePoint));
+						break;
+					case Aurora::Mathematics::Tonemap::Aces:
+						tonemapRange(s, d, n, exposure, AcesOperator(whitePoint));
+						break;
+					case Aurora::Mathematics::Tonemap::Filmic:
+						tonemapRange(s, d, n, exposure, FilmicOperator(whitePoint));
+						break;
+					default:
+						throw std::invalid_argument("'" + std::to_string(static_cast<int>(op)) + "' is not a defined Tonemap operator.");
+					}
+				});
+		}
+	}
+
+	col tonemap(Tonemap op, col value, float exposure, float whitePoint)
+	{
+		col result;
+		tonemapSpan(op, std::span<const col>(&value, 1), std::span<col>(&result, 1), exposure, whitePoint);
+		return result;
+	}
+
+	void tonemap(Tonemap op, std::span<const col> source, std::span<col> destination, float exposure, float whitePoint)
+	{
+		tonemapSpan(op, source, destination, exposure, whitePoint);
+	}
+
+	void tonemap(Tonemap op, std::span<const col> source, std::span<col32> destination, float exposure, float whitePoint)
+	{
+		tonemapSpan(op, source, destination, exposure, whitePoint);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "../INC/Aurora/Mathematics/aabb2.h"
+
+#include <algorithm>
+#include <limits>
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/rect.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	aabb2::aabb2()
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::numeric_limits<float>::infinity();
+			max_[i] = -std::numeric_limits<float>::infinity();
+		}
+	}
+
+	aabb2::aabb2(vec2 min, vec2 max)
+	{
+		min_[0] = min.x;
+		min_[1] = min.y;
+		max_[0] = max.x;
+		max_[1] = max.y;
+	}
+
+	aabb2::aabb2(rect value)
+	{
+		float x0 = value.x();
+		float x1 = value.x() + value.width();
+		float y0 = value.y();
+		float y1 = value.y() + value.height();
+
+		min_[0] = std::min(x0, x1);
+		min_[1] = std::min(y0, y1);
+		max_[0] = std::max(x0, x1);
+		max_[1] = std::max(y0, y1);
+	}
+
+	vec2 aabb2::min() const
+	{
+		return vec2(min_[0], min_[1]);
+	}
+
+	void aabb2::min(vec2 value)
+	{
+		min_[0] = value.x;
+		min_[1] = value.y;
+	}
+
+	vec2 aabb2::max() const
+	{
+		return vec2(max_[0], max_[1]);
+	}
+
+	void aabb2::max(vec2 value)
+	{
+		max_[0] = value.x;
+		max_[1] = value.y;
+	}
+
+	vec2 aabb2::center() const
+	{
+		return vec2((min_[0] + max_[0]) * 0.5f, (min_[1] + max_[1]) * 0.5f);
+	}
+
+	vec2 aabb2::size() const
+	{
+		if (empty())
+		{
+			return vec2(0.0f, 0.0f);
+		}
+
+		return vec2(max_[0] - min_[0], max_[1] - min_[1]);
+	}
+
+	bool aabb2::empty() const
+	{
+		// the lanes are compared into masks and only then combined, so the test compiles to one packed comparison
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = max_[i] < min_[i] ? -1 : 0;
+		}
+
+		return (mask[0] | mask[1]) != 0;
+	}
+
+	float aabb2::area() const
+	{
+		if (empty())
+		{
+			return 0.0f;
+		}
+
+		return (max_[0] - min_[0]) * (max_[1] - min_[1]);
+	}
+
+	float aabb2::perimeter() const
+	{
+		if (empty())
+		{
+			return 0.0f;
+		}
+
+		return 2.0f * ((max_[0] - min_[0]) + (max_[1] - min_[1]));
+	}
+
+	bool aabb2::approximately(const aabb2& value1, const aabb2& value2)
+	{
+		return
+			Mathematics::approximately(value1.min_[0], value2.min_[0]) &&
+			Mathematics::approximately(value1.min_[1], value2.min_[1]) &&
+			Mathematics::approximately(value1.max_[0], value2.max_[0]) &&
+			Mathematics::approximately(value1.max_[1], value2.max_[1]);
+	}
+
+	bool aabb2::inside(const aabb2& value, vec2 point)
+	{
+		return value.inside(point);
+	}
+
+	bool aabb2::inside(vec2 point) const
+	{
+		float p[2] = { point.x, point.y };
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (p[i] >= min_[i] ? -1 : 0) & (p[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool aabb2::inside(const aabb2& value1, const aabb2& value2)
+	{
+		return value1.inside(value2);
+	}
+
+	bool aabb2::inside(const aabb2& value) const
+	{
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (value.min_[i] >= min_[i] ? -1 : 0) & (value.max_[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool aabb2::intersects(const aabb2& value1, const aabb2& value2)
+	{
+		return value1.intersects(value2);
+	}
+
+	bool aabb2::intersects(const aabb2& other) const
+	{
+		// the boxes overlap where the larger minimum is below the smaller maximum on every axis
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = std::max(min_[i], other.min_[i]) < std::min(max_[i], other.max_[i]) ? -1 : 0;
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	aabb2 aabb2::intersection(const aabb2& value1, const aabb2& value2)
+	{
+		aabb2 result;
+
+		for (int i = 0; i < 2; i++)
+		{
+			result.min_[i] = std::max(value1.min_[i], value2.min_[i]);
+			result.max_[i] = std::min(value1.max_[i], value2.max_[i]);
+		}
+
+		return result;
+	}
+
+	aabb2 aabb2::merge(const aabb2& value1, const aabb2& value2)
+	{
+		aabb2 result = value1;
+		result.merge(value2);
+		return result;
+	}
+
+	void aabb2::merge(const aabb2& value)
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::min(min_[i], value.min_[i]);
+			max_[i] = std::max(max_[i], value.max_[i]);
+		}
+	}
+
+	aabb2 aabb2::merge(const aabb2& value, vec2 point)
+	{
+		aabb2 result = value;
+		result.merge(point);
+		return result;
+	}
+
+	void aabb2::merge(vec2 point)
+	{
+		float p[2] = { point.x, point.y };
+
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::min(min_[i], p[i]);
+			max_[i] = std::max(max_[i], p[i]);
+		}
+	}
+
+	aabb2 aabb2::expand(const aabb2& value, float amount)
+	{
+		aabb2 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void aabb2::expand(float amount)
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] -= amount;
+			max_[i] += amount;
+		}
+	}
+
+	aabb2 aabb2::expand(const aabb2& value, vec2 amount)
+	{
+		aabb2 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void aabb2::expand(vec2 amount)
+	{
+		float a[2] = { amount.x, amount.y };
+
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] -= a[i];
+			max_[i] += a[i];
+		}
+	}
+
+	bool aabb2::operator==(const aabb2& other) const
+	{
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (min_[i] == other.min_[i] ? -1 : 0) & (max_[i] == other.max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool aabb2::operator!=(const aabb2& other) const
+	{
+		return !((*this) == other);
+	}
+
+	aabb2::operator rect() const
+	{
+		if (empty())
+		{
+			return rect(0.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		return rect(min_[0], min_[1], max_[0] - min_[0], max_[1] - min_[1]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "../INC/Aurora/Mathematics/aabb3.h"
+
+#include <algorithm>
+#include <limits>
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	aabb3::aabb3()
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] = std::numeric_limits<float>::infinity();
+			max_[i] = -std::numeric_limits<float>::infinity();
+		}
+
+		min_[3] = -std::numeric_limits<float>::infinity();
+		max_[3] = std::numeric_limits<float>::infinity();
+	}
+
+	aabb3::aabb3(vec3 min, vec3 max)
+	{
+		min_[0] = min.x;
+		min_[1] = min.y;
+		min_[2] = min.z;
+		min_[3] = -std::numeric_limits<float>::infinity();
+		max_[0] = max.x;
+		max_[1] = max.y;
+		max_[2] = max.z;
+		max_[3] = std::numeric_limits<float>::infinity();
+	}
+
+	aabb3::aabb3(bounds value)
+	{
+		float x0 = value.x();
+		float x1 = value.x() + value.width();
+		float y0 = value.y();
+		float y1 = value.y() + value.height();
+		float z0 = value.z();
+		float z1 = value.z() + value.depth();
+
+		min_[0] = std::min(x0, x1);
+		min_[1] = std::min(y0, y1);
+		min_[2] = std::min(z0, z1);
+		min_[3] = -std::numeric_limits<float>::infinity();
+		max_[0] = std::max(x0, x1);
+		max_[1] = std::max(y0, y1);
+		max_[2] = std::max(z0, z1);
+		max_[3] = std::numeric_limits<float>::infinity();
+	}
+
+	vec3 aabb3::min() const
+	{
+		return vec3(min_[0], min_[1], min_[2]);
+	}
+
+	void aabb3::min(vec3 value)
+	{
+		min_[0] = value.x;
+		min_[1] = value.y;
+		min_[2] = value.z;
+	}
+
+	vec3 aabb3::max() const
+	{
+		return vec3(max_[0], max_[1], max_[2]);
+	}
+
+	void aabb3::max(vec3 value)
+	{
+		max_[0] = value.x;
+		max_[1] = value.y;
+		max_[2] = value.z;
+	}
+
+	vec3 aabb3::center() const
+	{
+		return vec3((min_[0] + max_[0]) * 0.5f, (min_[1] + max_[1]) * 0.5f, (min_[2] + max_[2]) * 0.5f);
+	}
+
+	vec3 aabb3::size() const
+	{
+		if (empty())
+		{
+			return vec3(0.0f, 0.0f, 0.0f);
+		}
+
+		return vec3(max_[0] - min_[0], max_[1] - min_[1], max_[2] - min_[2]);
+	}
+
+	bool aabb3::empty() const
+	{
+		// the lanes are compared into masks and only then combined, so the test compiles to one packed comparison
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = max_[i] < min_[i] ? -1 : 0;
+		}
+
+		return (mask[0] | mask[1] | mask[2] | mask[3]) != 0;
+	}
+
+	float aabb3::surfaceArea() const
+	{
+		if (empty())
+		{
+			return 0.0f;
+		}
+
+		float w = max_[0] - min_[0];
+		float h = max_[1] - min_[1];
+		float d = max_[2] - min_[2];
+
+		return 2.0f * (w * h + w * d + h * d);
+	}
+
+	float aabb3::volume() const
+	{
+		if (empty())
+		{
+			return 0.0f;
+		}
+
+		return (max_[0] - min_[0]) * (max_[1] - min_[1]) * (max_[2] - min_[2]);
+	}
+
+	bool aabb3::approximately(const aabb3& value1, const aabb3& value2)
+	{
+		return
+			Mathematics::approximately(value1.min_[0], value2.min_[0]) &&
+			Mathematics::approximately(value1.min_[1], value2.min_[1]) &&
+			Mathematics::approximately(value1.min_[2], value2.min_[2]) &&
+			Mathematics::approximately(value1.max_[0], value2.max_[0]) &&
+			Mathematics::approximately(value1.max_[1], value2.max_[1]) &&
+			Mathematics::approximately(value1.max_[2], value2.max_[2]);
+	}
+
+	bool aabb3::inside(const aabb3& value, vec3 point)
+	{
+		return value.inside(point);
+	}
+
+	bool aabb3::inside(vec3 point) const
+	{
+		float p[4] = { point.x, point.y, point.z, 0.0f };
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (p[i] >= min_[i] ? -1 : 0) & (p[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool aabb3::inside(const aabb3& value1, const aabb3& value2)
+	{
+		return value1.inside(value2);
+	}
+
+	bool aabb3::inside(const aabb3& value) const
+	{
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (value.min_[i] >= min_[i] ? -1 : 0) & (value.max_[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool aabb3::intersects(const aabb3& value1, const aabb3& value2)
+	{
+		return value1.intersects(value2);
+	}
+
+	bool aabb3::intersects(const aabb3& other) const
+	{
+		// the boxes overlap where the larger minimum is below the smaller maximum on every axis
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = std::max(min_[i], other.min_[i]) < std::min(max_[i], other.max_[i]) ? -1 : 0;
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	aabb3 aabb3::intersection(const aabb3& value1, const aabb3& value2)
+	{
+		aabb3 result;
+
+		for (int i = 0; i < 4; i++)
+		{
+			result.min_[i] = std::max(value1.min_[i], value2.min_[i]);
+			result.max_[i] = std::min(value1.max_[i], value2.max_[i]);
+		}
+
+		return result;
+	}
+
+	aabb3 aabb3::merge(const aabb3& value1, const aabb3& value2)
+	{
+		aabb3 result = value1;
+		result.merge(value2);
+		return result;
+	}
+
+	void aabb3::merge(const aabb3& value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			min_[i] = std::min(min_[i], value.min_[i]);
+			max_[i] = std::max(max_[i], value.max_[i]);
+		}
+	}
+
+	aabb3 aabb3::merge(const aabb3& value, vec3 point)
+	{
+		aabb3 result = value;
+		result.merge(point);
+		return result;
+	}
+
+	void aabb3::merge(vec3 point)
+	{
+		float p[4] = { point.x, point.y, point.z, 0.0f };
+
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] = std::min(min_[i], p[i]);
+			max_[i] = std::max(max_[i], p[i]);
+		}
+	}
+
+	aabb3 aabb3::expand(const aabb3& value, float amount)
+	{
+		aabb3 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void aabb3::expand(float amount)
+	{
+		// the unused lane is left alone, it is already unbounded
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] -= amount;
+			max_[i] += amount;
+		}
+	}
+
+	aabb3 aabb3::expand(const aabb3& value, vec3 amount)
+	{
+		aabb3 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void aabb3::expand(vec3 amount)
+	{
+		float a[3] = { amount.x, amount.y, amount.z };
+
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] -= a[i];
+			max_[i] += a[i];
+		}
+	}
+
+	bool aabb3::operator==(const aabb3& other) const
+	{
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (min_[i] == other.min_[i] ? -1 : 0) & (max_[i] == other.max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool aabb3::operator!=(const aabb3& other) const
+	{
+		return !((*this) == other);
+	}
+
+	aabb3::operator bounds() const
+	{
+		if (empty())
+		{
+			return bounds(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		return bounds(min_[0], min_[1], min_[2], max_[0] - min_[0], max_[1] - min_[1], max_[2] - min_[2]);
+	}
+}
\ No newline at end of file
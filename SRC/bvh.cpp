@@ -0,0 +1,924 @@
+#include "../INC/Aurora/Mathematics/bvh.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/ray.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of primitives handed to a thread at a time, nodes at least twice this size are measured and binned in parallel
+		constexpr size_t bvhGrain = 16384;
+
+		// number of nodes handed to a thread at a time when refitting leaves
+		constexpr size_t bvhNodeGrain = 8192;
+
+		// subtrees of at most this many primitives are built independently and in parallel once the nodes above them are built
+		constexpr uint32_t bvhSubtreeSize = 16384;
+
+		// number of bins the centroids are sorted into along each axis to evaluate the surface area heuristic
+		constexpr int bvhBins = 16;
+
+		// nodes with more primitives than this are always split
+		constexpr uint32_t bvhMaxLeafSize = 8;
+
+		// cost of visiting a node relative to testing a primitive
+		constexpr float bvhTraversalCost = 1.0f;
+
+		// nodes this deep become leaves, which bounds the size of the traversal stack
+		constexpr int bvhMaxDepth = 64;
+
+		// selects by value so merges compile to minss and maxss rather than branches on which reference to load
+		inline float bvhMin(float value1, float value2)
+		{
+			return value1 < value2 ? value1 : value2;
+		}
+
+		inline float bvhMax(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// merges corners padded to four lanes, written out lane by lane with every input read first, as the compiler vectorizes straight line code more readily than short loops and cannot otherwise rule out the corners overlapping
+		inline void bvhMerge(float* min, float* max, const float* otherMin, const float* otherMax)
+		{
+			float lower[4] = { otherMin[0], otherMin[1], otherMin[2], otherMin[3] };
+			float upper[4] = { otherMax[0], otherMax[1], otherMax[2], otherMax[3] };
+
+			min[0] = bvhMin(min[0], lower[0]);
+			min[1] = bvhMin(min[1], lower[1]);
+			min[2] = bvhMin(min[2], lower[2]);
+			min[3] = bvhMin(min[3], lower[3]);
+			max[0] = bvhMax(max[0], upper[0]);
+			max[1] = bvhMax(max[1], upper[1]);
+			max[2] = bvhMax(max[2], upper[2]);
+			max[3] = bvhMax(max[3], upper[3]);
+		}
+
+		inline float bvhHalfArea(const float* min, const float* max)
+		{
+			float x = bvhMax(max[0] - min[0], 0.0f);
+			float y = bvhMax(max[1] - min[1], 0.0f);
+			float z = bvhMax(max[2] - min[2], 0.0f);
+
+			return x * y + y * z + z * x;
+		}
+
+		// the comparisons are evaluated for every axis and then combined so they compile to packed comparisons
+		inline bool bvhOverlaps(const float* min, const float* max, const float* queryMin, const float* queryMax)
+		{
+			int mask0 = min[0] < queryMax[0] ? -1 : 0;
+			int mask1 = min[1] < queryMax[1] ? -1 : 0;
+			int mask2 = min[2] < queryMax[2] ? -1 : 0;
+			int mask3 = queryMin[0] < max[0] ? -1 : 0;
+			int mask4 = queryMin[1] < max[1] ? -1 : 0;
+			int mask5 = queryMin[2] < max[2] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3 & mask4 & mask5) != 0;
+		}
+
+		inline bool bvhContains(const float* min, const float* max, const float* point)
+		{
+			int mask0 = min[0] <= point[0] ? -1 : 0;
+			int mask1 = min[1] <= point[1] ? -1 : 0;
+			int mask2 = min[2] <= point[2] ? -1 : 0;
+			int mask3 = point[0] <= max[0] ? -1 : 0;
+			int mask4 = point[1] <= max[1] ? -1 : 0;
+			int mask5 = point[2] <= max[2] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3 & mask4 & mask5) != 0;
+		}
+
+		// returns the distance the ray enters the box at, or -1 if it misses the box within the maximum distance
+		inline float bvhSlab(const float* min, const float* max, const float* origin, const float* inverse, float maxDistance)
+		{
+			float near = 0.0f;
+			float far = maxDistance;
+
+			for (int i = 0; i < 3; i++)
+			{
+				float t0 = (min[i] - origin[i]) * inverse[i];
+				float t1 = (max[i] - origin[i]) * inverse[i];
+				float low = t0 < t1 ? t0 : t1;
+				float high = t0 < t1 ? t1 : t0;
+
+				near = low > near ? low : near;
+				far = high < far ? high : far;
+			}
+
+			// ordering each pair of distances would turn an empty box inside out, so empty boxes are rejected separately
+			bool valid = (min[0] <= max[0]) & (min[1] <= max[1]) & (min[2] <= max[2]);
+			return near <= far && valid ? near : -1.0f;
+		}
+
+		// walks the nodes depth first, descending into every node passing the test and invoking the leaf function on every leaf reached
+		template <typename Node, typename Test, typename Leaf>
+		void bvhTraverse(const std::vector<Node>& nodes, const Test& test, const Leaf& leaf)
+		{
+			if (nodes.empty() || !test(nodes[0]))
+			{
+				return;
+			}
+
+			uint32_t stack[bvhMaxDepth];
+			int top = 0;
+			uint32_t current = 0;
+
+			while (true)
+			{
+				const Node& value = nodes[current];
+
+				if (value.count == 0)
+				{
+					bool left = test(nodes[value.index]);
+					bool right = test(nodes[value.index + 1]);
+
+					if (left || right)
+					{
+						if (left && right)
+						{
+							stack[top++] = value.index + 1;
+						}
+
+						current = left ? value.index : value.index + 1;
+						continue;
+					}
+				}
+				else
+				{
+					leaf(value);
+				}
+
+				if (top == 0)
+				{
+					return;
+				}
+
+				current = stack[--top];
+			}
+		}
+	}
+
+	struct bvh::builder
+	{
+		// the corners of boxes while building are padded to four lanes so their merges compile to packed minimum and maximum operations, the fourth lane is never read
+
+		// the bounds of the boxes and of the centroids of a set of primitives
+		struct alignas(16) range
+		{
+			float min[4];
+			float max[4];
+			float centerMin[4];
+			float centerMax[4];
+		};
+
+		// the bins only track the bounds of the boxes, the centroid bounds of the children are measured after partitioning
+		struct alignas(16) bin
+		{
+			float min[4];
+			float max[4];
+			uint32_t count;
+		};
+
+		using bins = std::array<bin, 3 * bvhBins>;
+
+		// a subtree left to be built once the nodes above it are
+		struct task
+		{
+			uint32_t node;
+			uint32_t first;
+			uint32_t count;
+			int depth;
+			range extent;
+		};
+
+		// the primitives are partitioned by value rather than through an index array, so every pass over a node reads memory in order
+		struct alignas(16) item
+		{
+			float min[4];
+			float max[4];
+			float center[3];
+			uint32_t index;
+		};
+
+		std::vector<item> items;
+		std::vector<task> tasks;
+		bool deferring = false;
+
+		static range empty()
+		{
+			range result;
+
+			for (int i = 0; i < 4; i++)
+			{
+				result.min[i] = std::numeric_limits<float>::infinity();
+				result.max[i] = -std::numeric_limits<float>::infinity();
+				result.centerMin[i] = std::numeric_limits<float>::infinity();
+				result.centerMax[i] = -std::numeric_limits<float>::infinity();
+			}
+
+			return result;
+		}
+
+		static void merge(range& value, const range& other)
+		{
+			bvhMerge(value.min, value.max, other.min, other.max);
+			bvhMerge(value.centerMin, value.centerMax, other.centerMin, other.centerMax);
+		}
+
+		static void merge(range& value, const item& other)
+		{
+			bvhMerge(value.min, value.max, other.min, other.max);
+
+			for (int i = 0; i < 3; i++)
+			{
+				value.centerMin[i] = bvhMin(value.centerMin[i], other.center[i]);
+				value.centerMax[i] = bvhMax(value.centerMax[i], other.center[i]);
+			}
+		}
+
+		static void clear(bin& value)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				value.min[i] = std::numeric_limits<float>::infinity();
+				value.max[i] = -std::numeric_limits<float>::infinity();
+			}
+
+			value.count = 0;
+		}
+
+		static void merge(bin& value, const float* min, const float* max, uint32_t count)
+		{
+			bvhMerge(value.min, value.max, min, max);
+			value.count += count;
+		}
+
+		static int binIndex(float value, float min, float scale, int binCount)
+		{
+			int result = (int)((value - min) * scale);
+			return std::clamp(result, 0, binCount - 1);
+		}
+
+		range measure(uint32_t first, uint32_t count) const
+		{
+			range result = empty();
+
+			if (count < 2 * bvhGrain)
+			{
+				for (uint32_t i = first; i < first + count; i++)
+				{
+					merge(result, items[i]);
+				}
+
+				return result;
+			}
+
+			std::vector<range> partial((count + bvhGrain - 1) / bvhGrain, empty());
+
+			parallelFor(count, bvhGrain, [&](size_t begin, size_t end)
+				{
+					range& local = partial[begin / bvhGrain];
+
+					for (size_t i = first + begin; i < first + end; i++)
+					{
+						merge(local, items[i]);
+					}
+				});
+
+			for (const range& value : partial)
+			{
+				merge(result, value);
+			}
+
+			return result;
+		}
+
+		void sort(uint32_t first, uint32_t count, const range& extent, const float* scale, int binCount, bins& result) const
+		{
+			auto fill = [&](size_t begin, size_t end, bins& local)
+				{
+					for (int axis = 0; axis < 3; axis++)
+					{
+						for (int i = 0; i < binCount; i++)
+						{
+							clear(local[axis * bvhBins + i]);
+						}
+					}
+
+					float centerMin[3] = { extent.centerMin[0], extent.centerMin[1], extent.centerMin[2] };
+					float axisScale[3] = { scale[0], scale[1], scale[2] };
+					int binsUsed = binCount;
+
+					for (size_t i = first + begin; i < first + end; i++)
+					{
+						const item& value = items[i];
+
+						for (int axis = 0; axis < 3; axis++)
+						{
+							merge(local[axis * bvhBins + binIndex(value.center[axis], centerMin[axis], axisScale[axis], binsUsed)], value.min, value.max, 1);
+						}
+					}
+				};
+
+			if (count < 2 * bvhGrain)
+			{
+				fill(0, count, result);
+				return;
+			}
+
+			std::vector<bins> partial((count + bvhGrain - 1) / bvhGrain);
+
+			parallelFor(count, bvhGrain, [&](size_t begin, size_t end)
+				{
+					fill(begin, end, partial[begin / bvhGrain]);
+				});
+
+			for (size_t i = 0; i < result.size(); i++)
+			{
+				clear(result[i]);
+
+				for (const bins& local : partial)
+				{
+					merge(result[i], local[i].min, local[i].max, local[i].count);
+				}
+			}
+		}
+
+		static void leaf(std::vector<node>& nodes, uint32_t index, uint32_t first, uint32_t count)
+		{
+			nodes[index].index = first;
+			nodes[index].count = count;
+		}
+
+		void build(std::vector<node>& nodes, uint32_t index, uint32_t first, uint32_t count, const range& extent, int depth)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				nodes[index].min[i] = extent.min[i];
+				nodes[index].max[i] = extent.max[i];
+			}
+
+			if (deferring && count <= bvhSubtreeSize)
+			{
+				tasks.push_back({ index, first, count, depth, extent });
+				return;
+			}
+
+			if (count == 1 || depth >= bvhMaxDepth)
+			{
+				leaf(nodes, index, first, count);
+				return;
+			}
+
+			// small nodes use fewer bins, as there are too few centroids to fill them and sweeping empty bins dominates their cost
+			int binCount = (int)std::min<uint32_t>(count, bvhBins);
+			float scale[3];
+			bool splittable = false;
+
+			for (int i = 0; i < 3; i++)
+			{
+				// an axis too thin for its scale to be finite is treated as if every centroid were at the same point along it
+				float size = extent.centerMax[i] - extent.centerMin[i];
+				scale[i] = size > 0.0f ? binCount / size : 0.0f;
+				scale[i] = scale[i] < std::numeric_limits<float>::infinity() ? scale[i] : 0.0f;
+				splittable |= scale[i] > 0.0f;
+			}
+
+			uint32_t leftCount;
+			range left = empty();
+			range right = empty();
+
+			if (splittable)
+			{
+				bins sorted;
+				sort(first, count, extent, scale, binCount, sorted);
+
+				int bestAxis = -1;
+				int bestSplit = 0;
+				float bestCost = std::numeric_limits<float>::infinity();
+
+				for (int axis = 0; axis < 3; axis++)
+				{
+					if (scale[axis] == 0.0f)
+					{
+						continue;
+					}
+
+					const bin* axisBins = sorted.data() + axis * bvhBins;
+					float leftArea[bvhBins - 1];
+					uint32_t leftCounts[bvhBins - 1];
+					bin accumulated;
+					clear(accumulated);
+
+					for (int i = 0; i < binCount - 1; i++)
+					{
+						merge(accumulated, axisBins[i].min, axisBins[i].max, axisBins[i].count);
+						leftArea[i] = bvhHalfArea(accumulated.min, accumulated.max);
+						leftCounts[i] = accumulated.count;
+					}
+
+					clear(accumulated);
+
+					for (int i = binCount - 1; i > 0; i--)
+					{
+						merge(accumulated, axisBins[i].min, axisBins[i].max, axisBins[i].count);
+
+						if (leftCounts[i - 1] == 0 || accumulated.count == 0)
+						{
+							continue;
+						}
+
+						float cost = leftCounts[i - 1] * leftArea[i - 1] + accumulated.count * bvhHalfArea(accumulated.min, accumulated.max);
+
+						if (cost < bestCost)
+						{
+							bestAxis = axis;
+							bestSplit = i;
+							bestCost = cost;
+						}
+					}
+				}
+
+				// a split is only worth its extra node if visiting it is cheaper than testing every primitive
+				float area = bvhHalfArea(extent.min, extent.max);
+
+				if (count <= bvhMaxLeafSize && bestCost >= (count - bvhTraversalCost) * area)
+				{
+					leaf(nodes, index, first, count);
+					return;
+				}
+
+				float axisMin = extent.centerMin[bestAxis];
+				float axisScale = scale[bestAxis];
+
+				// the children are measured while partitioning, as every primitive passes through the loop exactly once
+				uint32_t begin = first;
+				uint32_t end = first + count;
+
+				while (begin < end)
+				{
+					if (binIndex(items[begin].center[bestAxis], axisMin, axisScale, binCount) < bestSplit)
+					{
+						merge(left, items[begin]);
+						begin++;
+					}
+					else
+					{
+						end--;
+						std::swap(items[begin], items[end]);
+						merge(right, items[end]);
+					}
+				}
+
+				leftCount = begin - first;
+			}
+			else
+			{
+				// every centroid is at the same point, so the primitives cannot be separated and are only split to bound the size of the leaves
+				if (count <= bvhMaxLeafSize)
+				{
+					leaf(nodes, index, first, count);
+					return;
+				}
+
+				leftCount = count / 2;
+				left = measure(first, leftCount);
+				right = measure(first + leftCount, count - leftCount);
+			}
+
+			uint32_t children = (uint32_t)nodes.size();
+			nodes.resize(nodes.size() + 2);
+			nodes[index].index = children;
+			nodes[index].count = 0;
+
+			build(nodes, children, first, leftCount, left, depth + 1);
+			build(nodes, children + 1, first + leftCount, count - leftCount, right, depth + 1);
+		}
+	};
+
+	bvh::bvh() { }
+
+	bvh::bvh(std::span<const bounds> primitives)
+	{
+		build(primitives);
+	}
+
+	bvh::bvh(std::span<const aabb3> primitives)
+	{
+		build(primitives);
+	}
+
+	void bvh::build(std::span<const bounds> primitives)
+	{
+		std::vector<aabb3> boxes(primitives.size());
+
+		parallelFor(primitives.size(), bvhGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					boxes[i] = aabb3(primitives[i]);
+				}
+			});
+
+		build(boxes);
+	}
+
+	void bvh::build(std::span<const aabb3> primitives)
+	{
+		if (primitives.size() > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::invalid_argument("The primitives (" + std::to_string(primitives.size()) + ") are more than the maximum (" + std::to_string(std::numeric_limits<uint32_t>::max()) + ").");
+		}
+
+		uint32_t count = (uint32_t)primitives.size();
+
+		nodes_.clear();
+		primitives_.clear();
+		indices_.clear();
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		builder context;
+		context.items.resize(count);
+
+		parallelFor(count, bvhGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					vec3 min = primitives[i].min();
+					vec3 max = primitives[i].max();
+
+					// empty boxes are placed at the origin so they do not spread the centroid bounds to infinity
+					bool empty = primitives[i].empty();
+
+					context.items[i] = {
+						{ min.x, min.y, min.z, 0.0f },
+						{ max.x, max.y, max.z, 0.0f },
+						{ empty ? 0.0f : (min.x + max.x) * 0.5f, empty ? 0.0f : (min.y + max.y) * 0.5f, empty ? 0.0f : (min.z + max.z) * 0.5f },
+						(uint32_t)i
+					};
+				}
+			});
+
+		// a binary tree with at most one primitive per leaf has fewer than twice as many nodes as primitives
+		nodes_.reserve(2 * (size_t)count);
+		nodes_.resize(1);
+
+		context.deferring = count > bvhSubtreeSize;
+		context.build(nodes_, 0, 0, count, context.measure(0, count), 0);
+		context.deferring = false;
+
+		// subtrees are built into separate arrays, then spliced in the order they were deferred so the layout does not depend on the number of threads
+		std::vector<std::vector<node>> subtrees(context.tasks.size());
+
+		parallelFor(context.tasks.size(), 1, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const builder::task& task = context.tasks[i];
+
+					subtrees[i].reserve(2 * (size_t)task.count);
+					subtrees[i].resize(1);
+					context.build(subtrees[i], 0, task.first, task.count, task.extent, task.depth);
+				}
+			});
+
+		for (size_t i = 0; i < subtrees.size(); i++)
+		{
+			const std::vector<node>& subtree = subtrees[i];
+
+			// the root of the subtree replaces the deferred node, and the rest are appended with their child indices moved along
+			uint32_t offset = (uint32_t)nodes_.size() - 1;
+
+			for (size_t j = 0; j < subtree.size(); j++)
+			{
+				node value = subtree[j];
+
+				if (value.count == 0)
+				{
+					value.index += offset;
+				}
+
+				if (j == 0)
+				{
+					nodes_[context.tasks[i].node] = value;
+				}
+				else
+				{
+					nodes_.push_back(value);
+				}
+			}
+		}
+
+		primitives_.resize(count);
+		indices_.resize(count);
+
+		parallelFor(count, bvhGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const builder::item& value = context.items[i];
+
+					primitives_[i] = { { value.min[0], value.min[1], value.min[2] }, { value.max[0], value.max[1], value.max[2] } };
+					indices_[i] = value.index;
+				}
+			});
+	}
+
+	void bvh::refit(std::span<const bounds> primitives)
+	{
+		if (primitives.size() != indices_.size())
+		{
+			throw std::invalid_argument("The primitives (" + std::to_string(primitives.size()) + ") do not match the number the hierarchy was built with (" + std::to_string(indices_.size()) + ").");
+		}
+
+		parallelFor(indices_.size(), bvhGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					aabb3 box(primitives[indices_[i]]);
+					vec3 min = box.min();
+					vec3 max = box.max();
+
+					primitives_[i] = { { min.x, min.y, min.z }, { max.x, max.y, max.z } };
+				}
+			});
+
+		refit();
+	}
+
+	void bvh::refit(std::span<const aabb3> primitives)
+	{
+		if (primitives.size() != indices_.size())
+		{
+			throw std::invalid_argument("The primitives (" + std::to_string(primitives.size()) + ") do not match the number the hierarchy was built with (" + std::to_string(indices_.size()) + ").");
+		}
+
+		parallelFor(indices_.size(), bvhGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					vec3 min = primitives[indices_[i]].min();
+					vec3 max = primitives[indices_[i]].max();
+
+					primitives_[i] = { { min.x, min.y, min.z }, { max.x, max.y, max.z } };
+				}
+			});
+
+		refit();
+	}
+
+	void bvh::refit()
+	{
+		parallelFor(nodes_.size(), bvhNodeGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					node& value = nodes_[i];
+
+					if (value.count == 0)
+					{
+						continue;
+					}
+
+					for (int j = 0; j < 3; j++)
+					{
+						value.min[j] = std::numeric_limits<float>::infinity();
+						value.max[j] = -std::numeric_limits<float>::infinity();
+					}
+
+					for (uint32_t k = value.index; k < value.index + value.count; k++)
+					{
+						for (int j = 0; j < 3; j++)
+						{
+							value.min[j] = bvhMin(value.min[j], primitives_[k].min[j]);
+							value.max[j] = bvhMax(value.max[j], primitives_[k].max[j]);
+						}
+					}
+				}
+			});
+
+		// children are always stored after their parent, so walking backwards updates every child before its parent
+		for (size_t i = nodes_.size(); i-- > 0;)
+		{
+			node& value = nodes_[i];
+
+			if (value.count != 0)
+			{
+				continue;
+			}
+
+			const node& left = nodes_[value.index];
+			const node& right = nodes_[value.index + 1];
+
+			for (int j = 0; j < 3; j++)
+			{
+				value.min[j] = bvhMin(left.min[j], right.min[j]);
+				value.max[j] = bvhMax(left.max[j], right.max[j]);
+			}
+		}
+	}
+
+	size_t bvh::size() const
+	{
+		return indices_.size();
+	}
+
+	size_t bvh::nodeCount() const
+	{
+		return nodes_.size();
+	}
+
+	aabb3 bvh::box() const
+	{
+		if (nodes_.empty())
+		{
+			return aabb3();
+		}
+
+		const node& root = nodes_[0];
+		return aabb3(vec3(root.min[0], root.min[1], root.min[2]), vec3(root.max[0], root.max[1], root.max[2]));
+	}
+
+	void bvh::overlapping(const aabb3& value, std::vector<size_t>& results) const
+	{
+		vec3 min = value.min();
+		vec3 max = value.max();
+		float queryMin[3] = { min.x, min.y, min.z };
+		float queryMax[3] = { max.x, max.y, max.z };
+
+		bvhTraverse(nodes_,
+			[&](const node& current)
+			{
+				return bvhOverlaps(current.min, current.max, queryMin, queryMax);
+			},
+			[&](const node& current)
+			{
+				for (uint32_t i = current.index; i < current.index + current.count; i++)
+				{
+					if (bvhOverlaps(primitives_[i].min, primitives_[i].max, queryMin, queryMax))
+					{
+						results.push_back(indices_[i]);
+					}
+				}
+			});
+	}
+
+	void bvh::containing(vec3 point, std::vector<size_t>& results) const
+	{
+		float query[3] = { point.x, point.y, point.z };
+
+		bvhTraverse(nodes_,
+			[&](const node& current)
+			{
+				return bvhContains(current.min, current.max, query);
+			},
+			[&](const node& current)
+			{
+				for (uint32_t i = current.index; i < current.index + current.count; i++)
+				{
+					if (bvhContains(primitives_[i].min, primitives_[i].max, query))
+					{
+						results.push_back(indices_[i]);
+					}
+				}
+			});
+	}
+
+	void bvh::intersecting(vec3 origin, vec3 direction, float maxDistance, std::vector<size_t>& results) const
+	{
+		intersecting(ray(origin, direction), maxDistance, results);
+	}
+
+	void bvh::intersecting(const ray& value, float maxDistance, std::vector<size_t>& results) const
+	{
+		vec3 origin = value.origin();
+		vec3 inverseDirection = value.inverseDirection();
+		float start[3] = { origin.x, origin.y, origin.z };
+		float inverse[3] = { inverseDirection.x, inverseDirection.y, inverseDirection.z };
+
+		bvhTraverse(nodes_,
+			[&](const node& current)
+			{
+				return bvhSlab(current.min, current.max, start, inverse, maxDistance) >= 0.0f;
+			},
+			[&](const node& current)
+			{
+				for (uint32_t i = current.index; i < current.index + current.count; i++)
+				{
+					if (bvhSlab(primitives_[i].min, primitives_[i].max, start, inverse, maxDistance) >= 0.0f)
+					{
+						results.push_back(indices_[i]);
+					}
+				}
+			});
+	}
+
+	bool bvh::raycast(vec3 origin, vec3 direction, float maxDistance, const std::function<float(size_t index, float distance)>& intersect, size_t& index, float& distance) const
+	{
+		return raycast(ray(origin, direction), maxDistance, intersect, index, distance);
+	}
+
+	bool bvh::raycast(const ray& value, float maxDistance, const std::function<float(size_t index, float distance)>& intersect, size_t& index, float& distance) const
+	{
+		vec3 origin = value.origin();
+		vec3 inverseDirection = value.inverseDirection();
+		float start[3] = { origin.x, origin.y, origin.z };
+		float inverse[3] = { inverseDirection.x, inverseDirection.y, inverseDirection.z };
+
+		if (nodes_.empty() || bvhSlab(nodes_[0].min, nodes_[0].max, start, inverse, maxDistance) < 0.0f)
+		{
+			return false;
+		}
+
+		// pending nodes are kept with the distance the ray enters them at, so they can be skipped once a closer hit is found
+		uint32_t stack[bvhMaxDepth];
+		float entries[bvhMaxDepth];
+		int top = 0;
+		uint32_t current = 0;
+		float closest = maxDistance;
+		bool hit = false;
+
+		while (true)
+		{
+			const node& value = nodes_[current];
+
+			if (value.count == 0)
+			{
+				const node& left = nodes_[value.index];
+				const node& right = nodes_[value.index + 1];
+				float leftEntry = bvhSlab(left.min, left.max, start, inverse, closest);
+				float rightEntry = bvhSlab(right.min, right.max, start, inverse, closest);
+
+				if (leftEntry >= 0.0f && rightEntry >= 0.0f)
+				{
+					bool leftFirst = leftEntry <= rightEntry;
+
+					stack[top] = leftFirst ? value.index + 1 : value.index;
+					entries[top] = leftFirst ? rightEntry : leftEntry;
+					top++;
+
+					current = leftFirst ? value.index : value.index + 1;
+					continue;
+				}
+
+				if (leftEntry >= 0.0f || rightEntry >= 0.0f)
+				{
+					current = leftEntry >= 0.0f ? value.index : value.index + 1;
+					continue;
+				}
+			}
+			else
+			{
+				for (uint32_t i = value.index; i < value.index + value.count; i++)
+				{
+					if (bvhSlab(primitives_[i].min, primitives_[i].max, start, inverse, closest) < 0.0f)
+					{
+						continue;
+					}
+
+					float result = intersect(indices_[i], closest);
+
+					if (result >= 0.0f && (hit ? result < closest : result <= closest))
+					{
+						closest = result;
+						index = indices_[i];
+						hit = true;
+					}
+				}
+			}
+
+			// pops until a node the ray enters before the closest hit is found
+			while (top > 0 && entries[top - 1] > closest)
+			{
+				top--;
+			}
+
+			if (top == 0)
+			{
+				break;
+			}
+
+			current = stack[--top];
+		}
+
+		if (hit)
+		{
+			distance = closest;
+		}
+
+		return hit;
+	}
+}
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include "../INC/Aurora/Mathematics/vec4.h"
 #include "../INC/Aurora/Mathematics/col32.h"
 #include "../INC/Aurora/Mathematics/hsv.h"
+#include "../INC/Aurora/Mathematics/xyz.h"
+#include "../INC/Aurora/Mathematics/oklab.h"
+#include "../INC/Aurora/Mathematics/oklch.h"
 #include "../INC/Aurora/Mathematics/Quality.h"
 #include <stdexcept>
 #include <string>
@@ -375,4 +378,23 @@ namespace Aurora::Mathematics
 
 		return hsv(wrapAngleUnsigned(h), clamp01(s) * 100.0f, v * 100.0f, a * 100.0f);
 	}
+
+	col::operator xyz() const
+	{
+		xyz result;
+		convert(std::span<const col>(this, 1), std::span<xyz>(&result, 1));
+		return result;
+	}
+
+	col::operator oklab() const
+	{
+		oklab result;
+		convert(std::span<const col>(this, 1), std::span<oklab>(&result, 1));
+		return result;
+	}
+
+	col::operator oklch() const
+	{
+		return (oklch)(oklab)(*this);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,571 @@
+#include "../INC/Aurora/Mathematics/compressedtrack.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/quat.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of tracks sampled by a thread at a time
+		constexpr size_t compressedtrackGrain = 1024;
+
+		// every component but the largest of a unit rotation is within this of 0
+		constexpr float compressedtrackSmallest = 0.70710678f;
+
+		template <typename T>
+		void compressedtrackValidate(std::span<const float> times, std::span<const T> values, Interpolation interpolation)
+		{
+			if (values.size() < times.size())
+			{
+				throw std::invalid_argument("The values (" + std::to_string(values.size()) + ") are fewer than required (" + std::to_string(times.size()) + ").");
+			}
+
+			if (interpolation == Interpolation::Hermite)
+			{
+				throw std::invalid_argument("The interpolation of a compressed track cannot be Hermite, whose tangents are not kept.");
+			}
+
+			for (size_t i = 1; i < times.size(); i++)
+			{
+				if (!(times[i] >= times[i - 1]))
+				{
+					throw std::invalid_argument("The time of the key (" + std::to_string(i) + ") is before the time of the key before it.");
+				}
+			}
+		}
+
+		// the largest component is made positive, which gives the same rotation, so only its index is stored, in the top bits of the first two words
+		void compressedtrackEncodeRotation(const float* value, uint16_t* result)
+		{
+			float length = std::sqrt(value[0] * value[0] + value[1] * value[1] + value[2] * value[2] + value[3] * value[3]);
+			float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+			size_t largest = 3;
+
+			for (size_t c = 0; c < 3; c++)
+			{
+				if (std::fabs(value[c]) > std::fabs(value[largest]))
+				{
+					largest = c;
+				}
+			}
+
+			float sign = value[largest] < 0.0f ? -inverse : inverse;
+
+			for (size_t c = 0, w = 0; c < 4; c++)
+			{
+				if (c == largest)
+				{
+					continue;
+				}
+
+				float fraction = value[c] * sign / compressedtrackSmallest * 0.5f + 0.5f;
+				result[w++] = static_cast<uint16_t>(std::clamp(std::lround(fraction * 32767.0f), 0L, 32767L));
+			}
+
+			result[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+			result[1] |= static_cast<uint16_t>((largest & 1) << 15);
+		}
+
+		// number of tracks sampled together by the batch sampler, one per lane
+		constexpr size_t compressedtrackLanes = 8;
+
+		// a rotation is decoded like a vec3 whose three components all range over [-compressedtrackSmallest, compressedtrackSmallest] in 15 bits
+		constexpr float compressedtrackRotationStep = 2.0f * compressedtrackSmallest / 32767.0f;
+
+		// the keys read by a sample of each lane, before the segment, at its start, at its end and after it, as stored, with how to decode them
+		template <size_t Lanes>
+		struct compressedtrackTile
+		{
+			float times[4][Lanes];
+			int32_t words[4][3][Lanes];
+			float minimum[3][Lanes];
+			float step[3][Lanes];
+			int32_t rotation[Lanes];
+			int32_t mode[Lanes];
+			float result[4][Lanes];
+		};
+
+		// decodes the four keys of every lane and interpolates between the middle two as track does, a rotation being normalized and the keys around it negated when on the other side of the key before them, since the encoding loses the sign
+		// every step is a loop over the lanes that only selects and never branches on the data, with the largest component of a rotation placed by selects since it changes from one track to the next, so each loop compiles to packed instructions
+		template <size_t Lanes>
+		void compressedtrackInterpolate(compressedtrackTile<Lanes>& tile, float time)
+		{
+			float keys[4][4][Lanes];
+
+			for (size_t k = 0; k < 4; k++)
+			{
+				for (size_t l = 0; l < Lanes; l++)
+				{
+					// a vec3 reads all 16 bits of its words and has no largest component, which places its components as the last index of a rotation does
+					int32_t rotation = tile.rotation[l];
+					int32_t mask = rotation != 0 ? 0x7FFF : 0xFFFF;
+					int32_t index = ((tile.words[k][0][l] >> 15) << 1) | (tile.words[k][1][l] >> 15);
+					int32_t largest = rotation != 0 ? index : 3;
+					float s0 = tile.minimum[0][l] + static_cast<float>(tile.words[k][0][l] & mask) * tile.step[0][l];
+					float s1 = tile.minimum[1][l] + static_cast<float>(tile.words[k][1][l] & mask) * tile.step[1][l];
+					float s2 = tile.minimum[2][l] + static_cast<float>(tile.words[k][2][l] & mask) * tile.step[2][l];
+					float remainder = std::sqrt(std::max(1.0f - s0 * s0 - s1 * s1 - s2 * s2, 0.0f));
+					float shifted1 = largest == 0 ? s0 : s1;
+					float shifted2 = largest == 3 ? s2 : s1;
+					float w = rotation != 0 ? remainder : 0.0f;
+
+					keys[k][0][l] = largest == 0 ? remainder : s0;
+					keys[k][1][l] = largest == 1 ? remainder : shifted1;
+					keys[k][2][l] = largest == 2 ? remainder : shifted2;
+					keys[k][3][l] = largest == 3 ? w : s2;
+				}
+			}
+
+			// the key after the segment is compared with the key at its end once that is aligned, so the sign of the end is applied first
+			float signs[4][Lanes];
+
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				float dot = keys[1][0][l] * keys[2][0][l] + keys[1][1][l] * keys[2][1][l] + keys[1][2][l] * keys[2][2][l] + keys[1][3][l] * keys[2][3][l];
+				signs[2][l] = tile.rotation[l] != 0 ? std::copysign(1.0f, dot) : 1.0f;
+			}
+
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				float before = keys[1][0][l] * keys[0][0][l] + keys[1][1][l] * keys[0][1][l] + keys[1][2][l] * keys[0][2][l] + keys[1][3][l] * keys[0][3][l];
+				float after = keys[2][0][l] * keys[3][0][l] + keys[2][1][l] * keys[3][1][l] + keys[2][2][l] * keys[3][2][l] + keys[2][3][l] * keys[3][3][l];
+				signs[0][l] = tile.rotation[l] != 0 ? std::copysign(1.0f, before) : 1.0f;
+				signs[3][l] = tile.rotation[l] != 0 ? std::copysign(1.0f, after * signs[2][l]) : 1.0f;
+			}
+
+			// a linear segment is the cubic whose tangents are both the difference of its keys, and a step segment is held at its start
+			float t[Lanes];
+			float scale0[Lanes];
+			float scale1[Lanes];
+			float catmullRom[Lanes];
+
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				float duration = tile.times[2][l] - tile.times[1][l];
+				float span0 = tile.times[2][l] - tile.times[0][l];
+				float span1 = tile.times[3][l] - tile.times[1][l];
+				float fraction = std::clamp((time - tile.times[1][l]) / (duration > 0.0f ? duration : 1.0f), 0.0f, 1.0f);
+
+				float moving = duration > 0.0f ? fraction : 0.0f;
+
+				t[l] = tile.mode[l] == static_cast<int32_t>(Interpolation::Step) ? 0.0f : moving;
+				scale0[l] = span0 > 0.0f ? duration / (span0 > 0.0f ? span0 : 1.0f) : 0.0f;
+				scale1[l] = span1 > 0.0f ? duration / (span1 > 0.0f ? span1 : 1.0f) : 0.0f;
+				catmullRom[l] = tile.mode[l] == static_cast<int32_t>(Interpolation::CatmullRom) ? 1.0f : 0.0f;
+			}
+
+			for (size_t c = 0; c < 4; c++)
+			{
+				for (size_t l = 0; l < Lanes; l++)
+				{
+					float p1 = keys[1][c][l];
+					float p2 = keys[2][c][l] * signs[2][l];
+					float difference = p2 - p1;
+					float m0 = catmullRom[l] != 0.0f ? (p2 - keys[0][c][l] * signs[0][l]) * scale0[l] : difference;
+					float m1 = catmullRom[l] != 0.0f ? (keys[3][c][l] * signs[3][l] - p1) * scale1[l] : difference;
+					float c2 = 3.0f * difference - 2.0f * m0 - m1;
+					float c3 = -2.0f * difference + m0 + m1;
+
+					tile.result[c][l] = ((c3 * t[l] + c2) * t[l] + m0) * t[l] + p1;
+				}
+			}
+
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				float lengthSquared = tile.result[0][l] * tile.result[0][l] + tile.result[1][l] * tile.result[1][l] + tile.result[2][l] * tile.result[2][l] + tile.result[3][l] * tile.result[3][l];
+				float inverse = tile.rotation[l] != 0 ? 1.0f / std::sqrt(lengthSquared > 0.0f ? lengthSquared : 1.0f) : 1.0f;
+				float w = tile.result[3][l] * inverse;
+
+				// a value of 0 is the identity for a rotation, and stays 0 otherwise
+				tile.result[0][l] *= inverse;
+				tile.result[1][l] *= inverse;
+				tile.result[2][l] *= inverse;
+				tile.result[3][l] = lengthSquared > 0.0f ? w : static_cast<float>(tile.rotation[l]);
+			}
+		}
+
+		// the distance between two values of a vec3, or the angle between two unit rotations, from the length of their difference since the arc cosine of their dot product loses most of its precision near 0
+		float compressedtrackError(const float* a, const float* b, bool rotation)
+		{
+			if (rotation)
+			{
+				float sign = std::copysign(1.0f, a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+				float lengthSquared = 0.0f;
+
+				for (size_t c = 0; c < 4; c++)
+				{
+					float difference = a[c] - b[c] * sign;
+					lengthSquared += difference * difference;
+				}
+
+				return 4.0f * std::asin(std::min(std::sqrt(lengthSquared) * 0.5f, 1.0f));
+			}
+
+			float x = a[0] - b[0];
+			float y = a[1] - b[1];
+			float z = a[2] - b[2];
+			return std::sqrt(x * x + y * y + z * z);
+		}
+	}
+
+	compressedtrack::compressedtrack() : minimum_{ 0.0f, 0.0f, 0.0f }, step_{ 0.0f, 0.0f, 0.0f }, components_(3), interpolation_(Interpolation::CatmullRom), error_(0.0f) { }
+
+	compressedtrack::compressedtrack(std::span<const float> times, std::span<const vec3> values, float tolerance, Interpolation interpolation) : minimum_{ 0.0f, 0.0f, 0.0f }, step_{ 0.0f, 0.0f, 0.0f }, components_(3), interpolation_(interpolation), error_(0.0f)
+	{
+		compressedtrackValidate(times, values, interpolation);
+
+		std::vector<float> flattened(times.size() * 3);
+
+		for (size_t i = 0; i < times.size(); i++)
+		{
+			flattened[i * 3] = values[i].x;
+			flattened[i * 3 + 1] = values[i].y;
+			flattened[i * 3 + 2] = values[i].z;
+		}
+
+		compress(times, flattened.data(), tolerance);
+	}
+
+	compressedtrack::compressedtrack(std::span<const float> times, std::span<const quat> values, float tolerance, Interpolation interpolation) : minimum_{ 0.0f, 0.0f, 0.0f }, step_{ 0.0f, 0.0f, 0.0f }, components_(4), interpolation_(interpolation), error_(0.0f)
+	{
+		compressedtrackValidate(times, values, interpolation);
+
+		for (size_t c = 0; c < 3; c++)
+		{
+			minimum_[c] = -compressedtrackSmallest;
+			step_[c] = compressedtrackRotationStep;
+		}
+
+		std::vector<float> flattened(times.size() * 4);
+
+		for (size_t i = 0; i < times.size(); i++)
+		{
+			float length = std::sqrt(values[i].x * values[i].x + values[i].y * values[i].y + values[i].z * values[i].z + values[i].w * values[i].w);
+			float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+
+			flattened[i * 4] = values[i].x * inverse;
+			flattened[i * 4 + 1] = values[i].y * inverse;
+			flattened[i * 4 + 2] = values[i].z * inverse;
+			flattened[i * 4 + 3] = length > 0.0f ? values[i].w * inverse : 1.0f;
+		}
+
+		compress(times, flattened.data(), tolerance);
+	}
+
+	size_t compressedtrack::size() const
+	{
+		return keys_.size();
+	}
+
+	size_t compressedtrack::bytes() const
+	{
+		return keys_.size() * sizeof(key);
+	}
+
+	float compressedtrack::error() const
+	{
+		return error_;
+	}
+
+	size_t compressedtrack::components() const
+	{
+		return components_;
+	}
+
+	float compressedtrack::start() const
+	{
+		return keys_.empty() ? 0.0f : keys_.front().time;
+	}
+
+	float compressedtrack::end() const
+	{
+		return keys_.empty() ? 0.0f : keys_.back().time;
+	}
+
+	vec3 compressedtrack::sampleVec3(float time, size_t& cursor) const
+	{
+		if (components_ != 3)
+		{
+			throw std::invalid_argument("The track does not hold a vec3.");
+		}
+
+		float result[3];
+		evaluate(time, cursor, result);
+		return vec3(result[0], result[1], result[2]);
+	}
+
+	quat compressedtrack::sampleQuat(float time, size_t& cursor) const
+	{
+		if (components_ != 4)
+		{
+			throw std::invalid_argument("The track does not hold a rotation.");
+		}
+
+		float result[4];
+		evaluate(time, cursor, result);
+
+		quat value;
+		value.x = result[0];
+		value.y = result[1];
+		value.z = result[2];
+		value.w = result[3];
+		return value;
+	}
+
+	void compressedtrack::sample(std::span<const compressedtrack> tracks, float time, std::span<size_t> cursors, std::span<float> results)
+	{
+		if (cursors.size() < tracks.size())
+		{
+			throw std::invalid_argument("The cursors (" + std::to_string(cursors.size()) + ") are fewer than required (" + std::to_string(tracks.size()) + ").");
+		}
+
+		std::vector<size_t> offsets(tracks.size() + 1);
+
+		for (size_t i = 0; i < tracks.size(); i++)
+		{
+			offsets[i + 1] = offsets[i] + tracks[i].components_;
+		}
+
+		if (results.size() < offsets.back())
+		{
+			throw std::invalid_argument("The results (" + std::to_string(results.size()) + ") are fewer than required (" + std::to_string(offsets.back()) + ").");
+		}
+
+		parallelFor(tracks.size(), compressedtrackGrain, [&](size_t begin, size_t end)
+		{
+			// the lanes past the last track of the range keep the keys of an earlier tile, which are interpolated and ignored
+			compressedtrackTile<compressedtrackLanes> tile = {};
+
+			for (size_t first = begin; first < end; first += compressedtrackLanes)
+			{
+				size_t lanes = std::min(compressedtrackLanes, end - first);
+
+				for (size_t l = 0; l < lanes; l++)
+				{
+					tracks[first + l].gather(time, cursors[first + l], tile, l);
+				}
+
+				compressedtrackInterpolate(tile, time);
+
+				for (size_t l = 0; l < lanes; l++)
+				{
+					float* result = results.data() + offsets[first + l];
+
+					for (size_t c = 0; c < tracks[first + l].components_; c++)
+					{
+						result[c] = tile.result[c][l];
+					}
+				}
+			}
+		});
+	}
+
+	void compressedtrack::compress(std::span<const float> times, const float* values, float tolerance)
+	{
+		size_t count = times.size();
+		size_t components = components_;
+		bool rotation = components_ == 4;
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (!rotation)
+		{
+			for (size_t c = 0; c < 3; c++)
+			{
+				float low = values[c];
+				float high = values[c];
+
+				for (size_t i = 1; i < count; i++)
+				{
+					low = std::min(low, values[i * 3 + c]);
+					high = std::max(high, values[i * 3 + c]);
+				}
+
+				minimum_[c] = low;
+				step_[c] = (high - low) / 65535.0f;
+			}
+		}
+
+		// every key is quantized before any is dropped, so the error measured while choosing the keys includes the quantization
+		std::vector<key> encoded(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			encoded[i].time = times[i];
+
+			if (rotation)
+			{
+				compressedtrackEncodeRotation(values + i * 4, encoded[i].value);
+				continue;
+			}
+
+			for (size_t c = 0; c < 3; c++)
+			{
+				float fraction = step_[c] > 0.0f ? (values[i * 3 + c] - minimum_[c]) / step_[c] : 0.0f;
+				encoded[i].value[c] = static_cast<uint16_t>(std::clamp(std::lround(fraction), 0L, 65535L));
+			}
+		}
+
+		std::vector<size_t> kept = { 0 };
+
+		if (count > 1)
+		{
+			kept.push_back(count - 1);
+		}
+
+		std::vector<float> errors(count, 0.0f);
+		std::vector<uint8_t> selected(count, 0);
+
+		for (size_t i : kept)
+		{
+			selected[i] = 1;
+			keys_.push_back(encoded[i]);
+		}
+
+		// measures the keys from the kept key first up to the kept key last, which are those whose segment or neighbouring segments changed, sampled as at runtime so the tolerance holds for what is played
+		// the kept keys are measured as well, since they carry the error of their quantization
+		auto measure = [&](size_t first, size_t last)
+			{
+				size_t cursor = first;
+
+				for (size_t i = kept[first]; i <= kept[last]; i++)
+				{
+					float result[4];
+					evaluate(times[i], cursor, result);
+					errors[i] = compressedtrackError(result, values + i * components, rotation);
+				}
+			};
+
+		measure(0, kept.size() - 1);
+
+		while (true)
+		{
+			// only a key that is not kept yet can lower the error by being kept
+			size_t worst = 0;
+			float largest = -1.0f;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!selected[i] && errors[i] > largest)
+				{
+					worst = i;
+					largest = errors[i];
+				}
+			}
+
+			if (!(largest > tolerance))
+			{
+				break;
+			}
+
+			size_t position = static_cast<size_t>(std::upper_bound(kept.begin(), kept.end(), worst) - kept.begin());
+			kept.insert(kept.begin() + position, worst);
+			keys_.insert(keys_.begin() + position, encoded[worst]);
+			selected[worst] = 1;
+
+			// a new key changes the tangents of the two kept keys on either side of it
+			measure(position >= 2 ? position - 2 : 0, std::min(position + 2, kept.size() - 1));
+		}
+
+		error_ = *std::max_element(errors.begin(), errors.end());
+	}
+
+	size_t compressedtrack::find(float time, size_t& cursor) const
+	{
+		size_t last = keys_.size() - 1;
+		size_t segment = std::min(cursor, last);
+
+		// the segment of the previous sample or the one after it, as for track, and otherwise a binary search
+		if (!((segment == 0 || time >= keys_[segment].time) && (segment == last || time < keys_[segment + 1].time)))
+		{
+			if (segment < last && time >= keys_[segment + 1].time && (segment + 1 == last || time < keys_[segment + 2].time))
+			{
+				segment++;
+			}
+			else
+			{
+				auto next = std::upper_bound(keys_.begin(), keys_.end(), time, [](float value, const key& element) { return value < element.time; });
+				segment = next == keys_.begin() ? 0 : static_cast<size_t>(next - keys_.begin()) - 1;
+			}
+		}
+
+		cursor = segment;
+		return segment;
+	}
+
+	template <typename Tile>
+	void compressedtrack::gather(float time, size_t& cursor, Tile& destination, size_t lane) const
+	{
+		size_t count = keys_.size();
+
+		// a track without keys reads as a vec3 of one key at 0, which samples as 0 whatever its components
+		if (count == 0)
+		{
+			for (size_t k = 0; k < 4; k++)
+			{
+				destination.times[k][lane] = 0.0f;
+
+				for (size_t c = 0; c < 3; c++)
+				{
+					destination.words[k][c][lane] = 0;
+				}
+			}
+
+			for (size_t c = 0; c < 3; c++)
+			{
+				destination.minimum[c][lane] = 0.0f;
+				destination.step[c][lane] = 0.0f;
+			}
+
+			destination.rotation[lane] = 0;
+			destination.mode[lane] = static_cast<int32_t>(Interpolation::Step);
+			return;
+		}
+
+		size_t segment = find(time, cursor);
+		size_t next = segment + 1 < count ? segment + 1 : segment;
+		size_t indices[4] = { segment > 0 ? segment - 1 : segment, segment, next, next + 1 < count ? next + 1 : next };
+
+		for (size_t k = 0; k < 4; k++)
+		{
+			const key& value = keys_[indices[k]];
+
+			destination.times[k][lane] = value.time;
+
+			for (size_t c = 0; c < 3; c++)
+			{
+				destination.words[k][c][lane] = value.value[c];
+			}
+		}
+
+		for (size_t c = 0; c < 3; c++)
+		{
+			destination.minimum[c][lane] = minimum_[c];
+			destination.step[c][lane] = step_[c];
+		}
+
+		destination.rotation[lane] = components_ == 4 ? 1 : 0;
+		destination.mode[lane] = static_cast<int32_t>(interpolation_);
+	}
+
+	void compressedtrack::evaluate(float time, size_t& cursor, float* result) const
+	{
+		compressedtrackTile<1> tile;
+		gather(time, cursor, tile, 0);
+		compressedtrackInterpolate(tile, time);
+
+		for (size_t c = 0; c < components_; c++)
+		{
+			result[c] = tile.result[c][0];
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "../INC/Aurora/Mathematics/dualquat.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/mat4.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// quat's constructor and product normalize, which the dual part cannot be, so its components are set directly
+		inline quat dualquatMake(float x, float y, float z, float w)
+		{
+			quat result;
+			result.x = x;
+			result.y = y;
+			result.z = z;
+			result.w = w;
+			return result;
+		}
+
+		inline quat dualquatMultiply(const quat& a, const quat& b)
+		{
+			return dualquatMake(
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+		}
+
+		inline float dualquatDot(const quat& a, const quat& b)
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+		}
+	}
+
+	dualquat::dualquat() : real(), dual(dualquatMake(0.0f, 0.0f, 0.0f, 0.0f)) { }
+
+	dualquat::dualquat(quat real, quat dual) : real(real), dual(dual) { }
+
+	dualquat::dualquat(quat rotation, vec3 translation)
+	{
+		float length = std::sqrt(dualquatDot(rotation, rotation));
+		real = length > 0.0f ? dualquatMake(rotation.x / length, rotation.y / length, rotation.z / length, rotation.w / length) : quat();
+		dual = dualquatMultiply(dualquatMake(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.0f), real);
+	}
+
+	dualquat::dualquat(const mat4& value)
+	{
+		vec3 translation;
+		quat rotation;
+		vec3 scale;
+		mat4::decompose(value, translation, rotation, scale);
+
+		*this = dualquat(rotation, translation);
+	}
+
+	dualquat dualquat::identity()
+	{
+		return dualquat();
+	}
+
+	quat dualquat::rotation() const
+	{
+		float length = std::sqrt(dualquatDot(real, real));
+		return length > 0.0f ? dualquatMake(real.x / length, real.y / length, real.z / length, real.w / length) : quat();
+	}
+
+	vec3 dualquat::translation() const
+	{
+		float lengthSquared = dualquatDot(real, real);
+
+		if (!(lengthSquared > 0.0f))
+		{
+			return vec3(0.0f, 0.0f, 0.0f);
+		}
+
+		quat conjugate = dualquatMake(-real.x, -real.y, -real.z, real.w);
+		quat t = dualquatMultiply(dual, conjugate);
+		float s = 2.0f / lengthSquared;
+
+		return vec3(t.x * s, t.y * s, t.z * s);
+	}
+
+	mat4 dualquat::matrix() const
+	{
+		mat4 result = mat4::createRotation(rotation());
+		vec3 t = translation();
+
+		result(3, 0) = t.x;
+		result(3, 1) = t.y;
+		result(3, 2) = t.z;
+
+		return result;
+	}
+
+	dualquat dualquat::normalize(dualquat value)
+	{
+		value.normalize();
+		return value;
+	}
+
+	void dualquat::normalize()
+	{
+		float lengthSquared = dualquatDot(real, real);
+
+		if (!(lengthSquared > 0.0f))
+		{
+			*this = identity();
+			return;
+		}
+
+		float inverse = 1.0f / std::sqrt(lengthSquared);
+		real = dualquatMake(real.x * inverse, real.y * inverse, real.z * inverse, real.w * inverse);
+		dual = dualquatMake(dual.x * inverse, dual.y * inverse, dual.z * inverse, dual.w * inverse);
+
+		// a unit dual quaternion has its dual part perpendicular to its real part, which rounding and blending do not keep
+		float along = dualquatDot(real, dual);
+		dual = dualquatMake(dual.x - real.x * along, dual.y - real.y * along, dual.z - real.z * along, dual.w - real.w * along);
+	}
+
+	dualquat dualquat::invert(dualquat value)
+	{
+		return dualquat(dualquatMake(-value.real.x, -value.real.y, -value.real.z, value.real.w), dualquatMake(-value.dual.x, -value.dual.y, -value.dual.z, value.dual.w));
+	}
+
+	dualquat dualquat::blend(std::span<const dualquat> values, std::span<const float> weights)
+	{
+		if (weights.size() < values.size())
+		{
+			throw std::invalid_argument("The weights (" + std::to_string(weights.size()) + ") are fewer than required (" + std::to_string(values.size()) + ").");
+		}
+
+		if (values.empty())
+		{
+			return identity();
+		}
+
+		quat real = dualquatMake(0.0f, 0.0f, 0.0f, 0.0f);
+		quat dual = dualquatMake(0.0f, 0.0f, 0.0f, 0.0f);
+
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			float weight = dualquatDot(values[i].real, values[0].real) < 0.0f ? -weights[i] : weights[i];
+
+			real.x += values[i].real.x * weight;
+			real.y += values[i].real.y * weight;
+			real.z += values[i].real.z * weight;
+			real.w += values[i].real.w * weight;
+			dual.x += values[i].dual.x * weight;
+			dual.y += values[i].dual.y * weight;
+			dual.z += values[i].dual.z * weight;
+			dual.w += values[i].dual.w * weight;
+		}
+
+		return normalize(dualquat(real, dual));
+	}
+
+	vec3 dualquat::transformPoint(vec3 value) const
+	{
+		vec3 rotated = transformVector(value);
+
+		// twice the vector part of the dual part multiplied by the conjugate of the real part
+		float tx = 2.0f * (real.w * dual.x - dual.w * real.x + real.y * dual.z - real.z * dual.y);
+		float ty = 2.0f * (real.w * dual.y - dual.w * real.y + real.z * dual.x - real.x * dual.z);
+		float tz = 2.0f * (real.w * dual.z - dual.w * real.z + real.x * dual.y - real.y * dual.x);
+
+		return vec3(rotated.x + tx, rotated.y + ty, rotated.z + tz);
+	}
+
+	vec3 dualquat::transformVector(vec3 value) const
+	{
+		// v + 2w(q x v) + 2q x (q x v), for the vector part q and scalar part w of the real part
+		float cx = real.y * value.z - real.z * value.y;
+		float cy = real.z * value.x - real.x * value.z;
+		float cz = real.x * value.y - real.y * value.x;
+		float ccx = real.y * cz - real.z * cy;
+		float ccy = real.z * cx - real.x * cz;
+		float ccz = real.x * cy - real.y * cx;
+
+		return vec3(value.x + 2.0f * (real.w * cx + ccx), value.y + 2.0f * (real.w * cy + ccy), value.z + 2.0f * (real.w * cz + ccz));
+	}
+
+	dualquat dualquat::operator*(const dualquat& other) const
+	{
+		quat r = dualquatMultiply(real, other.real);
+		quat d1 = dualquatMultiply(real, other.dual);
+		quat d2 = dualquatMultiply(dual, other.real);
+
+		return dualquat(r, dualquatMake(d1.x + d2.x, d1.y + d2.y, d1.z + d2.z, d1.w + d2.w));
+	}
+
+	dualquat& dualquat::operator*=(const dualquat& other)
+	{
+		*this = *this * other;
+		return *this;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,349 @@
+#include "../INC/Aurora/Mathematics/frustum.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/mat4.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/vec4.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of shapes handed to a thread at a time
+		constexpr size_t frustumGrain = 16384;
+
+		// number of shapes classified together, the lane loops over a packet compile to two 4 wide or one 8 wide vector instruction
+		constexpr size_t frustumLanes = 8;
+
+		// the planes of a frustum as plain coefficients, along with the absolute values of their normals which measure how far a box reaches towards them
+		struct frustumPlanes
+		{
+			float coefficients[6][4];
+			float absolute[6][3];
+
+			frustumPlanes(const frustum& value)
+			{
+				for (int i = 0; i < 6; i++)
+				{
+					const plane& current = value.planes[i];
+
+					coefficients[i][0] = current.normal.x;
+					coefficients[i][1] = current.normal.y;
+					coefficients[i][2] = current.normal.z;
+					coefficients[i][3] = current.distance;
+
+					absolute[i][0] = current.normal.x < 0.0f ? -current.normal.x : current.normal.x;
+					absolute[i][1] = current.normal.y < 0.0f ? -current.normal.y : current.normal.y;
+					absolute[i][2] = current.normal.z < 0.0f ? -current.normal.z : current.normal.z;
+				}
+			}
+		};
+
+		// a packet of shapes by their centers and extents, a sphere stores its radius as the extent on every axis
+		struct frustumPacket
+		{
+			float center[3][frustumLanes];
+			float extent[3][frustumLanes];
+		};
+
+		plane frustumPlane(vec4 value)
+		{
+			return plane(vec3(value.x, value.y, value.z), value.w).normalized();
+		}
+
+		// classifies a single shape, stopping at the first plane it lies outside of
+		template<bool Box>
+		Containment frustumClassify(const frustumPlanes& planes, float centerX, float centerY, float centerZ, float extentX, float extentY, float extentZ)
+		{
+			bool inside = true;
+
+			for (int i = 0; i < 6; i++)
+			{
+				const float* coefficients = planes.coefficients[i];
+				const float* absolute = planes.absolute[i];
+
+				// a box reaches towards a plane by its extents projected onto the normal, a sphere by its radius, as the planes are normalized
+				float distance = coefficients[0] * centerX + coefficients[1] * centerY + coefficients[2] * centerZ + coefficients[3];
+				float reach = Box ? absolute[0] * extentX + absolute[1] * extentY + absolute[2] * extentZ : extentX;
+
+				// written so that a NaN distance, the center of an empty box, counts as outside
+				if (!(distance + reach >= 0.0f))
+				{
+					return Containment::Outside;
+				}
+
+				inside &= distance - reach >= 0.0f;
+			}
+
+			return inside ? Containment::Inside : Containment::Intersecting;
+		}
+
+		// classifies a packet of shapes against one plane and merges the result into the lanes found outside and inside so far, the lanes newly found outside take the plane as their hint
+		template<bool Box>
+		inline bool frustumTest(const frustumPlanes& planes, int index, const frustumPacket& packet, int* outside, int* inside, int* hints)
+		{
+			const float* coefficients = planes.coefficients[index];
+			const float* absolute = planes.absolute[index];
+
+			for (size_t i = 0; i < frustumLanes; i++)
+			{
+				float distance = coefficients[0] * packet.center[0][i] + coefficients[1] * packet.center[1][i] + coefficients[2] * packet.center[2][i] + coefficients[3];
+				float reach = Box ? absolute[0] * packet.extent[0][i] + absolute[1] * packet.extent[1][i] + absolute[2] * packet.extent[2][i] : packet.extent[0][i];
+
+				int out = !(distance + reach >= 0.0f);
+				hints[i] = out & !outside[i] ? index : hints[i];
+				outside[i] |= out;
+				inside[i] &= distance - reach >= 0.0f;
+			}
+
+			int all = 1;
+
+			for (size_t i = 0; i < frustumLanes; i++)
+			{
+				all &= outside[i];
+			}
+
+			return all != 0;
+		}
+
+		void frustumCheck(size_t available, size_t required, const char* name)
+		{
+			if (available < required)
+			{
+				throw std::invalid_argument("The " + std::string(name) + " (" + std::to_string(available) + ") are fewer than required (" + std::to_string(required) + ").");
+			}
+		}
+
+		// classifies count shapes in packets on multiple threads, gather fills one lane of a packet from a shape and hints may be null
+		template<bool Box, typename Gather>
+		void frustumBatch(const frustum& value, size_t count, const Gather& gather, Containment* results, uint8_t* hints)
+		{
+			frustumPlanes planes(value);
+
+			parallelFor(count, frustumGrain, [&](size_t begin, size_t end)
+				{
+					// the flags of each lane are as wide as the floats they are computed from, bools would have to be narrowed in every lane loop
+					frustumPacket packet;
+					int outside[frustumLanes];
+					int inside[frustumLanes];
+					int first[frustumLanes];
+
+					for (size_t start = begin; start < end; start += frustumLanes)
+					{
+						size_t n = std::min(frustumLanes, end - start);
+
+						// unused lanes of the last packet repeat the last shape
+						for (size_t i = 0; i < frustumLanes; i++)
+						{
+							size_t j = std::min(start + i, end - 1);
+
+							gather(j, packet, i);
+							first[i] = hints != nullptr && hints[j] < 6 ? hints[j] : 0;
+							outside[i] = 0;
+							inside[i] = 1;
+						}
+
+						// neighbouring shapes tend to be culled by the same plane, so the planes are tested starting with the hint of the first shape in the packet
+						int hint = first[0];
+						bool culled = false;
+
+						for (int i = 0; i < 6 && !culled; i++)
+						{
+							culled = frustumTest<Box>(planes, (hint + i) % 6, packet, outside, inside, first);
+						}
+
+						for (size_t i = 0; i < n; i++)
+						{
+							results[start + i] = outside[i] ? Containment::Outside : inside[i] ? Containment::Inside : Containment::Intersecting;
+						}
+
+						if (hints != nullptr)
+						{
+							for (size_t i = 0; i < n; i++)
+							{
+								hints[start + i] = (uint8_t)first[i];
+							}
+						}
+					}
+				});
+		}
+
+		// a box reaches from its center by half its size on each axis, an empty box has a NaN center and is found outside
+		void frustumGather(std::span<const aabb3> boxes, size_t index, frustumPacket& packet, size_t lane)
+		{
+			const aabb3& box = boxes[index];
+			const float* boxMin = box.minLanes();
+			const float* boxMax = box.maxLanes();
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				packet.center[axis][lane] = (boxMin[axis] + boxMax[axis]) * 0.5f;
+				packet.extent[axis][lane] = (boxMax[axis] - boxMin[axis]) * 0.5f;
+			}
+		}
+
+		void frustumGather(std::span<const bounds> boxes, size_t index, frustumPacket& packet, size_t lane)
+		{
+			const bounds& box = boxes[index];
+
+			packet.extent[0][lane] = box.width() * 0.5f;
+			packet.extent[1][lane] = box.height() * 0.5f;
+			packet.extent[2][lane] = box.depth() * 0.5f;
+			packet.center[0][lane] = box.x() + packet.extent[0][lane];
+			packet.center[1][lane] = box.y() + packet.extent[1][lane];
+			packet.center[2][lane] = box.z() + packet.extent[2][lane];
+		}
+
+		void frustumGather(std::span<const vec3> centers, std::span<const float> radii, size_t index, frustumPacket& packet, size_t lane)
+		{
+			packet.center[0][lane] = centers[index].x;
+			packet.center[1][lane] = centers[index].y;
+			packet.center[2][lane] = centers[index].z;
+			packet.extent[0][lane] = radii[index];
+		}
+	}
+
+	frustum::frustum() : frustum(mat4::identity()) { }
+
+	frustum::frustum(const mat4& viewProjection)
+	{
+		// a point transformed as a row vector lands inside the clip volume when -w <= x, y, z <= w, where each clip coordinate is the dot product with a column of the matrix
+		vec4 x = viewProjection.col(0);
+		vec4 y = viewProjection.col(1);
+		vec4 z = viewProjection.col(2);
+		vec4 w = viewProjection.col(3);
+
+		planes[leftPlane] = frustumPlane(w + x);
+		planes[rightPlane] = frustumPlane(w - x);
+		planes[bottomPlane] = frustumPlane(w + y);
+		planes[topPlane] = frustumPlane(w - y);
+		planes[nearPlane] = frustumPlane(w + z);
+		planes[farPlane] = frustumPlane(w - z);
+	}
+
+	frustum::frustum(std::span<const plane, 6> planes)
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			this->planes[i] = planes[i].normalized();
+		}
+	}
+
+	bool frustum::approximately(const frustum& value1, const frustum& value2)
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			if (!plane::approximately(value1.planes[i], value2.planes[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool frustum::contains(vec3 point) const
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			if (planes[i].signedDistance(point) < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	Containment frustum::classify(const aabb3& value) const
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+
+		return frustumClassify<true>(frustumPlanes(*this),
+			(boxMin[0] + boxMax[0]) * 0.5f, (boxMin[1] + boxMax[1]) * 0.5f, (boxMin[2] + boxMax[2]) * 0.5f,
+			(boxMax[0] - boxMin[0]) * 0.5f, (boxMax[1] - boxMin[1]) * 0.5f, (boxMax[2] - boxMin[2]) * 0.5f);
+	}
+
+	Containment frustum::classify(bounds value) const
+	{
+		vec3 center = value.center();
+		vec3 extent = value.size() * 0.5f;
+
+		return frustumClassify<true>(frustumPlanes(*this), center.x, center.y, center.z, extent.x, extent.y, extent.z);
+	}
+
+	Containment frustum::classify(vec3 center, float radius) const
+	{
+		return frustumClassify<false>(frustumPlanes(*this), center.x, center.y, center.z, radius, radius, radius);
+	}
+
+	bool frustum::operator==(const frustum& other) const
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			if (planes[i] != other.planes[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool frustum::operator!=(const frustum& other) const
+	{
+		return !((*this) == other);
+	}
+
+	void classify(const frustum& value, std::span<const aabb3> boxes, std::span<Containment> results)
+	{
+		frustumCheck(results.size(), boxes.size(), "results");
+
+		frustumBatch<true>(value, boxes.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(boxes, index, packet, lane); }, results.data(), nullptr);
+	}
+
+	void classify(const frustum& value, std::span<const aabb3> boxes, std::span<Containment> results, std::span<uint8_t> hints)
+	{
+		frustumCheck(results.size(), boxes.size(), "results");
+		frustumCheck(hints.size(), boxes.size(), "hints");
+
+		frustumBatch<true>(value, boxes.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(boxes, index, packet, lane); }, results.data(), hints.data());
+	}
+
+	void classify(const frustum& value, std::span<const bounds> boxes, std::span<Containment> results)
+	{
+		frustumCheck(results.size(), boxes.size(), "results");
+
+		frustumBatch<true>(value, boxes.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(boxes, index, packet, lane); }, results.data(), nullptr);
+	}
+
+	void classify(const frustum& value, std::span<const bounds> boxes, std::span<Containment> results, std::span<uint8_t> hints)
+	{
+		frustumCheck(results.size(), boxes.size(), "results");
+		frustumCheck(hints.size(), boxes.size(), "hints");
+
+		frustumBatch<true>(value, boxes.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(boxes, index, packet, lane); }, results.data(), hints.data());
+	}
+
+	void classify(const frustum& value, std::span<const vec3> centers, std::span<const float> radii, std::span<Containment> results)
+	{
+		frustumCheck(radii.size(), centers.size(), "radii");
+		frustumCheck(results.size(), centers.size(), "results");
+
+		frustumBatch<false>(value, centers.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(centers, radii, index, packet, lane); }, results.data(), nullptr);
+	}
+
+	void classify(const frustum& value, std::span<const vec3> centers, std::span<const float> radii, std::span<Containment> results, std::span<uint8_t> hints)
+	{
+		frustumCheck(radii.size(), centers.size(), "radii");
+		frustumCheck(results.size(), centers.size(), "results");
+		frustumCheck(hints.size(), centers.size(), "hints");
+
+		frustumBatch<false>(value, centers.size(), [&](size_t index, frustumPacket& packet, size_t lane) { frustumGather(centers, radii, index, packet, lane); }, results.data(), hints.data());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,588 @@
+#include "../INC/Aurora/Mathematics/hashgrid2.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb2.h"
+#include "../INC/Aurora/Mathematics/ivec2.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/rect.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of points, rectangles or cells handed to a thread at a time
+		constexpr size_t hashgrid2Grain = 16384;
+
+		// number of bits of the keys sorted by each pass of the radix sort
+		constexpr int hashgrid2RadixBits = 11;
+
+		constexpr size_t hashgrid2RadixSize = (size_t)1 << hashgrid2RadixBits;
+
+		// more cells than can be indexed, the count of cells covered saturates here so it can be reported without overflowing
+		constexpr double hashgrid2MaxCells = 1099511627776.0;
+
+		inline float hashgrid2Max(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// rounds down and clamps to the range of an int, so far away coordinates end up in the outermost cells instead of overflowing, and NaN ends up in the last cell
+		inline int hashgrid2Floor(float value)
+		{
+			float result = std::floor(value);
+			result = result < 2147483520.0f ? result : 2147483520.0f;
+			result = result > -2147483648.0f ? result : -2147483648.0f;
+
+			return (int)result;
+		}
+
+		// the cells on either side of a cell along one axis, computed in 64 bits and clamped to the cells hashgrid2Floor produces, so a cell at the end of the int range neither overflows nor keeps the search from ending
+		inline void hashgrid2Around(int cell, int& low, int& high)
+		{
+			low = (int)std::max((int64_t)cell - 1, (int64_t)std::numeric_limits<int>::min());
+			high = (int)std::min((int64_t)cell + 1, (int64_t)2147483520);
+		}
+
+		// the comparisons are evaluated for both axes and then combined so they compile to packed comparisons
+		inline bool hashgrid2Overlaps(const float* min, const float* max, const float* queryMin, const float* queryMax)
+		{
+			int mask0 = min[0] < queryMax[0] ? -1 : 0;
+			int mask1 = min[1] < queryMax[1] ? -1 : 0;
+			int mask2 = queryMin[0] < max[0] ? -1 : 0;
+			int mask3 = queryMin[1] < max[1] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3) != 0;
+		}
+
+		inline float hashgrid2DistanceSquared(const float* min, const float* max, const float* point)
+		{
+			float x = hashgrid2Max(hashgrid2Max(min[0] - point[0], point[0] - max[0]), 0.0f);
+			float y = hashgrid2Max(hashgrid2Max(min[1] - point[1], point[1] - max[1]), 0.0f);
+
+			return x * x + y * y;
+		}
+
+		// the position of a cell in a table of 2 to the power of bits slots, taken from the high bits of its hash
+		inline size_t hashgrid2Slot(int x, int y, int bits)
+		{
+			return ivec2::hash(ivec2(x, y)) >> (std::numeric_limits<size_t>::digits - bits);
+		}
+	}
+
+	hashgrid2::hashgrid2() : hashgrid2(1.0f) { }
+
+	hashgrid2::hashgrid2(float cellSize) : cellSize_(cellSize), inverse_(1.0f / cellSize), size_(0), cellCount_(0), spanning_(false)
+	{
+		if (!(cellSize > 0.0f) || std::isinf(cellSize))
+		{
+			throw std::invalid_argument("The cell size (" + std::to_string(cellSize) + ") must be positive and finite.");
+		}
+	}
+
+	void hashgrid2::build(std::span<const vec2> points)
+	{
+		auto corners = [&](size_t index, float* min, float* max)
+			{
+				min[0] = max[0] = points[index].x;
+				min[1] = max[1] = points[index].y;
+			};
+
+		build(points.size(), corners);
+	}
+
+	void hashgrid2::build(std::span<const rect> rectangles)
+	{
+		auto corners = [&](size_t index, float* min, float* max)
+			{
+				aabb2 value(rectangles[index]);
+				const float* valueMin = value.minLanes();
+				const float* valueMax = value.maxLanes();
+
+				for (int axis = 0; axis < 2; axis++)
+				{
+					min[axis] = valueMin[axis];
+					max[axis] = valueMax[axis];
+				}
+			};
+
+		build(rectangles.size(), corners);
+	}
+
+	void hashgrid2::build(std::span<const aabb2> rectangles)
+	{
+		auto corners = [&](size_t index, float* min, float* max)
+			{
+				const aabb2& value = rectangles[index];
+				const float* valueMin = value.minLanes();
+				const float* valueMax = value.maxLanes();
+
+				for (int axis = 0; axis < 2; axis++)
+				{
+					min[axis] = valueMin[axis];
+					max[axis] = valueMax[axis];
+				}
+			};
+
+		build(rectangles.size(), corners);
+	}
+
+	void hashgrid2::clear()
+	{
+		size_ = 0;
+		cellCount_ = 0;
+		spanning_ = false;
+		items_.clear();
+		slots_.clear();
+	}
+
+	float hashgrid2::cellSize() const
+	{
+		return cellSize_;
+	}
+
+	size_t hashgrid2::size() const
+	{
+		return size_;
+	}
+
+	size_t hashgrid2::cellCount() const
+	{
+		return cellCount_;
+	}
+
+	ivec2 hashgrid2::cell(vec2 point) const
+	{
+		return ivec2(hashgrid2Floor(point.x * inverse_), hashgrid2Floor(point.y * inverse_));
+	}
+
+	void hashgrid2::neighbors(ivec2 cell, std::vector<size_t>& results) const
+	{
+		neighbors(cell, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool hashgrid2::neighbors(ivec2 cell, callback<bool(size_t index)> visit) const
+	{
+		int low[2];
+		int high[2];
+		hashgrid2Around(cell.x, low[0], high[0]);
+		hashgrid2Around(cell.y, low[1], high[1]);
+
+		auto accept = [](const item&)
+			{
+				return true;
+			};
+
+		return search(low, high, accept, visit);
+	}
+
+	void hashgrid2::within(vec2 point, float radius, std::vector<size_t>& results) const
+	{
+		within(point, radius, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool hashgrid2::within(vec2 point, float radius, callback<bool(size_t index)> visit) const
+	{
+		float position[2] = { point.x, point.y };
+		float squared = radius * radius;
+
+		// written so that a NaN point or radius finds nothing
+		if (!(radius >= 0.0f) || !(position[0] == position[0] && position[1] == position[1]))
+		{
+			return true;
+		}
+
+		int low[2];
+		int high[2];
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			low[axis] = hashgrid2Floor((position[axis] - radius) * inverse_);
+			high[axis] = hashgrid2Floor((position[axis] + radius) * inverse_);
+		}
+
+		auto accept = [&](const item& stored)
+			{
+				return hashgrid2DistanceSquared(stored.min, stored.max, position) <= squared;
+			};
+
+		return search(low, high, accept, visit);
+	}
+
+	void hashgrid2::overlapping(const aabb2& value, std::vector<size_t>& results) const
+	{
+		overlapping(value, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool hashgrid2::overlapping(const aabb2& value, callback<bool(size_t index)> visit) const
+	{
+		const float* queryMin = value.minLanes();
+		const float* queryMax = value.maxLanes();
+
+		// written so that an empty or NaN rectangle finds nothing
+		if (!(queryMin[0] <= queryMax[0] && queryMin[1] <= queryMax[1]))
+		{
+			return true;
+		}
+
+		int low[2];
+		int high[2];
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			low[axis] = hashgrid2Floor(queryMin[axis] * inverse_);
+			high[axis] = hashgrid2Floor(queryMax[axis] * inverse_);
+		}
+
+		auto accept = [&](const item& stored)
+			{
+				return hashgrid2Overlaps(stored.min, stored.max, queryMin, queryMax);
+			};
+
+		return search(low, high, accept, visit);
+	}
+
+	const hashgrid2::slot* hashgrid2::find(int x, int y) const
+	{
+		if (slots_.empty())
+		{
+			return nullptr;
+		}
+
+		size_t mask = slots_.size() - 1;
+		size_t position = hashgrid2Slot(x, y, std::countr_zero(slots_.size()));
+
+		while (slots_[position].begin != slots_[position].end)
+		{
+			const slot& current = slots_[position];
+
+			if (current.cell[0] == x && current.cell[1] == y)
+			{
+				return &current;
+			}
+
+			position = (position + 1) & mask;
+		}
+
+		return nullptr;
+	}
+
+	template<typename Corners>
+	void hashgrid2::build(size_t count, Corners& corners)
+	{
+		clear();
+
+		// the number of cells each point or rectangle overlaps, summed into the position of its first record
+		offsets_.resize(count + 1);
+		offsets_[0] = 0;
+
+		parallelFor(count, hashgrid2Grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					float min[2];
+					float max[2];
+					double cells = 1.0;
+
+					corners(i, min, max);
+
+					for (int axis = 0; axis < 2; axis++)
+					{
+						cells *= (double)hashgrid2Floor(max[axis] * inverse_) - hashgrid2Floor(min[axis] * inverse_) + 1.0;
+					}
+
+					// written so that NaN corners count as empty, and capped so that the sum below cannot overflow
+					bool empty = !(min[0] <= max[0] && min[1] <= max[1]);
+					offsets_[i + 1] = empty ? 0 : (uint64_t)std::min(cells, hashgrid2MaxCells);
+				}
+			});
+
+		for (size_t i = 0; i < count; i++)
+		{
+			spanning_ |= offsets_[i + 1] > 1;
+			offsets_[i + 1] = std::min(offsets_[i + 1] + offsets_[i], (uint64_t)hashgrid2MaxCells);
+		}
+
+		uint64_t total = offsets_[count];
+
+		if (total > std::numeric_limits<uint32_t>::max())
+		{
+			spanning_ = false;
+			throw std::invalid_argument("The cells covered by the points or rectangles (" + std::to_string(total) + ") are more than the maximum (" + std::to_string(std::numeric_limits<uint32_t>::max()) + ").");
+		}
+
+		size_ = count;
+
+		if (total == 0)
+		{
+			return;
+		}
+
+		// the key of a record is as many high bits of the hash of its cell as it takes to give most cells a key of their own
+		int bits = std::max(1, (int)std::bit_width(total - 1));
+
+		records_.resize(total);
+		sorted_.resize(total);
+
+		parallelFor(count, hashgrid2Grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					record* current = &records_[offsets_[i]];
+
+					if (offsets_[i + 1] == offsets_[i])
+					{
+						continue;
+					}
+
+					float min[2];
+					float max[2];
+
+					corners(i, min, max);
+
+					int low[2] = { hashgrid2Floor(min[0] * inverse_), hashgrid2Floor(min[1] * inverse_) };
+					int high[2] = { hashgrid2Floor(max[0] * inverse_), hashgrid2Floor(max[1] * inverse_) };
+
+					for (int y = low[1]; y <= high[1]; y++)
+					{
+						for (int x = low[0]; x <= high[0]; x++)
+						{
+							*current++ = { (uint32_t)hashgrid2Slot(x, y, bits), (uint32_t)i, { x, y } };
+						}
+					}
+				}
+			});
+
+		// a least significant digit radix sort, where every block of records counts its digits on its own and then scatters its records to the positions the counts of all blocks give it, so the sort is stable and needs no synchronization
+		size_t blockCount = (size_t)((total + hashgrid2Grain - 1) / hashgrid2Grain);
+
+		histograms_.resize(blockCount * hashgrid2RadixSize);
+
+		for (int shift = 0; shift < bits; shift += hashgrid2RadixBits)
+		{
+			parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t block = begin; block < end; block++)
+					{
+						uint32_t* histogram = &histograms_[block * hashgrid2RadixSize];
+						size_t last = std::min((block + 1) * hashgrid2Grain, (size_t)total);
+
+						std::fill(histogram, histogram + hashgrid2RadixSize, 0);
+
+						for (size_t i = block * hashgrid2Grain; i < last; i++)
+						{
+							histogram[(records_[i].key >> shift) & (hashgrid2RadixSize - 1)]++;
+						}
+					}
+				});
+
+			uint32_t position = 0;
+
+			for (size_t digit = 0; digit < hashgrid2RadixSize; digit++)
+			{
+				for (size_t block = 0; block < blockCount; block++)
+				{
+					uint32_t digitCount = histograms_[block * hashgrid2RadixSize + digit];
+
+					histograms_[block * hashgrid2RadixSize + digit] = position;
+					position += digitCount;
+				}
+			}
+
+			parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t block = begin; block < end; block++)
+					{
+						uint32_t* histogram = &histograms_[block * hashgrid2RadixSize];
+						size_t last = std::min((block + 1) * hashgrid2Grain, (size_t)total);
+
+						for (size_t i = block * hashgrid2Grain; i < last; i++)
+						{
+							sorted_[histogram[(records_[i].key >> shift) & (hashgrid2RadixSize - 1)]++] = records_[i];
+						}
+					}
+				});
+
+			records_.swap(sorted_);
+		}
+
+		// different cells sharing a key are interleaved, so those keys are sorted by cell as well, and by index within a cell to keep the order of the input
+		auto sameCell = [](const record& record1, const record& record2)
+			{
+				return record1.cell[0] == record2.cell[0] && record1.cell[1] == record2.cell[1];
+			};
+
+		for (size_t first = 0; first < total;)
+		{
+			size_t last = first + 1;
+			bool mixed = false;
+
+			while (last < total && records_[last].key == records_[first].key)
+			{
+				mixed |= !sameCell(records_[last], records_[first]);
+				last++;
+			}
+
+			if (mixed)
+			{
+				std::sort(records_.begin() + first, records_.begin() + last, [](const record& record1, const record& record2)
+					{
+						if (record1.cell[0] != record2.cell[0]) return record1.cell[0] < record2.cell[0];
+						if (record1.cell[1] != record2.cell[1]) return record1.cell[1] < record2.cell[1];
+
+						return record1.index < record2.index;
+					});
+			}
+
+			for (size_t i = first + 1; i < last; i++)
+			{
+				cellCount_ += sameCell(records_[i], records_[i - 1]) ? 0 : 1;
+			}
+
+			cellCount_++;
+			first = last;
+		}
+
+		items_.resize(total);
+
+		parallelFor(total, hashgrid2Grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					item& stored = items_[i];
+
+					stored.index = records_[i].index;
+					corners(stored.index, stored.min, stored.max);
+				}
+			});
+
+		// the table is kept at most half full so probes stay short, and the cells arrive in the order of their keys, which is close to the order of their slots, so the probes walk forward through memory
+		int slotBits = std::max(1, (int)std::bit_width(cellCount_ * 2 - 1));
+		size_t mask = ((size_t)1 << slotBits) - 1;
+
+		slots_.assign(mask + 1, { { 0, 0 }, 0, 0 });
+
+		for (size_t first = 0; first < total;)
+		{
+			size_t last = first + 1;
+
+			while (last < total && sameCell(records_[last], records_[first]))
+			{
+				last++;
+			}
+
+			const int* cell = records_[first].cell;
+			size_t position = hashgrid2Slot(cell[0], cell[1], slotBits);
+
+			while (slots_[position].begin != slots_[position].end)
+			{
+				position = (position + 1) & mask;
+			}
+
+			slots_[position] = { { cell[0], cell[1] }, (uint32_t)first, (uint32_t)last };
+			first = last;
+		}
+	}
+
+	template<typename Accept>
+	bool hashgrid2::search(const int* low, const int* high, Accept& accept, callback<bool(size_t index)> visit) const
+	{
+		auto visitCell = [&](const slot& current)
+			{
+				for (uint32_t i = current.begin; i < current.end; i++)
+				{
+					const item& stored = items_[i];
+
+					if (!accept(stored))
+					{
+						continue;
+					}
+
+					// a rectangle overlapping several cells of the query is only reported from the first of them
+					if (spanning_)
+					{
+						bool first = true;
+
+						for (int axis = 0; axis < 2; axis++)
+						{
+							int start = hashgrid2Floor(stored.min[axis] * inverse_);
+							first &= current.cell[axis] == (start > low[axis] ? start : low[axis]);
+						}
+
+						if (!first)
+						{
+							continue;
+						}
+					}
+
+					if (!visit(stored.index))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			};
+
+		double range = 1.0;
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			range *= (double)high[axis] - low[axis] + 1.0;
+		}
+
+		// a query covering more cells than there are slots goes through the slots instead
+		if (range > (double)slots_.size())
+		{
+			for (const slot& current : slots_)
+			{
+				bool inside = current.begin != current.end;
+
+				for (int axis = 0; axis < 2; axis++)
+				{
+					inside &= current.cell[axis] >= low[axis] && current.cell[axis] <= high[axis];
+				}
+
+				if (inside && !visitCell(current))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		for (int y = low[1]; y <= high[1]; y++)
+		{
+			for (int x = low[0]; x <= high[0]; x++)
+			{
+				const slot* current = find(x, y);
+
+				if (current != nullptr && !visitCell(*current))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,558 @@
+#include "../INC/Aurora/Mathematics/hierarchy.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/mat4.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// marks a free id, a removed position, or the parent of a root node
+		constexpr uint32_t hierarchyNone = 0xFFFFFFFF;
+
+		// number of nodes of a depth updated by a thread at a time, below which a depth is updated on the calling thread
+		constexpr size_t hierarchyGrain = 4096;
+
+		// scales, then rotates, then translates, for row vectors, so each row is an axis of the rotation scaled by the matching component of the scale
+		// the rotation is divided by its squared length instead of being normalized, and a rotation of length 0 gives no rotation
+		template <typename Frame>
+		inline void hierarchyCompose(const vec3& translation, const quat& rotation, const vec3& scale, Frame& result)
+		{
+			float lengthSquared = rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w;
+			float s = lengthSquared > 0.0f ? 2.0f / lengthSquared : 0.0f;
+
+			float xx = rotation.x * rotation.x * s;
+			float yy = rotation.y * rotation.y * s;
+			float zz = rotation.z * rotation.z * s;
+			float xy = rotation.x * rotation.y * s;
+			float xz = rotation.x * rotation.z * s;
+			float yz = rotation.y * rotation.z * s;
+			float wx = rotation.w * rotation.x * s;
+			float wy = rotation.w * rotation.y * s;
+			float wz = rotation.w * rotation.z * s;
+
+			result.rows[0][0] = (1.0f - (yy + zz)) * scale.x;
+			result.rows[0][1] = (xy + wz) * scale.x;
+			result.rows[0][2] = (xz - wy) * scale.x;
+			result.rows[0][3] = 0.0f;
+			result.rows[1][0] = (xy - wz) * scale.y;
+			result.rows[1][1] = (1.0f - (xx + zz)) * scale.y;
+			result.rows[1][2] = (yz + wx) * scale.y;
+			result.rows[1][3] = 0.0f;
+			result.rows[2][0] = (xz + wy) * scale.z;
+			result.rows[2][1] = (yz - wx) * scale.z;
+			result.rows[2][2] = (1.0f - (xx + yy)) * scale.z;
+			result.rows[2][3] = 0.0f;
+			result.rows[3][0] = translation.x;
+			result.rows[3][1] = translation.y;
+			result.rows[3][2] = translation.z;
+			result.rows[3][3] = 1.0f;
+		}
+
+		// the last column of the local matrix is known to be 0, 0, 0, 1, so each row of the product is three or four rows of the parent scaled and added, which compile to packed instructions over the four columns
+		template <typename Frame>
+		inline void hierarchyMultiply(const Frame& local, const Frame& parent, Frame& result)
+		{
+			for (int r = 0; r < 3; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					result.rows[r][c] = local.rows[r][0] * parent.rows[0][c] + local.rows[r][1] * parent.rows[1][c] + local.rows[r][2] * parent.rows[2][c];
+				}
+			}
+
+			for (int c = 0; c < 4; c++)
+			{
+				result.rows[3][c] = local.rows[3][0] * parent.rows[0][c] + local.rows[3][1] * parent.rows[1][c] + local.rows[3][2] * parent.rows[2][c] + parent.rows[3][c];
+			}
+		}
+
+		template <typename Frame>
+		inline void hierarchyIdentity(Frame& result)
+		{
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					result.rows[r][c] = r == c ? 1.0f : 0.0f;
+				}
+			}
+		}
+
+		// moves the values at the positions given by order to the front, in that order, dropping the rest
+		template <typename T>
+		void hierarchyGather(std::vector<T>& values, const std::vector<uint32_t>& order)
+		{
+			std::vector<T> result(order.size());
+
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				result[i] = values[order[i]];
+			}
+
+			values.swap(result);
+		}
+	}
+
+	hierarchy::hierarchy() : size_(0), ordered_(true) { }
+
+	size_t hierarchy::insert()
+	{
+		return add(hierarchyNone, vec3(0.0f, 0.0f, 0.0f), quat::identity(), vec3(1.0f, 1.0f, 1.0f));
+	}
+
+	size_t hierarchy::insert(vec3 translation, quat rotation, vec3 scale)
+	{
+		return add(hierarchyNone, translation, rotation, scale);
+	}
+
+	size_t hierarchy::insert(size_t parent)
+	{
+		return add(find(parent), vec3(0.0f, 0.0f, 0.0f), quat::identity(), vec3(1.0f, 1.0f, 1.0f));
+	}
+
+	size_t hierarchy::insert(size_t parent, vec3 translation, quat rotation, vec3 scale)
+	{
+		return add(find(parent), translation, rotation, scale);
+	}
+
+	void hierarchy::remove(size_t id)
+	{
+		uint32_t position = find(id);
+		unlink(position);
+
+		// the descendants are found through the links of their parents, and their positions are left as gaps for the next update to compact
+		order_.assign(1, position);
+
+		while (!order_.empty())
+		{
+			uint32_t current = order_.back();
+			order_.pop_back();
+
+			for (uint32_t child = firstChildren_[current]; child != hierarchyNone; child = nextSiblings_[child])
+			{
+				order_.push_back(child);
+			}
+
+			slots_[ids_[current]] = hierarchyNone;
+			freeIds_.push_back(ids_[current]);
+			ids_[current] = hierarchyNone;
+			size_--;
+		}
+
+		ordered_ = false;
+	}
+
+	void hierarchy::attach(size_t id, size_t parent)
+	{
+		uint32_t position = find(id);
+		uint32_t parentPosition = find(parent);
+
+		for (uint32_t ancestor = parentPosition; ancestor != hierarchyNone; ancestor = parents_[ancestor])
+		{
+			if (ancestor == position)
+			{
+				throw std::invalid_argument("The node (" + std::to_string(id) + ") cannot be attached to itself or one of its descendants (" + std::to_string(parent) + ").");
+			}
+		}
+
+		unlink(position);
+		parents_[position] = parentPosition;
+		link(position);
+		dirty_[position] = 1;
+		ordered_ = false;
+	}
+
+	void hierarchy::detach(size_t id)
+	{
+		uint32_t position = find(id);
+
+		if (parents_[position] != hierarchyNone)
+		{
+			unlink(position);
+			parents_[position] = hierarchyNone;
+			dirty_[position] = 1;
+			ordered_ = false;
+		}
+	}
+
+	void hierarchy::clear()
+	{
+		slots_.clear();
+		freeIds_.clear();
+		ids_.clear();
+		parents_.clear();
+		firstChildren_.clear();
+		nextSiblings_.clear();
+		previousSiblings_.clear();
+		translations_.clear();
+		rotations_.clear();
+		scales_.clear();
+		worlds_.clear();
+		dirty_.clear();
+		depths_.clear();
+		size_ = 0;
+		ordered_ = true;
+	}
+
+	bool hierarchy::contains(size_t id) const
+	{
+		return id < slots_.size() && slots_[id] != hierarchyNone;
+	}
+
+	size_t hierarchy::parent(size_t id) const
+	{
+		uint32_t parent = parents_[find(id)];
+		return parent == hierarchyNone ? id : ids_[parent];
+	}
+
+	size_t hierarchy::size() const
+	{
+		return size_;
+	}
+
+	vec3 hierarchy::translation(size_t id) const
+	{
+		return translations_[find(id)];
+	}
+
+	void hierarchy::translation(size_t id, vec3 value)
+	{
+		uint32_t position = find(id);
+		translations_[position] = value;
+		dirty_[position] = 1;
+	}
+
+	quat hierarchy::rotation(size_t id) const
+	{
+		return rotations_[find(id)];
+	}
+
+	void hierarchy::rotation(size_t id, quat value)
+	{
+		uint32_t position = find(id);
+		rotations_[position] = value;
+		dirty_[position] = 1;
+	}
+
+	vec3 hierarchy::scale(size_t id) const
+	{
+		return scales_[find(id)];
+	}
+
+	void hierarchy::scale(size_t id, vec3 value)
+	{
+		uint32_t position = find(id);
+		scales_[position] = value;
+		dirty_[position] = 1;
+	}
+
+	void hierarchy::local(size_t id, vec3 translation, quat rotation, vec3 scale)
+	{
+		uint32_t position = find(id);
+		translations_[position] = translation;
+		rotations_[position] = rotation;
+		scales_[position] = scale;
+		dirty_[position] = 1;
+	}
+
+	size_t hierarchy::update()
+	{
+		if (!ordered_)
+		{
+			reorder();
+		}
+
+		// a node is recomputed if it changed or its parent was recomputed, which is known once the depth before is done, so its flag is set for the depth after
+		auto updateRange = [this](size_t begin, size_t end)
+		{
+			size_t count = 0;
+
+			for (size_t i = begin; i < end; i++)
+			{
+				uint32_t parent = parents_[i];
+
+				if (dirty_[i] == 0 && (parent == hierarchyNone || dirty_[parent] == 0))
+				{
+					continue;
+				}
+
+				dirty_[i] = 1;
+				count++;
+
+				if (parent == hierarchyNone)
+				{
+					hierarchyCompose(translations_[i], rotations_[i], scales_[i], worlds_[i]);
+				}
+				else
+				{
+					frame local;
+					hierarchyCompose(translations_[i], rotations_[i], scales_[i], local);
+					hierarchyMultiply(local, worlds_[parent], worlds_[i]);
+				}
+			}
+
+			return count;
+		};
+
+		size_t count = 0;
+
+		for (size_t depth = 0; depth + 1 < depths_.size(); depth++)
+		{
+			size_t begin = depths_[depth];
+			size_t end = depths_[depth + 1];
+
+			if (end - begin < hierarchyGrain * 2)
+			{
+				count += updateRange(begin, end);
+				continue;
+			}
+
+			std::vector<size_t> counts((end - begin + hierarchyGrain - 1) / hierarchyGrain, 0);
+
+			parallelFor(end - begin, hierarchyGrain, [&](size_t blockBegin, size_t blockEnd)
+			{
+				counts[blockBegin / hierarchyGrain] += updateRange(begin + blockBegin, begin + blockEnd);
+			});
+
+			for (size_t blockCount : counts)
+			{
+				count += blockCount;
+			}
+		}
+
+		std::fill(dirty_.begin(), dirty_.end(), 0);
+
+		return count;
+	}
+
+	mat4 hierarchy::world(size_t id) const
+	{
+		const frame& world = worlds_[find(id)];
+		mat4 result;
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				result(r, c) = world.rows[r][c];
+			}
+		}
+
+		return result;
+	}
+
+	void hierarchy::world(std::span<const size_t> ids, std::span<float> matrices) const
+	{
+		if (matrices.size() / 16 < ids.size())
+		{
+			throw std::invalid_argument("The matrices (" + std::to_string(matrices.size()) + ") are fewer than required (" + std::to_string(ids.size() * 16) + ").");
+		}
+
+		for (size_t i = 0; i < ids.size(); i++)
+		{
+			std::memcpy(matrices.data() + i * 16, worlds_[find(ids[i])].rows, sizeof(frame));
+		}
+	}
+
+	uint32_t hierarchy::find(size_t id) const
+	{
+		if (!contains(id))
+		{
+			throw std::invalid_argument("The id (" + std::to_string(id) + ") does not belong to a node in the hierarchy.");
+		}
+
+		return slots_[id];
+	}
+
+	size_t hierarchy::add(uint32_t parent, vec3 translation, quat rotation, vec3 scale)
+	{
+		if (ids_.size() >= hierarchyNone)
+		{
+			throw std::invalid_argument("The nodes (" + std::to_string(ids_.size()) + ") are already at the maximum (" + std::to_string(hierarchyNone) + ").");
+		}
+
+		uint32_t id;
+
+		if (freeIds_.empty())
+		{
+			id = (uint32_t)slots_.size();
+			slots_.push_back(0);
+		}
+		else
+		{
+			id = freeIds_.back();
+			freeIds_.pop_back();
+		}
+
+		frame identity;
+		hierarchyIdentity(identity);
+
+		slots_[id] = (uint32_t)ids_.size();
+		ids_.push_back(id);
+		parents_.push_back(parent);
+		firstChildren_.push_back(hierarchyNone);
+		nextSiblings_.push_back(hierarchyNone);
+		previousSiblings_.push_back(hierarchyNone);
+		translations_.push_back(translation);
+		rotations_.push_back(rotation);
+		scales_.push_back(scale);
+		worlds_.push_back(identity);
+		dirty_.push_back(1);
+		link(slots_[id]);
+		size_++;
+		ordered_ = false;
+
+		return id;
+	}
+
+	void hierarchy::link(uint32_t position)
+	{
+		uint32_t parent = parents_[position];
+		previousSiblings_[position] = hierarchyNone;
+		nextSiblings_[position] = hierarchyNone;
+
+		if (parent == hierarchyNone)
+		{
+			return;
+		}
+
+		uint32_t next = firstChildren_[parent];
+		nextSiblings_[position] = next;
+
+		if (next != hierarchyNone)
+		{
+			previousSiblings_[next] = position;
+		}
+
+		firstChildren_[parent] = position;
+	}
+
+	void hierarchy::unlink(uint32_t position)
+	{
+		uint32_t parent = parents_[position];
+		uint32_t previous = previousSiblings_[position];
+		uint32_t next = nextSiblings_[position];
+
+		if (parent == hierarchyNone)
+		{
+			return;
+		}
+
+		if (previous != hierarchyNone)
+		{
+			nextSiblings_[previous] = next;
+		}
+		else
+		{
+			firstChildren_[parent] = next;
+		}
+
+		if (next != hierarchyNone)
+		{
+			previousSiblings_[next] = previous;
+		}
+	}
+
+	void hierarchy::reorder()
+	{
+		size_t count = ids_.size();
+
+		// the children of each position, grouped by parent with a counting sort, in increasing order of position
+		offsets_.assign(count + 1, 0);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (ids_[i] != hierarchyNone && parents_[i] != hierarchyNone)
+			{
+				offsets_[parents_[i]]++;
+			}
+		}
+
+		for (size_t i = 1; i <= count; i++)
+		{
+			offsets_[i] += offsets_[i - 1];
+		}
+
+		children_.resize(offsets_[count]);
+
+		for (size_t i = count; i-- > 0;)
+		{
+			if (ids_[i] != hierarchyNone && parents_[i] != hierarchyNone)
+			{
+				children_[--offsets_[parents_[i]]] = (uint32_t)i;
+			}
+		}
+
+		// the root nodes, then their children, then the children of those, noting where each depth starts
+		order_.clear();
+		depths_.assign(1, 0);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (ids_[i] != hierarchyNone && parents_[i] == hierarchyNone)
+			{
+				order_.push_back((uint32_t)i);
+			}
+		}
+
+		size_t depthEnd = order_.size();
+
+		for (size_t head = 0; head < order_.size(); head++)
+		{
+			if (head == depthEnd)
+			{
+				depths_.push_back(head);
+				depthEnd = order_.size();
+			}
+
+			uint32_t position = order_[head];
+			order_.insert(order_.end(), children_.begin() + offsets_[position], children_.begin() + offsets_[position + 1]);
+		}
+
+		if (!order_.empty())
+		{
+			depths_.push_back(order_.size());
+		}
+
+		hierarchyGather(ids_, order_);
+		hierarchyGather(parents_, order_);
+		hierarchyGather(translations_, order_);
+		hierarchyGather(rotations_, order_);
+		hierarchyGather(scales_, order_);
+		hierarchyGather(worlds_, order_);
+		hierarchyGather(dirty_, order_);
+
+		// the new position of each old position, to renumber the parents and the slots
+		for (size_t i = 0; i < order_.size(); i++)
+		{
+			offsets_[order_[i]] = (uint32_t)i;
+		}
+
+		for (size_t i = 0; i < order_.size(); i++)
+		{
+			if (parents_[i] != hierarchyNone)
+			{
+				parents_[i] = offsets_[parents_[i]];
+			}
+
+			slots_[ids_[i]] = (uint32_t)i;
+		}
+
+		// the links to the children are rebuilt at the new positions, each parent listing its children in order
+		firstChildren_.assign(order_.size(), hierarchyNone);
+		nextSiblings_.resize(order_.size());
+		previousSiblings_.resize(order_.size());
+
+		for (size_t i = order_.size(); i-- > 0;)
+		{
+			link((uint32_t)i);
+		}
+
+		ordered_ = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "../INC/Aurora/Mathematics/iaabb2.h"
+
+#include <algorithm>
+#include <limits>
+#include "../INC/Aurora/Mathematics/aabb2.h"
+#include "../INC/Aurora/Mathematics/irect.h"
+#include "../INC/Aurora/Mathematics/ivec2.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	iaabb2::iaabb2()
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::numeric_limits<int>::max();
+			max_[i] = std::numeric_limits<int>::min();
+		}
+	}
+
+	iaabb2::iaabb2(ivec2 min, ivec2 max)
+	{
+		min_[0] = min.x;
+		min_[1] = min.y;
+		max_[0] = max.x;
+		max_[1] = max.y;
+	}
+
+	iaabb2::iaabb2(irect value)
+	{
+		int x0 = value.x();
+		int x1 = value.x() + value.width();
+		int y0 = value.y();
+		int y1 = value.y() + value.height();
+
+		min_[0] = std::min(x0, x1);
+		min_[1] = std::min(y0, y1);
+		max_[0] = std::max(x0, x1);
+		max_[1] = std::max(y0, y1);
+	}
+
+	ivec2 iaabb2::min() const
+	{
+		return ivec2(min_[0], min_[1]);
+	}
+
+	void iaabb2::min(ivec2 value)
+	{
+		min_[0] = value.x;
+		min_[1] = value.y;
+	}
+
+	ivec2 iaabb2::max() const
+	{
+		return ivec2(max_[0], max_[1]);
+	}
+
+	void iaabb2::max(ivec2 value)
+	{
+		max_[0] = value.x;
+		max_[1] = value.y;
+	}
+
+	vec2 iaabb2::center() const
+	{
+		return vec2((static_cast<float>(min_[0]) + static_cast<float>(max_[0])) * 0.5f, (static_cast<float>(min_[1]) + static_cast<float>(max_[1])) * 0.5f);
+	}
+
+	ivec2 iaabb2::size() const
+	{
+		if (empty())
+		{
+			return ivec2(0, 0);
+		}
+
+		return ivec2(max_[0] - min_[0], max_[1] - min_[1]);
+	}
+
+	bool iaabb2::empty() const
+	{
+		// the lanes are compared into masks and only then combined, so the test compiles to one packed comparison
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = max_[i] < min_[i] ? -1 : 0;
+		}
+
+		return (mask[0] | mask[1]) != 0;
+	}
+
+	int iaabb2::area() const
+	{
+		if (empty())
+		{
+			return 0;
+		}
+
+		return (max_[0] - min_[0]) * (max_[1] - min_[1]);
+	}
+
+	int iaabb2::perimeter() const
+	{
+		if (empty())
+		{
+			return 0;
+		}
+
+		return 2 * ((max_[0] - min_[0]) + (max_[1] - min_[1]));
+	}
+
+	bool iaabb2::inside(const iaabb2& value, ivec2 point)
+	{
+		return value.inside(point);
+	}
+
+	bool iaabb2::inside(ivec2 point) const
+	{
+		int p[2] = { point.x, point.y };
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (p[i] >= min_[i] ? -1 : 0) & (p[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool iaabb2::inside(const iaabb2& value1, const iaabb2& value2)
+	{
+		return value1.inside(value2);
+	}
+
+	bool iaabb2::inside(const iaabb2& value) const
+	{
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (value.min_[i] >= min_[i] ? -1 : 0) & (value.max_[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool iaabb2::intersects(const iaabb2& value1, const iaabb2& value2)
+	{
+		return value1.intersects(value2);
+	}
+
+	bool iaabb2::intersects(const iaabb2& other) const
+	{
+		// the boxes overlap where the larger minimum is below the smaller maximum on every axis
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = std::max(min_[i], other.min_[i]) < std::min(max_[i], other.max_[i]) ? -1 : 0;
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	iaabb2 iaabb2::intersection(const iaabb2& value1, const iaabb2& value2)
+	{
+		iaabb2 result;
+
+		for (int i = 0; i < 2; i++)
+		{
+			result.min_[i] = std::max(value1.min_[i], value2.min_[i]);
+			result.max_[i] = std::min(value1.max_[i], value2.max_[i]);
+		}
+
+		return result;
+	}
+
+	iaabb2 iaabb2::merge(const iaabb2& value1, const iaabb2& value2)
+	{
+		iaabb2 result = value1;
+		result.merge(value2);
+		return result;
+	}
+
+	void iaabb2::merge(const iaabb2& value)
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::min(min_[i], value.min_[i]);
+			max_[i] = std::max(max_[i], value.max_[i]);
+		}
+	}
+
+	iaabb2 iaabb2::merge(const iaabb2& value, ivec2 point)
+	{
+		iaabb2 result = value;
+		result.merge(point);
+		return result;
+	}
+
+	void iaabb2::merge(ivec2 point)
+	{
+		int p[2] = { point.x, point.y };
+
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] = std::min(min_[i], p[i]);
+			max_[i] = std::max(max_[i], p[i]);
+		}
+	}
+
+	iaabb2 iaabb2::expand(const iaabb2& value, int amount)
+	{
+		iaabb2 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void iaabb2::expand(int amount)
+	{
+		// an empty rectangle holds the extremes of int, which moving would overflow, and stays empty
+		if (empty())
+		{
+			return;
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] -= amount;
+			max_[i] += amount;
+		}
+	}
+
+	iaabb2 iaabb2::expand(const iaabb2& value, ivec2 amount)
+	{
+		iaabb2 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void iaabb2::expand(ivec2 amount)
+	{
+		if (empty())
+		{
+			return;
+		}
+
+		int a[2] = { amount.x, amount.y };
+
+		for (int i = 0; i < 2; i++)
+		{
+			min_[i] -= a[i];
+			max_[i] += a[i];
+		}
+	}
+
+	bool iaabb2::operator==(const iaabb2& other) const
+	{
+		int mask[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			mask[i] = (min_[i] == other.min_[i] ? -1 : 0) & (max_[i] == other.max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1]) != 0;
+	}
+
+	bool iaabb2::operator!=(const iaabb2& other) const
+	{
+		return !((*this) == other);
+	}
+
+	iaabb2::operator irect() const
+	{
+		if (empty())
+		{
+			return irect(0, 0, 0, 0);
+		}
+
+		return irect(min_[0], min_[1], max_[0] - min_[0], max_[1] - min_[1]);
+	}
+
+	iaabb2::operator aabb2() const
+	{
+		if (empty())
+		{
+			return aabb2();
+		}
+
+		return aabb2(vec2(static_cast<float>(min_[0]), static_cast<float>(min_[1])), vec2(static_cast<float>(max_[0]), static_cast<float>(max_[1])));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "../INC/Aurora/Mathematics/iaabb3.h"
+
+#include <algorithm>
+#include <limits>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/ibounds.h"
+#include "../INC/Aurora/Mathematics/ivec3.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	iaabb3::iaabb3()
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] = std::numeric_limits<int>::max();
+			max_[i] = std::numeric_limits<int>::min();
+		}
+
+		min_[3] = std::numeric_limits<int>::min();
+		max_[3] = std::numeric_limits<int>::max();
+	}
+
+	iaabb3::iaabb3(ivec3 min, ivec3 max)
+	{
+		min_[0] = min.x;
+		min_[1] = min.y;
+		min_[2] = min.z;
+		min_[3] = std::numeric_limits<int>::min();
+		max_[0] = max.x;
+		max_[1] = max.y;
+		max_[2] = max.z;
+		max_[3] = std::numeric_limits<int>::max();
+	}
+
+	iaabb3::iaabb3(ibounds value)
+	{
+		int x0 = value.x();
+		int x1 = value.x() + value.width();
+		int y0 = value.y();
+		int y1 = value.y() + value.height();
+		int z0 = value.z();
+		int z1 = value.z() + value.depth();
+
+		min_[0] = std::min(x0, x1);
+		min_[1] = std::min(y0, y1);
+		min_[2] = std::min(z0, z1);
+		min_[3] = std::numeric_limits<int>::min();
+		max_[0] = std::max(x0, x1);
+		max_[1] = std::max(y0, y1);
+		max_[2] = std::max(z0, z1);
+		max_[3] = std::numeric_limits<int>::max();
+	}
+
+	ivec3 iaabb3::min() const
+	{
+		return ivec3(min_[0], min_[1], min_[2]);
+	}
+
+	void iaabb3::min(ivec3 value)
+	{
+		min_[0] = value.x;
+		min_[1] = value.y;
+		min_[2] = value.z;
+	}
+
+	ivec3 iaabb3::max() const
+	{
+		return ivec3(max_[0], max_[1], max_[2]);
+	}
+
+	void iaabb3::max(ivec3 value)
+	{
+		max_[0] = value.x;
+		max_[1] = value.y;
+		max_[2] = value.z;
+	}
+
+	vec3 iaabb3::center() const
+	{
+		return vec3((static_cast<float>(min_[0]) + static_cast<float>(max_[0])) * 0.5f, (static_cast<float>(min_[1]) + static_cast<float>(max_[1])) * 0.5f, (static_cast<float>(min_[2]) + static_cast<float>(max_[2])) * 0.5f);
+	}
+
+	ivec3 iaabb3::size() const
+	{
+		if (empty())
+		{
+			return ivec3(0, 0, 0);
+		}
+
+		return ivec3(max_[0] - min_[0], max_[1] - min_[1], max_[2] - min_[2]);
+	}
+
+	bool iaabb3::empty() const
+	{
+		// the lanes are compared into masks and only then combined, so the test compiles to one packed comparison
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = max_[i] < min_[i] ? -1 : 0;
+		}
+
+		return (mask[0] | mask[1] | mask[2] | mask[3]) != 0;
+	}
+
+	int iaabb3::surfaceArea() const
+	{
+		if (empty())
+		{
+			return 0;
+		}
+
+		int w = max_[0] - min_[0];
+		int h = max_[1] - min_[1];
+		int d = max_[2] - min_[2];
+
+		return 2 * (w * h + w * d + h * d);
+	}
+
+	int iaabb3::volume() const
+	{
+		if (empty())
+		{
+			return 0;
+		}
+
+		return (max_[0] - min_[0]) * (max_[1] - min_[1]) * (max_[2] - min_[2]);
+	}
+
+	bool iaabb3::inside(const iaabb3& value, ivec3 point)
+	{
+		return value.inside(point);
+	}
+
+	bool iaabb3::inside(ivec3 point) const
+	{
+		int p[4] = { point.x, point.y, point.z, 0 };
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (p[i] >= min_[i] ? -1 : 0) & (p[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool iaabb3::inside(const iaabb3& value1, const iaabb3& value2)
+	{
+		return value1.inside(value2);
+	}
+
+	bool iaabb3::inside(const iaabb3& value) const
+	{
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (value.min_[i] >= min_[i] ? -1 : 0) & (value.max_[i] <= max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool iaabb3::intersects(const iaabb3& value1, const iaabb3& value2)
+	{
+		return value1.intersects(value2);
+	}
+
+	bool iaabb3::intersects(const iaabb3& other) const
+	{
+		// the boxes overlap where the larger minimum is below the smaller maximum on every axis
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = std::max(min_[i], other.min_[i]) < std::min(max_[i], other.max_[i]) ? -1 : 0;
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	iaabb3 iaabb3::intersection(const iaabb3& value1, const iaabb3& value2)
+	{
+		iaabb3 result;
+
+		for (int i = 0; i < 4; i++)
+		{
+			result.min_[i] = std::max(value1.min_[i], value2.min_[i]);
+			result.max_[i] = std::min(value1.max_[i], value2.max_[i]);
+		}
+
+		return result;
+	}
+
+	iaabb3 iaabb3::merge(const iaabb3& value1, const iaabb3& value2)
+	{
+		iaabb3 result = value1;
+		result.merge(value2);
+		return result;
+	}
+
+	void iaabb3::merge(const iaabb3& value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			min_[i] = std::min(min_[i], value.min_[i]);
+			max_[i] = std::max(max_[i], value.max_[i]);
+		}
+	}
+
+	iaabb3 iaabb3::merge(const iaabb3& value, ivec3 point)
+	{
+		iaabb3 result = value;
+		result.merge(point);
+		return result;
+	}
+
+	void iaabb3::merge(ivec3 point)
+	{
+		int p[4] = { point.x, point.y, point.z, 0 };
+
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] = std::min(min_[i], p[i]);
+			max_[i] = std::max(max_[i], p[i]);
+		}
+	}
+
+	iaabb3 iaabb3::expand(const iaabb3& value, int amount)
+	{
+		iaabb3 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void iaabb3::expand(int amount)
+	{
+		// an empty box holds the extremes of int, which moving would overflow, and stays empty
+		if (empty())
+		{
+			return;
+		}
+
+		// the unused lane is left alone, it is already unbounded
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] -= amount;
+			max_[i] += amount;
+		}
+	}
+
+	iaabb3 iaabb3::expand(const iaabb3& value, ivec3 amount)
+	{
+		iaabb3 result = value;
+		result.expand(amount);
+		return result;
+	}
+
+	void iaabb3::expand(ivec3 amount)
+	{
+		if (empty())
+		{
+			return;
+		}
+
+		int a[3] = { amount.x, amount.y, amount.z };
+
+		for (int i = 0; i < 3; i++)
+		{
+			min_[i] -= a[i];
+			max_[i] += a[i];
+		}
+	}
+
+	bool iaabb3::operator==(const iaabb3& other) const
+	{
+		int mask[4];
+
+		for (int i = 0; i < 4; i++)
+		{
+			mask[i] = (min_[i] == other.min_[i] ? -1 : 0) & (max_[i] == other.max_[i] ? -1 : 0);
+		}
+
+		return (mask[0] & mask[1] & mask[2] & mask[3]) != 0;
+	}
+
+	bool iaabb3::operator!=(const iaabb3& other) const
+	{
+		return !((*this) == other);
+	}
+
+	iaabb3::operator ibounds() const
+	{
+		if (empty())
+		{
+			return ibounds(0, 0, 0, 0, 0, 0);
+		}
+
+		return ibounds(min_[0], min_[1], min_[2], max_[0] - min_[0], max_[1] - min_[1], max_[2] - min_[2]);
+	}
+
+	iaabb3::operator aabb3() const
+	{
+		if (empty())
+		{
+			return aabb3();
+		}
+
+		return aabb3(vec3(static_cast<float>(min_[0]), static_cast<float>(min_[1]), static_cast<float>(min_[2])), vec3(static_cast<float>(max_[0]), static_cast<float>(max_[1]), static_cast<float>(max_[2])));
+	}
+}
\ No newline at end of file
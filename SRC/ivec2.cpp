@@ -9,11 +9,124 @@
 #include "../INC/Aurora/Mathematics/vec4.h"
 #include "../INC/Aurora/Mathematics/ivec3.h"
 #include "../INC/Aurora/Mathematics/ivec4.h"
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
+#if defined(__BMI2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace Aurora::Mathematics
 {
+    namespace
+    {
+        // spreads the lowest 16 bits of a value to the even bits of the result
+        inline uint32_t ivec2Spread(uint32_t value)
+        {
+            value &= 0x0000FFFF;
+            value = (value | (value << 8)) & 0x00FF00FF;
+            value = (value | (value << 4)) & 0x0F0F0F0F;
+            value = (value | (value << 2)) & 0x33333333;
+            value = (value | (value << 1)) & 0x55555555;
+
+            return value;
+        }
+
+        // gathers the even bits of a value into the lowest 16 bits of the result
+        inline uint32_t ivec2Compact(uint32_t value)
+        {
+            value &= 0x55555555;
+            value = (value | (value >> 1)) & 0x33333333;
+            value = (value | (value >> 2)) & 0x0F0F0F0F;
+            value = (value | (value >> 4)) & 0x00FF00FF;
+            value = (value | (value >> 8)) & 0x0000FFFF;
+
+            return value;
+        }
+
+        inline uint64_t ivec2Spread(uint64_t value)
+        {
+            value &= 0x00000000FFFFFFFFull;
+            value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+            value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+            value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            value = (value | (value << 2)) & 0x3333333333333333ull;
+            value = (value | (value << 1)) & 0x5555555555555555ull;
+
+            return value;
+        }
+
+        inline uint64_t ivec2Compact(uint64_t value)
+        {
+            value &= 0x5555555555555555ull;
+            value = (value | (value >> 1)) & 0x3333333333333333ull;
+            value = (value | (value >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+            value = (value | (value >> 4)) & 0x00FF00FF00FF00FFull;
+            value = (value | (value >> 8)) & 0x0000FFFF0000FFFFull;
+            value = (value | (value >> 16)) & 0x00000000FFFFFFFFull;
+
+            return value;
+        }
+
+        // the table stepping through Skilling, "Programming the Hilbert curve", 2004, one level at a time, indexed by the current entry with its low 2 bits cleared plus the quadrant of the cell at the level, and holding the 2 bits of the index at the level plus 4 times the next state
+        struct ivec2HilbertTable
+        {
+            uint8_t entries[16 * 4];
+        };
+
+        // at every level Skilling's transform only inverts and swaps the bits of the axes below it, and the Gray code decoding after it only needs the parity of the bits above, so a state is whether the axes are swapped, the inversion of each, and that parity
+        constexpr ivec2HilbertTable ivec2CreateHilbertTable()
+        {
+            ivec2HilbertTable table{};
+
+            for (int state = 0; state < 16; state++)
+            {
+                for (int quadrant = 0; quadrant < 4; quadrant++)
+                {
+                    int axes[2] = { state / 8, 1 - state / 8 };
+                    int inversions = (state / 2) % 4;
+                    int parity = state % 2;
+                    int bits[2];
+
+                    for (int i = 0; i < 2; i++)
+                    {
+                        bits[i] = ((quadrant >> axes[i]) ^ (inversions >> i)) & 1;
+                    }
+
+                    for (int i = 0; i < 2; i++)
+                    {
+                        if (bits[i] != 0)
+                        {
+                            inversions ^= 1;
+                        }
+                        else
+                        {
+                            int axis = axes[0];
+                            axes[0] = axes[i];
+                            axes[i] = axis;
+
+                            if (((inversions ^ (inversions >> i)) & 1) != 0)
+                            {
+                                inversions ^= 1 | (1 << i);
+                            }
+                        }
+                    }
+
+                    int gray[2] = { bits[0], bits[0] ^ bits[1] };
+                    int next = (axes[0] * 4 + inversions) * 2 + (parity ^ gray[1]);
+                    int index = ((gray[0] ^ parity) << 1) | (gray[1] ^ parity);
+
+                    table.entries[state * 4 + quadrant] = (uint8_t)(next * 4 + index);
+                }
+            }
+
+            return table;
+        }
+
+        constexpr ivec2HilbertTable ivec2Hilbert = ivec2CreateHilbertTable();
+    }
+
     ivec2 ivec2::zero()
     {
         return ivec2(0, 0);
@@ -275,6 +388,66 @@ namespace Aurora::Mathematics
         );
     }
 
+    ivec2 ivec2::fromMorton32(uint32_t code)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return ivec2((int)_pext_u32(code, 0x55555555), (int)_pext_u32(code, 0xAAAAAAAA));
+#else
+        return ivec2((int)ivec2Compact(code), (int)ivec2Compact(code >> 1));
+#endif
+    }
+
+    ivec2 ivec2::fromMorton64(uint64_t code)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return ivec2((int)(uint32_t)_pext_u64(code, 0x5555555555555555ull), (int)(uint32_t)_pext_u64(code, 0xAAAAAAAAAAAAAAAAull));
+#else
+        return ivec2((int)(uint32_t)ivec2Compact(code), (int)(uint32_t)ivec2Compact(code >> 1));
+#endif
+    }
+
+    size_t ivec2::hash(ivec2 value)
+    {
+        // each component is spread by its own odd constant, then the high half is folded into the low half around a multiply so every input bit reaches every output bit
+        uint64_t result = (uint64_t)(uint32_t)value.x * 0x9E3779B97F4A7C15ull ^ (uint64_t)(uint32_t)value.y * 0xC2B2AE3D27D4EB4Full;
+
+        result ^= result >> 32;
+        result *= 0xD6E8FEB86659FD93ull;
+        result ^= result >> 32;
+
+        return (size_t)result;
+    }
+
+    uint32_t ivec2::hilbert32(ivec2 value)
+    {
+        uint32_t code = morton32(value);
+        uint32_t result = 0;
+        uint32_t entry = 0;
+
+        for (int shift = 30; shift >= 0; shift -= 2)
+        {
+            entry = ivec2Hilbert.entries[(entry & ~3u) | ((code >> shift) & 3)];
+            result = (result << 2) | (entry & 3);
+        }
+
+        return result;
+    }
+
+    uint64_t ivec2::hilbert64(ivec2 value)
+    {
+        uint64_t code = morton64(value);
+        uint64_t result = 0;
+        uint32_t entry = 0;
+
+        for (int shift = 62; shift >= 0; shift -= 2)
+        {
+            entry = ivec2Hilbert.entries[(entry & ~3u) | (uint32_t)((code >> shift) & 3)];
+            result = (result << 2) | (entry & 3);
+        }
+
+        return result;
+    }
+
     ivec2 ivec2::max(ivec2 value1, ivec2 value2)
     {
         return ivec2(
@@ -291,6 +464,25 @@ namespace Aurora::Mathematics
         );
     }
 
+    uint32_t ivec2::morton32(ivec2 value)
+    {
+        // pdep deposits the bits of each component at the set bits of its mask in one instruction, and is also used on every processor with AVX2 since MSVC does not define __BMI2__
+#if defined(__BMI2__) || defined(__AVX2__)
+        return _pdep_u32((uint32_t)value.x, 0x55555555) | _pdep_u32((uint32_t)value.y, 0xAAAAAAAA);
+#else
+        return ivec2Spread((uint32_t)value.x) | (ivec2Spread((uint32_t)value.y) << 1);
+#endif
+    }
+
+    uint64_t ivec2::morton64(ivec2 value)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return _pdep_u64((uint32_t)value.x, 0x5555555555555555ull) | _pdep_u64((uint32_t)value.y, 0xAAAAAAAAAAAAAAAAull);
+#else
+        return ivec2Spread((uint64_t)(uint32_t)value.x) | (ivec2Spread((uint64_t)(uint32_t)value.y) << 1);
+#endif
+    }
+
     ivec2 ivec2::perpendicular(ivec2 value)
     {
         return ivec2(-value.y, value.x);
@@ -580,4 +772,4 @@ namespace Aurora::Mathematics
     {
         return vec4(x, y, 0, 0);
     }
-}
+}
\ No newline at end of file
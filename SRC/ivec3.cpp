@@ -9,11 +9,132 @@
 #include "../INC/Aurora/Mathematics/vec4.h"
 #include "../INC/Aurora/Mathematics/ivec2.h"
 #include "../INC/Aurora/Mathematics/ivec4.h"
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
+#if defined(__BMI2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace Aurora::Mathematics
 {
+    namespace
+    {
+        // spreads the lowest 10 bits of a value to every third bit of the result, starting at the lowest
+        inline uint32_t ivec3Spread(uint32_t value)
+        {
+            value &= 0x000003FF;
+            value = (value | (value << 16)) & 0x030000FF;
+            value = (value | (value << 8)) & 0x0300F00F;
+            value = (value | (value << 4)) & 0x030C30C3;
+            value = (value | (value << 2)) & 0x09249249;
+
+            return value;
+        }
+
+        // gathers every third bit of a value, starting at the lowest, into the lowest 10 bits of the result
+        inline uint32_t ivec3Compact(uint32_t value)
+        {
+            value &= 0x09249249;
+            value = (value | (value >> 2)) & 0x030C30C3;
+            value = (value | (value >> 4)) & 0x0300F00F;
+            value = (value | (value >> 8)) & 0x030000FF;
+            value = (value | (value >> 16)) & 0x000003FF;
+
+            return value;
+        }
+
+        inline uint64_t ivec3Spread(uint64_t value)
+        {
+            value &= 0x00000000001FFFFFull;
+            value = (value | (value << 32)) & 0x001F00000000FFFFull;
+            value = (value | (value << 16)) & 0x001F0000FF0000FFull;
+            value = (value | (value << 8)) & 0x100F00F00F00F00Full;
+            value = (value | (value << 4)) & 0x10C30C30C30C30C3ull;
+            value = (value | (value << 2)) & 0x1249249249249249ull;
+
+            return value;
+        }
+
+        inline uint64_t ivec3Compact(uint64_t value)
+        {
+            value &= 0x1249249249249249ull;
+            value = (value | (value >> 2)) & 0x10C30C30C30C30C3ull;
+            value = (value | (value >> 4)) & 0x100F00F00F00F00Full;
+            value = (value | (value >> 8)) & 0x001F0000FF0000FFull;
+            value = (value | (value >> 16)) & 0x001F00000000FFFFull;
+            value = (value | (value >> 32)) & 0x00000000001FFFFFull;
+
+            return value;
+        }
+
+        // the table stepping through Skilling, "Programming the Hilbert curve", 2004, one level at a time, indexed by the current entry with its low 3 bits cleared plus the octant of the cell at the level, and holding the 3 bits of the index at the level plus 8 times the next state
+        struct ivec3HilbertTable
+        {
+            uint16_t entries[96 * 8];
+        };
+
+        // at every level Skilling's transform only inverts and swaps the bits of the axes below it, and the Gray code decoding after it only needs the parity of the bits above, so a state is a permutation of the axes, the inversion of each, and that parity
+        constexpr ivec3HilbertTable ivec3CreateHilbertTable()
+        {
+            constexpr int permutations[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+            ivec3HilbertTable table{};
+
+            for (int state = 0; state < 96; state++)
+            {
+                for (int octant = 0; octant < 8; octant++)
+                {
+                    int axes[3] = { permutations[state / 16][0], permutations[state / 16][1], permutations[state / 16][2] };
+                    int inversions = (state / 2) % 8;
+                    int parity = state % 2;
+                    int bits[3];
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        bits[i] = ((octant >> axes[i]) ^ (inversions >> i)) & 1;
+                    }
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        if (bits[i] != 0)
+                        {
+                            inversions ^= 1;
+                        }
+                        else
+                        {
+                            int axis = axes[0];
+                            axes[0] = axes[i];
+                            axes[i] = axis;
+
+                            if (((inversions ^ (inversions >> i)) & 1) != 0)
+                            {
+                                inversions ^= 1 | (1 << i);
+                            }
+                        }
+                    }
+
+                    int gray[3] = { bits[0], bits[0] ^ bits[1], bits[0] ^ bits[1] ^ bits[2] };
+                    int permutation = 0;
+
+                    while (permutations[permutation][0] != axes[0] || permutations[permutation][1] != axes[1])
+                    {
+                        permutation++;
+                    }
+
+                    int next = (permutation * 8 + inversions) * 2 + (parity ^ gray[2]);
+                    int index = ((gray[0] ^ parity) << 2) | ((gray[1] ^ parity) << 1) | (gray[2] ^ parity);
+
+                    table.entries[state * 8 + octant] = (uint16_t)(next * 8 + index);
+                }
+            }
+
+            return table;
+        }
+
+        constexpr ivec3HilbertTable ivec3Hilbert = ivec3CreateHilbertTable();
+    }
+
     ivec3 ivec3::zero()
     {
         return ivec3(0, 0, 0);
@@ -901,6 +1022,66 @@ namespace Aurora::Mathematics
         );
     }
 
+    ivec3 ivec3::fromMorton32(uint32_t code)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return ivec3((int)_pext_u32(code, 0x09249249), (int)_pext_u32(code, 0x12492492), (int)_pext_u32(code, 0x24924924));
+#else
+        return ivec3((int)ivec3Compact(code), (int)ivec3Compact(code >> 1), (int)ivec3Compact(code >> 2));
+#endif
+    }
+
+    ivec3 ivec3::fromMorton64(uint64_t code)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return ivec3((int)_pext_u64(code, 0x1249249249249249ull), (int)_pext_u64(code, 0x2492492492492492ull), (int)_pext_u64(code, 0x4924924924924924ull));
+#else
+        return ivec3((int)ivec3Compact(code), (int)ivec3Compact(code >> 1), (int)ivec3Compact(code >> 2));
+#endif
+    }
+
+    size_t ivec3::hash(ivec3 value)
+    {
+        // each component is spread by its own odd constant, then the high half is folded into the low half around a multiply so every input bit reaches every output bit
+        uint64_t result = (uint64_t)(uint32_t)value.x * 0x9E3779B97F4A7C15ull ^ (uint64_t)(uint32_t)value.y * 0xC2B2AE3D27D4EB4Full ^ (uint64_t)(uint32_t)value.z * 0x165667B19E3779F9ull;
+
+        result ^= result >> 32;
+        result *= 0xD6E8FEB86659FD93ull;
+        result ^= result >> 32;
+
+        return (size_t)result;
+    }
+
+    uint32_t ivec3::hilbert32(ivec3 value)
+    {
+        uint32_t code = morton32(value);
+        uint32_t result = 0;
+        uint32_t entry = 0;
+
+        for (int shift = 27; shift >= 0; shift -= 3)
+        {
+            entry = ivec3Hilbert.entries[(entry & ~7u) | ((code >> shift) & 7)];
+            result = (result << 3) | (entry & 7);
+        }
+
+        return result;
+    }
+
+    uint64_t ivec3::hilbert64(ivec3 value)
+    {
+        uint64_t code = morton64(value);
+        uint64_t result = 0;
+        uint32_t entry = 0;
+
+        for (int shift = 60; shift >= 0; shift -= 3)
+        {
+            entry = ivec3Hilbert.entries[(entry & ~7u) | (uint32_t)((code >> shift) & 7)];
+            result = (result << 3) | (entry & 7);
+        }
+
+        return result;
+    }
+
     ivec3 ivec3::max(ivec3 value1, ivec3 value2)
     {
         return ivec3(
@@ -919,6 +1100,25 @@ namespace Aurora::Mathematics
         );
     }
 
+    uint32_t ivec3::morton32(ivec3 value)
+    {
+        // pdep deposits the bits of each component at the set bits of its mask in one instruction, and is also used on every processor with AVX2 since MSVC does not define __BMI2__
+#if defined(__BMI2__) || defined(__AVX2__)
+        return _pdep_u32((uint32_t)value.x, 0x09249249) | _pdep_u32((uint32_t)value.y, 0x12492492) | _pdep_u32((uint32_t)value.z, 0x24924924);
+#else
+        return ivec3Spread((uint32_t)value.x) | (ivec3Spread((uint32_t)value.y) << 1) | (ivec3Spread((uint32_t)value.z) << 2);
+#endif
+    }
+
+    uint64_t ivec3::morton64(ivec3 value)
+    {
+#if defined(__BMI2__) || defined(__AVX2__)
+        return _pdep_u64((uint32_t)value.x, 0x1249249249249249ull) | _pdep_u64((uint32_t)value.y, 0x2492492492492492ull) | _pdep_u64((uint32_t)value.z, 0x4924924924924924ull);
+#else
+        return ivec3Spread((uint64_t)(uint32_t)value.x) | (ivec3Spread((uint64_t)(uint32_t)value.y) << 1) | (ivec3Spread((uint64_t)(uint32_t)value.z) << 2);
+#endif
+    }
+
     ivec3 ivec3::roundToInt(vec3 value)
     {
         return ivec3(
@@ -1237,4 +1437,4 @@ namespace Aurora::Mathematics
     {
         return vec4(x, y, z, 0);
     }
-}
+}
\ No newline at end of file
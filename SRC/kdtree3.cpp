@@ -0,0 +1,493 @@
+#include "../INC/Aurora/Mathematics/kdtree3.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of points copied by a thread at a time
+		constexpr size_t kdtree3Grain = 16384;
+
+		// number of points searched around by a thread at a time in the batch queries, each of which descends the tree
+		constexpr size_t kdtree3QueryGrain = 256;
+
+		// the most points in a leaf, which are cheaper to compare one after another than to split further
+		constexpr size_t kdtree3LeafSize = 8;
+
+		// the subtrees built on their own threads hold at least this many points, and there are at most about kdtree3SubtreeCount of them
+		constexpr size_t kdtree3SubtreeSize = 16384;
+
+		constexpr size_t kdtree3SubtreeCount = 64;
+
+		// marks a leaf in place of the axis of a node
+		constexpr uint32_t kdtree3Leaf = 3;
+
+		// splitting at the median leaves at most 8 points in a leaf within 30 levels, and a search holds at most one node per level, the farther child of each node on the path it is descending
+		constexpr size_t kdtree3StackSize = 64;
+
+		// a node waiting to be searched, with the squared distance to its cell
+		struct kdtree3Entry
+		{
+			uint32_t node;
+			float distance;
+		};
+
+		// written so that NaN components sort after every other point
+		inline float kdtree3Key(float value)
+		{
+			return value >= -std::numeric_limits<float>::infinity() ? value : std::numeric_limits<float>::infinity();
+		}
+
+		inline float kdtree3DistanceSquared(const float* position1, const float* position2)
+		{
+			float x = position1[0] - position2[0];
+			float y = position1[1] - position2[1];
+			float z = position1[2] - position2[2];
+
+			return x * x + y * y + z * z;
+		}
+	}
+
+	kdtree3::kdtree3() { }
+
+	kdtree3::kdtree3(std::span<const vec3> points)
+	{
+		build(points);
+	}
+
+	void kdtree3::build(std::span<const vec3> points)
+	{
+		if (points.size() > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::invalid_argument("The points (" + std::to_string(points.size()) + ") are more than the maximum (" + std::to_string(std::numeric_limits<uint32_t>::max()) + ").");
+		}
+
+		size_t count = points.size();
+
+		points_.resize(count);
+		nodes_.clear();
+
+		parallelFor(count, kdtree3Grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					points_[i] = { { points[i].x, points[i].y, points[i].z }, (uint32_t)i };
+				}
+			});
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		// the cell of the root is the bounds of the points, and the cell of every other node is the cell of its parent cut at the split, written as value selects so NaN components are skipped
+		float lower[3] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+		float upper[3] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+		for (const point& current : points_)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				lower[axis] = current.position[axis] < lower[axis] ? current.position[axis] : lower[axis];
+				upper[axis] = current.position[axis] > upper[axis] ? current.position[axis] : upper[axis];
+			}
+		}
+
+		// the first levels are split on the calling thread, leaving the subtrees below them as leaves that are then built on their own threads into their own arrays
+		std::vector<uint32_t> deferred;
+
+		subdivide(nodes_, 0, count, lower, upper, std::max(kdtree3SubtreeSize, count / kdtree3SubtreeCount), deferred);
+
+		std::vector<std::vector<node>> subtrees(deferred.size());
+
+		parallelFor(deferred.size(), 1, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const node& leaf = nodes_[deferred[i]];
+					float subtreeLower[3] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+					float subtreeUpper[3] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+					std::vector<uint32_t> none;
+
+					for (uint32_t j = leaf.first; j < leaf.second; j++)
+					{
+						for (int axis = 0; axis < 3; axis++)
+						{
+							subtreeLower[axis] = points_[j].position[axis] < subtreeLower[axis] ? points_[j].position[axis] : subtreeLower[axis];
+							subtreeUpper[axis] = points_[j].position[axis] > subtreeUpper[axis] ? points_[j].position[axis] : subtreeUpper[axis];
+						}
+					}
+
+					subdivide(subtrees[i], leaf.first, leaf.second, subtreeLower, subtreeUpper, 0, none);
+				}
+			});
+
+		// each subtree replaces its leaf with its root and appends the rest of its nodes, whose children move along with them
+		for (size_t i = 0; i < deferred.size(); i++)
+		{
+			const std::vector<node>& subtree = subtrees[i];
+			uint32_t offset = (uint32_t)nodes_.size() - 1;
+
+			for (size_t j = 0; j < subtree.size(); j++)
+			{
+				node moved = subtree[j];
+
+				if (moved.axis != kdtree3Leaf)
+				{
+					moved.first += offset;
+					moved.second += offset;
+				}
+
+				if (j == 0)
+				{
+					nodes_[deferred[i]] = moved;
+				}
+				else
+				{
+					nodes_.push_back(moved);
+				}
+			}
+		}
+	}
+
+	size_t kdtree3::size() const
+	{
+		return points_.size();
+	}
+
+	size_t kdtree3::nodeCount() const
+	{
+		return nodes_.size();
+	}
+
+	bool kdtree3::nearest(vec3 point, size_t& index, float& distance, float maxDistance, float epsilon) const
+	{
+		if (nodes_.empty())
+		{
+			return false;
+		}
+
+		float position[3] = { point.x, point.y, point.z };
+		float best = maxDistance * maxDistance;
+		// a cell is skipped once it is farther than the closest point found divided by 1 plus epsilon
+		float scale = (1.0f + epsilon) * (1.0f + epsilon);
+		size_t found = points_.size();
+
+		std::array<kdtree3Entry, kdtree3StackSize> stack;
+		size_t top = 0;
+
+		stack[top++] = { 0, 0.0f };
+
+		while (top > 0)
+		{
+			kdtree3Entry current = stack[--top];
+
+			if (current.distance * scale > best)
+			{
+				continue;
+			}
+
+			const node* visited = &nodes_[current.node];
+
+			// the search descends to the leaf on the side of the point, leaving the other child of each node to be searched after it
+			while (visited->axis != kdtree3Leaf)
+			{
+				float offset = position[visited->axis] - visited->split;
+				float squared = std::max(current.distance, offset * offset);
+
+				if (squared * scale <= best)
+				{
+					stack[top++] = { offset < 0.0f ? visited->second : visited->first, squared };
+				}
+
+				visited = &nodes_[offset < 0.0f ? visited->first : visited->second];
+			}
+
+			for (uint32_t i = visited->first; i < visited->second; i++)
+			{
+				float squared = kdtree3DistanceSquared(points_[i].position, position);
+
+				// points at infinity are not found even without a maximum distance
+				if (squared <= best && squared < std::numeric_limits<float>::infinity())
+				{
+					best = squared;
+					found = points_[i].index;
+				}
+			}
+		}
+
+		if (found == points_.size())
+		{
+			return false;
+		}
+
+		index = found;
+		distance = std::sqrt(best);
+		return true;
+	}
+
+	size_t kdtree3::nearest(vec3 point, std::span<size_t> indices, std::span<float> distances, float maxDistance, float epsilon) const
+	{
+		if (distances.size() < indices.size())
+		{
+			throw std::invalid_argument("The distances (" + std::to_string(distances.size()) + ") are fewer than required (" + std::to_string(indices.size()) + ").");
+		}
+
+		size_t count = indices.size();
+
+		if (nodes_.empty() || count == 0)
+		{
+			return 0;
+		}
+
+		float position[3] = { point.x, point.y, point.z };
+		// the squared distance to the farthest point kept once count points are found, and the maximum until then
+		float best = maxDistance * maxDistance;
+		float scale = (1.0f + epsilon) * (1.0f + epsilon);
+		size_t found = 0;
+
+		std::array<kdtree3Entry, kdtree3StackSize> stack;
+		size_t top = 0;
+
+		stack[top++] = { 0, 0.0f };
+
+		while (top > 0)
+		{
+			kdtree3Entry current = stack[--top];
+
+			if (current.distance * scale > best)
+			{
+				continue;
+			}
+
+			const node* visited = &nodes_[current.node];
+
+			while (visited->axis != kdtree3Leaf)
+			{
+				float offset = position[visited->axis] - visited->split;
+				float squared = std::max(current.distance, offset * offset);
+
+				if (squared * scale <= best)
+				{
+					stack[top++] = { offset < 0.0f ? visited->second : visited->first, squared };
+				}
+
+				visited = &nodes_[offset < 0.0f ? visited->first : visited->second];
+			}
+
+			for (uint32_t i = visited->first; i < visited->second; i++)
+			{
+				float squared = kdtree3DistanceSquared(points_[i].position, position);
+
+				if (!(squared <= best && squared < std::numeric_limits<float>::infinity()))
+				{
+					continue;
+				}
+
+				// the points found are kept sorted in the results, holding squared distances until the search ends, and once they are full the farthest is dropped
+				size_t j = found < count ? found++ : count - 1;
+
+				while (j > 0 && distances[j - 1] > squared)
+				{
+					indices[j] = indices[j - 1];
+					distances[j] = distances[j - 1];
+					j--;
+				}
+
+				indices[j] = points_[i].index;
+				distances[j] = squared;
+
+				if (found == count)
+				{
+					best = distances[count - 1];
+				}
+			}
+		}
+
+		for (size_t i = 0; i < found; i++)
+		{
+			distances[i] = std::sqrt(distances[i]);
+		}
+
+		return found;
+	}
+
+	void kdtree3::nearest(std::span<const vec3> points, size_t count, std::span<size_t> indices, std::span<float> distances, float maxDistance, float epsilon) const
+	{
+		size_t required = points.size() * count;
+
+		if (indices.size() < required)
+		{
+			throw std::invalid_argument("The indices (" + std::to_string(indices.size()) + ") are fewer than required (" + std::to_string(required) + ").");
+		}
+
+		if (distances.size() < required)
+		{
+			throw std::invalid_argument("The distances (" + std::to_string(distances.size()) + ") are fewer than required (" + std::to_string(required) + ").");
+		}
+
+		parallelFor(points.size(), kdtree3QueryGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					std::span<size_t> pointIndices = indices.subspan(i * count, count);
+					std::span<float> pointDistances = distances.subspan(i * count, count);
+
+					for (size_t j = nearest(points[i], pointIndices, pointDistances, maxDistance, epsilon); j < count; j++)
+					{
+						pointIndices[j] = std::numeric_limits<size_t>::max();
+						pointDistances[j] = -1.0f;
+					}
+				}
+			});
+	}
+
+	void kdtree3::within(vec3 point, float radius, std::vector<size_t>& results) const
+	{
+		within(point, radius, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool kdtree3::within(vec3 point, float radius, callback<bool(size_t index)> visit) const
+	{
+		float position[3] = { point.x, point.y, point.z };
+		float best = radius * radius;
+
+		// written so that a NaN point or radius finds nothing
+		if (nodes_.empty() || !(radius >= 0.0f) || !(position[0] == position[0] && position[1] == position[1] && position[2] == position[2]))
+		{
+			return true;
+		}
+
+		std::array<kdtree3Entry, kdtree3StackSize> stack;
+		size_t top = 0;
+
+		stack[top++] = { 0, 0.0f };
+
+		while (top > 0)
+		{
+			kdtree3Entry current = stack[--top];
+			const node* visited = &nodes_[current.node];
+
+			while (visited->axis != kdtree3Leaf)
+			{
+				float offset = position[visited->axis] - visited->split;
+				float squared = std::max(current.distance, offset * offset);
+
+				if (squared <= best)
+				{
+					stack[top++] = { offset < 0.0f ? visited->second : visited->first, squared };
+				}
+
+				visited = &nodes_[offset < 0.0f ? visited->first : visited->second];
+			}
+
+			for (uint32_t i = visited->first; i < visited->second; i++)
+			{
+				if (kdtree3DistanceSquared(points_[i].position, position) <= best && !visit(points_[i].index))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void kdtree3::within(std::span<const vec3> points, float radius, std::span<size_t> offsets, std::vector<size_t>& results) const
+	{
+		if (offsets.size() < points.size() + 1)
+		{
+			throw std::invalid_argument("The offsets (" + std::to_string(offsets.size()) + ") are fewer than required (" + std::to_string(points.size() + 1) + ").");
+		}
+
+		// every block of points collects the indices it finds on its own, and the blocks are then appended in order
+		size_t blockCount = (points.size() + kdtree3QueryGrain - 1) / kdtree3QueryGrain;
+		std::vector<std::vector<size_t>> found(blockCount);
+
+		parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t block = begin; block < end; block++)
+				{
+					size_t last = std::min((block + 1) * kdtree3QueryGrain, points.size());
+
+					for (size_t i = block * kdtree3QueryGrain; i < last; i++)
+					{
+						offsets[i] = found[block].size();
+						within(points[i], radius, found[block]);
+					}
+				}
+			});
+
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			size_t last = std::min((block + 1) * kdtree3QueryGrain, points.size());
+
+			for (size_t i = block * kdtree3QueryGrain; i < last; i++)
+			{
+				offsets[i] += results.size();
+			}
+
+			results.insert(results.end(), found[block].begin(), found[block].end());
+		}
+
+		offsets[points.size()] = results.size();
+	}
+
+	uint32_t kdtree3::subdivide(std::vector<node>& nodes, size_t begin, size_t end, const float* lower, const float* upper, size_t limit, std::vector<uint32_t>& deferred)
+	{
+		uint32_t id = (uint32_t)nodes.size();
+
+		nodes.push_back({ 0.0f, kdtree3Leaf, (uint32_t)begin, (uint32_t)end });
+
+		if (end - begin <= kdtree3LeafSize)
+		{
+			return id;
+		}
+
+		if (end - begin <= limit)
+		{
+			deferred.push_back(id);
+			return id;
+		}
+
+		int axis = 0;
+
+		for (int i = 1; i < 3; i++)
+		{
+			axis = upper[i] - lower[i] > upper[axis] - lower[axis] ? i : axis;
+		}
+
+		// splitting at the median keeps the tree balanced however the points are spread, with the points equal to the split on either side of it
+		size_t middle = begin + (end - begin) / 2;
+
+		std::nth_element(points_.begin() + begin, points_.begin() + middle, points_.begin() + end, [axis](const point& value1, const point& value2)
+			{
+				return kdtree3Key(value1.position[axis]) < kdtree3Key(value2.position[axis]);
+			});
+
+		float split = kdtree3Key(points_[middle].position[axis]);
+		float lowerUpper[3] = { upper[0], upper[1], upper[2] };
+		float upperLower[3] = { lower[0], lower[1], lower[2] };
+
+		lowerUpper[axis] = split;
+		upperLower[axis] = split;
+
+		uint32_t first = subdivide(nodes, begin, middle, lower, lowerUpper, limit, deferred);
+		uint32_t second = subdivide(nodes, middle, end, upperLower, upper, limit, deferred);
+
+		nodes[id] = { split, (uint32_t)axis, first, second };
+
+		return id;
+	}
+}
\ No newline at end of file
@@ -1,15 +1,270 @@
 #include "../INC/Aurora/Mathematics/mat4.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include "../INC/Aurora/Mathematics/math.h"
 #include "../INC/Aurora/Mathematics/vec2.h"
 #include "../INC/Aurora/Mathematics/vec3.h"
 #include "../INC/Aurora/Mathematics/vec4.h"
 #include "../INC/Aurora/Mathematics/quat.h"
 #include "../INC/Aurora/Mathematics/ivec2.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
 
 namespace Aurora::Mathematics
 {
+    namespace
+    {
+        // number of matrices decomposed by a thread at a time
+        constexpr size_t mat4DecomposeGrain = 4096;
+
+        // how far the rows of a matrix may be from perpendicular, relative to their lengths, and its last column from 0, 0, 0, 1, before the matrix is treated as shearing or projecting
+        constexpr float mat4DecomposeTolerance = 1e-4f;
+
+        // Shepperd's method takes the square root of the largest of the trace and the diagonal, so the reciprocal the other components are scaled by is never of a number near 0
+        // the rows are those of a rotation for row vectors, the transpose of the usual column vector form, and the result is kept in the half with a positive w
+        inline quat mat4Shepperd(const float r[3][3])
+        {
+            float trace = r[0][0] + r[1][1] + r[2][2];
+            float x, y, z, w;
+
+            if (trace >= r[0][0] && trace >= r[1][1] && trace >= r[2][2])
+            {
+                float root = std::sqrt(1.0f + trace);
+                float f = 0.5f / root;
+                w = 0.5f * root;
+                x = (r[1][2] - r[2][1]) * f;
+                y = (r[2][0] - r[0][2]) * f;
+                z = (r[0][1] - r[1][0]) * f;
+            }
+            else if (r[0][0] >= r[1][1] && r[0][0] >= r[2][2])
+            {
+                float root = std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]);
+                float f = 0.5f / root;
+                w = (r[1][2] - r[2][1]) * f;
+                x = 0.5f * root;
+                y = (r[0][1] + r[1][0]) * f;
+                z = (r[0][2] + r[2][0]) * f;
+            }
+            else if (r[1][1] >= r[2][2])
+            {
+                float root = std::sqrt(1.0f - r[0][0] + r[1][1] - r[2][2]);
+                float f = 0.5f / root;
+                w = (r[2][0] - r[0][2]) * f;
+                x = (r[0][1] + r[1][0]) * f;
+                y = 0.5f * root;
+                z = (r[1][2] + r[2][1]) * f;
+            }
+            else
+            {
+                float root = std::sqrt(1.0f - r[0][0] - r[1][1] + r[2][2]);
+                float f = 0.5f / root;
+                w = (r[0][1] - r[1][0]) * f;
+                x = (r[0][2] + r[2][0]) * f;
+                y = (r[1][2] + r[2][1]) * f;
+                z = 0.5f * root;
+            }
+
+            return w < 0.0f ? quat(-x, -y, -z, -w) : quat(x, y, z, w);
+        }
+
+        // number of matrices decomposed together by the batch decomposition, one per lane
+        constexpr size_t mat4DecomposeLanes = 8;
+
+        // the same steps as mat4Decompose on up to eight matrices at once, with every branch replaced by a select so each step compiles to packed instructions across the lanes
+        // the lanes past count are filled with identity matrices, and the number of matrices that are not a scale, a rotation and a translation is returned
+        inline size_t mat4DecomposeGroup(const float* matrices, size_t count, vec3* translations, quat* rotations, vec3* scales)
+        {
+            constexpr size_t L = mat4DecomposeLanes;
+
+            float m[16][L];
+
+            for (size_t l = 0; l < L; l++)
+            {
+                for (int k = 0; k < 16; k++)
+                {
+                    m[k][l] = l < count ? matrices[l * 16 + k] : (k % 5 == 0 ? 1.0f : 0.0f);
+                }
+            }
+
+            float qx[L], qy[L], qz[L], qw[L], sx[L], sy[L], sz[L];
+            int exact[L];
+
+            for (size_t l = 0; l < L; l++)
+            {
+                float ax = m[0][l], ay = m[1][l], az = m[2][l];
+                float bx = m[4][l], by = m[5][l], bz = m[6][l];
+                float cx = m[8][l], cy = m[9][l], cz = m[10][l];
+
+                float lx = std::sqrt(ax * ax + ay * ay + az * az);
+                float ly = std::sqrt(bx * bx + by * by + bz * bz);
+                float lz = std::sqrt(cx * cx + cy * cy + cz * cz);
+                float determinant = (ay * bz - az * by) * cx + (az * bx - ax * bz) * cy + (ax * by - ay * bx) * cz;
+                float mirrored = -lx;
+                lx = determinant < 0.0f ? mirrored : lx;
+
+                int valid = (lx != 0.0f ? -1 : 0) & (ly > 0.0f ? -1 : 0) & (lz > 0.0f ? -1 : 0);
+                float reciprocal = 1.0f / (valid != 0 ? lx : 1.0f);
+                float r00 = ax * reciprocal, r01 = ay * reciprocal, r02 = az * reciprocal;
+
+                float ab = bx * r00 + by * r01 + bz * r02;
+                float r10 = bx - ab * r00, r11 = by - ab * r01, r12 = bz - ab * r02;
+                float length = std::sqrt(r10 * r10 + r11 * r11 + r12 * r12);
+                valid &= length > 0.0f ? -1 : 0;
+                reciprocal = 1.0f / (length > 0.0f ? length : 1.0f);
+                r10 *= reciprocal;
+                r11 *= reciprocal;
+                r12 *= reciprocal;
+
+                float r20 = r01 * r12 - r02 * r11;
+                float r21 = r02 * r10 - r00 * r12;
+                float r22 = r00 * r11 - r01 * r10;
+
+                float ac = cx * r00 + cy * r01 + cz * r02;
+                float bc = cx * r10 + cy * r11 + cz * r12;
+                int orthogonal = (std::fabs(ab) <= mat4DecomposeTolerance * ly ? -1 : 0) & (std::fabs(ac) <= mat4DecomposeTolerance * lz ? -1 : 0) & (std::fabs(bc) <= mat4DecomposeTolerance * lz ? -1 : 0);
+                int affine = (std::fabs(m[3][l]) <= mat4DecomposeTolerance ? -1 : 0) & (std::fabs(m[7][l]) <= mat4DecomposeTolerance ? -1 : 0) & (std::fabs(m[11][l]) <= mat4DecomposeTolerance ? -1 : 0) & (std::fabs(m[15][l] - 1.0f) <= mat4DecomposeTolerance ? -1 : 0);
+
+                // Shepperd's method, choosing which component to take the square root for with selects
+                float trace = r00 + r11 + r22;
+                int caseW = (trace >= r00 ? -1 : 0) & (trace >= r11 ? -1 : 0) & (trace >= r22 ? -1 : 0);
+                int caseX = ~caseW & (r00 >= r11 ? -1 : 0) & (r00 >= r22 ? -1 : 0);
+                int caseY = ~caseW & ~caseX & (r11 >= r22 ? -1 : 0);
+                float radicandW = 1.0f + trace;
+                float radicandX = 1.0f + r00 - r11 - r22;
+                float radicandY = 1.0f - r00 + r11 - r22;
+                float radicandZ = 1.0f - r00 - r11 + r22;
+                float radicand = caseW != 0 ? radicandW : caseX != 0 ? radicandX : caseY != 0 ? radicandY : radicandZ;
+                float root = std::sqrt(radicand);
+                float large = 0.5f * root;
+                float f = 0.5f / root;
+
+                float a = (r12 - r21) * f;
+                float b = (r20 - r02) * f;
+                float c = (r01 - r10) * f;
+                float d = (r01 + r10) * f;
+                float e = (r02 + r20) * f;
+                float g = (r12 + r21) * f;
+
+                float w = caseW != 0 ? large : caseX != 0 ? a : caseY != 0 ? b : c;
+                float x = caseW != 0 ? a : caseX != 0 ? large : caseY != 0 ? d : e;
+                float y = caseW != 0 ? b : caseX != 0 ? d : caseY != 0 ? large : g;
+                float z = caseW != 0 ? c : caseX != 0 ? e : caseY != 0 ? g : large;
+
+                float sign = w < 0.0f ? -1.0f : 1.0f;
+                float normalize = sign / std::sqrt(x * x + y * y + z * z + w * w);
+
+                x *= normalize;
+                y *= normalize;
+                z *= normalize;
+                w *= normalize;
+
+                qx[l] = valid != 0 ? x : 0.0f;
+                qy[l] = valid != 0 ? y : 0.0f;
+                qz[l] = valid != 0 ? z : 0.0f;
+                qw[l] = valid != 0 ? w : 1.0f;
+                sx[l] = lx;
+                sy[l] = ly;
+                sz[l] = lz;
+                exact[l] = valid & orthogonal & affine;
+            }
+
+            size_t failed = 0;
+
+            for (size_t l = 0; l < count; l++)
+            {
+                translations[l] = vec3(m[12][l], m[13][l], m[14][l]);
+                rotations[l].x = qx[l];
+                rotations[l].y = qy[l];
+                rotations[l].z = qz[l];
+                rotations[l].w = qw[l];
+                scales[l] = vec3(sx[l], sy[l], sz[l]);
+                failed += exact[l] ? 0 : 1;
+            }
+
+            return failed;
+        }
+
+        // the matrix is 16 floats in row major order, whose first three rows are the axes of the rotation scaled by the scale
+        inline bool mat4Decompose(const float* m, vec3& translation, quat& rotation, vec3& scale)
+        {
+            translation = vec3(m[12], m[13], m[14]);
+
+            float a[3] = { m[0], m[1], m[2] };
+            float b[3] = { m[4], m[5], m[6] };
+            float c[3] = { m[8], m[9], m[10] };
+            float sx = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+            float sy = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+            float sz = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+
+            bool exact = std::fabs(m[3]) <= mat4DecomposeTolerance && std::fabs(m[7]) <= mat4DecomposeTolerance && std::fabs(m[11]) <= mat4DecomposeTolerance && std::fabs(m[15] - 1.0f) <= mat4DecomposeTolerance;
+
+            // written so that NaN lengths also give the identity
+            if (!(sx > 0.0f && sy > 0.0f && sz > 0.0f))
+            {
+                rotation = quat::identity();
+                scale = vec3(sx, sy, sz);
+                return false;
+            }
+
+            // a matrix that mirrors has a negative determinant, which is put on the x axis so the rest is a rotation
+            float determinant = (a[1] * b[2] - a[2] * b[1]) * c[0] + (a[2] * b[0] - a[0] * b[2]) * c[1] + (a[0] * b[1] - a[1] * b[0]) * c[2];
+
+            if (determinant < 0.0f)
+            {
+                sx = -sx;
+            }
+
+            // the rows are made perpendicular, y against x and z from both, so a shearing matrix still gives a rotation
+            float r[3][3];
+
+            float reciprocal = 1.0f / sx;
+
+            for (int i = 0; i < 3; i++)
+            {
+                r[0][i] = a[i] * reciprocal;
+            }
+
+            float ab = b[0] * r[0][0] + b[1] * r[0][1] + b[2] * r[0][2];
+
+            for (int i = 0; i < 3; i++)
+            {
+                r[1][i] = b[i] - ab * r[0][i];
+            }
+
+            float length = std::sqrt(r[1][0] * r[1][0] + r[1][1] * r[1][1] + r[1][2] * r[1][2]);
+
+            if (!(length > 0.0f))
+            {
+                rotation = quat::identity();
+                scale = vec3(sx, sy, sz);
+                return false;
+            }
+
+            reciprocal = 1.0f / length;
+
+            for (int i = 0; i < 3; i++)
+            {
+                r[1][i] *= reciprocal;
+            }
+
+            r[2][0] = r[0][1] * r[1][2] - r[0][2] * r[1][1];
+            r[2][1] = r[0][2] * r[1][0] - r[0][0] * r[1][2];
+            r[2][2] = r[0][0] * r[1][1] - r[0][1] * r[1][0];
+
+            float ac = c[0] * r[0][0] + c[1] * r[0][1] + c[2] * r[0][2];
+            float bc = c[0] * r[1][0] + c[1] * r[1][1] + c[2] * r[1][2];
+            exact = exact && std::fabs(ab) <= mat4DecomposeTolerance * sy && std::fabs(ac) <= mat4DecomposeTolerance * sz && std::fabs(bc) <= mat4DecomposeTolerance * sz;
+
+            rotation = mat4Shepperd(r);
+            scale = vec3(sx, sy, sz);
+
+            return exact;
+        }
+    }
+
     mat4 mat4::identity()
     {
         return mat4(
@@ -343,7 +598,7 @@ namespace Aurora::Mathematics
 
         return {
             1.0f - (2.0f * (yy + zz)), 2.0f * (xy - wz), 2.0f * (xz + wy), 0.0f,
-            2.0f * (xy * wz), 1.0f - (2.0f * (xx + zz)), 2.0f * (yz - wx), 0.0f,
+            2.0f * (xy + wz), 1.0f - (2.0f * (xx + zz)), 2.0f * (yz - wx), 0.0f,
             2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - (2.0f * (xx + yy)), 0.0f,
             0.0f, 0.0f, 0.0f, 1.0f
         };
@@ -355,7 +610,81 @@ namespace Aurora::Mathematics
         mat4 s = createScale(scaling);
         mat4 r = createRotation(rotation);
 
-        return t * s * r;
+        return s * r * t;
+    }
+
+    bool mat4::decompose(const mat4& value, vec3& translation, quat& rotation, vec3& scale)
+    {
+        float m[16];
+
+        for (int r = 0; r < 4; r++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                m[c + r * 4] = value(r, c);
+            }
+        }
+
+        return mat4Decompose(m, translation, rotation, scale);
+    }
+
+    size_t mat4::decompose(std::span<const float> matrices, std::span<vec3> translations, std::span<quat> rotations, std::span<vec3> scales)
+    {
+        size_t count = matrices.size() / 16;
+
+        if (translations.size() < count)
+        {
+            throw std::invalid_argument("The translations (" + std::to_string(translations.size()) + ") are fewer than required (" + std::to_string(count) + ").");
+        }
+
+        if (rotations.size() < count)
+        {
+            throw std::invalid_argument("The rotations (" + std::to_string(rotations.size()) + ") are fewer than required (" + std::to_string(count) + ").");
+        }
+
+        if (scales.size() < count)
+        {
+            throw std::invalid_argument("The scales (" + std::to_string(scales.size()) + ") are fewer than required (" + std::to_string(count) + ").");
+        }
+
+        std::vector<size_t> failures((count + mat4DecomposeGrain - 1) / mat4DecomposeGrain, 0);
+
+        parallelFor(count, mat4DecomposeGrain, [&](size_t begin, size_t end)
+        {
+            size_t failed = 0;
+
+            for (size_t i = begin; i < end; i += mat4DecomposeLanes)
+            {
+                failed += mat4DecomposeGroup(matrices.data() + i * 16, std::min(mat4DecomposeLanes, end - i), translations.data() + i, rotations.data() + i, scales.data() + i);
+            }
+
+            failures[begin / mat4DecomposeGrain] = failed;
+        });
+
+        size_t failed = 0;
+
+        for (size_t blockFailed : failures)
+        {
+            failed += blockFailed;
+        }
+
+        return failed;
+    }
+
+    // defined here, next to createRotation, so both directions between matrices and quaternions share the same convention
+    quat::quat(const mat4& rotation)
+    {
+        float r[3][3];
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                r[i][j] = rotation(i, j);
+            }
+        }
+
+        *this = mat4Shepperd(r);
     }
 
     mat4 mat4::createPerspective(float fov, const ivec2& viewport, float nearClip, float farClip)
@@ -369,8 +698,8 @@ namespace Aurora::Mathematics
         return mat4(
             1.0f / (thf * aspectRatio), 0, 0, 0,
             0, 1.0f / thf, 0, 0,
-            0, 0, (near + far) * ri, -1,
-            0, 0, 2.0f * near * far * ri, 0
+            0, 0, (near + far) * ri, 2.0f * near * far * ri,
+            0, 0, -1, 0
         );
     }
 
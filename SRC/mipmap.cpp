@@ -0,0 +1,380 @@
+#include "../INC/Aurora/Mathematics/mipmap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../INC/Aurora/Mathematics/col32.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/srgb.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of source pixels handed to a thread at a time
+		constexpr size_t mipmapGrain = 65536;
+
+		// the source pixels contributing to every pixel of a level along one axis
+		struct mipmapTaps
+		{
+			size_t size;
+			size_t count;
+			std::vector<size_t> first;
+			std::vector<float> weights;
+		};
+
+		mipmapTaps mipmapAxis(size_t sourceSize)
+		{
+			mipmapTaps taps;
+			taps.size = std::max<size_t>(sourceSize / 2, 1);
+			taps.count = sourceSize == 1 ? 1 : (sourceSize % 2 == 0 ? 2 : 3);
+			taps.first.resize(taps.size);
+			taps.weights.resize(taps.size * taps.count);
+
+			for (size_t i = 0; i < taps.size; i++)
+			{
+				float* weights = taps.weights.data() + i * taps.count;
+				taps.first[i] = i * 2;
+
+				switch (taps.count)
+				{
+				case 1:
+					weights[0] = 1.0f;
+					break;
+				case 2:
+					weights[0] = 0.5f;
+					weights[1] = 0.5f;
+					break;
+				default:
+					// an odd size 2n + 1 reduces to n pixels that each cover (2n + 1) / n source pixels, split across the three pixels they overlap
+					weights[0] = static_cast<float>(taps.size - i) / sourceSize;
+					weights[1] = static_cast<float>(taps.size) / sourceSize;
+					weights[2] = static_cast<float>(i + 1) / sourceSize;
+					break;
+				}
+			}
+
+			return taps;
+		}
+
+		// reads a pixel of a level at full precision (straight linear color and alpha)
+		void mipmapFetch(const float* row, size_t x, float* pixel, const float*)
+		{
+			pixel[0] = row[x * 4 + 0];
+			pixel[1] = row[x * 4 + 1];
+			pixel[2] = row[x * 4 + 2];
+			pixel[3] = row[x * 4 + 3];
+		}
+
+		// reads a pixel of the source image, decoding its color components through the table
+		void mipmapFetch(const col32* row, size_t x, float* pixel, const float* table)
+		{
+			pixel[0] = table[row[x].r];
+			pixel[1] = table[row[x].g];
+			pixel[2] = table[row[x].b];
+			pixel[3] = row[x].a * (1.0f / 255.0f);
+		}
+
+		void mipmapEncode(const float* source, col32* destination, size_t count, bool srgb)
+		{
+			const uint8_t* table = linearToSrgbTable();
+			const float scale = srgb ? static_cast<float>(linearToSrgbTableSize - 1) : 255.0f;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				int r = static_cast<int>(std::clamp(source[i * 4 + 0], 0.0f, 1.0f) * scale + 0.5f);
+				int g = static_cast<int>(std::clamp(source[i * 4 + 1], 0.0f, 1.0f) * scale + 0.5f);
+				int b = static_cast<int>(std::clamp(source[i * 4 + 2], 0.0f, 1.0f) * scale + 0.5f);
+
+				destination[i].r = srgb ? table[r] : static_cast<uint8_t>(r);
+				destination[i].g = srgb ? table[g] : static_cast<uint8_t>(g);
+				destination[i].b = srgb ? table[b] : static_cast<uint8_t>(b);
+				destination[i].a = static_cast<uint8_t>(std::clamp(source[i * 4 + 3], 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+
+		// reduces the given source rows into one row of the next level, decoding the source pixels as they are read
+		// the tap counts are template parameters so that the common 2x2 case compiles to fixed, unrolled loops
+		template<size_t RowCount, size_t ColumnCount, typename Pixel>
+		void mipmapReduce(const Pixel* const* rows, const float* rowWeights, const mipmapTaps& columns, const float* table, float* destination)
+		{
+			for (size_t x = 0; x < columns.size; x++)
+			{
+				const float* columnWeights = columns.weights.data() + x * ColumnCount;
+				size_t first = columns.first[x];
+				float weighted[3] = { 0.0f, 0.0f, 0.0f };
+				float plain[3] = { 0.0f, 0.0f, 0.0f };
+				float alpha = 0.0f;
+
+				for (size_t ty = 0; ty < RowCount; ty++)
+				{
+					for (size_t tx = 0; tx < ColumnCount; tx++)
+					{
+						float pixel[4];
+						mipmapFetch(rows[ty], first + tx, pixel, table);
+
+						float weight = rowWeights[ty] * columnWeights[tx];
+						float coverage = weight * pixel[3];
+
+						for (size_t c = 0; c < 3; c++)
+						{
+							weighted[c] += coverage * pixel[c];
+							plain[c] += weight * pixel[c];
+						}
+
+						alpha += coverage;
+					}
+				}
+
+				// the weights sum to 1, so the accumulated coverage is the average alpha, a fully transparent block falls back to the plain average
+				float invAlpha = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+
+				for (size_t c = 0; c < 3; c++)
+				{
+					destination[x * 4 + c] = alpha > 0.0f ? weighted[c] * invAlpha : plain[c];
+				}
+
+				destination[x * 4 + 3] = alpha;
+			}
+		}
+
+		template<size_t RowCount, typename Pixel>
+		void mipmapReduce(const Pixel* const* rows, const float* rowWeights, const mipmapTaps& columns, const float* table, float* destination)
+		{
+			switch (columns.count)
+			{
+			case 1:
+				mipmapReduce<RowCount, 1>(rows, rowWeights, columns, table, destination);
+				break;
+			case 2:
+				mipmapReduce<RowCount, 2>(rows, rowWeights, columns, table, destination);
+				break;
+			default:
+				mipmapReduce<RowCount, 3>(rows, rowWeights, columns, table, destination);
+				break;
+			}
+		}
+
+		template<typename Pixel>
+		void mipmapReduce(const Pixel* const* rows, const float* rowWeights, size_t rowCount, const mipmapTaps& columns, const float* table, float* destination)
+		{
+			switch (rowCount)
+			{
+			case 1:
+				mipmapReduce<1>(rows, rowWeights, columns, table, destination);
+				break;
+			case 2:
+				mipmapReduce<2>(rows, rowWeights, columns, table, destination);
+				break;
+			default:
+				mipmapReduce<3>(rows, rowWeights, columns, table, destination);
+				break;
+			}
+		}
+
+		// the state of a row of a level, a row is claimed by the one thread that reduces it once every row it reads is done
+		constexpr uint8_t mipmapPending = 0;
+		constexpr uint8_t mipmapClaimed = 1;
+		constexpr uint8_t mipmapDone = 2;
+
+		// a level of the chain, with its taps over the level above it and the state of each of its rows
+		struct mipmapLevel
+		{
+			mipmapTaps columns;
+			mipmapTaps rows;
+			size_t sourceWidth;
+			float* pixels;
+			col32* output;
+			std::vector<std::atomic<uint8_t>> states;
+		};
+
+		struct mipmapChain
+		{
+			std::vector<mipmapLevel>& levels;
+			const col32* source;
+			const float* table;
+			bool srgb;
+		};
+
+		// reduces and encodes one row of a level from the level above it, which is the source image for the largest level, and marks it done
+		void mipmapRow(const mipmapChain& chain, size_t index, size_t y)
+		{
+			mipmapLevel& level = chain.levels[index];
+			const float* rowWeights = level.rows.weights.data() + y * level.rows.count;
+			float* row = level.pixels + y * level.columns.size * 4;
+
+			if (index == 0)
+			{
+				const col32* sourceRows[3];
+
+				for (size_t ty = 0; ty < level.rows.count; ty++)
+				{
+					sourceRows[ty] = chain.source + (level.rows.first[y] + ty) * level.sourceWidth;
+				}
+
+				mipmapReduce(sourceRows, rowWeights, level.rows.count, level.columns, chain.table, row);
+			}
+			else
+			{
+				const float* sourceRows[3];
+
+				for (size_t ty = 0; ty < level.rows.count; ty++)
+				{
+					sourceRows[ty] = chain.levels[index - 1].pixels + (level.rows.first[y] + ty) * level.sourceWidth * 4;
+				}
+
+				mipmapReduce(sourceRows, rowWeights, level.rows.count, level.columns, chain.table, row);
+			}
+
+			mipmapEncode(row, level.output + y * level.columns.size, level.columns.size, chain.srgb);
+			level.states[y].store(mipmapDone);
+		}
+
+		// carries the rows just completed down the chain, reducing every row of the next level that reads them once all of its rows are done, so no thread waits for a whole level
+		// the row states are sequentially consistent, so of two threads completing the last rows a row reads at least one sees both done
+		void mipmapStream(const mipmapChain& chain, size_t index, size_t begin, size_t end)
+		{
+			while (index + 1 < chain.levels.size() && begin < end)
+			{
+				const mipmapLevel& level = chain.levels[index];
+				mipmapLevel& next = chain.levels[index + 1];
+				size_t count = next.rows.count;
+
+				// the rows of the next level whose taps, from row 2 * y, reach into [begin, end)
+				size_t first = begin + 1 >= count ? (begin + 2 - count) / 2 : 0;
+				size_t last = std::min((end - 1) / 2 + 1, next.rows.size);
+				size_t claimedBegin = last;
+				size_t claimedEnd = first;
+
+				for (size_t y = first; y < last; y++)
+				{
+					bool ready = true;
+
+					for (size_t ty = 0; ty < count; ty++)
+					{
+						ready = ready && level.states[next.rows.first[y] + ty].load() == mipmapDone;
+					}
+
+					uint8_t expected = mipmapPending;
+
+					if (ready && next.states[y].compare_exchange_strong(expected, mipmapClaimed))
+					{
+						mipmapRow(chain, index + 1, y);
+						claimedBegin = std::min(claimedBegin, y);
+						claimedEnd = y + 1;
+					}
+				}
+
+				index++;
+				begin = claimedBegin;
+				end = claimedEnd;
+			}
+		}
+
+		void mipmapCheckDimensions(int width, int height)
+		{
+			if (width <= 0 || height <= 0)
+			{
+				throw std::invalid_argument("The image dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ") must be positive.");
+			}
+		}
+	}
+
+	int mipmapLevels(int width, int height)
+	{
+		mipmapCheckDimensions(width, height);
+
+		int levels = 1;
+
+		while (width > 1 || height > 1)
+		{
+			width = std::max(width / 2, 1);
+			height = std::max(height / 2, 1);
+			levels++;
+		}
+
+		return levels;
+	}
+
+	size_t mipmapChainSize(int width, int height)
+	{
+		mipmapCheckDimensions(width, height);
+
+		size_t size = 0;
+
+		while (width > 1 || height > 1)
+		{
+			width = std::max(width / 2, 1);
+			height = std::max(height / 2, 1);
+			size += static_cast<size_t>(width) * static_cast<size_t>(height);
+		}
+
+		return size;
+	}
+
+	void generateMipmaps(std::span<const col32> source, int width, int height, std::span<col32> destination, bool srgb)
+	{
+		size_t required = mipmapChainSize(width, height);
+		size_t w = static_cast<size_t>(width);
+		size_t h = static_cast<size_t>(height);
+
+		if (source.size() < w * h)
+		{
+			throw std::invalid_argument("The source (" + std::to_string(source.size()) + ") is smaller than required (" + std::to_string(w * h) + ").");
+		}
+
+		if (destination.size() < required)
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than required (" + std::to_string(required) + ").");
+		}
+
+		if (required == 0)
+		{
+			return;
+		}
+
+		// the 8-bit decoding of linear components, matching the conversion operator of col32
+		std::vector<float> linearTable(256);
+
+		for (size_t i = 0; i < linearTable.size(); i++)
+		{
+			linearTable[i] = srgb ? srgbToLinearTable()[i] : i / 255.0f;
+		}
+
+		// every level is kept at full precision to reduce the next level from, only the largest level is read from the 8-bit source
+		std::vector<float> pixels(required * 4);
+		std::vector<mipmapLevel> levels;
+		size_t offset = 0;
+
+		while (w > 1 || h > 1)
+		{
+			mipmapLevel& level = levels.emplace_back();
+			level.columns = mipmapAxis(w);
+			level.rows = mipmapAxis(h);
+			level.sourceWidth = w;
+			level.pixels = pixels.data() + offset * 4;
+			level.output = destination.data() + offset;
+			level.states = std::vector<std::atomic<uint8_t>>(level.rows.size);
+
+			offset += level.columns.size * level.rows.size;
+			w = level.columns.size;
+			h = level.rows.size;
+		}
+
+		mipmapChain chain{ levels, source.data(), linearTable.data(), srgb };
+		const mipmapLevel& largest = levels.front();
+
+		parallelFor(largest.rows.size, mipmapGrain / (largest.sourceWidth * largest.rows.count) + 1, [&](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; y++)
+				{
+					mipmapRow(chain, 0, y);
+				}
+
+				mipmapStream(chain, 0, begin, end);
+			});
+	}
+}
\ No newline at end of file
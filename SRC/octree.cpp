@@ -0,0 +1,601 @@
+#include "../INC/Aurora/Mathematics/octree.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/frustum.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// marks a missing child, and a free entry
+		constexpr uint32_t octreeNone = 0xFFFFFFFF;
+
+		// the deepest supported tree, which bounds the size of the traversal stacks
+		constexpr int octreeMaxDepth = 20;
+
+		// a depth first traversal holds at most the seven unvisited siblings of each node on the path, plus the eight children of the last one
+		constexpr size_t octreeStackSize = 7 * octreeMaxDepth + 8;
+
+		// every plane of a frustum still has to be tested
+		constexpr uint32_t octreeAllPlanes = 0x3F;
+
+		inline float octreeMax(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// the comparisons are evaluated for every axis and then combined so they compile to packed comparisons
+		inline bool octreeOverlaps(const float* min, const float* max, const float* queryMin, const float* queryMax)
+		{
+			int mask0 = min[0] < queryMax[0] ? -1 : 0;
+			int mask1 = min[1] < queryMax[1] ? -1 : 0;
+			int mask2 = min[2] < queryMax[2] ? -1 : 0;
+			int mask3 = queryMin[0] < max[0] ? -1 : 0;
+			int mask4 = queryMin[1] < max[1] ? -1 : 0;
+			int mask5 = queryMin[2] < max[2] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3 & mask4 & mask5) != 0;
+		}
+
+		// the squared distance from a point to a box, infinite for an empty box
+		inline float octreeDistanceSquared(const float* min, const float* max, const float* point)
+		{
+			float x = octreeMax(octreeMax(min[0] - point[0], point[0] - max[0]), 0.0f);
+			float y = octreeMax(octreeMax(min[1] - point[1], point[1] - max[1]), 0.0f);
+			float z = octreeMax(octreeMax(min[2] - point[2], point[2] - max[2]), 0.0f);
+
+			return x * x + y * y + z * z;
+		}
+
+		// tests a box given by its center and extents against the planes of a frustum left in the mask, clearing the planes the box is entirely inside of, returns false if the box is outside a plane
+		inline bool octreeVisible(const frustum& value, const float* center, const float* extent, uint32_t& mask)
+		{
+			for (int i = 0; i < 6; i++)
+			{
+				if ((mask & (1u << i)) == 0)
+				{
+					continue;
+				}
+
+				const plane& current = value.planes[i];
+				float distance = current.normal.x * center[0] + current.normal.y * center[1] + current.normal.z * center[2] + current.distance;
+				float reach = std::abs(current.normal.x) * extent[0] + std::abs(current.normal.y) * extent[1] + std::abs(current.normal.z) * extent[2];
+
+				// written so that a NaN distance, the center of an empty box, counts as outside
+				if (!(distance + reach >= 0.0f))
+				{
+					return false;
+				}
+
+				if (distance - reach >= 0.0f)
+				{
+					mask &= ~(1u << i);
+				}
+			}
+
+			return true;
+		}
+	}
+
+	octree::octree() : octree(aabb3(vec3(-1.0f, -1.0f, -1.0f), vec3(1.0f, 1.0f, 1.0f))) { }
+
+	octree::octree(bounds region, int maxDepth) : octree(aabb3(region), maxDepth) { }
+
+	octree::octree(const aabb3& region, int maxDepth) : maxDepth_(maxDepth), size_(0)
+	{
+		if (region.empty())
+		{
+			throw std::invalid_argument("The region must not be empty.");
+		}
+
+		if (maxDepth < 0 || maxDepth > octreeMaxDepth)
+		{
+			throw std::invalid_argument("The maximum depth (" + std::to_string(maxDepth) + ") must be between 0 and " + std::to_string(octreeMaxDepth) + ".");
+		}
+
+		const float* boxMin = region.minLanes();
+		const float* boxMax = region.maxLanes();
+
+		half_ = 0.0f;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			center_[axis] = (boxMin[axis] + boxMax[axis]) * 0.5f;
+			half_ = octreeMax(half_, (boxMax[axis] - boxMin[axis]) * 0.5f);
+		}
+
+		clear();
+	}
+
+	size_t octree::insert(bounds value)
+	{
+		return insert(aabb3(value));
+	}
+
+	size_t octree::insert(const aabb3& value)
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		uint32_t id;
+
+		if (freeEntries_.empty())
+		{
+			id = (uint32_t)entries_.size();
+			entries_.push_back({ octreeNone, 0 });
+		}
+		else
+		{
+			id = freeEntries_.back();
+			freeEntries_.pop_back();
+		}
+
+		attach(id, place(boxMin, boxMax), boxMin, boxMax);
+		size_++;
+
+		return id;
+	}
+
+	void octree::move(size_t id, bounds value)
+	{
+		move(id, aabb3(value));
+	}
+
+	void octree::move(size_t id, const aabb3& value)
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		entry current = find(id);
+
+		// most moves are small enough for the box to stay in its node
+		if (fits(current.node, boxMin, boxMax))
+		{
+			item& stored = nodes_[current.node].items[current.slot];
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				stored.min[axis] = boxMin[axis];
+				stored.max[axis] = boxMax[axis];
+			}
+
+			return;
+		}
+
+		// the box is attached to its new node before it is detached from the old one, so the nodes both paths share are not released and allocated again
+		attach((uint32_t)id, place(boxMin, boxMax), boxMin, boxMax);
+		detach(current);
+	}
+
+	void octree::remove(size_t id)
+	{
+		detach(find(id));
+
+		entries_[id] = { octreeNone, 0 };
+		freeEntries_.push_back((uint32_t)id);
+		size_--;
+	}
+
+	void octree::clear()
+	{
+		if (nodes_.empty())
+		{
+			nodes_.emplace_back();
+		}
+
+		// every node but the root goes back to the pool, lowest first so the nodes reused first are the ones nearest the root in memory
+		freeNodes_.clear();
+
+		for (size_t i = nodes_.size() - 1; i > 0; i--)
+		{
+			nodes_[i].items.clear();
+			nodes_[i].parent = octreeNone;
+			freeNodes_.push_back((uint32_t)i);
+		}
+
+		entries_.clear();
+		freeEntries_.clear();
+		size_ = 0;
+
+		node& root = nodes_[0];
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			root.center[axis] = center_[axis];
+		}
+
+		root.half = half_;
+		root.depth = 0;
+		root.parent = octreeNone;
+		root.childCount = 0;
+		root.items.clear();
+
+		for (int i = 0; i < 8; i++)
+		{
+			root.children[i] = octreeNone;
+		}
+	}
+
+	bool octree::contains(size_t id) const
+	{
+		return id < entries_.size() && entries_[id].node != octreeNone;
+	}
+
+	aabb3 octree::box(size_t id) const
+	{
+		const entry& current = find(id);
+		const item& stored = nodes_[current.node].items[current.slot];
+
+		return aabb3(vec3(stored.min[0], stored.min[1], stored.min[2]), vec3(stored.max[0], stored.max[1], stored.max[2]));
+	}
+
+	aabb3 octree::region() const
+	{
+		return aabb3(vec3(center_[0] - half_, center_[1] - half_, center_[2] - half_), vec3(center_[0] + half_, center_[1] + half_, center_[2] + half_));
+	}
+
+	size_t octree::size() const
+	{
+		return size_;
+	}
+
+	size_t octree::nodeCount() const
+	{
+		return nodes_.size() - freeNodes_.size();
+	}
+
+	void octree::overlapping(const aabb3& value, std::vector<size_t>& results) const
+	{
+		const float* queryMin = value.minLanes();
+		const float* queryMax = value.maxLanes();
+
+		std::array<uint32_t, octreeStackSize> stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const node& current = nodes_[stack[--top]];
+
+			for (const item& stored : current.items)
+			{
+				if (octreeOverlaps(stored.min, stored.max, queryMin, queryMax))
+				{
+					results.push_back(stored.id);
+				}
+			}
+
+			// a child reaches half its size past each of its faces, so its loose box spans twice its size around its center
+			float reach = current.half;
+
+			for (int i = 0; i < 8; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == octreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float min[3] = { child.center[0] - reach, child.center[1] - reach, child.center[2] - reach };
+				float max[3] = { child.center[0] + reach, child.center[1] + reach, child.center[2] + reach };
+
+				if (octreeOverlaps(min, max, queryMin, queryMax))
+				{
+					stack[top++] = index;
+				}
+			}
+		}
+	}
+
+	void octree::overlapping(const frustum& value, std::vector<size_t>& results) const
+	{
+		std::array<uint32_t, octreeStackSize> stack;
+		std::array<uint32_t, octreeStackSize> masks;
+		size_t top = 0;
+
+		stack[top] = 0;
+		masks[top++] = octreeAllPlanes;
+
+		while (top > 0)
+		{
+			top--;
+
+			const node& current = nodes_[stack[top]];
+			uint32_t mask = masks[top];
+
+			for (const item& stored : current.items)
+			{
+				float center[3] = { (stored.min[0] + stored.max[0]) * 0.5f, (stored.min[1] + stored.max[1]) * 0.5f, (stored.min[2] + stored.max[2]) * 0.5f };
+				float extent[3] = { (stored.max[0] - stored.min[0]) * 0.5f, (stored.max[1] - stored.min[1]) * 0.5f, (stored.max[2] - stored.min[2]) * 0.5f };
+				uint32_t itemMask = mask;
+
+				if (mask == 0 || octreeVisible(value, center, extent, itemMask))
+				{
+					results.push_back(stored.id);
+				}
+			}
+
+			float reach = current.half;
+
+			for (int i = 0; i < 8; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == octreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float extent[3] = { reach, reach, reach };
+				uint32_t childMask = mask;
+
+				if (mask == 0 || octreeVisible(value, child.center, extent, childMask))
+				{
+					stack[top] = index;
+					masks[top++] = childMask;
+				}
+			}
+		}
+	}
+
+	bool octree::nearest(vec3 point, size_t& id, float& distance, float maxDistance) const
+	{
+		float origin[3] = { point.x, point.y, point.z };
+		float best = maxDistance * maxDistance;
+		uint32_t found = octreeNone;
+
+		std::array<uint32_t, octreeStackSize> stack;
+		std::array<float, octreeStackSize> distances;
+		size_t top = 0;
+
+		stack[top] = 0;
+		distances[top++] = 0.0f;
+
+		while (top > 0)
+		{
+			top--;
+
+			if (distances[top] > best)
+			{
+				continue;
+			}
+
+			const node& current = nodes_[stack[top]];
+
+			for (const item& stored : current.items)
+			{
+				float squared = octreeDistanceSquared(stored.min, stored.max, origin);
+
+				// empty boxes are infinitely far away, and are not found even without a maximum distance
+				if (squared <= best && squared < std::numeric_limits<float>::infinity())
+				{
+					best = squared;
+					found = stored.id;
+				}
+			}
+
+			// the children are pushed farthest first so the closest is searched first and narrows the search for the others
+			uint32_t order[8];
+			float orderDistances[8];
+			int count = 0;
+			float reach = current.half;
+
+			for (int i = 0; i < 8; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == octreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float min[3] = { child.center[0] - reach, child.center[1] - reach, child.center[2] - reach };
+				float max[3] = { child.center[0] + reach, child.center[1] + reach, child.center[2] + reach };
+				float squared = octreeDistanceSquared(min, max, origin);
+
+				if (squared > best)
+				{
+					continue;
+				}
+
+				int j = count++;
+
+				while (j > 0 && orderDistances[j - 1] < squared)
+				{
+					order[j] = order[j - 1];
+					orderDistances[j] = orderDistances[j - 1];
+					j--;
+				}
+
+				order[j] = index;
+				orderDistances[j] = squared;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				stack[top] = order[i];
+				distances[top++] = orderDistances[i];
+			}
+		}
+
+		if (found == octreeNone)
+		{
+			return false;
+		}
+
+		id = found;
+		distance = std::sqrt(best);
+		return true;
+	}
+
+	bool octree::fits(uint32_t index, const float* min, const float* max) const
+	{
+		const node& current = nodes_[index];
+		bool inside = true;
+		float extent = 0.0f;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float center = (min[axis] + max[axis]) * 0.5f;
+
+			// written so that the NaN center of an empty box is never inside
+			inside &= !(std::abs(center - current.center[axis]) > current.half) && center == center;
+			extent = octreeMax(extent, (max[axis] - min[axis]) * 0.5f);
+		}
+
+		// the root also holds the boxes that do not fit anywhere else
+		if (index == 0)
+		{
+			return !inside || extent > current.half * 0.5f || maxDepth_ == 0;
+		}
+
+		// a box belongs to the deepest node at least as large as it
+		return inside && extent <= current.half && (extent > current.half * 0.5f || current.depth == maxDepth_);
+	}
+
+	uint32_t octree::place(const float* min, const float* max)
+	{
+		float center[3];
+		float extent = 0.0f;
+		bool inside = true;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			center[axis] = (min[axis] + max[axis]) * 0.5f;
+			extent = octreeMax(extent, (max[axis] - min[axis]) * 0.5f);
+			inside &= !(std::abs(center[axis] - center_[axis]) > half_) && center[axis] == center[axis];
+		}
+
+		// empty boxes and boxes centered outside the region stay in the root
+		if (!inside)
+		{
+			return 0;
+		}
+
+		uint32_t index = 0;
+		float half = half_;
+
+		for (int depth = 0; depth < maxDepth_ && extent <= half * 0.5f; depth++)
+		{
+			const node& current = nodes_[index];
+			int octant = (center[0] >= current.center[0] ? 1 : 0) | (center[1] >= current.center[1] ? 2 : 0) | (center[2] >= current.center[2] ? 4 : 0);
+			uint32_t child = current.children[octant];
+
+			index = child == octreeNone ? allocate(index, octant) : child;
+			half *= 0.5f;
+		}
+
+		return index;
+	}
+
+	uint32_t octree::allocate(uint32_t parent, int octant)
+	{
+		uint32_t index;
+
+		if (freeNodes_.empty())
+		{
+			index = (uint32_t)nodes_.size();
+			nodes_.emplace_back();
+		}
+		else
+		{
+			index = freeNodes_.back();
+			freeNodes_.pop_back();
+		}
+
+		node& owner = nodes_[parent];
+		node& child = nodes_[index];
+		float quarter = owner.half * 0.5f;
+
+		child.center[0] = owner.center[0] + ((octant & 1) != 0 ? quarter : -quarter);
+		child.center[1] = owner.center[1] + ((octant & 2) != 0 ? quarter : -quarter);
+		child.center[2] = owner.center[2] + ((octant & 4) != 0 ? quarter : -quarter);
+		child.half = quarter;
+		child.depth = owner.depth + 1;
+		child.parent = parent;
+		child.childCount = 0;
+
+		for (int i = 0; i < 8; i++)
+		{
+			child.children[i] = octreeNone;
+		}
+
+		owner.children[octant] = index;
+		owner.childCount++;
+		return index;
+	}
+
+	void octree::release(uint32_t index)
+	{
+		node& current = nodes_[index];
+		node& owner = nodes_[current.parent];
+
+		for (int i = 0; i < 8; i++)
+		{
+			if (owner.children[i] == index)
+			{
+				owner.children[i] = octreeNone;
+			}
+		}
+
+		owner.childCount--;
+
+		// the items keep their capacity, so a released node can be reused without allocating
+		current.items.clear();
+		current.parent = octreeNone;
+		freeNodes_.push_back(index);
+	}
+
+	void octree::attach(uint32_t id, uint32_t index, const float* min, const float* max)
+	{
+		std::vector<item>& items = nodes_[index].items;
+
+		entries_[id] = { index, (uint32_t)items.size() };
+		items.push_back({ { min[0], min[1], min[2] }, { max[0], max[1], max[2] }, id });
+	}
+
+	void octree::detach(entry current)
+	{
+		std::vector<item>& items = nodes_[current.node].items;
+
+		// the last item takes the place of the removed one
+		size_t last = items.size() - 1;
+
+		if (current.slot != last)
+		{
+			items[current.slot] = items[last];
+			entries_[items[current.slot].id].slot = current.slot;
+		}
+
+		items.pop_back();
+
+		// nodes left without boxes or children are released, which usually stops at the node itself
+		uint32_t index = current.node;
+
+		while (index != 0 && nodes_[index].items.empty() && nodes_[index].childCount == 0)
+		{
+			uint32_t parent = nodes_[index].parent;
+
+			release(index);
+			index = parent;
+		}
+	}
+
+	const octree::entry& octree::find(size_t id) const
+	{
+		if (!contains(id))
+		{
+			throw std::invalid_argument("The id (" + std::to_string(id) + ") does not belong to a box in the octree.");
+		}
+
+		return entries_[id];
+	}
+}
\ No newline at end of file
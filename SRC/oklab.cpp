@@ -0,0 +1,161 @@
+#include "../INC/Aurora/Mathematics/oklab.h"
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/oklch.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of colors handed to a thread at a time
+		constexpr size_t oklabGrain = 16384;
+
+		// cube root accurate to float precision without calling into the C runtime, so that the conversion loops remain vectorizable
+		inline float oklabCbrt(float value)
+		{
+			float magnitude = value < 0.0f ? -value : value;
+			float estimate = std::bit_cast<float>(std::bit_cast<uint32_t>(magnitude) / 3u + 709921077u);
+
+			estimate = (2.0f * estimate + magnitude / (estimate * estimate)) * (1.0f / 3.0f);
+			estimate = (2.0f * estimate + magnitude / (estimate * estimate)) * (1.0f / 3.0f);
+			estimate = (2.0f * estimate + magnitude / (estimate * estimate)) * (1.0f / 3.0f);
+
+			estimate = magnitude == 0.0f ? 0.0f : estimate;
+			return value < 0.0f ? -estimate : estimate;
+		}
+	}
+
+	oklab::oklab() : oklab(0.0f, 0.0f, 0.0f, 1.0f) { }
+
+	oklab::oklab(float l, float a, float b, float alpha) : l(l), a(a), b(b), alpha(alpha) { }
+
+	bool oklab::approximately(oklab value1, oklab value2)
+	{
+		return
+			Mathematics::approximately(value1.l, value2.l) &&
+			Mathematics::approximately(value1.a, value2.a) &&
+			Mathematics::approximately(value1.b, value2.b) &&
+			Mathematics::approximately(value1.alpha, value2.alpha);
+	}
+
+	float oklab::difference(oklab value1, oklab value2)
+	{
+		float dl = value1.l - value2.l;
+		float da = value1.a - value2.a;
+		float db = value1.b - value2.b;
+
+		return sqrt(dl * dl + da * da + db * db);
+	}
+
+	oklab oklab::lerp(oklab value1, oklab value2, float amount)
+	{
+		return lerpUnclamped(value1, value2, clamp01(amount));
+	}
+
+	oklab oklab::lerpUnclamped(oklab value1, oklab value2, float amount)
+	{
+		return oklab(
+			Mathematics::lerpUnclamped(value1.l, value2.l, amount),
+			Mathematics::lerpUnclamped(value1.a, value2.a, amount),
+			Mathematics::lerpUnclamped(value1.b, value2.b, amount),
+			Mathematics::lerpUnclamped(value1.alpha, value2.alpha, amount)
+		);
+	}
+
+	bool oklab::operator==(oklab other) const
+	{
+		return l == other.l && a == other.a && b == other.b && alpha == other.alpha;
+	}
+
+	bool oklab::operator!=(oklab other) const
+	{
+		return !((*this) == other);
+	}
+
+	oklab::operator col() const
+	{
+		col result;
+		convert(std::span<const oklab>(this, 1), std::span<col>(&result, 1));
+		return result;
+	}
+
+	oklab::operator oklch() const
+	{
+		float c = sqrt(a * a + b * b);
+		float h = c == 0.0f ? 0.0f : wrapAngleUnsigned(atan(b, a) + 360.0f);
+
+		return oklch(l, c, h, alpha);
+	}
+
+	void convert(std::span<const col> source, std::span<oklab> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), oklabGrain, [&](size_t begin, size_t end)
+			{
+				const col* s = source.data();
+				oklab* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float r = s[i].r;
+					float g = s[i].g;
+					float b = s[i].b;
+					float alpha = s[i].a;
+
+					float l = oklabCbrt(0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b);
+					float m = oklabCbrt(0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b);
+					float n = oklabCbrt(0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b);
+
+					d[i].l = 0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * n;
+					d[i].a = 1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * n;
+					d[i].b = 0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * n;
+					d[i].alpha = alpha;
+				}
+			});
+	}
+
+	void convert(std::span<const oklab> source, std::span<col> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), oklabGrain, [&](size_t begin, size_t end)
+			{
+				const oklab* s = source.data();
+				col* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float lightness = s[i].l;
+					float a = s[i].a;
+					float b = s[i].b;
+					float alpha = s[i].alpha;
+
+					float l = lightness + 0.3963377774f * a + 0.2158037573f * b;
+					float m = lightness - 0.1055613458f * a - 0.0638541728f * b;
+					float n = lightness - 0.0894841775f * a - 1.2914855480f * b;
+
+					l = l * l * l;
+					m = m * m * m;
+					n = n * n * n;
+
+					d[i].r = 4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * n;
+					d[i].g = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * n;
+					d[i].b = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * n;
+					d[i].a = alpha;
+				}
+			});
+	}
+}
\ No newline at end of file
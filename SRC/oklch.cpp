@@ -0,0 +1,120 @@
+#include "../INC/Aurora/Mathematics/oklch.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/oklab.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of colors handed to a thread at a time
+		constexpr size_t oklchGrain = 16384;
+
+		// number of colors converted through the intermediate oklab buffer at a time
+		constexpr size_t oklchLanes = 256;
+	}
+
+	oklch::oklch() : oklch(0.0f, 0.0f, 0.0f, 1.0f) { }
+
+	oklch::oklch(float l, float c, float h, float alpha) : l(l), c(c), h(h), alpha(alpha) { }
+
+	bool oklch::approximately(oklch value1, oklch value2)
+	{
+		return
+			Mathematics::approximately(value1.l, value2.l) &&
+			Mathematics::approximately(value1.c, value2.c) &&
+			Mathematics::approximately(value1.h, value2.h) &&
+			Mathematics::approximately(value1.alpha, value2.alpha);
+	}
+
+	oklch oklch::lerp(oklch value1, oklch value2, float amount, LerpDirection direction)
+	{
+		return lerpUnclamped(value1, value2, clamp01(amount), direction);
+	}
+
+	oklch oklch::lerpUnclamped(oklch value1, oklch value2, float amount, LerpDirection direction)
+	{
+		return oklch(
+			Mathematics::lerpUnclamped(value1.l, value2.l, amount),
+			Mathematics::lerpUnclamped(value1.c, value2.c, amount),
+			Mathematics::wrapAngleUnsigned(Mathematics::lerpAngleUnclamped(value1.h, value2.h, amount, direction) + 360.0f),
+			Mathematics::lerpUnclamped(value1.alpha, value2.alpha, amount)
+		);
+	}
+
+	bool oklch::operator==(oklch other) const
+	{
+		return l == other.l && c == other.c && h == other.h && alpha == other.alpha;
+	}
+
+	bool oklch::operator!=(oklch other) const
+	{
+		return !((*this) == other);
+	}
+
+	oklch::operator col() const
+	{
+		return (col)(oklab)(*this);
+	}
+
+	oklch::operator oklab() const
+	{
+		return oklab(l, c * cos(h), c * sin(h), alpha);
+	}
+
+	void convert(std::span<const col> source, std::span<oklch> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), oklchGrain, [&](size_t begin, size_t end)
+			{
+				oklab lab[oklchLanes];
+
+				for (size_t start = begin; start < end; start += oklchLanes)
+				{
+					size_t n = std::min(oklchLanes, end - start);
+
+					// nested batch calls run on this thread since the block is below the grain of the inner conversion
+					convert(source.subspan(start, n), std::span<oklab>(lab, n));
+
+					for (size_t i = 0; i < n; i++)
+					{
+						destination[start + i] = (oklch)lab[i];
+					}
+				}
+			});
+	}
+
+	void convert(std::span<const oklch> source, std::span<col> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), oklchGrain, [&](size_t begin, size_t end)
+			{
+				oklab lab[oklchLanes];
+
+				for (size_t start = begin; start < end; start += oklchLanes)
+				{
+					size_t n = std::min(oklchLanes, end - start);
+
+					for (size_t i = 0; i < n; i++)
+					{
+						lab[i] = (oklab)source[start + i];
+					}
+
+					convert(std::span<const oklab>(lab, n), destination.subspan(start, n));
+				}
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Aurora::Mathematics
+{
+	unsigned int hardwareThreadCount()
+	{
+		unsigned int count = std::thread::hardware_concurrency();
+		return count == 0 ? 1 : count;
+	}
+
+	std::atomic<unsigned int> threadCount_ = hardwareThreadCount();
+
+	unsigned int threadCount()
+	{
+		return threadCount_.load(std::memory_order_relaxed);
+	}
+
+	void threadCount(unsigned int value)
+	{
+		threadCount_.store(value == 0 ? hardwareThreadCount() : value, std::memory_order_relaxed);
+	}
+
+	void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		grain = std::max<size_t>(grain, 1);
+
+		size_t blocks = (count + grain - 1) / grain;
+		size_t workers = std::min<size_t>(threadCount(), blocks);
+
+		if (workers <= 1)
+		{
+			for (size_t begin = 0; begin < count; begin += grain)
+			{
+				body(begin, std::min(begin + grain, count));
+			}
+
+			return;
+		}
+
+		// blocks are handed out through a shared counter so that uneven blocks balance themselves across the workers
+		std::atomic<size_t> next = 0;
+		std::atomic<bool> failed = false;
+		std::exception_ptr error;
+		std::mutex errorLock;
+
+		auto work = [&]()
+			{
+				while (!failed.load(std::memory_order_relaxed))
+				{
+					size_t block = next.fetch_add(1, std::memory_order_relaxed);
+
+					if (block >= blocks)
+					{
+						return;
+					}
+
+					size_t begin = block * grain;
+
+					try
+					{
+						body(begin, std::min(begin + grain, count));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(errorLock);
+
+						if (!error)
+						{
+							error = std::current_exception();
+						}
+
+						failed.store(true, std::memory_order_relaxed);
+					}
+				}
+			};
+
+		std::vector<std::thread> threads;
+		threads.reserve(workers - 1);
+
+		for (size_t i = 1; i < workers; i++)
+		{
+			threads.emplace_back(work);
+		}
+
+		work();
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+}
\ No newline at end of file
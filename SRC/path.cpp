@@ -0,0 +1,711 @@
+#include "../INC/Aurora/Mathematics/path.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		constexpr float pathPi = 3.14159265f;
+
+		// the share of the tolerance left to the quadratic curves approximating a cubic, the rest going to flattening them
+		constexpr float pathCubicShare = 0.1f;
+
+		// directions whose cross product is below this are parallel, and need no join between them when they go the same way
+		constexpr float pathParallel = 1e-6f;
+
+		void pathValidate(float tolerance)
+		{
+			if (!(tolerance > 0.0f))
+			{
+				throw std::invalid_argument("The tolerance (" + std::to_string(tolerance) + ") must be positive.");
+			}
+		}
+
+		// the closed forms approximating the integral of the square root of the curvature of the parabola y = x * x and its inverse, which spread the lines of a curve by how much it turns
+		inline float pathParabolaIntegral(float x)
+		{
+			constexpr float d = 0.67f;
+			return x / (1.0f - d + std::sqrt(std::sqrt(d * d * d * d + 0.25f * x * x)));
+		}
+
+		inline float pathParabolaInverse(float x)
+		{
+			constexpr float b = 0.39f;
+			return x * (1.0f - b + std::sqrt(b * b + 0.25f * x * x));
+		}
+
+		// appends a point to the contour starting at first, unless it repeats the last point
+		inline void pathAppend(std::vector<float>& points, size_t first, float x, float y)
+		{
+			if (points.size() > first && points[points.size() - 2] == x && points.back() == y)
+			{
+				return;
+			}
+
+			points.push_back(x);
+			points.push_back(y);
+		}
+
+		// appends the lines of a quadratic curve after its start, as many as keep the curve within the tolerance, by mapping the curve onto the segment of the parabola of the same shape
+		void pathQuadratic(const float* p0, const float* p1, const float* p2, float tolerance, std::vector<float>& points, size_t first)
+		{
+			float d01x = p1[0] - p0[0];
+			float d01y = p1[1] - p0[1];
+			float d12x = p2[0] - p1[0];
+			float d12y = p2[1] - p1[1];
+			float ddx = d01x - d12x;
+			float ddy = d01y - d12y;
+			float cross = (p2[0] - p0[0]) * ddy - (p2[1] - p0[1]) * ddx;
+			float x0 = (d01x * ddx + d01y * ddy) / cross;
+			float x2 = (d12x * ddx + d12y * ddy) / cross;
+			float scale = std::fabs(cross / (std::sqrt(ddx * ddx + ddy * ddy) * (x2 - x0)));
+			float root = std::sqrt(tolerance);
+
+			auto evaluate = [&](float t)
+				{
+					float u = 1.0f - t;
+					pathAppend(points, first, u * u * p0[0] + 2.0f * u * t * p1[0] + t * t * p2[0], u * u * p0[1] + 2.0f * u * t * p1[1] + t * t * p2[1]);
+				};
+
+			// a curve whose points are on one line is a line, which turns back on itself where the control point is past either end
+			if (!std::isfinite(scale))
+			{
+				float lengthSquared = ddx * ddx + ddy * ddy;
+				float t = lengthSquared > 0.0f ? (d01x * ddx + d01y * ddy) / lengthSquared : 0.0f;
+
+				if (t > 0.0f && t < 1.0f)
+				{
+					evaluate(t);
+				}
+
+				pathAppend(points, first, p2[0], p2[1]);
+				return;
+			}
+
+			float a0 = pathParabolaIntegral(x0);
+			float a2 = pathParabolaIntegral(x2);
+			float turn = std::fabs(a2 - a0);
+			float rootScale = std::sqrt(scale);
+
+			// the segment of the parabola holds its vertex when its ends are on either side of it, whose curvature is the largest
+			float value = (x0 < 0.0f) == (x2 < 0.0f) ? turn * rootScale : root * turn / pathParabolaIntegral(root / rootScale);
+			float pieces = 0.5f * value / root;
+			size_t count = pieces > 1.0f ? static_cast<size_t>(std::ceil(pieces)) : 1;
+			float u0 = pathParabolaInverse(a0);
+			float inverse = 1.0f / (pathParabolaInverse(a2) - u0);
+
+			for (size_t i = 1; i < count; i++)
+			{
+				float u = pathParabolaInverse(a0 + (a2 - a0) * static_cast<float>(i) / static_cast<float>(count));
+				evaluate((u - u0) * inverse);
+			}
+
+			pathAppend(points, first, p2[0], p2[1]);
+		}
+
+		// splits a cubic curve into quadratic curves, as many as keep each within its share of the tolerance, from the bound on the distance between a cubic and the quadratic sharing its ends and the tangents of its midpoint
+		void pathCubic(const float* p0, const float* p1, const float* p2, const float* p3, float tolerance, std::vector<float>& points, size_t first)
+		{
+			float accuracy = pathCubicShare * tolerance;
+			float ex = 3.0f * (p2[0] - p1[0]) + p0[0] - p3[0];
+			float ey = 3.0f * (p2[1] - p1[1]) + p0[1] - p3[1];
+			float bound = (ex * ex + ey * ey) / (432.0f * accuracy * accuracy);
+			size_t count = bound > 1.0f ? static_cast<size_t>(std::ceil(std::pow(bound, 1.0f / 6.0f))) : 1;
+
+			auto point = [&](float t, float* result)
+				{
+					float u = 1.0f - t;
+					float b0 = u * u * u;
+					float b1 = 3.0f * u * u * t;
+					float b2 = 3.0f * u * t * t;
+					float b3 = t * t * t;
+					result[0] = b0 * p0[0] + b1 * p1[0] + b2 * p2[0] + b3 * p3[0];
+					result[1] = b0 * p0[1] + b1 * p1[1] + b2 * p2[1] + b3 * p3[1];
+				};
+
+			auto derivative = [&](float t, float* result)
+				{
+					float u = 1.0f - t;
+					result[0] = 3.0f * (u * u * (p1[0] - p0[0]) + 2.0f * u * t * (p2[0] - p1[0]) + t * t * (p3[0] - p2[0]));
+					result[1] = 3.0f * (u * u * (p1[1] - p0[1]) + 2.0f * u * t * (p2[1] - p1[1]) + t * t * (p3[1] - p2[1]));
+				};
+
+			float start[2] = { p0[0], p0[1] };
+			float slope0[2];
+			derivative(0.0f, slope0);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				float t1 = static_cast<float>(i + 1) / static_cast<float>(count);
+				float third = 1.0f / (3.0f * static_cast<float>(count));
+				float end[2];
+				float slope1[2];
+
+				if (i + 1 == count)
+				{
+					end[0] = p3[0];
+					end[1] = p3[1];
+				}
+				else
+				{
+					point(t1, end);
+				}
+
+				derivative(t1, slope1);
+
+				// the control point of the quadratic is the average of where the two control points of the piece of the cubic extend its tangents to
+				float control[2] =
+				{
+					(3.0f * (start[0] + slope0[0] * third + end[0] - slope1[0] * third) - start[0] - end[0]) * 0.25f,
+					(3.0f * (start[1] + slope0[1] * third + end[1] - slope1[1] * third) - start[1] - end[1]) * 0.25f
+				};
+
+				pathQuadratic(start, control, end, tolerance - accuracy, points, first);
+				start[0] = end[0];
+				start[1] = end[1];
+				slope0[0] = slope1[0];
+				slope0[1] = slope1[1];
+			}
+		}
+
+		// writes the triangles that fit in the vertices and counts every triangle
+		struct pathWriter
+		{
+			std::span<vec2> vertices;
+			size_t count;
+
+			void triangle(float ax, float ay, float bx, float by, float cx, float cy)
+			{
+				if (count + 3 <= vertices.size())
+				{
+					vertices[count] = vec2(ax, ay);
+					vertices[count + 1] = vec2(bx, by);
+					vertices[count + 2] = vec2(cx, cy);
+				}
+
+				count += 3;
+			}
+		};
+
+		// the angle between the points of an arc of a radius that keeps the chords between them within the tolerance, 2 acos(1 - tolerance / radius) written so it does not round to 0 for a small tolerance
+		inline float pathArcStep(float radius, float tolerance)
+		{
+			return 4.0f * std::asin(std::sqrt(std::min(0.5f * tolerance / radius, 1.0f)));
+		}
+
+		// a fan of triangles around a center covering the arc from an offset turning by an angle, counterclockwise when positive
+		void pathArc(pathWriter& writer, float cx, float cy, float ox, float oy, float angle, float step)
+		{
+			float pieces = std::fabs(angle) / step;
+			size_t count = pieces > 1.0f ? static_cast<size_t>(std::ceil(pieces)) : 1;
+			float c = std::cos(angle / static_cast<float>(count));
+			float s = std::sin(angle / static_cast<float>(count));
+
+			for (size_t i = 0; i < count; i++)
+			{
+				float nx = ox * c - oy * s;
+				float ny = ox * s + oy * c;
+				writer.triangle(cx, cy, cx + ox, cy + oy, cx + nx, cy + ny);
+				ox = nx;
+				oy = ny;
+			}
+		}
+
+		// an edge of a filled path going down the plane, with the direction it was drawn in
+		struct pathEdge
+		{
+			float top;
+			float bottom;
+			float x;
+			float bottomX;
+			float slope;
+			int32_t winding;
+		};
+
+		// an edge crossing the band being filled, with its position at the top and the bottom of the band
+		struct pathCrossing
+		{
+			float top;
+			float bottom;
+			int32_t winding;
+			uint32_t edge;
+		};
+
+		inline float pathEdgeX(const pathEdge& edge, float y)
+		{
+			return y >= edge.bottom ? edge.bottomX : edge.x + (y - edge.top) * edge.slope;
+		}
+	}
+
+	path::path() : current_{ 0.0f, 0.0f }, start_{ 0.0f, 0.0f }, contours_(0), open_(false) { }
+
+	void path::moveTo(vec2 point)
+	{
+		verbs_.push_back(verb::Move);
+		points_.push_back(point.x);
+		points_.push_back(point.y);
+		current_[0] = start_[0] = point.x;
+		current_[1] = start_[1] = point.y;
+		contours_++;
+		open_ = true;
+	}
+
+	void path::lineTo(vec2 point)
+	{
+		begin();
+		verbs_.push_back(verb::Line);
+		points_.push_back(point.x);
+		points_.push_back(point.y);
+		current_[0] = point.x;
+		current_[1] = point.y;
+	}
+
+	void path::quadraticTo(vec2 control, vec2 point)
+	{
+		begin();
+		verbs_.push_back(verb::Quadratic);
+		points_.insert(points_.end(), { control.x, control.y, point.x, point.y });
+		current_[0] = point.x;
+		current_[1] = point.y;
+	}
+
+	void path::cubicTo(vec2 control1, vec2 control2, vec2 point)
+	{
+		begin();
+		verbs_.push_back(verb::Cubic);
+		points_.insert(points_.end(), { control1.x, control1.y, control2.x, control2.y, point.x, point.y });
+		current_[0] = point.x;
+		current_[1] = point.y;
+	}
+
+	void path::close()
+	{
+		if (!open_)
+		{
+			return;
+		}
+
+		verbs_.push_back(verb::Close);
+		current_[0] = start_[0];
+		current_[1] = start_[1];
+		open_ = false;
+	}
+
+	void path::clear()
+	{
+		verbs_.clear();
+		points_.clear();
+		current_[0] = current_[1] = 0.0f;
+		start_[0] = start_[1] = 0.0f;
+		contours_ = 0;
+		open_ = false;
+	}
+
+	bool path::empty() const
+	{
+		return contours_ == 0;
+	}
+
+	size_t path::contours() const
+	{
+		return contours_;
+	}
+
+	size_t path::flatten(float tolerance, std::span<vec2> points, std::span<size_t> ends) const
+	{
+		pathValidate(tolerance);
+
+		if (ends.size() < contours_)
+		{
+			throw std::invalid_argument("The ends (" + std::to_string(ends.size()) + ") are fewer than required (" + std::to_string(contours_) + ").");
+		}
+
+		std::vector<float> flattened;
+		std::vector<size_t> contourEnds;
+		std::vector<uint8_t> closed;
+		polylines(tolerance, flattened, contourEnds, closed);
+
+		size_t count = flattened.size() / 2;
+		size_t written = std::min(count, points.size());
+
+		for (size_t i = 0; i < written; i++)
+		{
+			points[i] = vec2(flattened[i * 2], flattened[i * 2 + 1]);
+		}
+
+		for (size_t c = 0; c < contourEnds.size(); c++)
+		{
+			ends[c] = contourEnds[c] / 2;
+		}
+
+		return count;
+	}
+
+	size_t path::stroke(float width, float tolerance, std::span<vec2> vertices, LineJoin join, LineCap cap, float miterLimit) const
+	{
+		pathValidate(tolerance);
+
+		if (!(width > 0.0f))
+		{
+			return 0;
+		}
+
+		std::vector<float> flattened;
+		std::vector<size_t> ends;
+		std::vector<uint8_t> closed;
+		polylines(tolerance, flattened, ends, closed);
+
+		pathWriter writer = { vertices, 0 };
+		float half = 0.5f * width;
+		float step = pathArcStep(half, tolerance);
+		float limit = miterLimit * miterLimit;
+		std::vector<float> directions;
+
+		for (size_t c = 0, first = 0; c < ends.size(); first = ends[c], c++)
+		{
+			const float* p = flattened.data() + first;
+			size_t count = (ends[c] - first) / 2;
+
+			// a closed contour is stroked around its corners rather than back to its repeated first point
+			if (closed[c] && count > 1 && p[0] == p[(count - 1) * 2] && p[1] == p[(count - 1) * 2 + 1])
+			{
+				count--;
+			}
+
+			if (count == 1)
+			{
+				if (cap == LineCap::Round)
+				{
+					pathArc(writer, p[0], p[1], half, 0.0f, 2.0f * pathPi, step);
+				}
+				else if (cap == LineCap::Square)
+				{
+					writer.triangle(p[0] - half, p[1] - half, p[0] + half, p[1] - half, p[0] + half, p[1] + half);
+					writer.triangle(p[0] - half, p[1] - half, p[0] + half, p[1] + half, p[0] - half, p[1] + half);
+				}
+
+				continue;
+			}
+
+			bool loop = closed[c] != 0;
+			size_t segments = loop ? count : count - 1;
+			directions.resize(segments * 2);
+
+			for (size_t i = 0; i < segments; i++)
+			{
+				const float* a = p + i * 2;
+				const float* b = p + ((i + 1) % count) * 2;
+				float dx = b[0] - a[0];
+				float dy = b[1] - a[1];
+				float inverse = 1.0f / std::sqrt(dx * dx + dy * dy);
+				directions[i * 2] = dx * inverse;
+				directions[i * 2 + 1] = dy * inverse;
+
+				// the normal of the segment, to its left
+				float nx = -directions[i * 2 + 1] * half;
+				float ny = directions[i * 2] * half;
+				writer.triangle(a[0] + nx, a[1] + ny, a[0] - nx, a[1] - ny, b[0] + nx, b[1] + ny);
+				writer.triangle(b[0] + nx, b[1] + ny, a[0] - nx, a[1] - ny, b[0] - nx, b[1] - ny);
+			}
+
+			for (size_t i = loop ? 0 : 1; i < (loop ? count : count - 1); i++)
+			{
+				const float* corner = p + i * 2;
+				const float* d0 = directions.data() + ((i + segments - 1) % segments) * 2;
+				const float* d1 = directions.data() + i * 2;
+				float cross = d0[0] * d1[1] - d0[1] * d1[0];
+				float dot = d0[0] * d1[0] + d0[1] * d1[1];
+
+				if (std::fabs(cross) < pathParallel && dot > 0.0f)
+				{
+					continue;
+				}
+
+				// the outer side of a left turn is to the right of both segments, and the arc between them turns the same way as the path
+				float side = cross >= 0.0f ? -half : half;
+				float o0x = -d0[1] * side;
+				float o0y = d0[0] * side;
+				float o1x = -d1[1] * side;
+				float o1y = d1[0] * side;
+
+				if (join == LineJoin::Round)
+				{
+					pathArc(writer, corner[0], corner[1], o0x, o0y, std::copysign(std::atan2(std::fabs(cross), dot), cross >= 0.0f ? 1.0f : -1.0f), step);
+					continue;
+				}
+
+				// the miter reaches 1 / cos of half the turn past the corner, in units of half the width
+				if (join == LineJoin::Miter && (1.0f + dot) * limit >= 2.0f)
+				{
+					float mx = corner[0] + (o0x + o1x) / (1.0f + dot);
+					float my = corner[1] + (o0y + o1y) / (1.0f + dot);
+					writer.triangle(corner[0], corner[1], corner[0] + o0x, corner[1] + o0y, mx, my);
+					writer.triangle(corner[0], corner[1], mx, my, corner[0] + o1x, corner[1] + o1y);
+					continue;
+				}
+
+				writer.triangle(corner[0], corner[1], corner[0] + o0x, corner[1] + o0y, corner[0] + o1x, corner[1] + o1y);
+			}
+
+			if (loop || cap == LineCap::Butt)
+			{
+				continue;
+			}
+
+			// the start is capped going back along the first segment and the end going on along the last, both from the normal to the left of the path
+			for (size_t e = 0; e < 2; e++)
+			{
+				const float* end = e == 0 ? p : p + (count - 1) * 2;
+				const float* d = directions.data() + (e == 0 ? 0 : (segments - 1) * 2);
+				float forward = e == 0 ? -half : half;
+				float nx = -d[1] * half * (e == 0 ? 1.0f : -1.0f);
+				float ny = d[0] * half * (e == 0 ? 1.0f : -1.0f);
+
+				if (cap == LineCap::Round)
+				{
+					pathArc(writer, end[0], end[1], nx, ny, pathPi, step);
+					continue;
+				}
+
+				float fx = d[0] * forward;
+				float fy = d[1] * forward;
+				writer.triangle(end[0] + nx, end[1] + ny, end[0] - nx, end[1] - ny, end[0] + nx + fx, end[1] + ny + fy);
+				writer.triangle(end[0] + nx + fx, end[1] + ny + fy, end[0] - nx, end[1] - ny, end[0] - nx + fx, end[1] - ny + fy);
+			}
+		}
+
+		return writer.count;
+	}
+
+	size_t path::fill(float tolerance, std::span<vec2> vertices, FillRule rule) const
+	{
+		pathValidate(tolerance);
+
+		std::vector<float> flattened;
+		std::vector<size_t> ends;
+		std::vector<uint8_t> closed;
+		polylines(tolerance, flattened, ends, closed);
+
+		// every contour is closed by an edge back to its first point, and horizontal edges cover no band
+		std::vector<pathEdge> edges;
+		std::vector<float> heights;
+
+		for (size_t c = 0, first = 0; c < ends.size(); first = ends[c], c++)
+		{
+			size_t count = (ends[c] - first) / 2;
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const float* a = flattened.data() + first + i * 2;
+				const float* b = flattened.data() + first + ((i + 1) % count) * 2;
+
+				if (!(a[1] != b[1]) || !std::isfinite(a[0]) || !std::isfinite(a[1]) || !std::isfinite(b[0]) || !std::isfinite(b[1]))
+				{
+					continue;
+				}
+
+				const float* top = a[1] < b[1] ? a : b;
+				const float* bottom = a[1] < b[1] ? b : a;
+				edges.push_back({ top[1], bottom[1], top[0], bottom[0], (bottom[0] - top[0]) / (bottom[1] - top[1]), a[1] < b[1] ? 1 : -1 });
+				heights.push_back(top[1]);
+				heights.push_back(bottom[1]);
+			}
+		}
+
+		std::sort(edges.begin(), edges.end(), [](const pathEdge& a, const pathEdge& b) { return a.top < b.top; });
+		std::sort(heights.begin(), heights.end());
+		heights.erase(std::unique(heights.begin(), heights.end()), heights.end());
+
+		pathWriter writer = { vertices, 0 };
+		std::vector<pathCrossing> active;
+		size_t next = 0;
+		size_t height = 1;
+		float y = heights.empty() ? 0.0f : heights.front();
+
+		// each band runs from the current height to the next vertex, or to the first crossing of two edges before it, so the edges keep their order across the band
+		while (height < heights.size())
+		{
+			float y1 = heights[height];
+
+			active.erase(std::remove_if(active.begin(), active.end(), [&](const pathCrossing& crossing) { return edges[crossing.edge].bottom <= y; }), active.end());
+
+			for (; next < edges.size() && edges[next].top <= y; next++)
+			{
+				active.push_back({ 0.0f, 0.0f, edges[next].winding, static_cast<uint32_t>(next) });
+			}
+
+			for (pathCrossing& crossing : active)
+			{
+				crossing.top = pathEdgeX(edges[crossing.edge], y);
+				crossing.bottom = pathEdgeX(edges[crossing.edge], y1);
+			}
+
+			// the order changes little from one band to the next, which insertion sort takes advantage of
+			for (size_t i = 1; i < active.size(); i++)
+			{
+				pathCrossing crossing = active[i];
+				size_t j = i;
+
+				for (; j > 0 && (active[j - 1].top > crossing.top || (active[j - 1].top == crossing.top && active[j - 1].bottom > crossing.bottom)); j--)
+				{
+					active[j] = active[j - 1];
+				}
+
+				active[j] = crossing;
+			}
+
+			float crossing = y1;
+
+			for (size_t i = 1; i < active.size(); i++)
+			{
+				float d0 = active[i].top - active[i - 1].top;
+				float d1 = active[i].bottom - active[i - 1].bottom;
+
+				if (!(d1 < 0.0f))
+				{
+					continue;
+				}
+
+				float at = y + (y1 - y) * (d0 / (d0 - d1));
+
+				// two edges whose crossing rounds to the top of the band, as after the band before was split at their crossing and their positions differ by rounding, are already past it, so they are swapped and the pair before them checked again
+				if (!(at > y))
+				{
+					std::swap(active[i - 1], active[i]);
+					i = i >= 2 ? i - 2 : 0;
+					continue;
+				}
+
+				crossing = std::min(crossing, at);
+			}
+
+			if (crossing < y1)
+			{
+				y1 = crossing;
+
+				for (pathCrossing& edge : active)
+				{
+					edge.bottom = pathEdgeX(edges[edge.edge], y1);
+				}
+			}
+
+			int32_t winding = 0;
+			size_t left = 0;
+
+			for (size_t i = 0; i < active.size(); i++)
+			{
+				bool before = rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+				winding += active[i].winding;
+				bool after = rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+
+				if (!before && after)
+				{
+					left = i;
+				}
+				else if (before && !after)
+				{
+					const pathCrossing& l = active[left];
+					const pathCrossing& r = active[i];
+
+					if (r.top > l.top)
+					{
+						writer.triangle(l.top, y, r.top, y, r.bottom, y1);
+					}
+
+					if (r.bottom > l.bottom)
+					{
+						writer.triangle(l.top, y, r.bottom, y1, l.bottom, y1);
+					}
+				}
+			}
+
+			if (y1 >= heights[height])
+			{
+				height++;
+			}
+
+			y = y1;
+		}
+
+		return writer.count;
+	}
+
+	void path::begin()
+	{
+		if (!open_)
+		{
+			verbs_.push_back(verb::Move);
+			points_.push_back(current_[0]);
+			points_.push_back(current_[1]);
+			start_[0] = current_[0];
+			start_[1] = current_[1];
+			contours_++;
+			open_ = true;
+		}
+	}
+
+	void path::polylines(float tolerance, std::vector<float>& points, std::vector<size_t>& ends, std::vector<uint8_t>& closed) const
+	{
+		const float* p = points_.data();
+		size_t first = 0;
+		bool pending = false;
+
+		points.reserve(points_.size());
+
+		for (size_t v = 0; v < verbs_.size(); v++)
+		{
+			switch (verbs_[v])
+			{
+			case verb::Move:
+				if (pending)
+				{
+					ends.push_back(points.size());
+					closed.push_back(0);
+				}
+
+				pending = true;
+				first = points.size();
+				points.push_back(p[0]);
+				points.push_back(p[1]);
+				p += 2;
+				break;
+			case verb::Line:
+				pathAppend(points, first, p[0], p[1]);
+				p += 2;
+				break;
+			case verb::Quadratic:
+			{
+				float start[2] = { points[points.size() - 2], points.back() };
+				pathQuadratic(start, p, p + 2, tolerance, points, first);
+				p += 4;
+				break;
+			}
+			case verb::Cubic:
+			{
+				float start[2] = { points[points.size() - 2], points.back() };
+				pathCubic(start, p, p + 2, p + 4, tolerance, points, first);
+				p += 6;
+				break;
+			}
+			case verb::Close:
+				pathAppend(points, first, points[first], points[first + 1]);
+				ends.push_back(points.size());
+				closed.push_back(1);
+				pending = false;
+				break;
+			}
+		}
+
+		// the last contour ends with the path unless it was closed
+		if (pending)
+		{
+			ends.push_back(points.size());
+			closed.push_back(0);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "../INC/Aurora/Mathematics/plane.h"
+
+#include "../INC/Aurora/Mathematics/math.h"
+
+namespace Aurora::Mathematics
+{
+	plane::plane() : plane(vec3::up(), 0.0f) { }
+
+	plane::plane(vec3 normal, float distance) : normal(normal), distance(distance) { }
+
+	plane::plane(vec3 normal, vec3 point) : normal(normal), distance(-vec3::dot(normal, point)) { }
+
+	plane::plane(vec3 point1, vec3 point2, vec3 point3) : plane(vec3::cross(point2 - point1, point3 - point1).normalized(), point1) { }
+
+	bool plane::approximately(plane value1, plane value2)
+	{
+		return vec3::approximately(value1.normal, value2.normal) && Mathematics::approximately(value1.distance, value2.distance);
+	}
+
+	plane plane::normalize(plane value)
+	{
+		float length = value.normal.length();
+		return plane(value.normal / length, value.distance / length);
+	}
+
+	plane plane::normalized() const
+	{
+		return normalize(*this);
+	}
+
+	plane plane::flipped() const
+	{
+		return plane(-normal, -distance);
+	}
+
+	float plane::signedDistance(vec3 point) const
+	{
+		return vec3::dot(normal, point) + distance;
+	}
+
+	vec3 plane::closestPoint(vec3 point) const
+	{
+		return point - normal * (signedDistance(point) / normal.lengthSquared());
+	}
+
+	bool plane::operator==(plane other) const
+	{
+		return normal == other.normal && distance == other.distance;
+	}
+
+	bool plane::operator!=(plane other) const
+	{
+		return !((*this) == other);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,428 @@
+#include "../INC/Aurora/Mathematics/pose.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// the components of a bone, each stored as its own array of every bone
+		constexpr size_t poseTranslationX = 0;
+		constexpr size_t poseRotationX = 3;
+		constexpr size_t poseRotationW = 6;
+		constexpr size_t poseScaleX = 7;
+		constexpr size_t poseChannels = 10;
+
+		// number of poses blended by a thread at a time, a skeleton of a couple hundred bones taking a few microseconds per layer
+		constexpr size_t poseGrain = 8;
+
+		struct poseChannelsView
+		{
+			float* c[poseChannels];
+		};
+
+		struct poseConstChannelsView
+		{
+			const float* c[poseChannels];
+		};
+
+		// the weight of an interpolation between rotations whose dot product is d, moved so the normalized interpolation follows the constant angular speed of a spherical one
+		// a cubic in the weight that is exact at 0, 0.5 and 1, fitted over the dot product, which keeps the error below a tenth of a degree
+		inline float poseCorrect(float t, float d)
+		{
+			float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+			float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+			float k = a * (t - 0.5f) * (t - 0.5f) + b;
+			return t + t * (t - 0.5f) * (t - 1.0f) * k;
+		}
+
+		// number of bones of a rotation processed together, copied into local arrays so the compiler knows they do not overlap the pose
+		constexpr size_t poseLanes = 8;
+
+		struct poseTile
+		{
+			float x[poseLanes];
+			float y[poseLanes];
+			float z[poseLanes];
+			float w[poseLanes];
+			float t[poseLanes];
+		};
+
+		// the lanes past the last bone are padded with the first bone of the tile, so every lane computes a valid rotation
+		template <bool Masked>
+		inline void poseLoad(const float* const* channels, size_t base, size_t count, float weight, const float* mask, poseTile& tile)
+		{
+			for (size_t l = 0; l < poseLanes; l++)
+			{
+				size_t i = base + (l < count ? l : 0);
+				tile.x[l] = channels[poseRotationX][i];
+				tile.y[l] = channels[poseRotationX + 1][i];
+				tile.z[l] = channels[poseRotationX + 2][i];
+				tile.w[l] = channels[poseRotationW][i];
+				tile.t[l] = Masked ? weight * mask[i] : weight;
+			}
+		}
+
+		inline void poseStore(float* const* channels, size_t base, size_t count, const poseTile& tile)
+		{
+			for (size_t l = 0; l < count; l++)
+			{
+				channels[poseRotationX][base + l] = tile.x[l];
+				channels[poseRotationX + 1][base + l] = tile.y[l];
+				channels[poseRotationX + 2][base + l] = tile.z[l];
+				channels[poseRotationW][base + l] = tile.w[l];
+			}
+		}
+
+		// the loops below only select and never branch on their data, and the sign of a dot product is copied rather than compared, so they compile to packed instructions
+		template <bool Masked>
+		void poseLerp(float* result, const float* source, size_t count, float weight, const float* mask)
+		{
+			for (size_t b = 0; b < count; b++)
+			{
+				result[b] += (source[b] - result[b]) * (Masked ? weight * mask[b] : weight);
+			}
+		}
+
+		template <bool Masked>
+		void poseAdd(float* result, const float* source, size_t count, float weight, const float* mask)
+		{
+			for (size_t b = 0; b < count; b++)
+			{
+				result[b] += source[b] * (Masked ? weight * mask[b] : weight);
+			}
+		}
+
+		template <bool Masked>
+		void poseMultiply(float* result, const float* source, size_t count, float weight, const float* mask)
+		{
+			for (size_t b = 0; b < count; b++)
+			{
+				result[b] *= 1.0f + (source[b] - 1.0f) * (Masked ? weight * mask[b] : weight);
+			}
+		}
+
+		template <bool Masked, bool Correct>
+		void poseOverride(poseChannelsView result, poseConstChannelsView source, size_t count, float weight, const float* mask)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				poseLerp<Masked>(result.c[poseTranslationX + i], source.c[poseTranslationX + i], count, weight, mask);
+				poseLerp<Masked>(result.c[poseScaleX + i], source.c[poseScaleX + i], count, weight, mask);
+			}
+
+			for (size_t base = 0; base < count; base += poseLanes)
+			{
+				size_t lanes = std::min(poseLanes, count - base);
+				poseTile current;
+				poseTile target;
+
+				poseLoad<Masked>(result.c, base, lanes, weight, mask, current);
+				poseLoad<false>(source.c, base, lanes, 0.0f, nullptr, target);
+
+				for (size_t l = 0; l < poseLanes; l++)
+				{
+					float t = current.t[l];
+					float d = current.x[l] * target.x[l] + current.y[l] * target.y[l] + current.z[l] * target.z[l] + current.w[l] * target.w[l];
+					float u = Correct ? poseCorrect(t, std::fabs(d)) : t;
+					float a = 1.0f - u;
+					float c = std::copysign(u, d);
+
+					float x = current.x[l] * a + target.x[l] * c;
+					float y = current.y[l] * a + target.y[l] * c;
+					float z = current.z[l] * a + target.z[l] * c;
+					float w = current.w[l] * a + target.w[l] * c;
+					float inverse = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+					current.x[l] = x * inverse;
+					current.y[l] = y * inverse;
+					current.z[l] = z * inverse;
+					current.w[l] = w * inverse;
+				}
+
+				poseStore(result.c, base, lanes, current);
+			}
+		}
+
+		// the difference is interpolated from no rotation by the weight, and then applied before the rotation of the bone
+		template <bool Masked, bool Correct>
+		void poseAdditive(poseChannelsView result, poseConstChannelsView source, size_t count, float weight, const float* mask)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				poseAdd<Masked>(result.c[poseTranslationX + i], source.c[poseTranslationX + i], count, weight, mask);
+				poseMultiply<Masked>(result.c[poseScaleX + i], source.c[poseScaleX + i], count, weight, mask);
+			}
+
+			for (size_t base = 0; base < count; base += poseLanes)
+			{
+				size_t lanes = std::min(poseLanes, count - base);
+				poseTile current;
+				poseTile delta;
+
+				poseLoad<Masked>(result.c, base, lanes, weight, mask, current);
+				poseLoad<false>(source.c, base, lanes, 0.0f, nullptr, delta);
+
+				for (size_t l = 0; l < poseLanes; l++)
+				{
+					float t = current.t[l];
+					float u = Correct ? poseCorrect(t, std::fabs(delta.w[l])) : t;
+					float c = std::copysign(u, delta.w[l]);
+
+					float dx = delta.x[l] * c;
+					float dy = delta.y[l] * c;
+					float dz = delta.z[l] * c;
+					float dw = 1.0f - u + delta.w[l] * c;
+					float inverse = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+
+					dx *= inverse;
+					dy *= inverse;
+					dz *= inverse;
+					dw *= inverse;
+
+					float x = current.x[l];
+					float y = current.y[l];
+					float z = current.z[l];
+					float w = current.w[l];
+
+					current.x[l] = w * dx + x * dw + y * dz - z * dy;
+					current.y[l] = w * dy - x * dz + y * dw + z * dx;
+					current.z[l] = w * dz + x * dy - y * dx + z * dw;
+					current.w[l] = w * dw - x * dx - y * dy - z * dz;
+				}
+
+				poseStore(result.c, base, lanes, current);
+			}
+		}
+
+		template <bool Masked, bool Correct>
+		void poseApply(const poselayer& layer, poseChannelsView result, poseConstChannelsView source, size_t count)
+		{
+			if (layer.mode == PoseBlend::Additive)
+			{
+				poseAdditive<Masked, Correct>(result, source, count, layer.weight, layer.mask.data());
+			}
+			else
+			{
+				poseOverride<Masked, Correct>(result, source, count, layer.weight, layer.mask.data());
+			}
+		}
+	}
+
+	pose::pose() : size_(0) { }
+
+	pose::pose(size_t bones) : size_(0)
+	{
+		resize(bones);
+	}
+
+	size_t pose::size() const
+	{
+		return size_;
+	}
+
+	void pose::resize(size_t bones)
+	{
+		std::vector<float> channels(bones * poseChannels);
+		size_t kept = std::min(bones, size_);
+
+		for (size_t i = 0; i < poseChannels; i++)
+		{
+			float initial = i == poseRotationW || i >= poseScaleX ? 1.0f : 0.0f;
+			float* destination = channels.data() + i * bones;
+
+			std::copy(channel(i), channel(i) + kept, destination);
+			std::fill(destination + kept, destination + bones, initial);
+		}
+
+		channels_ = std::move(channels);
+		size_ = bones;
+	}
+
+	void pose::reset()
+	{
+		for (size_t i = 0; i < poseChannels; i++)
+		{
+			std::fill(channel(i), channel(i) + size_, i == poseRotationW || i >= poseScaleX ? 1.0f : 0.0f);
+		}
+	}
+
+	vec3 pose::translation(size_t bone) const
+	{
+		validate(bone);
+		return vec3(channel(poseTranslationX)[bone], channel(poseTranslationX + 1)[bone], channel(poseTranslationX + 2)[bone]);
+	}
+
+	void pose::translation(size_t bone, vec3 value)
+	{
+		validate(bone);
+		channel(poseTranslationX)[bone] = value.x;
+		channel(poseTranslationX + 1)[bone] = value.y;
+		channel(poseTranslationX + 2)[bone] = value.z;
+	}
+
+	quat pose::rotation(size_t bone) const
+	{
+		validate(bone);
+		return quat(channel(poseRotationX)[bone], channel(poseRotationX + 1)[bone], channel(poseRotationX + 2)[bone], channel(poseRotationW)[bone]);
+	}
+
+	void pose::rotation(size_t bone, quat value)
+	{
+		validate(bone);
+		channel(poseRotationX)[bone] = value.x;
+		channel(poseRotationX + 1)[bone] = value.y;
+		channel(poseRotationX + 2)[bone] = value.z;
+		channel(poseRotationW)[bone] = value.w;
+	}
+
+	vec3 pose::scale(size_t bone) const
+	{
+		validate(bone);
+		return vec3(channel(poseScaleX)[bone], channel(poseScaleX + 1)[bone], channel(poseScaleX + 2)[bone]);
+	}
+
+	void pose::scale(size_t bone, vec3 value)
+	{
+		validate(bone);
+		channel(poseScaleX)[bone] = value.x;
+		channel(poseScaleX + 1)[bone] = value.y;
+		channel(poseScaleX + 2)[bone] = value.z;
+	}
+
+	void pose::blend(std::span<const poselayer> layers, bool correct)
+	{
+		blend(layers, layers.size(), std::span<pose>(this, 1), correct);
+	}
+
+	void pose::blend(std::span<const poselayer> layers, size_t layerCount, std::span<pose> poses, bool correct)
+	{
+		// the layers are fewer than layerCount for each pose, written as a division so the product cannot overflow
+		if (layerCount > 0 && layers.size() / layerCount < poses.size())
+		{
+			throw std::invalid_argument("The layers (" + std::to_string(layers.size()) + ") are fewer than required (" + std::to_string(layerCount * poses.size()) + ").");
+		}
+
+		for (size_t p = 0; p < poses.size(); p++)
+		{
+			for (size_t l = 0; l < layerCount; l++)
+			{
+				const poselayer& layer = layers[p * layerCount + l];
+
+				if (layer.source->size_ < poses[p].size_)
+				{
+					throw std::invalid_argument("The bones of a layer (" + std::to_string(layer.source->size_) + ") are fewer than required (" + std::to_string(poses[p].size_) + ").");
+				}
+
+				if (!layer.mask.empty() && layer.mask.size() < poses[p].size_)
+				{
+					throw std::invalid_argument("The bones of a mask (" + std::to_string(layer.mask.size()) + ") are fewer than required (" + std::to_string(poses[p].size_) + ").");
+				}
+			}
+		}
+
+		parallelFor(poses.size(), poseGrain, [&](size_t begin, size_t end)
+		{
+			for (size_t p = begin; p < end; p++)
+			{
+				pose& target = poses[p];
+				poseChannelsView result;
+
+				for (size_t i = 0; i < poseChannels; i++)
+				{
+					result.c[i] = target.channel(i);
+				}
+
+				for (size_t l = 0; l < layerCount; l++)
+				{
+					const poselayer& layer = layers[p * layerCount + l];
+					poseConstChannelsView source;
+
+					for (size_t i = 0; i < poseChannels; i++)
+					{
+						source.c[i] = layer.source->channel(i);
+					}
+
+					bool masked = !layer.mask.empty();
+
+					if (masked && correct)
+					{
+						poseApply<true, true>(layer, result, source, target.size_);
+					}
+					else if (masked)
+					{
+						poseApply<true, false>(layer, result, source, target.size_);
+					}
+					else if (correct)
+					{
+						poseApply<false, true>(layer, result, source, target.size_);
+					}
+					else
+					{
+						poseApply<false, false>(layer, result, source, target.size_);
+					}
+				}
+			}
+		});
+	}
+
+	pose pose::difference(const pose& reference, const pose& value)
+	{
+		if (value.size_ < reference.size_)
+		{
+			throw std::invalid_argument("The bones of the pose (" + std::to_string(value.size_) + ") are fewer than required (" + std::to_string(reference.size_) + ").");
+		}
+
+		pose result(reference.size_);
+
+		for (size_t b = 0; b < reference.size_; b++)
+		{
+			for (size_t i = 0; i < 3; i++)
+			{
+				float scale = reference.channel(poseScaleX + i)[b];
+
+				result.channel(poseTranslationX + i)[b] = value.channel(poseTranslationX + i)[b] - reference.channel(poseTranslationX + i)[b];
+				result.channel(poseScaleX + i)[b] = scale != 0.0f ? value.channel(poseScaleX + i)[b] / scale : 1.0f;
+			}
+
+			// the conjugate of the reference rotation followed by the rotation, so the reference rotation followed by the difference is the rotation
+			float x = -reference.channel(poseRotationX)[b];
+			float y = -reference.channel(poseRotationX + 1)[b];
+			float z = -reference.channel(poseRotationX + 2)[b];
+			float w = reference.channel(poseRotationW)[b];
+			float vx = value.channel(poseRotationX)[b];
+			float vy = value.channel(poseRotationX + 1)[b];
+			float vz = value.channel(poseRotationX + 2)[b];
+			float vw = value.channel(poseRotationW)[b];
+
+			result.channel(poseRotationX)[b] = w * vx + x * vw + y * vz - z * vy;
+			result.channel(poseRotationX + 1)[b] = w * vy - x * vz + y * vw + z * vx;
+			result.channel(poseRotationX + 2)[b] = w * vz + x * vy - y * vx + z * vw;
+			result.channel(poseRotationW)[b] = w * vw - x * vx - y * vy - z * vz;
+		}
+
+		return result;
+	}
+
+	void pose::validate(size_t bone) const
+	{
+		if (bone >= size_)
+		{
+			throw std::invalid_argument("The bone (" + std::to_string(bone) + ") does not belong to the pose.");
+		}
+	}
+
+	float* pose::channel(size_t index)
+	{
+		return channels_.data() + index * size_;
+	}
+
+	const float* pose::channel(size_t index) const
+	{
+		return channels_.data() + index * size_;
+	}
+}
\ No newline at end of file
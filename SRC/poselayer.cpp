@@ -0,0 +1,6 @@
+#include "../INC/Aurora/Mathematics/poselayer.h"
+
+namespace Aurora::Mathematics
+{
+	poselayer::poselayer(const pose& source, float weight, PoseBlend mode, std::span<const float> mask) : source(&source), weight(weight), mode(mode), mask(mask) { }
+}
\ No newline at end of file
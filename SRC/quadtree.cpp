@@ -0,0 +1,596 @@
+#include "../INC/Aurora/Mathematics/quadtree.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb2.h"
+#include "../INC/Aurora/Mathematics/iaabb2.h"
+#include "../INC/Aurora/Mathematics/irect.h"
+#include "../INC/Aurora/Mathematics/rect.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// marks a missing child, and a free entry
+		constexpr uint32_t quadtreeNone = 0xFFFFFFFF;
+
+		// the deepest supported tree, which bounds the size of the traversal stacks
+		constexpr int quadtreeMaxDepth = 20;
+
+		// a depth first traversal holds at most the three unvisited siblings of each node on the path, plus the four children of the last one
+		constexpr size_t quadtreeStackSize = 3 * quadtreeMaxDepth + 4;
+
+		inline float quadtreeMax(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// the comparisons are evaluated for both axes and then combined so they compile to packed comparisons
+		inline bool quadtreeOverlaps(const float* min, const float* max, const float* queryMin, const float* queryMax)
+		{
+			int mask0 = min[0] < queryMax[0] ? -1 : 0;
+			int mask1 = min[1] < queryMax[1] ? -1 : 0;
+			int mask2 = queryMin[0] < max[0] ? -1 : 0;
+			int mask3 = queryMin[1] < max[1] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3) != 0;
+		}
+
+		inline bool quadtreeContains(const float* min, const float* max, const float* point)
+		{
+			int mask0 = min[0] <= point[0] ? -1 : 0;
+			int mask1 = min[1] <= point[1] ? -1 : 0;
+			int mask2 = point[0] <= max[0] ? -1 : 0;
+			int mask3 = point[1] <= max[1] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3) != 0;
+		}
+
+		// the squared distance from a point to a rectangle, infinite for an empty rectangle
+		inline float quadtreeDistanceSquared(const float* min, const float* max, const float* point)
+		{
+			float x = quadtreeMax(quadtreeMax(min[0] - point[0], point[0] - max[0]), 0.0f);
+			float y = quadtreeMax(quadtreeMax(min[1] - point[1], point[1] - max[1]), 0.0f);
+
+			return x * x + y * y;
+		}
+	}
+
+	quadtree::quadtree() : quadtree(aabb2(vec2(-1.0f, -1.0f), vec2(1.0f, 1.0f))) { }
+
+	quadtree::quadtree(rect region, int maxDepth) : quadtree(aabb2(region), maxDepth) { }
+
+	quadtree::quadtree(const aabb2& region, int maxDepth) : maxDepth_(maxDepth), size_(0)
+	{
+		if (region.empty())
+		{
+			throw std::invalid_argument("The region must not be empty.");
+		}
+
+		if (maxDepth < 0 || maxDepth > quadtreeMaxDepth)
+		{
+			throw std::invalid_argument("The maximum depth (" + std::to_string(maxDepth) + ") must be between 0 and " + std::to_string(quadtreeMaxDepth) + ".");
+		}
+
+		const float* boxMin = region.minLanes();
+		const float* boxMax = region.maxLanes();
+
+		half_ = 0.0f;
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			center_[axis] = (boxMin[axis] + boxMax[axis]) * 0.5f;
+			half_ = quadtreeMax(half_, (boxMax[axis] - boxMin[axis]) * 0.5f);
+		}
+
+		clear();
+	}
+
+	size_t quadtree::insert(rect value)
+	{
+		return insert(aabb2(value));
+	}
+
+	size_t quadtree::insert(irect value)
+	{
+		return insert(aabb2(iaabb2(value)));
+	}
+
+	size_t quadtree::insert(const aabb2& value)
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		uint32_t id;
+
+		if (freeEntries_.empty())
+		{
+			id = (uint32_t)entries_.size();
+			entries_.push_back({ quadtreeNone, 0 });
+		}
+		else
+		{
+			id = freeEntries_.back();
+			freeEntries_.pop_back();
+		}
+
+		attach(id, place(boxMin, boxMax), boxMin, boxMax);
+		size_++;
+
+		return id;
+	}
+
+	void quadtree::move(size_t id, rect value)
+	{
+		move(id, aabb2(value));
+	}
+
+	void quadtree::move(size_t id, irect value)
+	{
+		move(id, aabb2(iaabb2(value)));
+	}
+
+	void quadtree::move(size_t id, const aabb2& value)
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		entry current = find(id);
+
+		// most moves are small enough for the rectangle to stay in its node
+		if (fits(current.node, boxMin, boxMax))
+		{
+			item& stored = nodes_[current.node].items[current.slot];
+
+			for (int axis = 0; axis < 2; axis++)
+			{
+				stored.min[axis] = boxMin[axis];
+				stored.max[axis] = boxMax[axis];
+			}
+
+			return;
+		}
+
+		// the rectangle is attached to its new node before it is detached from the old one, so the nodes both paths share are not released and allocated again
+		attach((uint32_t)id, place(boxMin, boxMax), boxMin, boxMax);
+		detach(current);
+	}
+
+	void quadtree::remove(size_t id)
+	{
+		detach(find(id));
+
+		entries_[id] = { quadtreeNone, 0 };
+		freeEntries_.push_back((uint32_t)id);
+		size_--;
+	}
+
+	void quadtree::clear()
+	{
+		if (nodes_.empty())
+		{
+			nodes_.emplace_back();
+		}
+
+		// every node but the root goes back to the pool, lowest first so the nodes reused first are the ones nearest the root in memory
+		freeNodes_.clear();
+
+		for (size_t i = nodes_.size() - 1; i > 0; i--)
+		{
+			nodes_[i].items.clear();
+			nodes_[i].parent = quadtreeNone;
+			freeNodes_.push_back((uint32_t)i);
+		}
+
+		entries_.clear();
+		freeEntries_.clear();
+		size_ = 0;
+
+		node& root = nodes_[0];
+
+		root.center[0] = center_[0];
+		root.center[1] = center_[1];
+		root.half = half_;
+		root.depth = 0;
+		root.parent = quadtreeNone;
+		root.childCount = 0;
+		root.items.clear();
+
+		for (int i = 0; i < 4; i++)
+		{
+			root.children[i] = quadtreeNone;
+		}
+	}
+
+	bool quadtree::contains(size_t id) const
+	{
+		return id < entries_.size() && entries_[id].node != quadtreeNone;
+	}
+
+	aabb2 quadtree::box(size_t id) const
+	{
+		const entry& current = find(id);
+		const item& stored = nodes_[current.node].items[current.slot];
+
+		return aabb2(vec2(stored.min[0], stored.min[1]), vec2(stored.max[0], stored.max[1]));
+	}
+
+	aabb2 quadtree::region() const
+	{
+		return aabb2(vec2(center_[0] - half_, center_[1] - half_), vec2(center_[0] + half_, center_[1] + half_));
+	}
+
+	size_t quadtree::size() const
+	{
+		return size_;
+	}
+
+	size_t quadtree::nodeCount() const
+	{
+		return nodes_.size() - freeNodes_.size();
+	}
+
+	void quadtree::overlapping(const aabb2& value, std::vector<size_t>& results) const
+	{
+		overlapping(value, [&](size_t id)
+			{
+				results.push_back(id);
+				return true;
+			});
+	}
+
+	bool quadtree::overlapping(const aabb2& value, callback<bool(size_t id)> visit) const
+	{
+		const float* queryMin = value.minLanes();
+		const float* queryMax = value.maxLanes();
+
+		std::array<uint32_t, quadtreeStackSize> stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const node& current = nodes_[stack[--top]];
+
+			for (const item& stored : current.items)
+			{
+				if (quadtreeOverlaps(stored.min, stored.max, queryMin, queryMax) && !visit(stored.id))
+				{
+					return false;
+				}
+			}
+
+			// a child reaches half its size past each of its edges, so its loose square spans twice its size around its center
+			float reach = current.half;
+
+			for (int i = 0; i < 4; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == quadtreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float min[2] = { child.center[0] - reach, child.center[1] - reach };
+				float max[2] = { child.center[0] + reach, child.center[1] + reach };
+
+				if (quadtreeOverlaps(min, max, queryMin, queryMax))
+				{
+					stack[top++] = index;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void quadtree::containing(vec2 point, std::vector<size_t>& results) const
+	{
+		containing(point, [&](size_t id)
+			{
+				results.push_back(id);
+				return true;
+			});
+	}
+
+	bool quadtree::containing(vec2 point, callback<bool(size_t id)> visit) const
+	{
+		float position[2] = { point.x, point.y };
+
+		std::array<uint32_t, quadtreeStackSize> stack;
+		size_t top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const node& current = nodes_[stack[--top]];
+
+			for (const item& stored : current.items)
+			{
+				if (quadtreeContains(stored.min, stored.max, position) && !visit(stored.id))
+				{
+					return false;
+				}
+			}
+
+			float reach = current.half;
+
+			for (int i = 0; i < 4; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == quadtreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float min[2] = { child.center[0] - reach, child.center[1] - reach };
+				float max[2] = { child.center[0] + reach, child.center[1] + reach };
+
+				if (quadtreeContains(min, max, position))
+				{
+					stack[top++] = index;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool quadtree::nearest(vec2 point, size_t& id, float& distance, float maxDistance) const
+	{
+		float origin[2] = { point.x, point.y };
+		float best = maxDistance * maxDistance;
+		uint32_t found = quadtreeNone;
+
+		std::array<uint32_t, quadtreeStackSize> stack;
+		std::array<float, quadtreeStackSize> distances;
+		size_t top = 0;
+
+		stack[top] = 0;
+		distances[top++] = 0.0f;
+
+		while (top > 0)
+		{
+			top--;
+
+			if (distances[top] > best)
+			{
+				continue;
+			}
+
+			const node& current = nodes_[stack[top]];
+
+			for (const item& stored : current.items)
+			{
+				float squared = quadtreeDistanceSquared(stored.min, stored.max, origin);
+
+				// empty rectangles are infinitely far away, and are not found even without a maximum distance
+				if (squared <= best && squared < std::numeric_limits<float>::infinity())
+				{
+					best = squared;
+					found = stored.id;
+				}
+			}
+
+			// the children are pushed farthest first so the closest is searched first and narrows the search for the others
+			uint32_t order[4];
+			float orderDistances[4];
+			int count = 0;
+			float reach = current.half;
+
+			for (int i = 0; i < 4; i++)
+			{
+				uint32_t index = current.children[i];
+
+				if (index == quadtreeNone)
+				{
+					continue;
+				}
+
+				const node& child = nodes_[index];
+				float min[2] = { child.center[0] - reach, child.center[1] - reach };
+				float max[2] = { child.center[0] + reach, child.center[1] + reach };
+				float squared = quadtreeDistanceSquared(min, max, origin);
+
+				if (squared > best)
+				{
+					continue;
+				}
+
+				int j = count++;
+
+				while (j > 0 && orderDistances[j - 1] < squared)
+				{
+					order[j] = order[j - 1];
+					orderDistances[j] = orderDistances[j - 1];
+					j--;
+				}
+
+				order[j] = index;
+				orderDistances[j] = squared;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				stack[top] = order[i];
+				distances[top++] = orderDistances[i];
+			}
+		}
+
+		if (found == quadtreeNone)
+		{
+			return false;
+		}
+
+		id = found;
+		distance = std::sqrt(best);
+		return true;
+	}
+
+	bool quadtree::fits(uint32_t index, const float* min, const float* max) const
+	{
+		const node& current = nodes_[index];
+		bool inside = true;
+		float extent = 0.0f;
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			float center = (min[axis] + max[axis]) * 0.5f;
+
+			// written so that the NaN center of an empty rectangle is never inside
+			inside &= !(std::abs(center - current.center[axis]) > current.half) && center == center;
+			extent = quadtreeMax(extent, (max[axis] - min[axis]) * 0.5f);
+		}
+
+		// the root also holds the rectangles that do not fit anywhere else
+		if (index == 0)
+		{
+			return !inside || extent > current.half * 0.5f || maxDepth_ == 0;
+		}
+
+		// a rectangle belongs to the deepest node at least as large as it
+		return inside && extent <= current.half && (extent > current.half * 0.5f || current.depth == maxDepth_);
+	}
+
+	uint32_t quadtree::place(const float* min, const float* max)
+	{
+		float center[2];
+		float extent = 0.0f;
+		bool inside = true;
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			center[axis] = (min[axis] + max[axis]) * 0.5f;
+			extent = quadtreeMax(extent, (max[axis] - min[axis]) * 0.5f);
+			inside &= !(std::abs(center[axis] - center_[axis]) > half_) && center[axis] == center[axis];
+		}
+
+		// empty rectangles and rectangles centered outside the region stay in the root
+		if (!inside)
+		{
+			return 0;
+		}
+
+		uint32_t index = 0;
+		float half = half_;
+
+		for (int depth = 0; depth < maxDepth_ && extent <= half * 0.5f; depth++)
+		{
+			const node& current = nodes_[index];
+			int quadrant = (center[0] >= current.center[0] ? 1 : 0) | (center[1] >= current.center[1] ? 2 : 0);
+			uint32_t child = current.children[quadrant];
+
+			index = child == quadtreeNone ? allocate(index, quadrant) : child;
+			half *= 0.5f;
+		}
+
+		return index;
+	}
+
+	uint32_t quadtree::allocate(uint32_t parent, int quadrant)
+	{
+		uint32_t index;
+
+		if (freeNodes_.empty())
+		{
+			index = (uint32_t)nodes_.size();
+			nodes_.emplace_back();
+		}
+		else
+		{
+			index = freeNodes_.back();
+			freeNodes_.pop_back();
+		}
+
+		node& owner = nodes_[parent];
+		node& child = nodes_[index];
+		float quarter = owner.half * 0.5f;
+
+		child.center[0] = owner.center[0] + ((quadrant & 1) != 0 ? quarter : -quarter);
+		child.center[1] = owner.center[1] + ((quadrant & 2) != 0 ? quarter : -quarter);
+		child.half = quarter;
+		child.depth = owner.depth + 1;
+		child.parent = parent;
+		child.childCount = 0;
+
+		for (int i = 0; i < 4; i++)
+		{
+			child.children[i] = quadtreeNone;
+		}
+
+		owner.children[quadrant] = index;
+		owner.childCount++;
+		return index;
+	}
+
+	void quadtree::release(uint32_t index)
+	{
+		node& current = nodes_[index];
+		node& owner = nodes_[current.parent];
+
+		for (int i = 0; i < 4; i++)
+		{
+			if (owner.children[i] == index)
+			{
+				owner.children[i] = quadtreeNone;
+			}
+		}
+
+		owner.childCount--;
+
+		// the items keep their capacity, so a released node can be reused without allocating
+		current.items.clear();
+		current.parent = quadtreeNone;
+		freeNodes_.push_back(index);
+	}
+
+	void quadtree::attach(uint32_t id, uint32_t index, const float* min, const float* max)
+	{
+		std::vector<item>& items = nodes_[index].items;
+
+		entries_[id] = { index, (uint32_t)items.size() };
+		items.push_back({ { min[0], min[1] }, { max[0], max[1] }, id });
+	}
+
+	void quadtree::detach(entry current)
+	{
+		std::vector<item>& items = nodes_[current.node].items;
+
+		// the last item takes the place of the removed one
+		size_t last = items.size() - 1;
+
+		if (current.slot != last)
+		{
+			items[current.slot] = items[last];
+			entries_[items[current.slot].id].slot = current.slot;
+		}
+
+		items.pop_back();
+
+		// nodes left without rectangles or children are released, which usually stops at the node itself
+		uint32_t index = current.node;
+
+		while (index != 0 && nodes_[index].items.empty() && nodes_[index].childCount == 0)
+		{
+			uint32_t parent = nodes_[index].parent;
+
+			release(index);
+			index = parent;
+		}
+	}
+
+	const quadtree::entry& quadtree::find(size_t id) const
+	{
+		if (!contains(id))
+		{
+			throw std::invalid_argument("The id (" + std::to_string(id) + ") does not belong to a rectangle in the quadtree.");
+		}
+
+		return entries_[id];
+	}
+}
\ No newline at end of file
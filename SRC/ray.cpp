@@ -0,0 +1,486 @@
+#include "../INC/Aurora/Mathematics/ray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/plane.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of primitives or rays handed to a thread at a time
+		constexpr size_t rayGrain = 8192;
+
+		// number of primitives or rays tested together, the lane loops over a packet compile to two 4 wide or one 8 wide vector instruction
+		constexpr size_t rayLanes = 8;
+
+		// selects by value so the lane loops compile to packed minimum and maximum operations
+		inline float rayMin(float value1, float value2)
+		{
+			return value1 < value2 ? value1 : value2;
+		}
+
+		inline float rayMax(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// the tests below are branchless so the lane loops calling them vectorize, each returns the distance of the hit or -1 for a miss
+
+		inline float raySlab(float minX, float minY, float minZ, float maxX, float maxY, float maxZ, const float* origin, const float* inverse, float maxDistance)
+		{
+			float x0 = (minX - origin[0]) * inverse[0];
+			float x1 = (maxX - origin[0]) * inverse[0];
+			float y0 = (minY - origin[1]) * inverse[1];
+			float y1 = (maxY - origin[1]) * inverse[1];
+			float z0 = (minZ - origin[2]) * inverse[2];
+			float z1 = (maxZ - origin[2]) * inverse[2];
+
+			float near = rayMax(rayMax(rayMin(x0, x1), rayMin(y0, y1)), rayMax(rayMin(z0, z1), 0.0f));
+			float far = rayMin(rayMin(rayMax(x0, x1), rayMax(y0, y1)), rayMin(rayMax(z0, z1), maxDistance));
+
+			// ordering each pair of distances would turn an empty box inside out, so empty boxes are rejected separately
+			bool hit = (near <= far) & (minX <= maxX) & (minY <= maxY) & (minZ <= maxZ);
+			return hit ? near : -1.0f;
+		}
+
+		inline float raySphere(float centerX, float centerY, float centerZ, float radius, const float* origin, const float* direction, float inverseLength, float maxDistance)
+		{
+			float x = origin[0] - centerX;
+			float y = origin[1] - centerY;
+			float z = origin[2] - centerZ;
+
+			// with the direction d and the offset from the center o, solves |o + t d|^2 = r^2 for t, where the half b of the linear term is dot(o, d)
+			float b = x * direction[0] + y * direction[1] + z * direction[2];
+			float c = x * x + y * y + z * z - radius * radius;
+			float discriminant = b * b - c / inverseLength;
+			float root = std::sqrt(rayMax(discriminant, 0.0f));
+
+			float near = (-b - root) * inverseLength;
+			float far = (-b + root) * inverseLength;
+			near = rayMax(near, 0.0f);
+
+			bool hit = (discriminant >= 0.0f) & (far >= 0.0f) & (near <= maxDistance);
+			return hit ? near : -1.0f;
+		}
+
+		inline float rayPlane(float normalX, float normalY, float normalZ, float distance, const float* origin, const float* direction, float maxDistance)
+		{
+			float denominator = normalX * direction[0] + normalY * direction[1] + normalZ * direction[2];
+			float numerator = -(normalX * origin[0] + normalY * origin[1] + normalZ * origin[2] + distance);
+			float t = numerator / denominator;
+
+			// a ray parallel to the plane divides by zero, and the infinite or undefined result fails the range check
+			bool hit = (t >= 0.0f) & (t <= maxDistance);
+			return hit ? t : -1.0f;
+		}
+
+		inline float rayTriangle(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz, const float* origin, const float* direction, float maxDistance, float& u, float& v)
+		{
+			float e1x = bx - ax;
+			float e1y = by - ay;
+			float e1z = bz - az;
+			float e2x = cx - ax;
+			float e2y = cy - ay;
+			float e2z = cz - az;
+
+			float px = direction[1] * e2z - direction[2] * e2y;
+			float py = direction[2] * e2x - direction[0] * e2z;
+			float pz = direction[0] * e2y - direction[1] * e2x;
+			float inverseDeterminant = 1.0f / (e1x * px + e1y * py + e1z * pz);
+
+			float sx = origin[0] - ax;
+			float sy = origin[1] - ay;
+			float sz = origin[2] - az;
+			u = (sx * px + sy * py + sz * pz) * inverseDeterminant;
+
+			float qx = sy * e1z - sz * e1y;
+			float qy = sz * e1x - sx * e1z;
+			float qz = sx * e1y - sy * e1x;
+			v = (direction[0] * qx + direction[1] * qy + direction[2] * qz) * inverseDeterminant;
+
+			float t = (e2x * qx + e2y * qy + e2z * qz) * inverseDeterminant;
+
+			// a degenerate or parallel triangle has a zero determinant, and the infinite or undefined results fail every comparison
+			bool hit = (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t >= 0.0f) & (t <= maxDistance);
+			return hit ? t : -1.0f;
+		}
+
+		inline float rayInverse(float value)
+		{
+			float largest = value < 0.0f ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();
+			return value != 0.0f ? 1.0f / value : largest;
+		}
+
+		void rayCheck(size_t available, size_t required, const char* name)
+		{
+			if (available < required)
+			{
+				throw std::invalid_argument("The " + std::string(name) + " (" + std::to_string(available) + ") are fewer than required (" + std::to_string(required) + ").");
+			}
+		}
+	}
+
+	ray::ray() : ray(vec3::zero(), vec3::forward()) { }
+
+	ray::ray(vec3 origin, vec3 direction) : origin_(origin)
+	{
+		this->direction(direction);
+	}
+
+	ray ray::between(vec3 from, vec3 to)
+	{
+		return ray(from, to - from);
+	}
+
+	vec3 ray::origin() const
+	{
+		return origin_;
+	}
+
+	void ray::origin(vec3 value)
+	{
+		origin_ = value;
+	}
+
+	vec3 ray::direction() const
+	{
+		return direction_;
+	}
+
+	void ray::direction(vec3 value)
+	{
+		direction_ = value;
+		inverse_ = vec3(rayInverse(value.x), rayInverse(value.y), rayInverse(value.z));
+	}
+
+	vec3 ray::inverseDirection() const
+	{
+		return inverse_;
+	}
+
+	vec3 ray::at(float distance) const
+	{
+		return origin_ + direction_ * distance;
+	}
+
+	bool ray::approximately(const ray& value1, const ray& value2)
+	{
+		return vec3::approximately(value1.origin_, value2.origin_) && vec3::approximately(value1.direction_, value2.direction_);
+	}
+
+	bool ray::intersects(const aabb3& value, float& distance, float maxDistance) const
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		float origin[3] = { origin_.x, origin_.y, origin_.z };
+		float inverse[3] = { inverse_.x, inverse_.y, inverse_.z };
+		float result = raySlab(boxMin[0], boxMin[1], boxMin[2], boxMax[0], boxMax[1], boxMax[2], origin, inverse, maxDistance);
+
+		if (result < 0.0f)
+		{
+			return false;
+		}
+
+		distance = result;
+		return true;
+	}
+
+	bool ray::intersects(bounds value, float& distance, float maxDistance) const
+	{
+		return intersects(aabb3(value), distance, maxDistance);
+	}
+
+	bool ray::intersects(vec3 center, float radius, float& distance, float maxDistance) const
+	{
+		float origin[3] = { origin_.x, origin_.y, origin_.z };
+		float direction[3] = { direction_.x, direction_.y, direction_.z };
+		float result = raySphere(center.x, center.y, center.z, radius, origin, direction, 1.0f / direction_.lengthSquared(), maxDistance);
+
+		if (result < 0.0f)
+		{
+			return false;
+		}
+
+		distance = result;
+		return true;
+	}
+
+	bool ray::intersects(plane value, float& distance, float maxDistance) const
+	{
+		float origin[3] = { origin_.x, origin_.y, origin_.z };
+		float direction[3] = { direction_.x, direction_.y, direction_.z };
+		float result = rayPlane(value.normal.x, value.normal.y, value.normal.z, value.distance, origin, direction, maxDistance);
+
+		if (result < 0.0f)
+		{
+			return false;
+		}
+
+		distance = result;
+		return true;
+	}
+
+	bool ray::intersects(vec3 vertex1, vec3 vertex2, vec3 vertex3, float& distance, float maxDistance) const
+	{
+		vec2 barycentric;
+		return intersects(vertex1, vertex2, vertex3, distance, barycentric, maxDistance);
+	}
+
+	bool ray::intersects(vec3 vertex1, vec3 vertex2, vec3 vertex3, float& distance, vec2& barycentric, float maxDistance) const
+	{
+		float origin[3] = { origin_.x, origin_.y, origin_.z };
+		float direction[3] = { direction_.x, direction_.y, direction_.z };
+		float u;
+		float v;
+		float result = rayTriangle(vertex1.x, vertex1.y, vertex1.z, vertex2.x, vertex2.y, vertex2.z, vertex3.x, vertex3.y, vertex3.z, origin, direction, maxDistance, u, v);
+
+		if (result < 0.0f)
+		{
+			return false;
+		}
+
+		distance = result;
+		barycentric = vec2(u, v);
+		return true;
+	}
+
+	bool ray::operator==(const ray& other) const
+	{
+		return origin_ == other.origin_ && direction_ == other.direction_;
+	}
+
+	bool ray::operator!=(const ray& other) const
+	{
+		return !((*this) == other);
+	}
+
+	void intersect(const ray& value, std::span<const aabb3> boxes, std::span<float> distances, float maxDistance)
+	{
+		rayCheck(distances.size(), boxes.size(), "distances");
+
+		vec3 start = value.origin();
+		vec3 inverseDirection = value.inverseDirection();
+		float origin[3] = { start.x, start.y, start.z };
+		float inverse[3] = { inverseDirection.x, inverseDirection.y, inverseDirection.z };
+
+		parallelFor(boxes.size(), rayGrain, [&](size_t begin, size_t end)
+			{
+				// the boxes are transposed into one array per corner component, unused lanes of the last packet repeat the last box
+				float min[3][rayLanes];
+				float max[3][rayLanes];
+				float result[rayLanes];
+
+				for (size_t start = begin; start < end; start += rayLanes)
+				{
+					size_t n = std::min(rayLanes, end - start);
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						const aabb3& box = boxes[std::min(start + i, end - 1)];
+						const float* boxMin = box.minLanes();
+						const float* boxMax = box.maxLanes();
+
+						for (int axis = 0; axis < 3; axis++)
+						{
+							min[axis][i] = boxMin[axis];
+							max[axis][i] = boxMax[axis];
+						}
+					}
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						result[i] = raySlab(min[0][i], min[1][i], min[2][i], max[0][i], max[1][i], max[2][i], origin, inverse, maxDistance);
+					}
+
+					std::copy(result, result + n, distances.begin() + start);
+				}
+			});
+	}
+
+	void intersect(std::span<const ray> rays, const aabb3& box, std::span<float> distances, float maxDistance)
+	{
+		rayCheck(distances.size(), rays.size(), "distances");
+
+		const float* cornersMin = box.minLanes();
+		const float* cornersMax = box.maxLanes();
+
+		parallelFor(rays.size(), rayGrain, [&](size_t begin, size_t end)
+			{
+				float origin[3][rayLanes];
+				float inverse[3][rayLanes];
+				float result[rayLanes];
+
+				for (size_t start = begin; start < end; start += rayLanes)
+				{
+					size_t n = std::min(rayLanes, end - start);
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						const ray& current = rays[std::min(start + i, end - 1)];
+						vec3 position = current.origin();
+						vec3 inverseDirection = current.inverseDirection();
+
+						origin[0][i] = position.x;
+						origin[1][i] = position.y;
+						origin[2][i] = position.z;
+						inverse[0][i] = inverseDirection.x;
+						inverse[1][i] = inverseDirection.y;
+						inverse[2][i] = inverseDirection.z;
+					}
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						float laneOrigin[3] = { origin[0][i], origin[1][i], origin[2][i] };
+						float laneInverse[3] = { inverse[0][i], inverse[1][i], inverse[2][i] };
+
+						result[i] = raySlab(cornersMin[0], cornersMin[1], cornersMin[2], cornersMax[0], cornersMax[1], cornersMax[2], laneOrigin, laneInverse, maxDistance);
+					}
+
+					std::copy(result, result + n, distances.begin() + start);
+				}
+			});
+	}
+
+	void intersect(const ray& value, std::span<const vec3> centers, std::span<const float> radii, std::span<float> distances, float maxDistance)
+	{
+		rayCheck(radii.size(), centers.size(), "radii");
+		rayCheck(distances.size(), centers.size(), "distances");
+
+		vec3 start = value.origin();
+		vec3 heading = value.direction();
+		float origin[3] = { start.x, start.y, start.z };
+		float direction[3] = { heading.x, heading.y, heading.z };
+		float inverseLength = 1.0f / heading.lengthSquared();
+
+		parallelFor(centers.size(), rayGrain, [&](size_t begin, size_t end)
+			{
+				// the centers are transposed into one array per component, unused lanes of the last packet repeat the last sphere
+				float center[3][rayLanes];
+				float radius[rayLanes];
+				float result[rayLanes];
+
+				for (size_t start = begin; start < end; start += rayLanes)
+				{
+					size_t n = std::min(rayLanes, end - start);
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						size_t j = std::min(start + i, end - 1);
+
+						center[0][i] = centers[j].x;
+						center[1][i] = centers[j].y;
+						center[2][i] = centers[j].z;
+						radius[i] = radii[j];
+					}
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						result[i] = raySphere(center[0][i], center[1][i], center[2][i], radius[i], origin, direction, inverseLength, maxDistance);
+					}
+
+					std::copy(result, result + n, distances.begin() + start);
+				}
+			});
+	}
+
+	void intersect(const ray& value, std::span<const plane> planes, std::span<float> distances, float maxDistance)
+	{
+		rayCheck(distances.size(), planes.size(), "distances");
+
+		vec3 start = value.origin();
+		vec3 heading = value.direction();
+		float origin[3] = { start.x, start.y, start.z };
+		float direction[3] = { heading.x, heading.y, heading.z };
+
+		parallelFor(planes.size(), rayGrain, [&](size_t begin, size_t end)
+			{
+				// the planes are transposed into one array per component, unused lanes of the last packet repeat the last plane
+				float coefficients[4][rayLanes];
+				float result[rayLanes];
+
+				for (size_t start = begin; start < end; start += rayLanes)
+				{
+					size_t n = std::min(rayLanes, end - start);
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						const plane& current = planes[std::min(start + i, end - 1)];
+
+						coefficients[0][i] = current.normal.x;
+						coefficients[1][i] = current.normal.y;
+						coefficients[2][i] = current.normal.z;
+						coefficients[3][i] = current.distance;
+					}
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						result[i] = rayPlane(coefficients[0][i], coefficients[1][i], coefficients[2][i], coefficients[3][i], origin, direction, maxDistance);
+					}
+
+					std::copy(result, result + n, distances.begin() + start);
+				}
+			});
+	}
+
+	void intersect(const ray& value, std::span<const vec3> vertices, std::span<float> distances, float maxDistance)
+	{
+		if (vertices.size() % 3 != 0)
+		{
+			throw std::invalid_argument("The vertices (" + std::to_string(vertices.size()) + ") are not a multiple of 3.");
+		}
+
+		size_t count = vertices.size() / 3;
+		rayCheck(distances.size(), count, "distances");
+
+		vec3 start = value.origin();
+		vec3 heading = value.direction();
+		float origin[3] = { start.x, start.y, start.z };
+		float direction[3] = { heading.x, heading.y, heading.z };
+
+		parallelFor(count, rayGrain, [&](size_t begin, size_t end)
+			{
+				// the triangles are transposed into one array per vertex component, unused lanes of the last packet repeat the last triangle
+				float corners[9][rayLanes];
+				float result[rayLanes];
+
+				for (size_t start = begin; start < end; start += rayLanes)
+				{
+					size_t n = std::min(rayLanes, end - start);
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						const vec3* triangle = vertices.data() + 3 * std::min(start + i, end - 1);
+
+						for (int j = 0; j < 3; j++)
+						{
+							corners[3 * j][i] = triangle[j].x;
+							corners[3 * j + 1][i] = triangle[j].y;
+							corners[3 * j + 2][i] = triangle[j].z;
+						}
+					}
+
+					for (size_t i = 0; i < rayLanes; i++)
+					{
+						float u;
+						float v;
+
+						result[i] = rayTriangle(
+							corners[0][i], corners[1][i], corners[2][i],
+							corners[3][i], corners[4][i], corners[5][i],
+							corners[6][i], corners[7][i], corners[8][i],
+							origin, direction, maxDistance, u, v);
+					}
+
+					std::copy(result, result + n, distances.begin() + start);
+				}
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include "../INC/Aurora/Mathematics/rtree.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb2.h"
+#include "../INC/Aurora/Mathematics/iaabb2.h"
+#include "../INC/Aurora/Mathematics/irect.h"
+#include "../INC/Aurora/Mathematics/ivec2.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/rect.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of rectangles handed to a thread at a time
+		constexpr size_t rtreeGrain = 16384;
+
+		// number of children of every node but the last of each level
+		constexpr size_t rtreeNodeSize = 16;
+
+		// 16 to the power of 8 covers every index that fits in 32 bits, plus one level for the rectangles themselves
+		constexpr size_t rtreeMaxLevels = 9;
+
+		// a depth first traversal holds at most the unvisited siblings of each node on the path
+		constexpr size_t rtreeStackSize = rtreeNodeSize * rtreeMaxLevels;
+
+		// the Hilbert curve is walked on a grid of 65536 by 65536 cells over the centers of the rectangles
+		constexpr float rtreeGridSize = 65535.0f;
+
+		inline float rtreeMin(float value1, float value2)
+		{
+			return value1 < value2 ? value1 : value2;
+		}
+
+		inline float rtreeMax(float value1, float value2)
+		{
+			return value1 > value2 ? value1 : value2;
+		}
+
+		// the comparisons are evaluated for both axes and then combined so they compile to packed comparisons
+		inline bool rtreeOverlaps(const float* min, const float* max, const float* queryMin, const float* queryMax)
+		{
+			int mask0 = min[0] < queryMax[0] ? -1 : 0;
+			int mask1 = min[1] < queryMax[1] ? -1 : 0;
+			int mask2 = queryMin[0] < max[0] ? -1 : 0;
+			int mask3 = queryMin[1] < max[1] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3) != 0;
+		}
+
+		inline bool rtreeContains(const float* min, const float* max, const float* point)
+		{
+			int mask0 = min[0] <= point[0] ? -1 : 0;
+			int mask1 = min[1] <= point[1] ? -1 : 0;
+			int mask2 = point[0] <= max[0] ? -1 : 0;
+			int mask3 = point[1] <= max[1] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3) != 0;
+		}
+
+		// the squared distance from a point to a rectangle, infinite for an empty rectangle
+		inline float rtreeDistanceSquared(const float* min, const float* max, const float* point)
+		{
+			float x = rtreeMax(rtreeMax(min[0] - point[0], point[0] - max[0]), 0.0f);
+			float y = rtreeMax(rtreeMax(min[1] - point[1], point[1] - max[1]), 0.0f);
+
+			return x * x + y * y;
+		}
+	}
+
+	rtree::rtree() { }
+
+	rtree::rtree(std::span<const rect> rectangles)
+	{
+		build(rectangles);
+	}
+
+	rtree::rtree(std::span<const irect> rectangles)
+	{
+		build(rectangles);
+	}
+
+	rtree::rtree(std::span<const aabb2> rectangles)
+	{
+		build(rectangles);
+	}
+
+	void rtree::build(std::span<const rect> rectangles)
+	{
+		std::vector<aabb2> boxes(rectangles.size());
+
+		parallelFor(rectangles.size(), rtreeGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					boxes[i] = aabb2(rectangles[i]);
+				}
+			});
+
+		build(boxes);
+	}
+
+	void rtree::build(std::span<const irect> rectangles)
+	{
+		std::vector<aabb2> boxes(rectangles.size());
+
+		parallelFor(rectangles.size(), rtreeGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					boxes[i] = aabb2(iaabb2(rectangles[i]));
+				}
+			});
+
+		build(boxes);
+	}
+
+	void rtree::build(std::span<const aabb2> rectangles)
+	{
+		if (rectangles.size() > std::numeric_limits<uint32_t>::max())
+		{
+			throw std::invalid_argument("The rectangles (" + std::to_string(rectangles.size()) + ") are more than the maximum (" + std::to_string(std::numeric_limits<uint32_t>::max()) + ").");
+		}
+
+		size_t count = rectangles.size();
+
+		boxes_.clear();
+		indices_.clear();
+		levels_.clear();
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		// the curve is laid over the bounds of the centers, empty rectangles have no center and are left out
+		float lower[2] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+		float upper[2] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const aabb2& value = rectangles[i];
+			const float* valueMin = value.minLanes();
+			const float* valueMax = value.maxLanes();
+
+			if (valueMin[0] <= valueMax[0] && valueMin[1] <= valueMax[1])
+			{
+				for (int axis = 0; axis < 2; axis++)
+				{
+					float center = (valueMin[axis] + valueMax[axis]) * 0.5f;
+
+					lower[axis] = rtreeMin(lower[axis], center);
+					upper[axis] = rtreeMax(upper[axis], center);
+				}
+			}
+		}
+
+		float scale[2];
+
+		for (int axis = 0; axis < 2; axis++)
+		{
+			float extent = upper[axis] - lower[axis];
+			scale[axis] = extent > 0.0f ? rtreeGridSize / extent : 0.0f;
+		}
+
+		// each key holds the distance along the curve above the index, so sorting the keys sorts by distance and keeps ties in input order
+		std::vector<uint64_t> keys(count);
+
+		parallelFor(count, rtreeGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const aabb2& value = rectangles[i];
+					const float* valueMin = value.minLanes();
+					const float* valueMax = value.maxLanes();
+					uint32_t cell[2] = { 0, 0 };
+
+					if (valueMin[0] <= valueMax[0] && valueMin[1] <= valueMax[1])
+					{
+						for (int axis = 0; axis < 2; axis++)
+						{
+							float center = (valueMin[axis] + valueMax[axis]) * 0.5f;
+							cell[axis] = (uint32_t)rtreeMin((center - lower[axis]) * scale[axis], rtreeGridSize);
+						}
+					}
+
+					keys[i] = ((uint64_t)ivec2::hilbert32(ivec2((int)cell[0], (int)cell[1])) << 32) | i;
+				}
+			});
+
+		std::sort(keys.begin(), keys.end());
+
+		// a full tree has one node for every 15 boxes below the root, so this reserves enough for every level
+		size_t capacity = count + count / (rtreeNodeSize - 1) + rtreeMaxLevels;
+
+		boxes_.resize(count);
+		indices_.resize(count);
+		boxes_.reserve(capacity);
+		indices_.reserve(capacity);
+
+		parallelFor(count, rtreeGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					uint32_t index = (uint32_t)keys[i];
+					const aabb2& value = rectangles[index];
+					const float* valueMin = value.minLanes();
+					const float* valueMax = value.maxLanes();
+
+					boxes_[i] = { { valueMin[0], valueMin[1] }, { valueMax[0], valueMax[1] } };
+					indices_[i] = index;
+				}
+			});
+
+		// every level groups consecutive boxes of the level below it, until a level holds a single node
+		size_t first = 0;
+		size_t last = count;
+
+		do
+		{
+			levels_.push_back(last);
+
+			for (size_t start = first; start < last; start += rtreeNodeSize)
+			{
+				size_t end = std::min(start + rtreeNodeSize, last);
+				entry parent = { { boxes_[start].min[0], boxes_[start].min[1] }, { boxes_[start].max[0], boxes_[start].max[1] } };
+
+				for (size_t i = start + 1; i < end; i++)
+				{
+					parent.min[0] = rtreeMin(parent.min[0], boxes_[i].min[0]);
+					parent.min[1] = rtreeMin(parent.min[1], boxes_[i].min[1]);
+					parent.max[0] = rtreeMax(parent.max[0], boxes_[i].max[0]);
+					parent.max[1] = rtreeMax(parent.max[1], boxes_[i].max[1]);
+				}
+
+				boxes_.push_back(parent);
+				indices_.push_back((uint32_t)start);
+			}
+
+			first = last;
+			last = boxes_.size();
+		} while (last - first > 1);
+
+		levels_.push_back(last);
+	}
+
+	size_t rtree::size() const
+	{
+		return levels_.empty() ? 0 : levels_[0];
+	}
+
+	size_t rtree::nodeCount() const
+	{
+		return boxes_.size() - size();
+	}
+
+	aabb2 rtree::box() const
+	{
+		if (boxes_.empty())
+		{
+			return aabb2();
+		}
+
+		const entry& root = boxes_.back();
+		return aabb2(vec2(root.min[0], root.min[1]), vec2(root.max[0], root.max[1]));
+	}
+
+	void rtree::overlapping(const aabb2& value, std::vector<size_t>& results) const
+	{
+		overlapping(value, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool rtree::overlapping(const aabb2& value, callback<bool(size_t index)> visit) const
+	{
+		if (boxes_.empty())
+		{
+			return true;
+		}
+
+		const float* queryMin = value.minLanes();
+		const float* queryMax = value.maxLanes();
+
+		// each entry of the stack is a node and its level, the rectangles are level 0
+		std::array<size_t, rtreeStackSize> stack;
+		std::array<size_t, rtreeStackSize> levels;
+		size_t top = 0;
+
+		if (rtreeOverlaps(boxes_.back().min, boxes_.back().max, queryMin, queryMax))
+		{
+			stack[top] = boxes_.size() - 1;
+			levels[top++] = levels_.size() - 1;
+		}
+
+		while (top > 0)
+		{
+			top--;
+
+			size_t level = levels[top] - 1;
+			size_t first = indices_[stack[top]];
+			size_t last = std::min(first + rtreeNodeSize, levels_[level]);
+
+			for (size_t i = first; i < last; i++)
+			{
+				if (!rtreeOverlaps(boxes_[i].min, boxes_[i].max, queryMin, queryMax))
+				{
+					continue;
+				}
+
+				if (level == 0)
+				{
+					if (!visit(indices_[i]))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					stack[top] = i;
+					levels[top++] = level;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void rtree::containing(vec2 point, std::vector<size_t>& results) const
+	{
+		containing(point, [&](size_t index)
+			{
+				results.push_back(index);
+				return true;
+			});
+	}
+
+	bool rtree::containing(vec2 point, callback<bool(size_t index)> visit) const
+	{
+		if (boxes_.empty())
+		{
+			return true;
+		}
+
+		float position[2] = { point.x, point.y };
+
+		std::array<size_t, rtreeStackSize> stack;
+		std::array<size_t, rtreeStackSize> levels;
+		size_t top = 0;
+
+		if (rtreeContains(boxes_.back().min, boxes_.back().max, position))
+		{
+			stack[top] = boxes_.size() - 1;
+			levels[top++] = levels_.size() - 1;
+		}
+
+		while (top > 0)
+		{
+			top--;
+
+			size_t level = levels[top] - 1;
+			size_t first = indices_[stack[top]];
+			size_t last = std::min(first + rtreeNodeSize, levels_[level]);
+
+			for (size_t i = first; i < last; i++)
+			{
+				if (!rtreeContains(boxes_[i].min, boxes_[i].max, position))
+				{
+					continue;
+				}
+
+				if (level == 0)
+				{
+					if (!visit(indices_[i]))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					stack[top] = i;
+					levels[top++] = level;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool rtree::nearest(vec2 point, size_t& index, float& distance, float maxDistance) const
+	{
+		if (boxes_.empty())
+		{
+			return false;
+		}
+
+		float position[2] = { point.x, point.y };
+		float best = maxDistance * maxDistance;
+		size_t found = boxes_.size();
+
+		std::array<size_t, rtreeStackSize> stack;
+		std::array<size_t, rtreeStackSize> levels;
+		std::array<float, rtreeStackSize> distances;
+		size_t top = 0;
+
+		stack[top] = boxes_.size() - 1;
+		levels[top] = levels_.size() - 1;
+		distances[top++] = rtreeDistanceSquared(boxes_.back().min, boxes_.back().max, position);
+
+		while (top > 0)
+		{
+			top--;
+
+			if (distances[top] > best)
+			{
+				continue;
+			}
+
+			size_t level = levels[top] - 1;
+			size_t first = indices_[stack[top]];
+			size_t last = std::min(first + rtreeNodeSize, levels_[level]);
+
+			if (level == 0)
+			{
+				for (size_t i = first; i < last; i++)
+				{
+					float squared = rtreeDistanceSquared(boxes_[i].min, boxes_[i].max, position);
+
+					// empty rectangles are infinitely far away, and are not found even without a maximum distance
+					if (squared <= best && squared < std::numeric_limits<float>::infinity())
+					{
+						best = squared;
+						found = indices_[i];
+					}
+				}
+
+				continue;
+			}
+
+			// the children are pushed farthest first so the closest is searched first and narrows the search for the others
+			size_t order[rtreeNodeSize];
+			float orderDistances[rtreeNodeSize];
+			size_t count = 0;
+
+			for (size_t i = first; i < last; i++)
+			{
+				float squared = rtreeDistanceSquared(boxes_[i].min, boxes_[i].max, position);
+
+				if (squared > best)
+				{
+					continue;
+				}
+
+				size_t j = count++;
+
+				while (j > 0 && orderDistances[j - 1] < squared)
+				{
+					order[j] = order[j - 1];
+					orderDistances[j] = orderDistances[j - 1];
+					j--;
+				}
+
+				order[j] = i;
+				orderDistances[j] = squared;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				stack[top] = order[i];
+				levels[top] = level;
+				distances[top++] = orderDistances[i];
+			}
+		}
+
+		if (found == boxes_.size())
+		{
+			return false;
+		}
+
+		index = found;
+		distance = std::sqrt(best);
+		return true;
+	}
+}
\ No newline at end of file
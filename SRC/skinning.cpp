@@ -0,0 +1,412 @@
+#include "../INC/Aurora/Mathematics/skinning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../INC/Aurora/Mathematics/dualquat.h"
+#include "../INC/Aurora/Mathematics/mat4.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of vertices skinned together, one per lane
+		constexpr size_t skinningLanes = 8;
+
+		// number of vertices skinned by a thread at a time, a multiple of the lanes
+		constexpr size_t skinningGrain = 4096;
+
+		// the most influences a vertex may have
+		constexpr size_t skinningMaxInfluences = 8;
+
+		// a stream of vectors stored as three planes, each a third of the span
+		struct skinningPlanes
+		{
+			const float* x;
+			const float* y;
+			const float* z;
+		};
+
+		struct skinningDestination
+		{
+			float* x;
+			float* y;
+			float* z;
+		};
+
+		// the vectors of a group of vertices, one per lane
+		struct skinningLane
+		{
+			float x[skinningLanes];
+			float y[skinningLanes];
+			float z[skinningLanes];
+		};
+
+		// every stream holds its planes of one float per vertex at its start, so they are split by the number of vertices rather than by their own size, which may be larger
+		inline skinningPlanes skinningSplit(std::span<const float> values, size_t count)
+		{
+			return { values.data(), values.data() + count, values.data() + count * 2 };
+		}
+
+		inline skinningDestination skinningSplit(std::span<float> values, size_t count)
+		{
+			return { values.data(), values.data() + count, values.data() + count * 2 };
+		}
+
+		// the lanes past the last vertex repeat the first, so every lane holds a finite vector and the loads need no condition
+		inline void skinningLoad(const skinningPlanes& source, size_t base, size_t count, skinningLane& lane)
+		{
+			for (size_t l = 0; l < skinningLanes; l++)
+			{
+				size_t i = base + (l < count ? l : 0);
+				lane.x[l] = source.x[i];
+				lane.y[l] = source.y[i];
+				lane.z[l] = source.z[i];
+			}
+		}
+
+		inline void skinningStore(const skinningDestination& destination, size_t base, size_t count, const skinningLane& lane)
+		{
+			for (size_t l = 0; l < count; l++)
+			{
+				destination.x[base + l] = lane.x[l];
+				destination.y[base + l] = lane.y[l];
+				destination.z[base + l] = lane.z[l];
+			}
+		}
+
+		// checks the arguments shared by every skinning function and returns the number of vertices
+		size_t skinningValidate(size_t bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals, std::span<float> skinnedNormals, std::span<const float> tangents, std::span<float> skinnedTangents)
+		{
+			if (influences < 1)
+			{
+				throw std::invalid_argument("The influences (" + std::to_string(influences) + ") are fewer than required (1).");
+			}
+
+			if (influences > skinningMaxInfluences)
+			{
+				throw std::invalid_argument("The influences (" + std::to_string(influences) + ") are more than the maximum (" + std::to_string(skinningMaxInfluences) + ").");
+			}
+
+			size_t count = positions.size() / 3;
+
+			if (joints.size() < count * influences)
+			{
+				throw std::invalid_argument("The joints (" + std::to_string(joints.size()) + ") are fewer than required (" + std::to_string(count * influences) + ").");
+			}
+
+			if (weights.size() < count * influences)
+			{
+				throw std::invalid_argument("The weights (" + std::to_string(weights.size()) + ") are fewer than required (" + std::to_string(count * influences) + ").");
+			}
+
+			if (skinnedPositions.size() < count * 3)
+			{
+				throw std::invalid_argument("The skinned positions (" + std::to_string(skinnedPositions.size()) + ") are fewer than required (" + std::to_string(count * 3) + ").");
+			}
+
+			if (!normals.empty() && normals.size() < count * 3)
+			{
+				throw std::invalid_argument("The normals (" + std::to_string(normals.size()) + ") are fewer than required (" + std::to_string(count * 3) + ").");
+			}
+
+			if (!normals.empty() && skinnedNormals.size() < count * 3)
+			{
+				throw std::invalid_argument("The skinned normals (" + std::to_string(skinnedNormals.size()) + ") are fewer than required (" + std::to_string(count * 3) + ").");
+			}
+
+			if (!tangents.empty() && tangents.size() < count * 3)
+			{
+				throw std::invalid_argument("The tangents (" + std::to_string(tangents.size()) + ") are fewer than required (" + std::to_string(count * 3) + ").");
+			}
+
+			if (!tangents.empty() && skinnedTangents.size() < count * 3)
+			{
+				throw std::invalid_argument("The skinned tangents (" + std::to_string(skinnedTangents.size()) + ") are fewer than required (" + std::to_string(count * 3) + ").");
+			}
+
+			// checked once up front so the threads never meet a joint outside the palette
+			uint16_t highest = 0;
+
+			for (size_t i = 0; i < count * influences; i++)
+			{
+				highest = std::max(highest, joints[i]);
+			}
+
+			if (count > 0 && highest >= bones)
+			{
+				throw std::invalid_argument("The joint (" + std::to_string(highest) + ") does not belong to a bone in the palette.");
+			}
+
+			return count;
+		}
+
+		// the number of floats of a bone in an affine palette, the first three columns of the four rows
+		constexpr size_t skinningAffine = 12;
+
+		// transforms the vectors of a group of vertices by the first three rows of their blended matrices, normalizing the results
+		inline void skinningDirections(const float (&m)[skinningAffine][skinningLanes], skinningLane& lane)
+		{
+			for (size_t l = 0; l < skinningLanes; l++)
+			{
+				float x = lane.x[l] * m[0][l] + lane.y[l] * m[3][l] + lane.z[l] * m[6][l];
+				float y = lane.x[l] * m[1][l] + lane.y[l] * m[4][l] + lane.z[l] * m[7][l];
+				float z = lane.x[l] * m[2][l] + lane.y[l] * m[5][l] + lane.z[l] * m[8][l];
+				float lengthSquared = x * x + y * y + z * z;
+				float inverse = 1.0f / std::sqrt(lengthSquared > 0.0f ? lengthSquared : 1.0f);
+
+				lane.x[l] = x * inverse;
+				lane.y[l] = y * inverse;
+				lane.z[l] = z * inverse;
+			}
+		}
+
+		// v + 2w(q x v) + 2q x (q x v), for the vector part q and scalar part w of a unit quaternion
+		inline void skinningRotate(float qx, float qy, float qz, float qw, float& x, float& y, float& z)
+		{
+			float cx = qy * z - qz * y;
+			float cy = qz * x - qx * z;
+			float cz = qx * y - qy * x;
+			float ccx = qy * cz - qz * cy;
+			float ccy = qz * cx - qx * cz;
+			float ccz = qx * cy - qy * cx;
+
+			x += 2.0f * (qw * cx + ccx);
+			y += 2.0f * (qw * cy + ccy);
+			z += 2.0f * (qw * cz + ccz);
+		}
+	}
+
+	void skin(std::span<const dualquat> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals, std::span<float> skinnedNormals, std::span<const float> tangents, std::span<float> skinnedTangents)
+	{
+		size_t count = skinningValidate(bones.size(), joints, weights, influences, positions, skinnedPositions, normals, skinnedNormals, tangents, skinnedTangents);
+
+		skinningPlanes positionSource = skinningSplit(positions, count);
+		skinningDestination positionDestination = skinningSplit(skinnedPositions, count);
+		skinningPlanes normalSource = skinningSplit(normals, count);
+		skinningDestination normalDestination = skinningSplit(skinnedNormals, count);
+		skinningPlanes tangentSource = skinningSplit(tangents, count);
+		skinningDestination tangentDestination = skinningSplit(skinnedTangents, count);
+
+		parallelFor(count, skinningGrain, [&](size_t begin, size_t end)
+		{
+			constexpr size_t L = skinningLanes;
+
+			for (size_t base = begin; base < end; base += L)
+			{
+				size_t lanes = std::min(L, end - base);
+				float rx[L], ry[L], rz[L], rw[L], dx[L], dy[L], dz[L], dw[L];
+
+				// the bones are gathered one lane at a time, since each vertex reads different bones
+				for (size_t l = 0; l < L; l++)
+				{
+					rx[l] = ry[l] = rz[l] = rw[l] = dx[l] = dy[l] = dz[l] = dw[l] = 0.0f;
+
+					if (l >= lanes)
+					{
+						continue;
+					}
+
+					const uint16_t* vertexJoints = joints.data() + (base + l) * influences;
+					const float* vertexWeights = weights.data() + (base + l) * influences;
+					const quat& pivot = bones[vertexJoints[0]].real;
+
+					for (size_t k = 0; k < influences; k++)
+					{
+						const dualquat& bone = bones[vertexJoints[k]];
+						float side = bone.real.x * pivot.x + bone.real.y * pivot.y + bone.real.z * pivot.z + bone.real.w * pivot.w;
+						float weight = side < 0.0f ? -vertexWeights[k] : vertexWeights[k];
+
+						rx[l] += bone.real.x * weight;
+						ry[l] += bone.real.y * weight;
+						rz[l] += bone.real.z * weight;
+						rw[l] += bone.real.w * weight;
+						dx[l] += bone.dual.x * weight;
+						dy[l] += bone.dual.y * weight;
+						dz[l] += bone.dual.z * weight;
+						dw[l] += bone.dual.w * weight;
+					}
+				}
+
+				// normalizing by the length of the real part, and finding the translation, twice the dual part times the conjugate of the real part
+				// the part of the dual part along the real part cancels out of the translation, so it does not need to be removed
+				float tx[L], ty[L], tz[L];
+
+				for (size_t l = 0; l < L; l++)
+				{
+					float lengthSquared = rx[l] * rx[l] + ry[l] * ry[l] + rz[l] * rz[l] + rw[l] * rw[l];
+					int valid = lengthSquared > 0.0f ? -1 : 0;
+					float inverse = 1.0f / std::sqrt(valid != 0 ? lengthSquared : 1.0f);
+
+					float x = rx[l] * inverse, y = ry[l] * inverse, z = rz[l] * inverse, w = rw[l] * inverse;
+					float ex = dx[l] * inverse, ey = dy[l] * inverse, ez = dz[l] * inverse, ew = dw[l] * inverse;
+
+					rx[l] = x;
+					ry[l] = y;
+					rz[l] = z;
+					rw[l] = valid != 0 ? w : 1.0f;
+					tx[l] = 2.0f * (w * ex - ew * x + y * ez - z * ey);
+					ty[l] = 2.0f * (w * ey - ew * y + z * ex - x * ez);
+					tz[l] = 2.0f * (w * ez - ew * z + x * ey - y * ex);
+				}
+
+				skinningLane lane;
+				skinningLoad(positionSource, base, lanes, lane);
+
+				for (size_t l = 0; l < L; l++)
+				{
+					skinningRotate(rx[l], ry[l], rz[l], rw[l], lane.x[l], lane.y[l], lane.z[l]);
+					lane.x[l] += tx[l];
+					lane.y[l] += ty[l];
+					lane.z[l] += tz[l];
+				}
+
+				skinningStore(positionDestination, base, lanes, lane);
+
+				if (!normals.empty())
+				{
+					skinningLoad(normalSource, base, lanes, lane);
+
+					for (size_t l = 0; l < L; l++)
+					{
+						skinningRotate(rx[l], ry[l], rz[l], rw[l], lane.x[l], lane.y[l], lane.z[l]);
+					}
+
+					skinningStore(normalDestination, base, lanes, lane);
+				}
+
+				if (!tangents.empty())
+				{
+					skinningLoad(tangentSource, base, lanes, lane);
+
+					for (size_t l = 0; l < L; l++)
+					{
+						skinningRotate(rx[l], ry[l], rz[l], rw[l], lane.x[l], lane.y[l], lane.z[l]);
+					}
+
+					skinningStore(tangentDestination, base, lanes, lane);
+				}
+			}
+		});
+	}
+
+	void skin(std::span<const mat4> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals, std::span<float> skinnedNormals, std::span<const float> tangents, std::span<float> skinnedTangents)
+	{
+		std::vector<float> palette(bones.size() * skinningAffine);
+
+		for (size_t i = 0; i < bones.size(); i++)
+		{
+			for (int r = 0; r < 4; r++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					palette[i * skinningAffine + r * 3 + c] = bones[i](r, c);
+				}
+			}
+		}
+
+		skin(palette, joints, weights, influences, positions, skinnedPositions, normals, skinnedNormals, tangents, skinnedTangents);
+	}
+
+	void skin(std::span<const float> bones, std::span<const uint16_t> joints, std::span<const float> weights, size_t influences, std::span<const float> positions, std::span<float> skinnedPositions, std::span<const float> normals, std::span<float> skinnedNormals, std::span<const float> tangents, std::span<float> skinnedTangents)
+	{
+		size_t count = skinningValidate(bones.size() / skinningAffine, joints, weights, influences, positions, skinnedPositions, normals, skinnedNormals, tangents, skinnedTangents);
+
+		skinningPlanes positionSource = skinningSplit(positions, count);
+		skinningDestination positionDestination = skinningSplit(skinnedPositions, count);
+		skinningPlanes normalSource = skinningSplit(normals, count);
+		skinningDestination normalDestination = skinningSplit(skinnedNormals, count);
+		skinningPlanes tangentSource = skinningSplit(tangents, count);
+		skinningDestination tangentDestination = skinningSplit(skinnedTangents, count);
+
+		parallelFor(count, skinningGrain, [&](size_t begin, size_t end)
+		{
+			constexpr size_t L = skinningLanes;
+
+			for (size_t base = begin; base < end; base += L)
+			{
+				size_t lanes = std::min(L, end - base);
+				float m[skinningAffine][L];
+				float total[L];
+
+				// the bones are gathered one lane at a time, since each vertex reads different bones
+				for (size_t l = 0; l < L; l++)
+				{
+					for (size_t e = 0; e < skinningAffine; e++)
+					{
+						m[e][l] = 0.0f;
+					}
+
+					total[l] = 0.0f;
+
+					if (l >= lanes)
+					{
+						continue;
+					}
+
+					const uint16_t* vertexJoints = joints.data() + (base + l) * influences;
+					const float* vertexWeights = weights.data() + (base + l) * influences;
+
+					for (size_t k = 0; k < influences; k++)
+					{
+						const float* bone = bones.data() + vertexJoints[k] * skinningAffine;
+						float weight = vertexWeights[k];
+
+						for (size_t e = 0; e < skinningAffine; e++)
+						{
+							m[e][l] += bone[e] * weight;
+						}
+
+						total[l] += weight;
+					}
+				}
+
+				// dividing by the sum of the weights, and using the identity for a vertex whose weights add up to 0
+				for (size_t e = 0; e < skinningAffine; e++)
+				{
+					float identity = e == 0 || e == 4 || e == 8 ? 1.0f : 0.0f;
+
+					for (size_t l = 0; l < L; l++)
+					{
+						float divisor = total[l] != 0.0f ? total[l] : 1.0f;
+						float value = m[e][l] / divisor;
+						m[e][l] = total[l] != 0.0f ? value : identity;
+					}
+				}
+
+				skinningLane lane;
+				skinningLoad(positionSource, base, lanes, lane);
+
+				for (size_t l = 0; l < L; l++)
+				{
+					float x = lane.x[l] * m[0][l] + lane.y[l] * m[3][l] + lane.z[l] * m[6][l] + m[9][l];
+					float y = lane.x[l] * m[1][l] + lane.y[l] * m[4][l] + lane.z[l] * m[7][l] + m[10][l];
+					float z = lane.x[l] * m[2][l] + lane.y[l] * m[5][l] + lane.z[l] * m[8][l] + m[11][l];
+
+					lane.x[l] = x;
+					lane.y[l] = y;
+					lane.z[l] = z;
+				}
+
+				skinningStore(positionDestination, base, lanes, lane);
+
+				if (!normals.empty())
+				{
+					skinningLoad(normalSource, base, lanes, lane);
+					skinningDirections(m, lane);
+					skinningStore(normalDestination, base, lanes, lane);
+				}
+
+				if (!tangents.empty())
+				{
+					skinningLoad(tangentSource, base, lanes, lane);
+					skinningDirections(m, lane);
+					skinningStore(tangentDestination, base, lanes, lane);
+				}
+			}
+		});
+	}
+}
\ No newline at end of file
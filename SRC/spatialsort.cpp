@@ -0,0 +1,295 @@
+#include "../INC/Aurora/Mathematics/spatialsort.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "../INC/Aurora/Mathematics/ivec2.h"
+#include "../INC/Aurora/Mathematics/ivec3.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of points handed to a thread at a time
+		constexpr size_t spatialSortGrain = 16384;
+
+		// number of bits of the keys sorted by each pass of the radix sort, three passes cover the 32-bit keys
+		constexpr int spatialSortRadixBits = 11;
+
+		constexpr size_t spatialSortRadixSize = (size_t)1 << spatialSortRadixBits;
+
+		inline void spatialSortComponents(const vec2& point, float* components)
+		{
+			components[0] = point.x;
+			components[1] = point.y;
+		}
+
+		inline void spatialSortComponents(const vec3& point, float* components)
+		{
+			components[0] = point.x;
+			components[1] = point.y;
+			components[2] = point.z;
+		}
+
+		inline void spatialSortComponents(const ivec2& point, int* components)
+		{
+			components[0] = point.x;
+			components[1] = point.y;
+		}
+
+		inline void spatialSortComponents(const ivec3& point, int* components)
+		{
+			components[0] = point.x;
+			components[1] = point.y;
+			components[2] = point.z;
+		}
+
+		// sorts values by their high 32 bits with a least significant digit radix sort, where every block of values counts its digits on its own and then scatters its values to the positions the counts of all blocks give it, so the sort is stable and needs no synchronization
+		void spatialSortRadix(std::vector<uint64_t>& values, std::vector<uint64_t>& scratch)
+		{
+			size_t count = values.size();
+			size_t blockCount = (count + spatialSortGrain - 1) / spatialSortGrain;
+			std::vector<uint32_t> histograms(blockCount * spatialSortRadixSize);
+
+			scratch.resize(count);
+
+			for (int shift = 32; shift < 64; shift += spatialSortRadixBits)
+			{
+				parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+					{
+						for (size_t block = begin; block < end; block++)
+						{
+							uint32_t* histogram = &histograms[block * spatialSortRadixSize];
+							size_t last = std::min((block + 1) * spatialSortGrain, count);
+
+							std::fill(histogram, histogram + spatialSortRadixSize, 0);
+
+							for (size_t i = block * spatialSortGrain; i < last; i++)
+							{
+								histogram[(values[i] >> shift) & (spatialSortRadixSize - 1)]++;
+							}
+						}
+					});
+
+				uint32_t position = 0;
+
+				for (size_t digit = 0; digit < spatialSortRadixSize; digit++)
+				{
+					for (size_t block = 0; block < blockCount; block++)
+					{
+						uint32_t digitCount = histograms[block * spatialSortRadixSize + digit];
+
+						histograms[block * spatialSortRadixSize + digit] = position;
+						position += digitCount;
+					}
+				}
+
+				parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+					{
+						for (size_t block = begin; block < end; block++)
+						{
+							uint32_t* histogram = &histograms[block * spatialSortRadixSize];
+							size_t last = std::min((block + 1) * spatialSortGrain, count);
+
+							for (size_t i = block * spatialSortGrain; i < last; i++)
+							{
+								scratch[histogram[(values[i] >> shift) & (spatialSortRadixSize - 1)]++] = values[i];
+							}
+						}
+					});
+
+				values.swap(scratch);
+			}
+		}
+
+		// finds the cell of each point in a grid of 2 to the power of cellBits cells along each axis over the bounds of the points, sorts the points by the key encode gives their cell, and gathers them in that order
+		template<int Dimensions, typename Scalar, typename Point, typename Encode>
+		void spatialSortPoints(std::span<Point> points, std::span<uint32_t> indices, int cellBits, Encode encode)
+		{
+			if (indices.size() < points.size())
+			{
+				throw std::invalid_argument("The indices (" + std::to_string(indices.size()) + ") are fewer than required (" + std::to_string(points.size()) + ").");
+			}
+
+			if (points.size() > std::numeric_limits<uint32_t>::max())
+			{
+				throw std::invalid_argument("The points (" + std::to_string(points.size()) + ") are more than the maximum (" + std::to_string(std::numeric_limits<uint32_t>::max()) + ").");
+			}
+
+			size_t count = points.size();
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			// the bounds are found per block and then merged, starting from the widest values so a NaN component, which fails every comparison, is never taken as a bound
+			size_t blockCount = (count + spatialSortGrain - 1) / spatialSortGrain;
+			std::vector<Scalar> blockBounds(blockCount * Dimensions * 2);
+
+			parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t block = begin; block < end; block++)
+					{
+						Scalar* lower = &blockBounds[block * Dimensions * 2];
+						Scalar* upper = lower + Dimensions;
+						size_t last = std::min((block + 1) * spatialSortGrain, count);
+
+						for (int axis = 0; axis < Dimensions; axis++)
+						{
+							if constexpr (std::is_floating_point_v<Scalar>)
+							{
+								lower[axis] = std::numeric_limits<Scalar>::infinity();
+								upper[axis] = -std::numeric_limits<Scalar>::infinity();
+							}
+							else
+							{
+								lower[axis] = std::numeric_limits<Scalar>::max();
+								upper[axis] = std::numeric_limits<Scalar>::lowest();
+							}
+						}
+
+						for (size_t i = block * spatialSortGrain; i < last; i++)
+						{
+							Scalar components[Dimensions];
+							spatialSortComponents(points[i], components);
+
+							for (int axis = 0; axis < Dimensions; axis++)
+							{
+								lower[axis] = components[axis] < lower[axis] ? components[axis] : lower[axis];
+								upper[axis] = components[axis] > upper[axis] ? components[axis] : upper[axis];
+							}
+						}
+					}
+				});
+
+			Scalar lower[Dimensions];
+			Scalar upper[Dimensions];
+
+			for (int axis = 0; axis < Dimensions; axis++)
+			{
+				lower[axis] = blockBounds[axis];
+				upper[axis] = blockBounds[Dimensions + axis];
+
+				for (size_t block = 1; block < blockCount; block++)
+				{
+					Scalar blockLower = blockBounds[block * Dimensions * 2 + axis];
+					Scalar blockUpper = blockBounds[block * Dimensions * 2 + Dimensions + axis];
+
+					lower[axis] = blockLower < lower[axis] ? blockLower : lower[axis];
+					upper[axis] = blockUpper > upper[axis] ? blockUpper : upper[axis];
+				}
+			}
+
+			uint32_t maxCell = (1u << cellBits) - 1;
+			float scale[Dimensions];
+			int shift[Dimensions];
+
+			for (int axis = 0; axis < Dimensions; axis++)
+			{
+				if constexpr (std::is_floating_point_v<Scalar>)
+				{
+					float extent = upper[axis] - lower[axis];
+					scale[axis] = extent > 0.0f && extent < std::numeric_limits<float>::infinity() ? (float)maxCell / extent : 0.0f;
+				}
+				else
+				{
+					// integer points are grouped into cells of a power of two size, so the cells never split a coordinate
+					uint64_t range = (uint64_t)((int64_t)upper[axis] - lower[axis]);
+					shift[axis] = 0;
+
+					while ((range >> shift[axis]) > maxCell)
+					{
+						shift[axis]++;
+					}
+				}
+			}
+
+			std::vector<uint64_t> values(count);
+			std::vector<uint64_t> scratch;
+
+			parallelFor(count, spatialSortGrain, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						Scalar components[Dimensions];
+						uint32_t cell[Dimensions];
+
+						spatialSortComponents(points[i], components);
+
+						for (int axis = 0; axis < Dimensions; axis++)
+						{
+							if constexpr (std::is_floating_point_v<Scalar>)
+							{
+								// written so that NaN components end up in the last cell
+								float position = (components[axis] - lower[axis]) * scale[axis];
+								position = position < (float)maxCell ? position : (float)maxCell;
+								position = position > 0.0f ? position : 0.0f;
+								cell[axis] = (uint32_t)position;
+							}
+							else
+							{
+								cell[axis] = (uint32_t)((uint64_t)((int64_t)components[axis] - lower[axis]) >> shift[axis]);
+							}
+						}
+
+						values[i] = ((uint64_t)encode(cell) << 32) | i;
+					}
+				});
+
+			spatialSortRadix(values, scratch);
+
+			std::vector<Point> copy(points.begin(), points.end());
+
+			parallelFor(count, spatialSortGrain, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						uint32_t index = (uint32_t)values[i];
+
+						points[i] = copy[index];
+						indices[i] = index;
+					}
+				});
+		}
+	}
+
+	void spatialSort(std::span<vec2> points, std::span<uint32_t> indices, Curve curve)
+	{
+		spatialSortPoints<2, float>(points, indices, 16, [curve](const uint32_t* cell)
+			{
+				ivec2 value((int)cell[0], (int)cell[1]);
+				return curve == Curve::Morton ? ivec2::morton32(value) : ivec2::hilbert32(value);
+			});
+	}
+
+	void spatialSort(std::span<vec3> points, std::span<uint32_t> indices, Curve curve)
+	{
+		spatialSortPoints<3, float>(points, indices, 10, [curve](const uint32_t* cell)
+			{
+				ivec3 value((int)cell[0], (int)cell[1], (int)cell[2]);
+				return curve == Curve::Morton ? ivec3::morton32(value) : ivec3::hilbert32(value);
+			});
+	}
+
+	void spatialSort(std::span<ivec2> points, std::span<uint32_t> indices, Curve curve)
+	{
+		spatialSortPoints<2, int>(points, indices, 16, [curve](const uint32_t* cell)
+			{
+				ivec2 value((int)cell[0], (int)cell[1]);
+				return curve == Curve::Morton ? ivec2::morton32(value) : ivec2::hilbert32(value);
+			});
+	}
+
+	void spatialSort(std::span<ivec3> points, std::span<uint32_t> indices, Curve curve)
+	{
+		spatialSortPoints<3, int>(points, indices, 10, [curve](const uint32_t* cell)
+			{
+				ivec3 value((int)cell[0], (int)cell[1], (int)cell[2]);
+				return curve == Curve::Morton ? ivec3::morton32(value) : ivec3::hilbert32(value);
+			});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "../INC/Aurora/Mathematics/spline2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/vec2.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of agents evaluated by a thread at a time, each a binary search of the table and a cubic
+		constexpr size_t spline2Grain = 4096;
+
+		// the coefficients of a segment, four for each component
+		constexpr size_t spline2Stride = 8;
+
+		// the nodes and weights of the five point Gauss-Legendre rule over [-1, 1], exact for a polynomial up to degree 9, which the speed along a subdivision is close to
+		constexpr float spline2Nodes[5] = { -0.9061798459f, -0.5384693101f, 0.0f, 0.5384693101f, 0.9061798459f };
+		constexpr float spline2Weights[5] = { 0.2369268851f, 0.4786286705f, 0.5688888889f, 0.4786286705f, 0.2369268851f };
+
+		inline float spline2Component(vec2 value, size_t component)
+		{
+			return component == 0 ? value.x : value.y;
+		}
+
+		// the power basis of a segment from the four values that shape it, the value and tangent of each end for Spline::Hermite
+		void spline2Coefficients(Spline type, float p0, float p1, float p2, float p3, float* result)
+		{
+			switch (type)
+			{
+			case Spline::CatmullRom:
+				result[0] = p1;
+				result[1] = 0.5f * (p2 - p0);
+				result[2] = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
+				result[3] = 0.5f * (p3 - p0) + 1.5f * (p1 - p2);
+				break;
+			case Spline::Hermite:
+				result[0] = p0;
+				result[1] = p1;
+				result[2] = 3.0f * (p2 - p0) - 2.0f * p1 - p3;
+				result[3] = 2.0f * (p0 - p2) + p1 + p3;
+				break;
+			case Spline::Bezier:
+				result[0] = p0;
+				result[1] = 3.0f * (p1 - p0);
+				result[2] = 3.0f * (p0 - 2.0f * p1 + p2);
+				result[3] = p3 - p0 + 3.0f * (p1 - p2);
+				break;
+			default:
+				result[0] = (p0 + 4.0f * p1 + p2) / 6.0f;
+				result[1] = 0.5f * (p2 - p0);
+				result[2] = 0.5f * (p0 + p2) - p1;
+				result[3] = (p3 - p0) / 6.0f + 0.5f * (p1 - p2);
+				break;
+			}
+		}
+
+		inline float spline2Speed(const float* coefficients, float u)
+		{
+			float x = (3.0f * coefficients[3] * u + 2.0f * coefficients[2]) * u + coefficients[1];
+			float y = (3.0f * coefficients[7] * u + 2.0f * coefficients[6]) * u + coefficients[5];
+
+			return std::sqrt(x * x + y * y);
+		}
+
+		// the cubic from (0, 0) to (1, 1) with the slopes given at its ends, which are limited so the cubic never turns back, as the parameter and the distance only ever increase together
+		inline float spline2Monotone(float slope0, float slope1, float x)
+		{
+			slope0 = std::min(slope0, 3.0f);
+			slope1 = std::min(slope1, 3.0f);
+
+			float squared = slope0 * slope0 + slope1 * slope1;
+			float scale = squared > 9.0f ? 3.0f / std::sqrt(squared) : 1.0f;
+
+			slope0 *= scale;
+			slope1 *= scale;
+
+			return x * (slope0 + x * (3.0f - 2.0f * slope0 - slope1 + x * (slope0 + slope1 - 2.0f)));
+		}
+	}
+
+	spline2::spline2() : segments_(0), subdivisions_(1) { }
+
+	spline2::spline2(std::span<const vec2> points, Spline type, std::span<const vec2> tangents, size_t subdivisions) : segments_(0), subdivisions_(subdivisions)
+	{
+		size_t count = points.size();
+		size_t required = type == Spline::Bezier || type == Spline::BSpline ? 4 : 2;
+
+		if (count < required)
+		{
+			throw std::invalid_argument("The points (" + std::to_string(count) + ") are fewer than required (" + std::to_string(required) + ").");
+		}
+
+		if (type == Spline::Bezier && (count - 1) % 3 != 0)
+		{
+			throw std::invalid_argument("The points (" + std::to_string(count) + ") are not 1 more than a multiple of 3.");
+		}
+
+		if (type == Spline::Hermite && tangents.size() < count)
+		{
+			throw std::invalid_argument("The tangents (" + std::to_string(tangents.size()) + ") are fewer than required (" + std::to_string(count) + ").");
+		}
+
+		if (subdivisions == 0)
+		{
+			throw std::invalid_argument("The subdivisions (0) are fewer than required (1).");
+		}
+
+		segments_ = type == Spline::Bezier ? (count - 1) / 3 : type == Spline::BSpline ? count - 3 : count - 1;
+		coefficients_.resize(segments_ * spline2Stride);
+
+		for (size_t s = 0; s < segments_; s++)
+		{
+			for (size_t c = 0; c < 2; c++)
+			{
+				float* coefficients = coefficients_.data() + s * spline2Stride + c * 4;
+
+				switch (type)
+				{
+				case Spline::CatmullRom:
+					spline2Coefficients(type, spline2Component(points[s > 0 ? s - 1 : 0], c), spline2Component(points[s], c), spline2Component(points[s + 1], c), spline2Component(points[std::min(s + 2, count - 1)], c), coefficients);
+					break;
+				case Spline::Hermite:
+					spline2Coefficients(type, spline2Component(points[s], c), spline2Component(tangents[s], c), spline2Component(points[s + 1], c), spline2Component(tangents[s + 1], c), coefficients);
+					break;
+				case Spline::Bezier:
+					spline2Coefficients(type, spline2Component(points[s * 3], c), spline2Component(points[s * 3 + 1], c), spline2Component(points[s * 3 + 2], c), spline2Component(points[s * 3 + 3], c), coefficients);
+					break;
+				default:
+					spline2Coefficients(type, spline2Component(points[s], c), spline2Component(points[s + 1], c), spline2Component(points[s + 2], c), spline2Component(points[s + 3], c), coefficients);
+					break;
+				}
+			}
+		}
+
+		// the speed is taken at both ends of every subdivision from its own segment, since two Bézier segments need not leave their shared point at the same speed
+		size_t entries = segments_ * subdivisions_;
+		float step = 1.0f / static_cast<float>(subdivisions_);
+		double total = 0.0;
+
+		distances_.resize(entries + 1);
+		speeds_.resize(entries * 2);
+
+		for (size_t i = 0; i < entries; i++)
+		{
+			const float* coefficients = coefficients_.data() + (i / subdivisions_) * spline2Stride;
+			float start = static_cast<float>(i % subdivisions_) * step;
+			float length = 0.0f;
+
+			for (size_t n = 0; n < 5; n++)
+			{
+				length += spline2Weights[n] * spline2Speed(coefficients, start + (spline2Nodes[n] + 1.0f) * 0.5f * step);
+			}
+
+			distances_[i] = static_cast<float>(total);
+			speeds_[i * 2] = spline2Speed(coefficients, start);
+			speeds_[i * 2 + 1] = spline2Speed(coefficients, start + step);
+			total += length * 0.5f * step;
+		}
+
+		distances_[entries] = static_cast<float>(total);
+	}
+
+	size_t spline2::segments() const
+	{
+		return segments_;
+	}
+
+	float spline2::length() const
+	{
+		return distances_.empty() ? 0.0f : distances_.back();
+	}
+
+	vec2 spline2::position(float parameter) const
+	{
+		float result[2];
+		evaluate(parameter, result, nullptr);
+		return vec2(result[0], result[1]);
+	}
+
+	vec2 spline2::derivative(float parameter) const
+	{
+		float result[2];
+		evaluate(parameter, nullptr, result);
+		return vec2(result[0], result[1]);
+	}
+
+	float spline2::parameter(float distance) const
+	{
+		if (segments_ == 0)
+		{
+			return 0.0f;
+		}
+
+		// the last subdivision starting at or before the distance, skipping those of no length, halving the range with a select rather than a branch since the distances of many agents are not predictable
+		const float* first = distances_.data();
+		size_t remaining = segments_ * subdivisions_;
+
+		while (remaining > 1)
+		{
+			size_t half = remaining / 2;
+			first = first[half] <= distance ? first + half : first;
+			remaining -= half;
+		}
+
+		size_t i = static_cast<size_t>(first - distances_.data());
+		float start = distances_[i];
+		float span = distances_[i + 1] - start;
+		float step = 1.0f / static_cast<float>(subdivisions_);
+		float x = span > 0.0f ? std::clamp((distance - start) / span, 0.0f, 1.0f) : 0.0f;
+
+		// the parameter changes by the inverse of the speed per unit of length, or as fast as the cubic allows where the spline stops
+		float slope0 = speeds_[i * 2] > 0.0f ? span / (speeds_[i * 2] * step) : std::numeric_limits<float>::infinity();
+		float slope1 = speeds_[i * 2 + 1] > 0.0f ? span / (speeds_[i * 2 + 1] * step) : std::numeric_limits<float>::infinity();
+
+		return (static_cast<float>(i) + spline2Monotone(slope0, slope1, x)) * step;
+	}
+
+	float spline2::distance(float parameter) const
+	{
+		if (segments_ == 0)
+		{
+			return 0.0f;
+		}
+
+		size_t entries = segments_ * subdivisions_;
+		float scaled = parameter > 0.0f ? std::min(parameter, static_cast<float>(segments_)) * static_cast<float>(subdivisions_) : 0.0f;
+		size_t i = std::min(static_cast<size_t>(scaled), entries - 1);
+		float start = distances_[i];
+		float span = distances_[i + 1] - start;
+
+		if (!(span > 0.0f))
+		{
+			return start;
+		}
+
+		float step = 1.0f / static_cast<float>(subdivisions_);
+		float slope0 = speeds_[i * 2] * step / span;
+		float slope1 = speeds_[i * 2 + 1] * step / span;
+
+		return start + span * spline2Monotone(slope0, slope1, scaled - static_cast<float>(i));
+	}
+
+	vec2 spline2::positionAt(float distance) const
+	{
+		return position(parameter(distance));
+	}
+
+	void spline2::positionAt(std::span<const float> distances, std::span<vec2> positions, std::span<vec2> directions) const
+	{
+		if (positions.size() < distances.size())
+		{
+			throw std::invalid_argument("The positions (" + std::to_string(positions.size()) + ") are fewer than required (" + std::to_string(distances.size()) + ").");
+		}
+
+		if (!directions.empty() && directions.size() < distances.size())
+		{
+			throw std::invalid_argument("The directions (" + std::to_string(directions.size()) + ") are fewer than required (" + std::to_string(distances.size()) + ").");
+		}
+
+		parallelFor(distances.size(), spline2Grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					float position[2];
+					float derivative[2];
+					evaluate(parameter(distances[i]), position, derivative);
+					positions[i] = vec2(position[0], position[1]);
+
+					if (!directions.empty())
+					{
+						float lengthSquared = derivative[0] * derivative[0] + derivative[1] * derivative[1];
+						float inverse = lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+						directions[i] = vec2(derivative[0] * inverse, derivative[1] * inverse);
+					}
+				}
+			});
+	}
+
+	void spline2::evaluate(float parameter, float* position, float* derivative) const
+	{
+		if (segments_ == 0)
+		{
+			if (position != nullptr)
+			{
+				std::fill(position, position + 2, 0.0f);
+			}
+
+			if (derivative != nullptr)
+			{
+				std::fill(derivative, derivative + 2, 0.0f);
+			}
+
+			return;
+		}
+
+		// the end of the last segment is its parameter of 1 rather than the start of a segment past it
+		float clamped = parameter > 0.0f ? std::min(parameter, static_cast<float>(segments_)) : 0.0f;
+		size_t segment = std::min(static_cast<size_t>(clamped), segments_ - 1);
+		float u = clamped - static_cast<float>(segment);
+		const float* coefficients = coefficients_.data() + segment * spline2Stride;
+
+		for (size_t c = 0; c < 2; c++)
+		{
+			const float* k = coefficients + c * 4;
+
+			if (position != nullptr)
+			{
+				position[c] = ((k[3] * u + k[2]) * u + k[1]) * u + k[0];
+			}
+
+			if (derivative != nullptr)
+			{
+				derivative[c] = (3.0f * k[3] * u + 2.0f * k[2]) * u + k[1];
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "../INC/Aurora/Mathematics/srgb.h"
+
+#include <array>
+#include <cmath>
+#include "../INC/Aurora/Mathematics/math.h"
+
+namespace Aurora::Mathematics
+{
+	float srgbToLinear(float value)
+	{
+		return (value <= 0.04045f) ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float srgbToLinear(uint8_t value)
+	{
+		return srgbToLinearTable()[value];
+	}
+
+	float linearToSrgb(float value)
+	{
+		value = clamp01(value);
+		return (value <= 0.0031308f) ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	uint8_t linearToSrgb8(float value)
+	{
+		return linearToSrgbTable()[static_cast<int>(clamp01(value) * (linearToSrgbTableSize - 1) + 0.5f)];
+	}
+
+	const float* srgbToLinearTable()
+	{
+		static const std::array<float, 256> table = []()
+			{
+				std::array<float, 256> result{};
+
+				for (int i = 0; i < 256; i++)
+				{
+					result[i] = srgbToLinear(i / 255.0f);
+				}
+
+				return result;
+			}();
+
+		return table.data();
+	}
+
+	const uint8_t* linearToSrgbTable()
+	{
+		static const std::array<uint8_t, linearToSrgbTableSize> table = []()
+			{
+				std::array<uint8_t, linearToSrgbTableSize> result{};
+
+				for (int i = 0; i < linearToSrgbTableSize; i++)
+				{
+					float encoded = linearToSrgb(static_cast<float>(i) / (linearToSrgbTableSize - 1));
+					result[i] = static_cast<uint8_t>(encoded * 255.0f + 0.5f);
+				}
+
+				return result;
+			}();
+
+		return table.data();
+	}
+}
\ No newline at end of file
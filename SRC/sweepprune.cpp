@@ -0,0 +1,520 @@
+#include "../INC/Aurora/Mathematics/sweepprune.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/aabb3.h"
+#include "../INC/Aurora/Mathematics/bounds.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// marks a free id
+		constexpr uint32_t sweeppruneNone = 0xFFFFFFFF;
+
+		// number of boxes swept by a thread at a time, kept small since a box in a crowded area can be tested against many others
+		constexpr size_t sweeppruneGrain = 1024;
+
+		// number of steps per box the insertion sort may take before the previous order is treated as lost and the boxes are sorted from scratch
+		constexpr size_t sweeppruneSortBudget = 8;
+
+		// how many times the average size of the boxes a slab is thick, so only a few boxes reach into more than one slab
+		constexpr float sweeppruneSlabSize = 4.0f;
+
+		// the most slabs the boxes are cut into, past which the slabs cost more to fill than they save
+		constexpr size_t sweeppruneMaxSlabs = 256;
+
+		// how many times more the centers have to be spread along another axis before the boxes are sorted along it, so the axis does not switch back and forth between two that are about as good
+		constexpr double sweeppruneAxisHysteresis = 1.5;
+
+		// written so that a NaN minimum sorts after every other box
+		inline float sweeppruneKey(float value)
+		{
+			return value >= -std::numeric_limits<float>::infinity() ? value : std::numeric_limits<float>::infinity();
+		}
+
+		// the comparisons are evaluated for every axis and then combined so they compile to packed comparisons
+		inline bool sweeppruneOverlaps(const float* min1, const float* max1, const float* min2, const float* max2)
+		{
+			int mask0 = min1[0] < max2[0] ? -1 : 0;
+			int mask1 = min1[1] < max2[1] ? -1 : 0;
+			int mask2 = min1[2] < max2[2] ? -1 : 0;
+			int mask3 = min2[0] < max1[0] ? -1 : 0;
+			int mask4 = min2[1] < max1[1] ? -1 : 0;
+			int mask5 = min2[2] < max1[2] ? -1 : 0;
+
+			return (mask0 & mask1 & mask2 & mask3 & mask4 & mask5) != 0;
+		}
+
+		inline std::pair<size_t, size_t> sweeppruneUnpack(uint64_t pair)
+		{
+			return { (size_t)(pair >> 32), (size_t)(pair & 0xFFFFFFFF) };
+		}
+	}
+
+	sweepprune::sweepprune() : size_(0), axis_(0) { }
+
+	size_t sweepprune::insert(bounds value)
+	{
+		return insert(aabb3(value));
+	}
+
+	size_t sweepprune::insert(const aabb3& value)
+	{
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		uint32_t id;
+
+		if (freeIds_.empty())
+		{
+			if (boxes_.size() >= sweeppruneNone)
+			{
+				throw std::invalid_argument("The boxes (" + std::to_string(boxes_.size()) + ") are already at the maximum (" + std::to_string(sweeppruneNone) + ").");
+			}
+
+			id = (uint32_t)boxes_.size();
+			boxes_.emplace_back();
+		}
+		else
+		{
+			id = freeIds_.back();
+			freeIds_.pop_back();
+		}
+
+		item& stored = boxes_[id];
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			stored.min[axis] = boxMin[axis];
+			stored.max[axis] = boxMax[axis];
+		}
+
+		stored.id = id;
+		order_.push_back({ sweeppruneKey(boxMin[axis_]), id });
+		size_++;
+
+		return id;
+	}
+
+	void sweepprune::move(size_t id, bounds value)
+	{
+		move(id, aabb3(value));
+	}
+
+	void sweepprune::move(size_t id, const aabb3& value)
+	{
+		find(id);
+
+		const float* boxMin = value.minLanes();
+		const float* boxMax = value.maxLanes();
+		item& stored = boxes_[id];
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			stored.min[axis] = boxMin[axis];
+			stored.max[axis] = boxMax[axis];
+		}
+	}
+
+	void sweepprune::remove(size_t id)
+	{
+		find(id);
+
+		boxes_[id].id = sweeppruneNone;
+		releasedIds_.push_back((uint32_t)id);
+		size_--;
+	}
+
+	void sweepprune::clear()
+	{
+		for (item& current : boxes_)
+		{
+			if (current.id != sweeppruneNone)
+			{
+				releasedIds_.push_back(current.id);
+				current.id = sweeppruneNone;
+			}
+		}
+
+		order_.clear();
+		size_ = 0;
+	}
+
+	bool sweepprune::contains(size_t id) const
+	{
+		return id < boxes_.size() && boxes_[id].id != sweeppruneNone;
+	}
+
+	aabb3 sweepprune::box(size_t id) const
+	{
+		const item& stored = find(id);
+
+		return aabb3(vec3(stored.min[0], stored.min[1], stored.min[2]), vec3(stored.max[0], stored.max[1], stored.max[2]));
+	}
+
+	size_t sweepprune::size() const
+	{
+		return size_;
+	}
+
+	size_t sweepprune::pairCount() const
+	{
+		return pairs_.size();
+	}
+
+	int sweepprune::axis() const
+	{
+		return axis_;
+	}
+
+	void sweepprune::update(std::vector<std::pair<size_t, size_t>>& added, std::vector<std::pair<size_t, size_t>>& removed)
+	{
+		sort();
+
+		// the boxes are gathered in sorted order so the sweep reads them one after another, leaving out empty boxes and boxes with NaN corners
+		sweep_.clear();
+
+		for (const endpoint& current : order_)
+		{
+			const item& stored = boxes_[current.id];
+
+			if (stored.min[0] <= stored.max[0] && stored.min[1] <= stored.max[1] && stored.min[2] <= stored.max[2])
+			{
+				sweep_.push_back(stored);
+			}
+		}
+
+		// the slabs are cut along the axis with the most slabs of the size of the boxes along it, not counting boxes reaching to infinity
+		float lower[3] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+		float upper[3] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+		double extent[3] = { 0.0, 0.0, 0.0 };
+		size_t finite = 0;
+
+		for (const item& current : sweep_)
+		{
+			if (!std::isfinite(current.min[0] + current.min[1] + current.min[2] + current.max[0] + current.max[1] + current.max[2]))
+			{
+				continue;
+			}
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				lower[axis] = std::min(lower[axis], current.min[axis]);
+				upper[axis] = std::max(upper[axis], current.max[axis]);
+				extent[axis] += current.max[axis] - current.min[axis];
+			}
+
+			finite++;
+		}
+
+		int across = axis_ == 0 ? 1 : 0;
+		float slabCount = 1.0f;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (axis == axis_ || finite == 0)
+			{
+				continue;
+			}
+
+			// written so that a NaN count, from boxes of no size spread over no distance, leaves a single slab
+			float slabs = (upper[axis] - lower[axis]) / (sweeppruneSlabSize * (float)(extent[axis] / (double)finite));
+			slabs = slabs < (float)sweeppruneMaxSlabs ? slabs : (float)sweeppruneMaxSlabs;
+
+			if (slabs > slabCount)
+			{
+				across = axis;
+				slabCount = std::floor(slabs);
+			}
+		}
+
+		size_t slabs = (size_t)slabCount;
+		float low = lower[across];
+		float inverse = slabs > 1 ? (float)slabs / (upper[across] - low) : 0.0f;
+		float maxSlab = (float)(slabs - 1);
+
+		auto slab = [low, inverse, maxSlab](float value)
+			{
+				// written so that a NaN position, from infinity times 0, ends up in the last slab
+				float position = (value - low) * inverse;
+				position = position < maxSlab ? position : maxSlab;
+				position = position > 0.0f ? position : 0.0f;
+
+				return (size_t)position;
+			};
+
+		// the boxes are copied into every slab they reach, keeping each slab in sorted order
+		slabOffsets_.assign(slabs + 1, 0);
+
+		for (const item& current : sweep_)
+		{
+			for (size_t i = slab(current.min[across]), last = slab(current.max[across]); i <= last; i++)
+			{
+				slabOffsets_[i + 1]++;
+			}
+		}
+
+		for (size_t i = 1; i <= slabs; i++)
+		{
+			slabOffsets_[i] += slabOffsets_[i - 1];
+		}
+
+		counts_.assign(slabOffsets_.begin(), slabOffsets_.end() - 1);
+		slabs_.resize(slabOffsets_.back());
+
+		for (const item& current : sweep_)
+		{
+			for (size_t i = slab(current.min[across]), last = slab(current.max[across]); i <= last; i++)
+			{
+				slabs_[counts_[i]++] = current;
+			}
+		}
+
+		tasks_.clear();
+
+		for (size_t i = 0; i < slabs; i++)
+		{
+			for (size_t begin = slabOffsets_[i]; begin < slabOffsets_[i + 1]; begin += sweeppruneGrain)
+			{
+				tasks_.push_back({ begin, std::min(begin + sweeppruneGrain, slabOffsets_[i + 1]), slabOffsets_[i + 1], i });
+			}
+		}
+
+		size_t blockCount = tasks_.size();
+		int axis = axis_;
+
+		if (blockPairs_.size() < blockCount)
+		{
+			blockPairs_.resize(blockCount);
+		}
+
+		parallelFor(blockCount, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t block = begin; block < end; block++)
+				{
+					const task& current = tasks_[block];
+					std::vector<uint64_t>& found = blockPairs_[block];
+
+					found.clear();
+
+					for (size_t i = current.begin; i < current.end; i++)
+					{
+						const item& first = slabs_[i];
+
+						// the boxes after this one are sorted by their minimum, so the first one starting past its end ends the search
+						for (size_t j = i + 1; j < current.last && slabs_[j].min[axis] < first.max[axis]; j++)
+						{
+							const item& second = slabs_[j];
+
+							// a pair in more than one slab is reported by the slab holding the start of their overlap along the axis the slabs are cut along
+							if (sweeppruneOverlaps(first.min, first.max, second.min, second.max) && slab(std::max(first.min[across], second.min[across])) == current.slab)
+							{
+								uint32_t low = std::min(first.id, second.id);
+								uint32_t high = std::max(first.id, second.id);
+
+								found.push_back(((uint64_t)low << 32) | high);
+							}
+						}
+					}
+				}
+			});
+
+		// the pairs are sorted by their lower id with a counting sort, and then by their higher id within each lower id, where a box rarely has more than a handful of pairs
+		counts_.assign(boxes_.size() + 1, 0);
+
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			for (uint64_t pair : blockPairs_[block])
+			{
+				counts_[(pair >> 32) + 1]++;
+			}
+		}
+
+		for (size_t i = 1; i < counts_.size(); i++)
+		{
+			counts_[i] += counts_[i - 1];
+		}
+
+		found_.resize(counts_.back());
+
+		for (size_t block = 0; block < blockCount; block++)
+		{
+			for (uint64_t pair : blockPairs_[block])
+			{
+				found_[counts_[pair >> 32]++] = pair;
+			}
+		}
+
+		size_t first = 0;
+
+		for (size_t i = 0; i < boxes_.size(); i++)
+		{
+			if (counts_[i] - first > 1)
+			{
+				std::sort(found_.begin() + first, found_.begin() + counts_[i]);
+			}
+
+			first = counts_[i];
+		}
+
+		// both sets of pairs are sorted, so a single merge finds the pairs only in one of them
+		size_t previous = 0;
+		size_t current = 0;
+
+		while (previous < pairs_.size() || current < found_.size())
+		{
+			if (current == found_.size() || (previous < pairs_.size() && pairs_[previous] < found_[current]))
+			{
+				removed.push_back(sweeppruneUnpack(pairs_[previous++]));
+			}
+			else if (previous == pairs_.size() || found_[current] < pairs_[previous])
+			{
+				added.push_back(sweeppruneUnpack(found_[current++]));
+			}
+			else
+			{
+				previous++;
+				current++;
+			}
+		}
+
+		pairs_.swap(found_);
+
+		// the pairs of the removed boxes have been reported, so their ids can now be reused
+		freeIds_.insert(freeIds_.end(), releasedIds_.begin(), releasedIds_.end());
+		releasedIds_.clear();
+	}
+
+	void sweepprune::pairs(std::vector<std::pair<size_t, size_t>>& results) const
+	{
+		results.reserve(results.size() + pairs_.size());
+
+		for (uint64_t pair : pairs_)
+		{
+			results.push_back(sweeppruneUnpack(pair));
+		}
+	}
+
+	bool sweepprune::overlapping(size_t id1, size_t id2) const
+	{
+		if (id1 == id2 || id1 >= sweeppruneNone || id2 >= sweeppruneNone)
+		{
+			return false;
+		}
+
+		uint64_t pair = ((uint64_t)std::min(id1, id2) << 32) | std::max(id1, id2);
+
+		return std::binary_search(pairs_.begin(), pairs_.end(), pair);
+	}
+
+	const sweepprune::item& sweepprune::find(size_t id) const
+	{
+		if (!contains(id))
+		{
+			throw std::invalid_argument("The id (" + std::to_string(id) + ") does not belong to a box in the sweepprune.");
+		}
+
+		return boxes_[id];
+	}
+
+	void sweepprune::sort()
+	{
+		if (!releasedIds_.empty())
+		{
+			order_.erase(std::remove_if(order_.begin(), order_.end(), [this](const endpoint& current) { return boxes_[current.id].id == sweeppruneNone; }), order_.end());
+		}
+
+		// the boxes are sorted along the axis their centers are spread the most along, which leaves the fewest boxes overlapping along it
+		double sum[3] = { 0.0, 0.0, 0.0 };
+		double sumSquared[3] = { 0.0, 0.0, 0.0 };
+		size_t count = 0;
+
+		for (const endpoint& current : order_)
+		{
+			const item& stored = boxes_[current.id];
+			double center[3];
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				center[axis] = ((double)stored.min[axis] + stored.max[axis]) * 0.5;
+			}
+
+			// boxes reaching to infinity or with NaN corners would make the spread meaningless
+			if (!std::isfinite(center[0] + center[1] + center[2]))
+			{
+				continue;
+			}
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				sum[axis] += center[axis];
+				sumSquared[axis] += center[axis] * center[axis];
+			}
+
+			count++;
+		}
+
+		bool switched = false;
+
+		if (count > 1)
+		{
+			double spread[3];
+			int best = axis_;
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				double mean = sum[axis] / (double)count;
+				spread[axis] = sumSquared[axis] / (double)count - mean * mean;
+				best = spread[axis] > spread[best] ? axis : best;
+			}
+
+			if (spread[best] > spread[axis_] * sweeppruneAxisHysteresis)
+			{
+				axis_ = best;
+				switched = true;
+			}
+		}
+
+		for (endpoint& current : order_)
+		{
+			current.key = sweeppruneKey(boxes_[current.id].min[axis_]);
+		}
+
+		auto less = [](const endpoint& value1, const endpoint& value2) { return value1.key < value2.key; };
+
+		if (switched)
+		{
+			std::sort(order_.begin(), order_.end(), less);
+			return;
+		}
+
+		// the steps are checked against the budget of the boxes sorted so far, plus some slack for a few boxes moving far, so a lost order is given up on early
+		size_t steps = 0;
+
+		for (size_t i = 1; i < order_.size(); i++)
+		{
+			endpoint current = order_[i];
+			size_t j = i;
+
+			while (j > 0 && order_[j - 1].key > current.key)
+			{
+				order_[j] = order_[j - 1];
+				j--;
+			}
+
+			order_[j] = current;
+			steps += i - j;
+
+			if (steps > (i + sweeppruneGrain) * sweeppruneSortBudget)
+			{
+				std::sort(order_.begin(), order_.end(), less);
+				return;
+			}
+		}
+	}
+}
\ No newline at end of file
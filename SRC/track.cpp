@@ -0,0 +1,394 @@
+#include "../INC/Aurora/Mathematics/track.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+#include "../INC/Aurora/Mathematics/quat.h"
+#include "../INC/Aurora/Mathematics/vec3.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of tracks sampled by a thread at a time, a sample costing a few tens of nanoseconds
+		constexpr size_t trackGrain = 1024;
+
+		template <typename T>
+		void trackValidate(std::span<const float> times, std::span<const T> values, Interpolation interpolation, std::span<const T> tangents)
+		{
+			if (values.size() < times.size())
+			{
+				throw std::invalid_argument("The values (" + std::to_string(values.size()) + ") are fewer than required (" + std::to_string(times.size()) + ").");
+			}
+
+			if (interpolation == Interpolation::Hermite && tangents.size() < times.size())
+			{
+				throw std::invalid_argument("The tangents (" + std::to_string(tangents.size()) + ") are fewer than required (" + std::to_string(times.size()) + ").");
+			}
+
+			for (size_t i = 1; i < times.size(); i++)
+			{
+				if (!(times[i] >= times[i - 1]))
+				{
+					throw std::invalid_argument("The time of the key (" + std::to_string(i) + ") is before the time of the key before it.");
+				}
+			}
+		}
+
+		// copies the components of the keys that are read, so every type of track is built by the same code
+		template <typename T, typename Flatten>
+		std::vector<float> trackFlatten(std::span<const T> values, size_t count, size_t components, Flatten flatten)
+		{
+			std::vector<float> result(count * components);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				flatten(values[i], result.data() + i * components);
+			}
+
+			return result;
+		}
+	}
+
+	track::track() : size_(0), stride_(0), components_(1), rotation_(false) { }
+
+	track::track(std::span<const float> times, std::span<const float> values, Interpolation interpolation, std::span<const float> tangents) : size_(0), stride_(0), components_(1), rotation_(false)
+	{
+		trackValidate(times, values, interpolation, tangents);
+		build(times, values.data(), interpolation == Interpolation::Hermite ? tangents.data() : nullptr, 1, interpolation);
+	}
+
+	track::track(std::span<const float> times, std::span<const vec3> values, Interpolation interpolation, std::span<const vec3> tangents) : size_(0), stride_(0), components_(3), rotation_(false)
+	{
+		trackValidate(times, values, interpolation, tangents);
+
+		auto flatten = [](const vec3& value, float* result)
+			{
+				result[0] = value.x;
+				result[1] = value.y;
+				result[2] = value.z;
+			};
+
+		std::vector<float> keys = trackFlatten(values, times.size(), 3, flatten);
+		std::vector<float> slopes = interpolation == Interpolation::Hermite ? trackFlatten(tangents, times.size(), 3, flatten) : std::vector<float>();
+
+		build(times, keys.data(), slopes.empty() ? nullptr : slopes.data(), 3, interpolation);
+	}
+
+	track::track(std::span<const float> times, std::span<const quat> values, Interpolation interpolation, std::span<const quat> tangents) : size_(0), stride_(0), components_(4), rotation_(true)
+	{
+		trackValidate(times, values, interpolation, tangents);
+
+		auto flatten = [](const quat& value, float* result)
+			{
+				result[0] = value.x;
+				result[1] = value.y;
+				result[2] = value.z;
+				result[3] = value.w;
+			};
+
+		std::vector<float> keys = trackFlatten(values, times.size(), 4, flatten);
+		std::vector<float> slopes = interpolation == Interpolation::Hermite ? trackFlatten(tangents, times.size(), 4, flatten) : std::vector<float>();
+
+		// keeps each key on the same side as the one before it, so interpolating the components takes the short way
+		for (size_t i = 1; i < times.size(); i++)
+		{
+			float* previous = keys.data() + (i - 1) * 4;
+			float* current = keys.data() + i * 4;
+
+			if (previous[0] * current[0] + previous[1] * current[1] + previous[2] * current[2] + previous[3] * current[3] < 0.0f)
+			{
+				for (size_t c = 0; c < 4; c++)
+				{
+					current[c] = -current[c];
+
+					if (!slopes.empty())
+					{
+						slopes[i * 4 + c] = -slopes[i * 4 + c];
+					}
+				}
+			}
+		}
+
+		build(times, keys.data(), slopes.empty() ? nullptr : slopes.data(), 4, interpolation);
+	}
+
+	track::track(std::span<const float> times, std::span<const col> values, Interpolation interpolation, std::span<const col> tangents) : size_(0), stride_(0), components_(4), rotation_(false)
+	{
+		trackValidate(times, values, interpolation, tangents);
+
+		auto flatten = [](const col& value, float* result)
+			{
+				result[0] = value.r;
+				result[1] = value.g;
+				result[2] = value.b;
+				result[3] = value.a;
+			};
+
+		std::vector<float> keys = trackFlatten(values, times.size(), 4, flatten);
+		std::vector<float> slopes = interpolation == Interpolation::Hermite ? trackFlatten(tangents, times.size(), 4, flatten) : std::vector<float>();
+
+		build(times, keys.data(), slopes.empty() ? nullptr : slopes.data(), 4, interpolation);
+	}
+
+	size_t track::size() const
+	{
+		return size_;
+	}
+
+	size_t track::components() const
+	{
+		return components_;
+	}
+
+	float track::start() const
+	{
+		return size_ == 0 ? 0.0f : segments_.front();
+	}
+
+	float track::end() const
+	{
+		return size_ == 0 ? 0.0f : segments_[(size_ - 1) * stride_];
+	}
+
+	void track::sample(float time, size_t& cursor, std::span<float> result) const
+	{
+		if (result.size() < components_)
+		{
+			throw std::invalid_argument("The result (" + std::to_string(result.size()) + ") is smaller than required (" + std::to_string(components_) + ").");
+		}
+
+		evaluate(time, cursor, result.data());
+	}
+
+	float track::sampleFloat(float time, size_t& cursor) const
+	{
+		if (components_ != 1)
+		{
+			throw std::invalid_argument("The track does not hold a float.");
+		}
+
+		float result;
+		evaluate(time, cursor, &result);
+		return result;
+	}
+
+	vec3 track::sampleVec3(float time, size_t& cursor) const
+	{
+		if (components_ != 3)
+		{
+			throw std::invalid_argument("The track does not hold a vec3.");
+		}
+
+		float result[3];
+		evaluate(time, cursor, result);
+		return vec3(result[0], result[1], result[2]);
+	}
+
+	quat track::sampleQuat(float time, size_t& cursor) const
+	{
+		if (!rotation_)
+		{
+			throw std::invalid_argument("The track does not hold a rotation.");
+		}
+
+		float result[4];
+		evaluate(time, cursor, result);
+
+		quat value;
+		value.x = result[0];
+		value.y = result[1];
+		value.z = result[2];
+		value.w = result[3];
+		return value;
+	}
+
+	col track::sampleCol(float time, size_t& cursor) const
+	{
+		if (components_ != 4 || rotation_)
+		{
+			throw std::invalid_argument("The track does not hold a color.");
+		}
+
+		float result[4];
+		evaluate(time, cursor, result);
+		return col(result[0], result[1], result[2], result[3]);
+	}
+
+	void track::sample(std::span<const track> tracks, float time, std::span<size_t> cursors, std::span<float> results)
+	{
+		if (cursors.size() < tracks.size())
+		{
+			throw std::invalid_argument("The cursors (" + std::to_string(cursors.size()) + ") are fewer than required (" + std::to_string(tracks.size()) + ").");
+		}
+
+		std::vector<size_t> offsets(tracks.size() + 1);
+
+		for (size_t i = 0; i < tracks.size(); i++)
+		{
+			offsets[i + 1] = offsets[i] + tracks[i].components_;
+		}
+
+		if (results.size() < offsets.back())
+		{
+			throw std::invalid_argument("The results (" + std::to_string(results.size()) + ") are fewer than required (" + std::to_string(offsets.back()) + ").");
+		}
+
+		parallelFor(tracks.size(), trackGrain, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				tracks[i].evaluate(time, cursors[i], results.data() + offsets[i]);
+			}
+		});
+	}
+
+	void track::build(std::span<const float> times, const float* values, const float* tangents, size_t components, Interpolation interpolation)
+	{
+		size_t count = times.size();
+
+		size_ = count;
+		stride_ = 2 + components * 4;
+		segments_.assign(count * stride_, 0.0f);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			float* record = segments_.data() + i * stride_;
+			float* segment = record + 2;
+			record[0] = times[i];
+			const float* p0 = values + i * components;
+
+			// the last key is a segment of its own that holds its value, so a time past it needs no special case
+			if (i + 1 == count)
+			{
+				for (size_t c = 0; c < components; c++)
+				{
+					segment[c * 4] = p0[c];
+				}
+
+				break;
+			}
+
+			const float* p1 = values + (i + 1) * components;
+			float duration = times[i + 1] - times[i];
+			record[1] = duration > 0.0f ? 1.0f / duration : 0.0f;
+
+			for (size_t c = 0; c < components; c++)
+			{
+				float* coefficients = segment + c * 4;
+				coefficients[0] = p0[c];
+
+				if (interpolation == Interpolation::Step)
+				{
+					continue;
+				}
+
+				if (interpolation == Interpolation::Linear)
+				{
+					coefficients[1] = p1[c] - p0[c];
+					continue;
+				}
+
+				float m0;
+				float m1;
+
+				if (interpolation == Interpolation::Hermite)
+				{
+					m0 = tangents[i * components + c];
+					m1 = tangents[(i + 1) * components + c];
+				}
+				else
+				{
+					// the slope between the keys on either side, or between the key and its only neighbour at either end
+					size_t before = i > 0 ? i - 1 : i;
+					size_t after = i + 2 < count ? i + 2 : i + 1;
+					float span0 = times[i + 1] - times[before];
+					float span1 = times[after] - times[i];
+					m0 = span0 > 0.0f ? (p1[c] - values[before * components + c]) / span0 : 0.0f;
+					m1 = span1 > 0.0f ? (values[after * components + c] - p0[c]) / span1 : 0.0f;
+				}
+
+				// the hermite basis expanded in the fraction of the segment, with the tangents scaled from per unit of time to per segment
+				m0 *= duration;
+				m1 *= duration;
+				coefficients[1] = m0;
+				coefficients[2] = 3.0f * (p1[c] - p0[c]) - 2.0f * m0 - m1;
+				coefficients[3] = 2.0f * (p0[c] - p1[c]) + m0 + m1;
+			}
+		}
+	}
+
+	size_t track::find(float time, size_t& cursor) const
+	{
+		const float* segments = segments_.data();
+		size_t last = size_ - 1;
+		size_t segment = std::min(cursor, last);
+
+		// the segment of the previous sample, or the one after it, covers every sample of forward playback, and the first segment also covers the times before it
+		if ((segment == 0 || time >= segments[segment * stride_]) && (segment == last || time < segments[(segment + 1) * stride_]))
+		{
+			cursor = segment;
+			return segment;
+		}
+
+		if (segment < last && time >= segments[(segment + 1) * stride_] && (segment + 1 == last || time < segments[(segment + 2) * stride_]))
+		{
+			cursor = segment + 1;
+			return segment + 1;
+		}
+
+		// the last segment whose time is not after the time, or the first segment
+		size_t low = 0;
+		size_t high = last;
+
+		while (low < high)
+		{
+			size_t middle = (low + high + 1) / 2;
+
+			if (segments[middle * stride_] <= time)
+			{
+				low = middle;
+			}
+			else
+			{
+				high = middle - 1;
+			}
+		}
+
+		cursor = low;
+		return low;
+	}
+
+	void track::evaluate(float time, size_t& cursor, float* result) const
+	{
+		if (size_ == 0)
+		{
+			std::fill(result, result + components_, 0.0f);
+			return;
+		}
+
+		const float* record = segments_.data() + find(time, cursor) * stride_;
+		float t = std::clamp((time - record[0]) * record[1], 0.0f, 1.0f);
+		const float* coefficients = record + 2;
+
+		for (size_t c = 0; c < components_; c++)
+		{
+			const float* k = coefficients + c * 4;
+			result[c] = ((k[3] * t + k[2]) * t + k[1]) * t + k[0];
+		}
+
+		if (rotation_)
+		{
+			float lengthSquared = result[0] * result[0] + result[1] * result[1] + result[2] * result[2] + result[3] * result[3];
+			float inverse = lengthSquared > 0.0f ? 1.0f / std::sqrt(lengthSquared) : 0.0f;
+
+			result[0] *= inverse;
+			result[1] *= inverse;
+			result[2] *= inverse;
+			result[3] = lengthSquared > 0.0f ? result[3] * inverse : 1.0f;
+		}
+	}
+}
\ No newline at end of file
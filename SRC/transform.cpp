@@ -0,0 +1,286 @@
+#include "../INC/Aurora/Mathematics/transform.h"
+
+#include <cmath>
+#include "../INC/Aurora/Mathematics/mat3.h"
+#include "../INC/Aurora/Mathematics/mat4.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// the rotation as rows for row vectors, dividing by the squared length of the quaternion instead of normalizing it, so a rotation of length 0 gives the identity
+		inline void transformRotation(const quat& rotation, float result[3][3])
+		{
+			float lengthSquared = rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w;
+			float s = lengthSquared > 0.0f ? 2.0f / lengthSquared : 0.0f;
+
+			float xx = rotation.x * rotation.x * s;
+			float yy = rotation.y * rotation.y * s;
+			float zz = rotation.z * rotation.z * s;
+			float xy = rotation.x * rotation.y * s;
+			float xz = rotation.x * rotation.z * s;
+			float yz = rotation.y * rotation.z * s;
+			float wx = rotation.w * rotation.x * s;
+			float wy = rotation.w * rotation.y * s;
+			float wz = rotation.w * rotation.z * s;
+
+			result[0][0] = 1.0f - (yy + zz);
+			result[0][1] = xy + wz;
+			result[0][2] = xz - wy;
+			result[1][0] = xy - wz;
+			result[1][1] = 1.0f - (xx + zz);
+			result[1][2] = yz + wx;
+			result[2][0] = xz + wy;
+			result[2][1] = yz - wx;
+			result[2][2] = 1.0f - (xx + yy);
+		}
+
+		inline float transformReciprocal(float value)
+		{
+			return value != 0.0f ? 1.0f / value : 0.0f;
+		}
+	}
+
+	transform::transform() : transform(vec3(0.0f, 0.0f, 0.0f), quat::identity(), vec3(1.0f, 1.0f, 1.0f)) { }
+
+	transform::transform(vec3 translation, quat rotation, vec3 scale) : translation_(translation), rotation_(rotation), scale_(scale), version_(1), matrix_(), inverse_(), normal_(), matrixVersion_(0), inverseVersion_(0), normalVersion_(0) { }
+
+	vec3 transform::translation() const
+	{
+		return translation_;
+	}
+
+	void transform::translation(vec3 value)
+	{
+		translation_ = value;
+		version_++;
+	}
+
+	quat transform::rotation() const
+	{
+		return rotation_;
+	}
+
+	void transform::rotation(quat value)
+	{
+		rotation_ = value;
+		version_++;
+	}
+
+	vec3 transform::scale() const
+	{
+		return scale_;
+	}
+
+	void transform::scale(vec3 value)
+	{
+		scale_ = value;
+		version_++;
+	}
+
+	uint64_t transform::version() const
+	{
+		return version_;
+	}
+
+	bool transform::rigid() const
+	{
+		return scale_.x == 1.0f && scale_.y == 1.0f && scale_.z == 1.0f;
+	}
+
+	bool transform::uniform() const
+	{
+		return scale_.x == scale_.y && scale_.y == scale_.z;
+	}
+
+	mat4 transform::matrix() const
+	{
+		updateMatrix();
+
+		mat4 result = mat4::identity();
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				result(r, c) = matrix_[r][c];
+			}
+		}
+
+		return result;
+	}
+
+	mat4 transform::inverse() const
+	{
+		updateInverse();
+
+		mat4 result = mat4::identity();
+
+		for (int r = 0; r < 4; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				result(r, c) = inverse_[r][c];
+			}
+		}
+
+		return result;
+	}
+
+	mat3 transform::normal() const
+	{
+		updateNormal();
+
+		mat3 result;
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				result(r, c) = normal_[r][c];
+			}
+		}
+
+		return result;
+	}
+
+	vec3 transform::transformPoint(vec3 value) const
+	{
+		updateMatrix();
+
+		return vec3(
+			value.x * matrix_[0][0] + value.y * matrix_[1][0] + value.z * matrix_[2][0] + matrix_[3][0],
+			value.x * matrix_[0][1] + value.y * matrix_[1][1] + value.z * matrix_[2][1] + matrix_[3][1],
+			value.x * matrix_[0][2] + value.y * matrix_[1][2] + value.z * matrix_[2][2] + matrix_[3][2]);
+	}
+
+	vec3 transform::transformVector(vec3 value) const
+	{
+		updateMatrix();
+
+		return vec3(
+			value.x * matrix_[0][0] + value.y * matrix_[1][0] + value.z * matrix_[2][0],
+			value.x * matrix_[0][1] + value.y * matrix_[1][1] + value.z * matrix_[2][1],
+			value.x * matrix_[0][2] + value.y * matrix_[1][2] + value.z * matrix_[2][2]);
+	}
+
+	vec3 transform::transformNormal(vec3 value) const
+	{
+		updateNormal();
+
+		float x = value.x * normal_[0][0] + value.y * normal_[1][0] + value.z * normal_[2][0];
+		float y = value.x * normal_[0][1] + value.y * normal_[1][1] + value.z * normal_[2][1];
+		float z = value.x * normal_[0][2] + value.y * normal_[1][2] + value.z * normal_[2][2];
+		float length = std::sqrt(x * x + y * y + z * z);
+
+		if (length == 0.0f)
+		{
+			return vec3(0.0f, 0.0f, 0.0f);
+		}
+
+		return vec3(x / length, y / length, z / length);
+	}
+
+	vec3 transform::inverseTransformPoint(vec3 value) const
+	{
+		updateInverse();
+
+		return vec3(
+			value.x * inverse_[0][0] + value.y * inverse_[1][0] + value.z * inverse_[2][0] + inverse_[3][0],
+			value.x * inverse_[0][1] + value.y * inverse_[1][1] + value.z * inverse_[2][1] + inverse_[3][1],
+			value.x * inverse_[0][2] + value.y * inverse_[1][2] + value.z * inverse_[2][2] + inverse_[3][2]);
+	}
+
+	void transform::updateMatrix() const
+	{
+		if (matrixVersion_ == version_)
+		{
+			return;
+		}
+
+		float rotation[3][3];
+		transformRotation(rotation_, rotation);
+
+		float scale[3] = { scale_.x, scale_.y, scale_.z };
+		float translation[3] = { translation_.x, translation_.y, translation_.z };
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				matrix_[r][c] = rotation[r][c] * scale[r];
+			}
+
+			matrix_[3][r] = translation[r];
+		}
+
+		matrixVersion_ = version_;
+	}
+
+	void transform::updateInverse() const
+	{
+		if (inverseVersion_ == version_)
+		{
+			return;
+		}
+
+		float rotation[3][3];
+		transformRotation(rotation_, rotation);
+
+		// the inverse of the scale followed by the rotation is the transposed rotation followed by the reciprocal scale, which a rigid transform skips entirely
+		float reciprocal[3] = { 1.0f, 1.0f, 1.0f };
+
+		if (!rigid())
+		{
+			reciprocal[0] = transformReciprocal(scale_.x);
+			reciprocal[1] = transformReciprocal(scale_.y);
+			reciprocal[2] = transformReciprocal(scale_.z);
+		}
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				inverse_[r][c] = rotation[c][r] * reciprocal[c];
+			}
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			inverse_[3][c] = -(translation_.x * inverse_[0][c] + translation_.y * inverse_[1][c] + translation_.z * inverse_[2][c]);
+		}
+
+		inverseVersion_ = version_;
+	}
+
+	void transform::updateNormal() const
+	{
+		if (normalVersion_ == version_)
+		{
+			return;
+		}
+
+		float rotation[3][3];
+		transformRotation(rotation_, rotation);
+
+		// the inverse transpose of the scale followed by the rotation is the reciprocal scale followed by the rotation, so it is the rotation itself for a rigid transform
+		float reciprocal[3] = { 1.0f, 1.0f, 1.0f };
+
+		if (!rigid())
+		{
+			reciprocal[0] = transformReciprocal(scale_.x);
+			reciprocal[1] = transformReciprocal(scale_.y);
+			reciprocal[2] = transformReciprocal(scale_.z);
+		}
+
+		for (int r = 0; r < 3; r++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				normal_[r][c] = rotation[r][c] * reciprocal[r];
+			}
+		}
+
+		normalVersion_ = version_;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "../INC/Aurora/Mathematics/xyz.h"
+
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of colors handed to a thread at a time
+		constexpr size_t xyzGrain = 32768;
+	}
+
+	xyz::xyz() : xyz(0.0f, 0.0f, 0.0f, 1.0f) { }
+
+	xyz::xyz(float x, float y, float z, float a) : x(x), y(y), z(z), a(a) { }
+
+	bool xyz::approximately(xyz value1, xyz value2)
+	{
+		return
+			Mathematics::approximately(value1.x, value2.x) &&
+			Mathematics::approximately(value1.y, value2.y) &&
+			Mathematics::approximately(value1.z, value2.z) &&
+			Mathematics::approximately(value1.a, value2.a);
+	}
+
+	xyz xyz::lerp(xyz value1, xyz value2, float amount)
+	{
+		return lerpUnclamped(value1, value2, clamp01(amount));
+	}
+
+	xyz xyz::lerpUnclamped(xyz value1, xyz value2, float amount)
+	{
+		return xyz(
+			Mathematics::lerpUnclamped(value1.x, value2.x, amount),
+			Mathematics::lerpUnclamped(value1.y, value2.y, amount),
+			Mathematics::lerpUnclamped(value1.z, value2.z, amount),
+			Mathematics::lerpUnclamped(value1.a, value2.a, amount)
+		);
+	}
+
+	bool xyz::operator==(xyz other) const
+	{
+		return x == other.x && y == other.y && z == other.z && a == other.a;
+	}
+
+	bool xyz::operator!=(xyz other) const
+	{
+		return !((*this) == other);
+	}
+
+	xyz::operator col() const
+	{
+		col result;
+		convert(std::span<const xyz>(this, 1), std::span<col>(&result, 1));
+		return result;
+	}
+
+	void convert(std::span<const col> source, std::span<xyz> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), xyzGrain, [&](size_t begin, size_t end)
+			{
+				const col* s = source.data();
+				xyz* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float r = s[i].r;
+					float g = s[i].g;
+					float b = s[i].b;
+					float a = s[i].a;
+
+					d[i].x = 0.4124564f * r + 0.3575761f * g + 0.1804375f * b;
+					d[i].y = 0.2126729f * r + 0.7151522f * g + 0.0721750f * b;
+					d[i].z = 0.0193339f * r + 0.1191920f * g + 0.9503041f * b;
+					d[i].a = a;
+				}
+			});
+	}
+
+	void convert(std::span<const xyz> source, std::span<col> destination)
+	{
+		if (destination.size() < source.size())
+		{
+			throw std::invalid_argument("The destination (" + std::to_string(destination.size()) + ") is smaller than the source (" + std::to_string(source.size()) + ").");
+		}
+
+		parallelFor(source.size(), xyzGrain, [&](size_t begin, size_t end)
+			{
+				const xyz* s = source.data();
+				col* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float x = s[i].x;
+					float y = s[i].y;
+					float z = s[i].z;
+					float a = s[i].a;
+
+					d[i].r = 3.2404542f * x - 1.5371385f * y - 0.4985314f * z;
+					d[i].g = -0.9692660f * x + 1.8760108f * y + 0.0415560f * z;
+					d[i].b = 0.0556434f * x - 0.2040259f * y + 1.0572252f * z;
+					d[i].a = a;
+				}
+			});
+	}
+}
\ No newline at end of file
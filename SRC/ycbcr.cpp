@@ -0,0 +1,369 @@
+#include "../INC/Aurora/Mathematics/ycbcr.h"
+
+#include <stdexcept>
+#include <string>
+#include "../INC/Aurora/Mathematics/col.h"
+#include "../INC/Aurora/Mathematics/col32.h"
+#include "../INC/Aurora/Mathematics/math.h"
+#include "../INC/Aurora/Mathematics/parallel.h"
+
+namespace Aurora::Mathematics
+{
+	namespace
+	{
+		// number of colors handed to a thread at a time
+		constexpr size_t ycbcrGrain = 32768;
+
+		// number of fractional bits used by the 8-bit conversions
+		constexpr int ycbcrShift = 14;
+		constexpr int ycbcrHalf = 1 << (ycbcrShift - 1);
+
+		struct ycbcrWeights
+		{
+			float kr;
+			float kg;
+			float kb;
+
+			ycbcrWeights(YCbCrStandard standard)
+			{
+				switch (standard)
+				{
+				case Aurora::Mathematics::YCbCrStandard::Bt601:
+					kr = 0.299f;
+					kb = 0.114f;
+					break;
+				case Aurora::Mathematics::YCbCrStandard::Bt709:
+					kr = 0.2126f;
+					kb = 0.0722f;
+					break;
+				default:
+					throw std::invalid_argument("'" + std::to_string(static_cast<int>(standard)) + "' is not a defined YCbCrStandard.");
+				}
+
+				kg = 1.0f - kr - kb;
+			}
+		};
+
+		// fixed point coefficients of the 8-bit conversions for one standard and range
+		struct ycbcrFixed
+		{
+			int yr, yg, yb, yOffset;
+			int cbr, cbg, cbb;
+			int crr, crg, crb;
+			int cOffset;
+
+			int ys, rcr, gcb, gcr, bcb;
+			int yBase;
+
+			ycbcrFixed(YCbCrStandard standard, YCbCrRange range)
+			{
+				ycbcrWeights w(standard);
+				float lumaScale;
+				float chromaScale;
+				int lumaOffset;
+
+				switch (range)
+				{
+				case Aurora::Mathematics::YCbCrRange::Full:
+					lumaScale = 1.0f;
+					chromaScale = 1.0f;
+					lumaOffset = 0;
+					break;
+				case Aurora::Mathematics::YCbCrRange::Limited:
+					lumaScale = 219.0f / 255.0f;
+					chromaScale = 224.0f / 255.0f;
+					lumaOffset = 16;
+					break;
+				default:
+					throw std::invalid_argument("'" + std::to_string(static_cast<int>(range)) + "' is not a defined YCbCrRange.");
+				}
+
+				auto fixed = [](float value) { return roundToInt(value * (1 << ycbcrShift)); };
+
+				float cbDenominator = 2.0f * (1.0f - w.kb);
+				float crDenominator = 2.0f * (1.0f - w.kr);
+
+				yr = fixed(w.kr * lumaScale);
+				yg = fixed(w.kg * lumaScale);
+				yb = fixed(w.kb * lumaScale);
+				yOffset = (lumaOffset << ycbcrShift) + ycbcrHalf;
+
+				cbr = fixed(-w.kr / cbDenominator * chromaScale);
+				cbg = fixed(-w.kg / cbDenominator * chromaScale);
+				cbb = fixed(0.5f * chromaScale);
+				crr = fixed(0.5f * chromaScale);
+				crg = fixed(-w.kg / crDenominator * chromaScale);
+				crb = fixed(-w.kb / crDenominator * chromaScale);
+				cOffset = (128 << ycbcrShift) + ycbcrHalf;
+
+				ys = fixed(1.0f / lumaScale);
+				rcr = fixed(crDenominator / chromaScale);
+				gcb = fixed(-cbDenominator * w.kb / w.kg / chromaScale);
+				gcr = fixed(-crDenominator * w.kr / w.kg / chromaScale);
+				bcb = fixed(cbDenominator / chromaScale);
+				yBase = lumaOffset;
+			}
+		};
+
+		inline uint8_t ycbcrClamp(int value)
+		{
+			return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+		}
+
+		void ycbcrEncodeRange(const col32* source, uint8_t* y, uint8_t* cb, uint8_t* cr, size_t count, const ycbcrFixed& f)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				int r = source[i].r;
+				int g = source[i].g;
+				int b = source[i].b;
+
+				y[i] = ycbcrClamp((f.yr * r + f.yg * g + f.yb * b + f.yOffset) >> ycbcrShift);
+				cb[i] = ycbcrClamp((f.cbr * r + f.cbg * g + f.cbb * b + f.cOffset) >> ycbcrShift);
+				cr[i] = ycbcrClamp((f.crr * r + f.crg * g + f.crb * b + f.cOffset) >> ycbcrShift);
+			}
+		}
+
+		inline void ycbcrDecode(int luma, int blue, int red, const ycbcrFixed& f, col32& destination)
+		{
+			int l = (luma - f.yBase) * f.ys + ycbcrHalf;
+			int u = blue - 128;
+			int v = red - 128;
+
+			destination.r = ycbcrClamp((l + f.rcr * v) >> ycbcrShift);
+			destination.g = ycbcrClamp((l + f.gcb * u + f.gcr * v) >> ycbcrShift);
+			destination.b = ycbcrClamp((l + f.bcb * u) >> ycbcrShift);
+			destination.a = 255;
+		}
+
+		void ycbcrCheck(size_t required, size_t available, const char* name)
+		{
+			if (available < required)
+			{
+				throw std::invalid_argument("The " + std::string(name) + " (" + std::to_string(available) + ") is smaller than required (" + std::to_string(required) + ").");
+			}
+		}
+
+		void ycbcrCheckDimensions(int width, int height)
+		{
+			if (width < 0 || height < 0)
+			{
+				throw std::invalid_argument("The image dimensions (" + std::to_string(width) + ", " + std::to_string(height) + ") must not be negative.");
+			}
+		}
+	}
+
+	ycbcr::ycbcr() : ycbcr(0.0f, 0.0f, 0.0f, 1.0f) { }
+
+	ycbcr::ycbcr(float y, float cb, float cr, float a) : y(y), cb(cb), cr(cr), a(a) { }
+
+	ycbcr::ycbcr(col value, YCbCrStandard standard)
+	{
+		convert(std::span<const col>(&value, 1), std::span<ycbcr>(this, 1), standard);
+	}
+
+	bool ycbcr::approximately(ycbcr value1, ycbcr value2)
+	{
+		return
+			Mathematics::approximately(value1.y, value2.y) &&
+			Mathematics::approximately(value1.cb, value2.cb) &&
+			Mathematics::approximately(value1.cr, value2.cr) &&
+			Mathematics::approximately(value1.a, value2.a);
+	}
+
+	col ycbcr::rgb(YCbCrStandard standard) const
+	{
+		col result;
+		convert(std::span<const ycbcr>(this, 1), std::span<col>(&result, 1), standard);
+		return result;
+	}
+
+	bool ycbcr::operator==(ycbcr other) const
+	{
+		return y == other.y && cb == other.cb && cr == other.cr && a == other.a;
+	}
+
+	bool ycbcr::operator!=(ycbcr other) const
+	{
+		return !((*this) == other);
+	}
+
+	void convert(std::span<const col> source, std::span<ycbcr> destination, YCbCrStandard standard)
+	{
+		ycbcrCheck(source.size(), destination.size(), "destination");
+
+		ycbcrWeights w(standard);
+		float cbScale = 0.5f / (1.0f - w.kb);
+		float crScale = 0.5f / (1.0f - w.kr);
+
+		parallelFor(source.size(), ycbcrGrain, [&](size_t begin, size_t end)
+			{
+				const col* s = source.data();
+				ycbcr* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float r = s[i].r;
+					float g = s[i].g;
+					float b = s[i].b;
+					float a = s[i].a;
+					float luma = w.kr * r + w.kg * g + w.kb * b;
+
+					d[i].y = luma;
+					d[i].cb = (b - luma) * cbScale;
+					d[i].cr = (r - luma) * crScale;
+					d[i].a = a;
+				}
+			});
+	}
+
+	void convert(std::span<const ycbcr> source, std::span<col> destination, YCbCrStandard standard)
+	{
+		ycbcrCheck(source.size(), destination.size(), "destination");
+
+		ycbcrWeights w(standard);
+		float rcr = 2.0f * (1.0f - w.kr);
+		float bcb = 2.0f * (1.0f - w.kb);
+		float gcb = -bcb * w.kb / w.kg;
+		float gcr = -rcr * w.kr / w.kg;
+
+		parallelFor(source.size(), ycbcrGrain, [&](size_t begin, size_t end)
+			{
+				const ycbcr* s = source.data();
+				col* d = destination.data();
+
+				for (size_t i = begin; i < end; i++)
+				{
+					float luma = s[i].y;
+					float u = s[i].cb;
+					float v = s[i].cr;
+					float a = s[i].a;
+
+					d[i].r = luma + rcr * v;
+					d[i].g = luma + gcb * u + gcr * v;
+					d[i].b = luma + bcb * u;
+					d[i].a = a;
+				}
+			});
+	}
+
+	void convert(std::span<const col32> source, std::span<uint8_t> y, std::span<uint8_t> cb, std::span<uint8_t> cr, YCbCrStandard standard, YCbCrRange range)
+	{
+		ycbcrCheck(source.size(), y.size(), "luma plane");
+		ycbcrCheck(source.size(), cb.size(), "blue difference plane");
+		ycbcrCheck(source.size(), cr.size(), "red difference plane");
+
+		ycbcrFixed f(standard, range);
+
+		parallelFor(source.size(), ycbcrGrain, [&](size_t begin, size_t end)
+			{
+				ycbcrEncodeRange(source.data() + begin, y.data() + begin, cb.data() + begin, cr.data() + begin, end - begin, f);
+			});
+	}
+
+	void convert(std::span<const uint8_t> y, std::span<const uint8_t> cb, std::span<const uint8_t> cr, std::span<col32> destination, YCbCrStandard standard, YCbCrRange range)
+	{
+		ycbcrCheck(y.size(), cb.size(), "blue difference plane");
+		ycbcrCheck(y.size(), cr.size(), "red difference plane");
+		ycbcrCheck(y.size(), destination.size(), "destination");
+
+		ycbcrFixed f(standard, range);
+
+		parallelFor(y.size(), ycbcrGrain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					ycbcrDecode(y[i], cb[i], cr[i], f, destination[i]);
+				}
+			});
+	}
+
+	void convert420(std::span<const col32> source, int width, int height, std::span<uint8_t> y, std::span<uint8_t> cb, std::span<uint8_t> cr, YCbCrStandard standard, YCbCrRange range)
+	{
+		ycbcrCheckDimensions(width, height);
+
+		size_t w = static_cast<size_t>(width);
+		size_t h = static_cast<size_t>(height);
+		size_t cw = (w + 1) / 2;
+		size_t ch = (h + 1) / 2;
+
+		ycbcrCheck(w * h, source.size(), "source");
+		ycbcrCheck(w * h, y.size(), "luma plane");
+		ycbcrCheck(cw * ch, cb.size(), "blue difference plane");
+		ycbcrCheck(cw * ch, cr.size(), "red difference plane");
+
+		ycbcrFixed f(standard, range);
+
+		// each block of work is a run of chroma rows, covering two rows of luma
+		parallelFor(ch, ycbcrGrain / (w + 1) + 1, [&](size_t begin, size_t end)
+			{
+				for (size_t row = begin; row < end; row++)
+				{
+					size_t top = row * 2;
+					size_t bottom = top + 1 < h ? top + 1 : top;
+					const col32* s0 = source.data() + top * w;
+					const col32* s1 = source.data() + bottom * w;
+
+					for (size_t x = 0; x < w; x++)
+					{
+						y[top * w + x] = ycbcrClamp((f.yr * s0[x].r + f.yg * s0[x].g + f.yb * s0[x].b + f.yOffset) >> ycbcrShift);
+					}
+
+					if (bottom != top)
+					{
+						for (size_t x = 0; x < w; x++)
+						{
+							y[bottom * w + x] = ycbcrClamp((f.yr * s1[x].r + f.yg * s1[x].g + f.yb * s1[x].b + f.yOffset) >> ycbcrShift);
+						}
+					}
+
+					for (size_t x = 0; x < cw; x++)
+					{
+						size_t left = x * 2;
+						size_t right = left + 1 < w ? left + 1 : left;
+
+						// the 2x2 sum is 4 times the average, which the extra 2 bits of shift remove
+						int r = s0[left].r + s0[right].r + s1[left].r + s1[right].r;
+						int g = s0[left].g + s0[right].g + s1[left].g + s1[right].g;
+						int b = s0[left].b + s0[right].b + s1[left].b + s1[right].b;
+
+						cb[row * cw + x] = ycbcrClamp((f.cbr * r + f.cbg * g + f.cbb * b + (f.cOffset << 2)) >> (ycbcrShift + 2));
+						cr[row * cw + x] = ycbcrClamp((f.crr * r + f.crg * g + f.crb * b + (f.cOffset << 2)) >> (ycbcrShift + 2));
+					}
+				}
+			});
+	}
+
+	void convert420(std::span<const uint8_t> y, std::span<const uint8_t> cb, std::span<const uint8_t> cr, int width, int height, std::span<col32> destination, YCbCrStandard standard, YCbCrRange range)
+	{
+		ycbcrCheckDimensions(width, height);
+
+		size_t w = static_cast<size_t>(width);
+		size_t h = static_cast<size_t>(height);
+		size_t cw = (w + 1) / 2;
+		size_t ch = (h + 1) / 2;
+
+		ycbcrCheck(w * h, y.size(), "luma plane");
+		ycbcrCheck(cw * ch, cb.size(), "blue difference plane");
+		ycbcrCheck(cw * ch, cr.size(), "red difference plane");
+		ycbcrCheck(w * h, destination.size(), "destination");
+
+		ycbcrFixed f(standard, range);
+
+		parallelFor(h, ycbcrGrain / (w + 1) + 1, [&](size_t begin, size_t end)
+			{
+				for (size_t row = begin; row < end; row++)
+				{
+					const uint8_t* luma = y.data() + row * w;
+					const uint8_t* blue = cb.data() + (row / 2) * cw;
+					const uint8_t* red = cr.data() + (row / 2) * cw;
+					col32* d = destination.data() + row * w;
+
+					for (size_t x = 0; x < w; x++)
+					{
+						ycbcrDecode(luma[x], blue[x / 2], red[x / 2], f, d[x]);
+					}
+				}
+			});
+	}
+}
\ No newline at end of file